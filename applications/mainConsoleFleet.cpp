@@ -0,0 +1,315 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+// Runs many simulated consoles in a single process (fleet testing).
+// Each console uses a different component prefix so all the
+// components can coexist in the same component manager.  Configuration
+// files are parsed in parallel, consoles are then configured one after
+// the other since configuration registers components with the
+// component manager.  The configuration time as well as the steady
+// state CPU load of each console are reported.
+
+// system
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <list>
+#include <vector>
+
+// cisst/saw
+#include <cisstCommon/cmnPath.h>
+#include <cisstCommon/cmnCommandLineOptions.h>
+#include <cisstOSAbstraction/osaGetTime.h>
+#include <cisstOSAbstraction/osaSleep.h>
+#include <cisstOSAbstraction/osaThread.h>
+#include <cisstMultiTask/mtsManagerLocal.h>
+#include <cisstMultiTask/mtsTask.h>
+#include <cisstMultiTask/mtsIntervalStatistics.h>
+
+#include <sawIntuitiveResearchKit/mtsIntuitiveResearchKit.h>
+#include <sawIntuitiveResearchKit/mtsIntuitiveResearchKitConsole.h>
+#include <sawIntuitiveResearchKit/mtsConsoleExecutor.h>
+
+#include <json/json.h>
+
+struct ConsoleData {
+    std::string m_file;
+    std::string m_prefix;
+    mtsIntuitiveResearchKitConsole * m_console;
+    Json::Value m_json;
+    bool m_parsed;
+    std::string m_parse_errors;
+    double m_parse_time;
+    double m_configure_time;
+    osaThread m_thread;
+    std::vector<std::string> m_components;
+    double m_load_sum;
+};
+
+class FleetLoader {
+public:
+    // runs in its own thread, only parses the file so errors are
+    // reported by the main thread
+    void * Parse(ConsoleData * data) {
+        const double start = osaGetTime();
+        std::ifstream jsonStream;
+        jsonStream.open(data->m_file.c_str());
+        Json::Reader jsonReader;
+        data->m_parsed = jsonReader.parse(jsonStream, data->m_json);
+        if (!data->m_parsed) {
+            data->m_parse_errors = jsonReader.getFormattedErrorMessages();
+        }
+        data->m_parse_time = osaGetTime() - start;
+        return 0;
+    }
+};
+
+void fileExists(const std::string & description, const std::string & filename)
+{
+    if (!cmnPath::Exists(filename)) {
+        std::cerr << "File not found: " << description
+                  << "; " << filename << std::endl;
+        exit(-1);
+    } else {
+        std::cout << "File found: " << description
+                  << "; " << filename << std::endl;
+    }
+}
+
+// average load of a component over the last statistics interval
+double componentLoad(mtsComponent * component)
+{
+    mtsTask * task = dynamic_cast<mtsTask *>(component);
+    if (!task) {
+        return 0.0;
+    }
+    const mtsIntervalStatistics & stats = task->GetDefaultStateTable()->PeriodStats;
+    if (stats.PeriodAvg() <= 0.0) {
+        return 0.0;
+    }
+    return stats.ComputeTimeAvg() / stats.PeriodAvg();
+}
+
+
+int main(int argc, char ** argv)
+{
+    // log configuration
+    cmnLogger::SetMask(CMN_LOG_ALLOW_ALL);
+    cmnLogger::SetMaskDefaultLog(CMN_LOG_ALLOW_ALL);
+    cmnLogger::SetMaskFunction(CMN_LOG_ALLOW_ALL);
+    cmnLogger::SetMaskClassMatching("mtsIntuitiveResearchKit", CMN_LOG_ALLOW_ALL);
+    cmnLogger::AddChannel(std::cerr, CMN_LOG_ALLOW_ERRORS_AND_WARNINGS);
+
+    // parse options
+    cmnCommandLineOptions options;
+    std::list<std::string> jsonConfigFiles;
+    int numberOfInstances = 1;
+    double duration = 10.0;
+    double executorPeriod = mtsIntuitiveResearchKit::IOPeriod;
+
+    options.AddOptionMultipleValues("j", "json-config",
+                                    "json configuration files, each console must be simulated (no IO)",
+                                    cmnCommandLineOptions::REQUIRED_OPTION, &jsonConfigFiles);
+
+    options.AddOptionOneValue("n", "instances",
+                              "number of consoles created for each configuration file (default 1)",
+                              cmnCommandLineOptions::OPTIONAL_OPTION, &numberOfInstances);
+
+    options.AddOptionOneValue("d", "duration",
+                              "duration in seconds used to measure steady state CPU load (default 10)",
+                              cmnCommandLineOptions::OPTIONAL_OPTION, &duration);
+
+    options.AddOptionNoValue("s", "shared-executor",
+                             "run all consoles using a single shared executor thread");
+
+    options.AddOptionOneValue("p", "executor-period",
+                              "period in seconds for the shared executor (default IO period)",
+                              cmnCommandLineOptions::OPTIONAL_OPTION, &executorPeriod);
+
+    options.AddOptionNoValue("S", "sequential",
+                             "parse configuration files sequentially");
+
+    // check that all required options have been provided
+    std::string errorMessage;
+    if (!options.Parse(argc, argv, errorMessage)) {
+        std::cerr << "Error: " << errorMessage << std::endl;
+        options.PrintUsage(std::cerr);
+        return -1;
+    }
+    std::string arguments;
+    options.PrintParsedArguments(arguments);
+    std::cout << "Options provided:" << std::endl << arguments << std::endl;
+
+    if (numberOfInstances < 1) {
+        std::cerr << "Error: number of instances must be at least 1" << std::endl;
+        return -1;
+    }
+    if (duration < 1.0) {
+        std::cerr << "Error: duration must be at least 1 second" << std::endl;
+        return -1;
+    }
+
+    for (const auto & file : jsonConfigFiles) {
+        fileExists("JSON configuration", file);
+    }
+
+    mtsManagerLocal * componentManager = mtsManagerLocal::GetInstance();
+
+    // optional executor shared by all consoles
+    mtsConsoleExecutor * executor = 0;
+    const bool sharedExecutor = options.IsSet("shared-executor");
+    if (sharedExecutor) {
+        executor = new mtsConsoleExecutor("FleetExecutor", executorPeriod);
+    }
+
+    // create all consoles, one prefix per console
+    std::vector<ConsoleData *> consoles;
+    for (const auto & file : jsonConfigFiles) {
+        for (int instance = 0; instance < numberOfInstances; ++instance) {
+            ConsoleData * data = new ConsoleData;
+            data->m_file = file;
+            data->m_prefix = "fleet" + std::to_string(consoles.size()) + "-";
+            data->m_console = new mtsIntuitiveResearchKitConsole(data->m_prefix + "console");
+            data->m_console->set_component_prefix(data->m_prefix);
+            if (sharedExecutor) {
+                data->m_console->set_executor(executor);
+            }
+            data->m_parsed = false;
+            data->m_parse_time = 0.0;
+            data->m_configure_time = 0.0;
+            data->m_load_sum = 0.0;
+            consoles.push_back(data);
+        }
+    }
+
+    // parse all files, in parallel unless requested otherwise
+    FleetLoader loader;
+    const bool parallel = !options.IsSet("sequential");
+    const double parseStart = osaGetTime();
+    for (auto data : consoles) {
+        if (parallel) {
+            data->m_thread.Create<FleetLoader, ConsoleData *>
+                (&loader, &FleetLoader::Parse, data, data->m_prefix.c_str());
+        } else {
+            loader.Parse(data);
+        }
+    }
+    if (parallel) {
+        for (auto data : consoles) {
+            data->m_thread.Wait();
+        }
+    }
+    const double parseTime = osaGetTime() - parseStart;
+    for (auto data : consoles) {
+        if (!data->m_parsed) {
+            std::cerr << "Error: failed to parse " << data->m_file << std::endl
+                      << data->m_parse_errors << std::endl;
+            return -1;
+        }
+    }
+
+    // configure, consoles register components with the component
+    // manager and exit on errors, this is done in main thread
+    const double configureStart = osaGetTime();
+    for (auto data : consoles) {
+        const double start = osaGetTime();
+        data->m_console->Configure(data->m_file, data->m_json);
+        data->m_configure_time = osaGetTime() - start;
+    }
+    const double configureTime = osaGetTime() - configureStart;
+
+    for (auto data : consoles) {
+        componentManager->AddComponent(data->m_console);
+        data->m_console->Connect();
+    }
+    if (sharedExecutor) {
+        componentManager->AddComponent(executor);
+    }
+
+    // find all components created by each console
+    const std::vector<std::string> componentNames = componentManager->GetNamesOfComponents();
+    for (auto data : consoles) {
+        for (const auto & name : componentNames) {
+            if (name.compare(0, data->m_prefix.size(), data->m_prefix) == 0) {
+                data->m_components.push_back(name);
+            }
+        }
+    }
+
+    //-------------- create the components ------------------
+    componentManager->CreateAllAndWait(5.0 * cmn_s);
+    componentManager->StartAllAndWait(5.0 * cmn_s);
+
+    // let the system settle, then sample the statistics every second
+    osaSleep(2.0 * cmn_s);
+    double executorLoadSum = 0.0;
+    const size_t numberOfSamples = static_cast<size_t>(duration);
+    for (size_t sample = 0; sample < numberOfSamples; ++sample) {
+        osaSleep(1.0 * cmn_s);
+        for (auto data : consoles) {
+            for (const auto & name : data->m_components) {
+                data->m_load_sum += componentLoad(componentManager->GetComponent(name));
+            }
+        }
+        if (executor) {
+            executorLoadSum += componentLoad(executor);
+        }
+    }
+
+    componentManager->KillAllAndWait(5.0 * cmn_s);
+    componentManager->Cleanup();
+
+    // report
+    const double samples = static_cast<double>(numberOfSamples);
+    double totalLoad = 0.0;
+    std::cout << std::fixed << std::setprecision(2)
+              << "Fleet of " << consoles.size() << " console(s), files parsed in "
+              << parseTime / cmn_ms << " ms ("
+              << (parallel ? "parallel" : "sequential") << "), consoles configured in "
+              << configureTime / cmn_ms << " ms" << std::endl
+              << "Console / configuration file / components / parse time (ms) / configuration time (ms) / CPU load (% of one core)" << std::endl;
+    for (auto data : consoles) {
+        const double load = 100.0 * data->m_load_sum / samples;
+        totalLoad += load;
+        std::cout << " - " << data->m_console->GetName()
+                  << " / " << data->m_file
+                  << " / " << data->m_components.size()
+                  << " / " << data->m_parse_time / cmn_ms
+                  << " / " << data->m_configure_time / cmn_ms
+                  << " / " << load << std::endl;
+    }
+    std::cout << " - total CPU load: " << totalLoad << "%" << std::endl;
+    if (executor) {
+        std::cout << " - shared executor CPU load: "
+                  << 100.0 * executorLoadSum / samples << "%" << std::endl;
+    }
+
+    for (auto data : consoles) {
+        delete data->m_console;
+        delete data;
+    }
+    if (executor) {
+        delete executor;
+    }
+
+    // stop all logs
+    cmnLogger::Kill();
+
+    return 0;
+}
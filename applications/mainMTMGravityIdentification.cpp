@@ -0,0 +1,353 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+// Identifies the MTM gravity compensation parameters from a recorded
+// trajectory (see robGravityCompensationMTMIdentification) and saves
+// them in a gc-*.json file that can be used with
+// "gravity-compensation" in the MTM configuration file.  The input
+// is either a file created by the dVRK recorder (see mtsDataRecorder)
+// or a CSV file created by share/collection/dvrk-recorder-convert.py.
+// The file is read by blocks so memory usage doesn't depend on the
+// size of the recording.
+
+// system
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+// cisst/saw
+#include <cisstCommon/cmnCommandLineOptions.h>
+#include <cisstCommon/cmnLogger.h>
+#include <cisstOSAbstraction/osaGetTime.h>
+
+#include <sawIntuitiveResearchKit/robGravityCompensationMTMIdentification.h>
+
+#include <json/json.h>
+
+typedef robGravityCompensationMTMIdentification Identification;
+
+// adds samples from signal (position, velocity and effort) found at
+// column first with joints per vector
+class SampleAdder {
+public:
+    SampleAdder(Identification & identification, const size_t decimation):
+        m_identification(identification),
+        m_decimation(decimation),
+        m_count(0),
+        m_skipped(0),
+        m_position(Identification::NumberOfJoints),
+        m_velocity(Identification::NumberOfJoints),
+        m_effort(Identification::NumberOfJoints)
+    {}
+
+    void Add(const double * values, const size_t joints) {
+        if ((m_count++ % m_decimation) != 0) {
+            return;
+        }
+        for (size_t joint = 0; joint < Identification::NumberOfJoints; ++joint) {
+            m_position[joint] = values[joint];
+            m_velocity[joint] = values[joints + joint];
+            m_effort[joint] = values[2 * joints + joint];
+            if (!std::isfinite(m_position[joint])
+                || !std::isfinite(m_velocity[joint])
+                || !std::isfinite(m_effort[joint])) {
+                ++m_skipped;
+                return;
+            }
+        }
+        m_identification.Add(m_position, m_velocity, m_effort);
+    }
+
+    inline size_t Skipped(void) const {
+        return m_skipped;
+    }
+
+protected:
+    Identification & m_identification;
+    size_t m_decimation;
+    size_t m_count;
+    size_t m_skipped;
+    vctDoubleVec m_position, m_velocity, m_effort;
+};
+
+// see mtsDataRecorder.h for file format
+bool readRecorder(std::ifstream & file, const std::string & signal,
+                  SampleAdder & adder, std::string & errorMessage)
+{
+    const char magicNumber[8] = {'d', 'V', 'R', 'K', 'R', 'E', 'C', '\0'};
+    const size_t preambleSize = 32;
+    char preamble[preambleSize];
+    if (!file.read(preamble, preambleSize)
+        || (memcmp(preamble, magicNumber, 8) != 0)) {
+        errorMessage = "not a dVRK recorder file";
+        return false;
+    }
+    uint32_t version, headerSize, numberOfColumns;
+    uint64_t numberOfRecords;
+    memcpy(&version, preamble + 8, sizeof(uint32_t));
+    memcpy(&headerSize, preamble + 12, sizeof(uint32_t));
+    memcpy(&numberOfColumns, preamble + 16, sizeof(uint32_t));
+    memcpy(&numberOfRecords, preamble + 24, sizeof(uint64_t));
+    if ((version != 1) || (headerSize < preambleSize) || (numberOfColumns == 0)) {
+        errorMessage = "unsupported or corrupted header";
+        return false;
+    }
+
+    std::string text(headerSize - preambleSize, '\0');
+    file.read(&(text[0]), text.size());
+    Json::Value jsonDescription;
+    Json::Reader jsonReader;
+    if (!jsonReader.parse(text.c_str(), jsonDescription)) {
+        errorMessage = "failed to parse file description";
+        return false;
+    }
+    size_t first = 0, size = 0;
+    const Json::Value jsonSignals = jsonDescription["signals"];
+    for (unsigned int index = 0; index < jsonSignals.size(); ++index) {
+        if (jsonSignals[index]["name"].asString() == signal) {
+            first = jsonSignals[index]["first-column"].asUInt();
+            size = jsonSignals[index]["size"].asUInt();
+        }
+    }
+    if ((size == 0) || (size % 3 != 0) || (size / 3 < Identification::NumberOfJoints)
+        || (first + size > numberOfColumns)) {
+        errorMessage = "can't find signal \"" + signal + "\" with at least "
+            + std::to_string(Identification::NumberOfJoints) + " joints";
+        return false;
+    }
+
+    // file might not have been closed properly, stop on first
+    // record not written yet (time is 0)
+    const size_t blockSize = 4096;
+    std::vector<double> block(blockSize * numberOfColumns);
+    uint64_t read = 0;
+    while (file && ((numberOfRecords == 0) || (read < numberOfRecords))) {
+        file.read(reinterpret_cast<char *>(block.data()), block.size() * sizeof(double));
+        const size_t records = file.gcount() / (numberOfColumns * sizeof(double));
+        for (size_t index = 0; index < records; ++index) {
+            const double * record = &(block[index * numberOfColumns]);
+            if ((record[0] == 0.0)
+                || ((numberOfRecords != 0) && (read >= numberOfRecords))) {
+                return true;
+            }
+            adder.Add(record + first, size / 3);
+            ++read;
+        }
+    }
+    return true;
+}
+
+// CSV with one header line, see dvrk-recorder-convert.py
+bool readCSV(std::ifstream & file, const std::string & signal,
+             SampleAdder & adder, std::string & errorMessage)
+{
+    std::string line;
+    if (!std::getline(file, line)) {
+        errorMessage = "empty file";
+        return false;
+    }
+    size_t first = 0, size = 0, column = 0;
+    std::stringstream header(line);
+    std::string name;
+    const std::string prefix = signal + "[";
+    while (std::getline(header, name, ',')) {
+        if (name.compare(0, prefix.size(), prefix) == 0) {
+            if (size == 0) {
+                first = column;
+            }
+            ++size;
+        }
+        ++column;
+    }
+    if ((size == 0) || (size % 3 != 0) || (size / 3 < Identification::NumberOfJoints)) {
+        errorMessage = "can't find columns \"" + prefix + "...]\" with at least "
+            + std::to_string(Identification::NumberOfJoints) + " joints";
+        return false;
+    }
+
+    std::vector<double> values(column);
+    while (std::getline(file, line)) {
+        const char * current = line.c_str();
+        char * end;
+        size_t index = 0;
+        for (; index < column; ++index) {
+            values[index] = strtod(current, &end);
+            if (end == current) {
+                break;
+            }
+            current = (*end == ',') ? end + 1 : end;
+        }
+        if (index == column) {
+            adder.Add(&(values[first]), size / 3);
+        }
+    }
+    return true;
+}
+
+int main(int argc, char ** argv)
+{
+    // log configuration
+    cmnLogger::SetMask(CMN_LOG_ALLOW_ALL);
+    cmnLogger::SetMaskDefaultLog(CMN_LOG_ALLOW_ALL);
+    cmnLogger::AddChannel(std::cerr, CMN_LOG_ALLOW_ERRORS_AND_WARNINGS);
+
+    // parse options
+    cmnCommandLineOptions options;
+    std::string inputFile, outputFile, templateFile;
+    std::string signal = "measured_js";
+    std::string armName, serialNumber;
+    double regularization = 1e-6;
+    int decimation = 1;
+
+    options.AddOptionOneValue("i", "input",
+                              "recorded trajectory, dVRK recorder file or CSV",
+                              cmnCommandLineOptions::REQUIRED_OPTION, &inputFile);
+
+    options.AddOptionOneValue("o", "output",
+                              "gravity compensation file to create, e.g. gc-MTML-22723.json",
+                              cmnCommandLineOptions::REQUIRED_OPTION, &outputFile);
+
+    options.AddOptionOneValue("t", "template",
+                              "existing gravity compensation file, velocity thresholds and other fields are preserved",
+                              cmnCommandLineOptions::OPTIONAL_OPTION, &templateFile);
+
+    options.AddOptionOneValue("s", "signal",
+                              "recorded signal with positions, velocities and efforts (default measured_js)",
+                              cmnCommandLineOptions::OPTIONAL_OPTION, &signal);
+
+    options.AddOptionOneValue("a", "arm",
+                              "arm name saved in output file, e.g. MTML",
+                              cmnCommandLineOptions::OPTIONAL_OPTION, &armName);
+
+    options.AddOptionOneValue("n", "serial-number",
+                              "arm serial number saved in output file",
+                              cmnCommandLineOptions::OPTIONAL_OPTION, &serialNumber);
+
+    options.AddOptionOneValue("r", "regularization",
+                              "ridge regularization (default 1e-6)",
+                              cmnCommandLineOptions::OPTIONAL_OPTION, &regularization);
+
+    options.AddOptionOneValue("d", "decimation",
+                              "use one sample every d samples (default 1)",
+                              cmnCommandLineOptions::OPTIONAL_OPTION, &decimation);
+
+    std::string errorMessage;
+    if (!options.Parse(argc, argv, errorMessage)) {
+        std::cerr << "Error: " << errorMessage << std::endl;
+        options.PrintUsage(std::cerr);
+        return -1;
+    }
+    if (decimation < 1) {
+        std::cerr << "Error: decimation must be at least 1" << std::endl;
+        return -1;
+    }
+
+    Identification identification;
+    identification.SetRegularization(regularization);
+
+    // template
+    Json::Value jsonOutput;
+    if (!templateFile.empty()) {
+        std::ifstream jsonStream(templateFile.c_str());
+        Json::Reader jsonReader;
+        if (!jsonReader.parse(jsonStream, jsonOutput)) {
+            std::cerr << "Error: failed to parse \"" << templateFile << "\"" << std::endl
+                      << jsonReader.getFormattedErrorMessages();
+            return -1;
+        }
+        if (!identification.ConfigureJSON(jsonOutput, errorMessage)) {
+            std::cerr << "Error: \"" << templateFile << "\": " << errorMessage << std::endl;
+            return -1;
+        }
+        // results from previous identification don't apply anymore
+        jsonOutput.removeMember("GC_Test");
+    }
+
+    // stream input
+    std::ifstream file(inputFile.c_str(), std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Error: unable to open \"" << inputFile << "\"" << std::endl;
+        return -1;
+    }
+    const std::string extension = ".csv";
+    const bool csv = (inputFile.size() > extension.size())
+        && (inputFile.compare(inputFile.size() - extension.size(), extension.size(), extension) == 0);
+
+    SampleAdder adder(identification, decimation);
+    const double start = osaGetTime();
+    const bool read = csv ?
+        readCSV(file, signal, adder, errorMessage)
+        : readRecorder(file, signal, adder, errorMessage);
+    if (!read) {
+        std::cerr << "Error: \"" << inputFile << "\": " << errorMessage << std::endl;
+        return -1;
+    }
+    const double readTime = osaGetTime() - start;
+    std::cout << "Read " << identification.NumberOfSamples() << " samples from \""
+              << inputFile << "\" in " << readTime << "s";
+    if (adder.Skipped() != 0) {
+        std::cout << ", " << adder.Skipped() << " invalid samples skipped";
+    }
+    std::cout << std::endl;
+
+    if (!identification.Solve(errorMessage)) {
+        std::cerr << "Error: " << errorMessage << std::endl;
+        return -1;
+    }
+    std::cout << "Solved in " << osaGetTime() - start - readTime << "s" << std::endl
+              << "Residual efforts RMS per joint:";
+    for (size_t joint = 0; joint < Identification::NumberOfModeledJoints; ++joint) {
+        std::cout << " " << identification.ResidualRMS().Element(joint);
+    }
+    std::cout << std::endl;
+
+    // save
+    identification.ToJSON(jsonOutput);
+    if (!armName.empty()) {
+        jsonOutput["ARM_NAME"] = armName;
+    }
+    if (!serialNumber.empty()) {
+        jsonOutput["SN"] = serialNumber;
+    }
+    char date[32];
+    const std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%b-%d-%Y-%H:%M:%S", std::localtime(&now));
+    jsonOutput["date_time"] = date;
+    jsonOutput["identification"]["input"] = inputFile;
+    jsonOutput["identification"]["samples"] = static_cast<Json::UInt64>(identification.NumberOfSamples());
+    for (size_t joint = 0; joint < Identification::NumberOfModeledJoints; ++joint) {
+        jsonOutput["identification"]["residual_rms"].append(identification.ResidualRMS().Element(joint));
+    }
+
+    std::ofstream output(outputFile.c_str());
+    if (!output.is_open()) {
+        std::cerr << "Error: unable to create \"" << outputFile << "\"" << std::endl;
+        return -1;
+    }
+    Json::StyledStreamWriter writer;
+    writer.write(output, jsonOutput);
+    std::cout << "Saved \"" << outputFile << "\"" << std::endl;
+    return 0;
+}
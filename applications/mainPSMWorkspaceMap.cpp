@@ -0,0 +1,161 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+// Builds the workspace map for a PSM with a given tool (see
+// robPSMWorkspaceMap).  By default, the map is saved next to the tool
+// definition file with the extension .dvrk-ws so the PSM loads it
+// automatically when the tool is used.
+
+// system
+#include <iostream>
+#include <fstream>
+
+// cisst/saw
+#include <cisstCommon/cmnPath.h>
+#include <cisstCommon/cmnCommandLineOptions.h>
+#include <cisstCommon/cmnUnits.h>
+#include <cisstVector/vctDataFunctionsTransformationsJSON.h>
+#include <cisstOSAbstraction/osaGetTime.h>
+#include <cisstRobot/robManipulator.h>
+
+#include <sawIntuitiveResearchKit/mtsIntuitiveResearchKit.h>
+#include <sawIntuitiveResearchKit/sawIntuitiveResearchKitConfig.h>
+#include <sawIntuitiveResearchKit/robPSMWorkspaceMap.h>
+
+#include <json/json.h>
+
+bool loadJSON(const std::string & filename, Json::Value & jsonConfig)
+{
+    std::ifstream jsonStream;
+    jsonStream.open(filename.c_str());
+    Json::Reader jsonReader;
+    if (!jsonReader.parse(jsonStream, jsonConfig)) {
+        std::cerr << "Error: failed to parse \"" << filename << "\"" << std::endl
+                  << jsonReader.getFormattedErrorMessages();
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char ** argv)
+{
+    // log configuration
+    cmnLogger::SetMask(CMN_LOG_ALLOW_ALL);
+    cmnLogger::SetMaskDefaultLog(CMN_LOG_ALLOW_ALL);
+    cmnLogger::AddChannel(std::cerr, CMN_LOG_ALLOW_ERRORS_AND_WARNINGS);
+
+    // parse options
+    cmnCommandLineOptions options;
+    std::string kinematicFile = "kinematic/psm.json";
+    std::string toolFile;
+    std::string outputFile;
+    double voxelSize = 5.0; // mm
+
+    options.AddOptionOneValue("k", "kinematic",
+                              "arm kinematic file, only the first 3 links are used (default kinematic/psm.json)",
+                              cmnCommandLineOptions::OPTIONAL_OPTION, &kinematicFile);
+
+    options.AddOptionOneValue("t", "tool",
+                              "tool definition file, e.g. LARGE_NEEDLE_DRIVER_400006.json",
+                              cmnCommandLineOptions::REQUIRED_OPTION, &toolFile);
+
+    options.AddOptionOneValue("v", "voxel-size",
+                              "voxel size in millimeters (default 5)",
+                              cmnCommandLineOptions::OPTIONAL_OPTION, &voxelSize);
+
+    options.AddOptionOneValue("o", "output",
+                              "output file (default is tool file with extension .dvrk-ws)",
+                              cmnCommandLineOptions::OPTIONAL_OPTION, &outputFile);
+
+    std::string errorMessage;
+    if (!options.Parse(argc, argv, errorMessage)) {
+        std::cerr << "Error: " << errorMessage << std::endl;
+        options.PrintUsage(std::cerr);
+        return -1;
+    }
+
+    // same search path as arms and tools
+    cmnPath path;
+    path.Add(cmnPath::GetWorkingDirectory());
+    path.Add(std::string(sawIntuitiveResearchKit_SOURCE_DIR) + "/../share", cmnPath::TAIL);
+    path.Add(std::string(sawIntuitiveResearchKit_SOURCE_DIR) + "/../share/tool", cmnPath::TAIL);
+
+    const std::string kinematicFullName = path.Find(kinematicFile);
+    const std::string toolFullName = path.Find(toolFile);
+    if (kinematicFullName.empty() || toolFullName.empty()) {
+        std::cerr << "Error: can't find \"" << (kinematicFullName.empty() ? kinematicFile : toolFile)
+                  << "\" in " << path << std::endl;
+        return -1;
+    }
+
+    if (outputFile.empty()) {
+        outputFile = toolFullName;
+        const std::string extension = ".json";
+        if ((outputFile.size() > extension.size())
+            && (outputFile.compare(outputFile.size() - extension.size(), extension.size(), extension) == 0)) {
+            outputFile.resize(outputFile.size() - extension.size());
+        }
+        outputFile.append(".dvrk-ws");
+    }
+
+    // same kinematic chain as mtsIntuitiveResearchKitPSM::ConfigureTool
+    Json::Value jsonKinematic, jsonTool;
+    if (!loadJSON(kinematicFullName, jsonKinematic)
+        || !loadJSON(toolFullName, jsonTool)) {
+        return -1;
+    }
+    robManipulator manipulator;
+    const Json::Value jsonBase = jsonKinematic["base-offset"];
+    if (!jsonBase.isNull()) {
+        cmnDataJSON<vctFrm4x4>::DeSerializeText(manipulator.Rtw0, jsonBase);
+    }
+    if (manipulator.LoadRobot(jsonKinematic["DH"]) != robManipulator::ESUCCESS) {
+        std::cerr << "Error: failed to load \"DH\" from \"" << kinematicFullName << "\"" << std::endl;
+        return -1;
+    }
+    manipulator.Truncate(3);
+    if (manipulator.LoadRobot(jsonTool["DH"]) != robManipulator::ESUCCESS) {
+        std::cerr << "Error: failed to load \"DH\" from \"" << toolFullName << "\"" << std::endl;
+        return -1;
+    }
+
+    std::cout << "Building workspace map for \"" << toolFullName << "\"" << std::endl
+              << " - arm kinematic: \"" << kinematicFullName << "\"" << std::endl
+              << " - voxel size: " << voxelSize << " mm" << std::endl;
+
+    robPSMWorkspaceMap map;
+    const double start = osaGetTime();
+    if (!map.Build(manipulator, voxelSize * cmn_mm,
+                   mtsIntuitiveResearchKit::PSM::SafeDistanceFromRCM,
+                   errorMessage, &std::cout)) {
+        std::cerr << "Error: " << errorMessage << std::endl;
+        return -1;
+    }
+    size_t reachable, unsafe, unreachable;
+    map.Count(reachable, unsafe, unreachable);
+    std::cout << "Built in " << osaGetTime() - start << "s, voxels reachable: " << reachable
+              << ", reachable unsafe: " << unsafe << ", unreachable: " << unreachable << std::endl;
+
+    if (!map.Save(outputFile, errorMessage)) {
+        std::cerr << "Error: " << errorMessage << std::endl;
+        return -1;
+    }
+    std::cout << "Saved \"" << outputFile << "\"" << std::endl;
+    return 0;
+}
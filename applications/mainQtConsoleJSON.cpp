@@ -18,6 +18,7 @@ http://www.cisst.org/cisst/license.txt.
 */
 
 // system
+#include <csignal>
 #include <iostream>
 #include <map>
 
@@ -25,8 +26,10 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstCommon/cmnPath.h>
 #include <cisstCommon/cmnCommandLineOptions.h>
 #include <cisstCommon/cmnQt.h>
+#include <cisstOSAbstraction/osaSleep.h>
 #include <sawIntuitiveResearchKit/mtsIntuitiveResearchKitConsole.h>
 #include <sawIntuitiveResearchKit/mtsIntuitiveResearchKitConsoleQt.h>
+#include <sawIntuitiveResearchKit/mtsConsoleSharedMemoryServer.h>
 
 #include <cisstMultiTask/mtsCollectorFactory.h>
 #include <cisstMultiTask/mtsCollectorQtFactory.h>
@@ -36,6 +39,10 @@ http://www.cisst.org/cisst/license.txt.
 #include <QApplication>
 #include <QIcon>
 
+#if (CISST_OS == CISST_LINUX)
+#include <sys/mman.h>
+#endif
+
 void fileExists(const std::string & description, const std::string & filename)
 {
     if (!cmnPath::Exists(filename)) {
@@ -48,6 +55,13 @@ void fileExists(const std::string & description, const std::string & filename)
     }
 }
 
+// used to stop the headless console on ctrl-c
+static volatile std::sig_atomic_t headlessStop = 0;
+
+void headlessSignalHandler(int)
+{
+    headlessStop = 1;
+}
 
 int main(int argc, char ** argv)
 {
@@ -64,6 +78,7 @@ int main(int argc, char ** argv)
     std::string jsonCollectionConfigFile;
     std::list<std::string> managerConfig;
     std::string qtStyle;
+    std::string sharedMemoryName;
 
     options.AddOptionOneValue("j", "json-config",
                               "json configuration file",
@@ -87,6 +102,16 @@ int main(int argc, char ** argv)
     options.AddOptionNoValue("D", "dark-mode",
                              "replaces the default Qt palette with darker colors");
 
+    options.AddOptionOneValue("s", "shared-memory",
+                              "publish console and arms state in shared memory for sawIntuitiveResearchKitQtConsoleRemote",
+                              cmnCommandLineOptions::OPTIONAL_OPTION, &sharedMemoryName);
+
+    options.AddOptionNoValue("H", "headless",
+                             "don't create any Qt widget, use with -s to run the GUI in a separate process");
+
+    options.AddOptionNoValue("L", "lock-memory",
+                             "lock all current and future memory pages to avoid page faults in the control loops (Linux only, might require elevated privileges)");
+
     // check that all required options have been provided
     std::string errorMessage;
     if (!options.Parse(argc, argv, errorMessage)) {
@@ -110,24 +135,42 @@ int main(int argc, char ** argv)
     componentManager->AddComponent(console);
     console->Connect();
 
-    // add all Qt widgets
-    QApplication application(argc, argv);
-    application.setWindowIcon(QIcon(":/dVRK.png"));
-    cmnQt::QApplicationExitsOnCtrlC();
-    if (options.IsSet("qt-style")) {
-        std::string errorMessage = cmnQt::SetStyle(qtStyle);
-        if (errorMessage != "") {
-            std::cerr << errorMessage << std::endl;
-            return -1;
-        }
+    // shared memory for out-of-process GUI
+    if (options.IsSet("shared-memory")) {
+        mtsConsoleSharedMemoryServer * sharedMemoryServer
+            = new mtsConsoleSharedMemoryServer("console-shared-memory", 20.0 * cmn_ms, sharedMemoryName);
+        sharedMemoryServer->Configure(console);
+        componentManager->AddComponent(sharedMemoryServer);
+        sharedMemoryServer->Connect();
     }
-    if (options.IsSet("dark-mode")) {
-        cmnQt::SetDarkMode();
+
+    const bool headless = options.IsSet("headless");
+    if (headless && !options.IsSet("shared-memory")) {
+        std::cout << "Running headless without shared memory, only messages in cisstLog will be available" << std::endl;
     }
 
-    mtsIntuitiveResearchKitConsoleQt * consoleQt = new mtsIntuitiveResearchKitConsoleQt();
-    consoleQt->Configure(console);
-    consoleQt->Connect();
+    // add all Qt widgets, headless doesn't require a display
+    QApplication * application = nullptr;
+    mtsIntuitiveResearchKitConsoleQt * consoleQt = nullptr;
+    if (!headless) {
+        application = new QApplication(argc, argv);
+        application->setWindowIcon(QIcon(":/dVRK.png"));
+        cmnQt::QApplicationExitsOnCtrlC();
+        if (options.IsSet("qt-style")) {
+            std::string errorMessage = cmnQt::SetStyle(qtStyle);
+            if (errorMessage != "") {
+                std::cerr << errorMessage << std::endl;
+                return -1;
+            }
+        }
+        if (options.IsSet("dark-mode")) {
+            cmnQt::SetDarkMode();
+        }
+
+        consoleQt = new mtsIntuitiveResearchKitConsoleQt();
+        consoleQt->Configure(console);
+        consoleQt->Connect();
+    }
 
     // configure data collection if needed
     if (options.IsSet("collection-config")) {
@@ -139,14 +182,16 @@ int main(int argc, char ** argv)
         componentManager->AddComponent(collectorFactory);
         collectorFactory->Connect();
 
-        mtsCollectorQtWidget * collectorQtWidget = new mtsCollectorQtWidget();
-        consoleQt->addTab(collectorQtWidget, "Collection");
+        if (!headless) {
+            mtsCollectorQtWidget * collectorQtWidget = new mtsCollectorQtWidget();
+            consoleQt->addTab(collectorQtWidget, "Collection");
 
-        mtsCollectorQtFactory * collectorQtFactory = new mtsCollectorQtFactory("collectorsQt");
-        collectorQtFactory->SetFactory("collectors");
-        componentManager->AddComponent(collectorQtFactory);
-        collectorQtFactory->Connect();
-        collectorQtFactory->ConnectToWidget(collectorQtWidget);
+            mtsCollectorQtFactory * collectorQtFactory = new mtsCollectorQtFactory("collectorsQt");
+            collectorQtFactory->SetFactory("collectors");
+            componentManager->AddComponent(collectorQtFactory);
+            collectorQtFactory->Connect();
+            collectorQtFactory->ConnectToWidget(collectorQtWidget);
+        }
     }
 
     // custom user component
@@ -159,7 +204,29 @@ int main(int argc, char ** argv)
     componentManager->CreateAllAndWait(2.0 * cmn_s);
     componentManager->StartAllAndWait(2.0 * cmn_s);
 
-    application.exec();
+    // lock memory once all components and threads are created
+    if (options.IsSet("lock-memory")) {
+#if (CISST_OS == CISST_LINUX)
+        if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+            CMN_LOG_INIT_WARNING << "main: failed to lock memory (mlockall), make sure the user can lock memory (ulimit -l)" << std::endl;
+        } else {
+            std::cout << "Memory locked" << std::endl;
+        }
+#else
+        CMN_LOG_INIT_WARNING << "main: lock-memory option is only supported on Linux" << std::endl;
+#endif
+    }
+
+    if (headless) {
+        std::signal(SIGINT, headlessSignalHandler);
+        std::signal(SIGTERM, headlessSignalHandler);
+        std::cout << "Running headless, press ctrl-c to quit" << std::endl;
+        while (!headlessStop) {
+            osaSleep(100.0 * cmn_ms);
+        }
+    } else {
+        application->exec();
+    }
 
     componentManager->KillAllAndWait(2.0 * cmn_s);
     componentManager->Cleanup();
@@ -167,7 +234,10 @@ int main(int argc, char ** argv)
     // stop all logs
     cmnLogger::Kill();
 
-    delete consoleQt;
+    if (consoleQt) {
+        delete consoleQt;
+        delete application;
+    }
 
     return 0;
 }
@@ -0,0 +1,133 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+// system
+#include <iostream>
+
+// cisst/saw
+#include <cisstCommon/cmnCommandLineOptions.h>
+#include <cisstCommon/cmnQt.h>
+#include <cisstMultiTask/mtsManagerLocal.h>
+#include <sawIntuitiveResearchKit/mtsConsoleSharedMemoryClient.h>
+#include <sawIntuitiveResearchKit/mtsIntuitiveResearchKitConsoleQtWidget.h>
+#include <sawIntuitiveResearchKit/mtsIntuitiveResearchKitArmQtWidget.h>
+
+#include <QApplication>
+#include <QIcon>
+#include <QTabWidget>
+
+int main(int argc, char ** argv)
+{
+    // log configuration
+    cmnLogger::SetMask(CMN_LOG_ALLOW_ALL);
+    cmnLogger::SetMaskDefaultLog(CMN_LOG_ALLOW_ALL);
+    cmnLogger::SetMaskFunction(CMN_LOG_ALLOW_ALL);
+    cmnLogger::SetMaskClassMatching("mtsIntuitiveResearchKit", CMN_LOG_ALLOW_ALL);
+    cmnLogger::SetMaskClassMatching("mtsConsoleSharedMemory", CMN_LOG_ALLOW_ALL);
+    cmnLogger::AddChannel(std::cerr, CMN_LOG_ALLOW_ERRORS_AND_WARNINGS);
+
+    // parse options
+    cmnCommandLineOptions options;
+    std::string sharedMemoryName = "dvrk-console";
+    std::string qtStyle;
+
+    options.AddOptionOneValue("s", "shared-memory",
+                              "shared memory name used by the console (see sawIntuitiveResearchKitQtConsoleJSON -s), default is dvrk-console",
+                              cmnCommandLineOptions::OPTIONAL_OPTION, &sharedMemoryName);
+
+    options.AddOptionOneValue("S", "qt-style",
+                              "Qt style, use this option with a random name to see available styles",
+                              cmnCommandLineOptions::OPTIONAL_OPTION, &qtStyle);
+
+    options.AddOptionNoValue("D", "dark-mode",
+                             "replaces the default Qt palette with darker colors");
+
+    // check that all required options have been provided
+    std::string errorMessage;
+    if (!options.Parse(argc, argv, errorMessage)) {
+        std::cerr << "Error: " << errorMessage << std::endl;
+        options.PrintUsage(std::cerr);
+        return -1;
+    }
+    std::string arguments;
+    options.PrintParsedArguments(arguments);
+    std::cout << "Options provided:" << std::endl << arguments << std::endl;
+
+    mtsManagerLocal * componentManager = mtsManagerLocal::GetInstance();
+
+    // client, attaches to shared memory created by the console process
+    mtsConsoleSharedMemoryClient * client
+        = new mtsConsoleSharedMemoryClient("console-remote", 20.0 * cmn_ms, sharedMemoryName);
+    client->Configure();
+    componentManager->AddComponent(client);
+
+    // add all Qt widgets
+    QApplication application(argc, argv);
+    application.setWindowIcon(QIcon(":/dVRK.png"));
+    cmnQt::QApplicationExitsOnCtrlC();
+    if (options.IsSet("qt-style")) {
+        std::string errorMessage = cmnQt::SetStyle(qtStyle);
+        if (errorMessage != "") {
+            std::cerr << errorMessage << std::endl;
+            return -1;
+        }
+    }
+    if (options.IsSet("dark-mode")) {
+        cmnQt::SetDarkMode();
+    }
+
+    mtsIntuitiveResearchKitConsoleQtWidget * consoleGUI
+        = new mtsIntuitiveResearchKitConsoleQtWidget("consoleGUI");
+    componentManager->AddComponent(consoleGUI);
+    componentManager->Connect(consoleGUI->GetName(), "Main", client->GetName(), "Main");
+
+    // arms, all use the generic arm widget
+    QTabWidget * tabWidget = consoleGUI->GetTabWidget();
+    QTabWidget * armTabWidget;
+    if (client->Arms().size() > 1) {
+        armTabWidget = new QTabWidget();
+        armTabWidget->setObjectName(QString("Arms"));
+        tabWidget->addTab(armTabWidget, "Arms");
+    } else {
+        armTabWidget = tabWidget;
+    }
+    for (const auto & arm : client->Arms()) {
+        mtsIntuitiveResearchKitArmQtWidget * armGUI
+            = new mtsIntuitiveResearchKitArmQtWidget(arm.Name + "-GUI");
+        armGUI->Configure();
+        componentManager->AddComponent(armGUI);
+        componentManager->Connect(armGUI->GetName(), "Manipulator", client->GetName(), arm.Name);
+        armGUI->setObjectName(arm.Name.c_str());
+        armTabWidget->addTab(armGUI, arm.Name.c_str());
+    }
+
+    //-------------- create the components ------------------
+    componentManager->CreateAllAndWait(2.0 * cmn_s);
+    componentManager->StartAllAndWait(2.0 * cmn_s);
+
+    application.exec();
+
+    componentManager->KillAllAndWait(2.0 * cmn_s);
+    componentManager->Cleanup();
+
+    // stop all logs
+    cmnLogger::Kill();
+
+    return 0;
+}
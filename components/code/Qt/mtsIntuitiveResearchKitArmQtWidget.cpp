@@ -28,6 +28,7 @@ http://www.cisst.org/cisst/license.txt.
 #include <QMessageBox>
 #include <QScrollBar>
 #include <QCloseEvent>
+#include <QShowEvent>
 #include <QCoreApplication>
 
 // cisst
@@ -43,6 +44,8 @@ CMN_IMPLEMENT_SERVICES_DERIVED_ONEARG(mtsIntuitiveResearchKitArmQtWidget, mtsCom
 mtsIntuitiveResearchKitArmQtWidget::mtsIntuitiveResearchKitArmQtWidget(const std::string & componentName, double periodInSeconds):
     mtsComponent(componentName),
     TimerPeriodInMilliseconds(periodInSeconds * 1000),
+    RefreshDecimation(1),
+    RefreshCounter(0),
     DirectControl(false),
     LogEnabled(false)
 {
@@ -62,6 +65,7 @@ mtsIntuitiveResearchKitArmQtWidget::mtsIntuitiveResearchKitArmQtWidget(const std
         InterfaceRequired->AddFunction("body/measured_cf", Arm.measured_cf_body, MTS_OPTIONAL);
         InterfaceRequired->AddFunction("move_jp", Arm.move_jp, MTS_OPTIONAL);
         InterfaceRequired->AddFunction("period_statistics", Arm.period_statistics);
+        InterfaceRequired->AddFunction("gui/snapshot", Arm.gui_snapshot, MTS_OPTIONAL);
         InterfaceRequired->AddEventReceiver("trajectory_j/ratio", Arm.trajectory_j_ratio, MTS_OPTIONAL);
         InterfaceRequired->AddFunction("trajectory_j/set_ratio", Arm.trajectory_j_set_ratio, MTS_OPTIONAL);
 
@@ -105,44 +109,81 @@ void mtsIntuitiveResearchKitArmQtWidget::closeEvent(QCloseEvent * event)
     }
 }
 
+void mtsIntuitiveResearchKitArmQtWidget::showEvent(QShowEvent * event)
+{
+    // refresh as soon as the widget (or tab) is displayed
+    RefreshDecimation = 1;
+    RefreshCounter = 0;
+    QWidget::showEvent(event);
+}
+
 void mtsIntuitiveResearchKitArmQtWidget::timerEvent(QTimerEvent * CMN_UNUSED(event))
 {
-    // make sure we should update the display
-    if (this->isHidden()) {
+    // make sure we should update the display, isVisible is false for
+    // tabs not selected and widgets in hidden windows
+    if (!this->isVisible()) {
         return;
     }
 
-    mtsExecutionResult executionResult;
+    // lower refresh rate when the arm is not moving
+    ++RefreshCounter;
+    if (RefreshCounter < RefreshDecimation) {
+        return;
+    }
+    RefreshCounter = 0;
 
-    executionResult = Arm.measured_js(StateJoint);
-    if (executionResult) {
-        if ((ConfigurationJoint.Name().size() != StateJoint.Name().size())
-            && (Arm.configuration_js.IsValid())) {
-            Arm.configuration_js(ConfigurationJoint);
-            QSJWidget->SetConfiguration(ConfigurationJoint);
+    if (UsesSnapshot()) {
+        // single read for all data
+        if (!Arm.gui_snapshot(Snapshot)) {
+            return;
         }
-        QSJWidget->SetValue(StateJoint);
+        StateJoint = Snapshot.StateJoint();
+        Position = Snapshot.Position();
+        Wrench = Snapshot.Wrench();
+        IntervalStatistics = Snapshot.PeriodStatistics();
+    } else {
+        Arm.measured_js(StateJoint);
+        Arm.measured_cp(Position);
+        if (Arm.measured_cf_body.IsValid()) {
+            Arm.measured_cf_body(Wrench);
+        }
+        Arm.period_statistics(IntervalStatistics);
     }
 
-    executionResult = Arm.measured_cp(Position);
-    if (executionResult) {
-        QCPGWidget->SetValue(Position);
+    if ((ConfigurationJoint.Name().size() != StateJoint.Name().size())
+        && (Arm.configuration_js.IsValid())) {
+        Arm.configuration_js(ConfigurationJoint);
+        QSJWidget->SetConfiguration(ConfigurationJoint);
     }
-
-    executionResult = Arm.measured_cf_body(Wrench);
-    if (executionResult) {
-        if (Wrench.Valid()) {
-            QFTWidget->SetValue(Wrench.F(), Wrench.T(), Wrench.Timestamp());
-        }
+    QSJWidget->SetValue(StateJoint);
+    QCPGWidget->SetValue(Position);
+    if (Wrench.Valid()) {
+        QFTWidget->SetValue(Wrench.F(), Wrench.T(), Wrench.Timestamp());
     }
-
-    Arm.period_statistics(IntervalStatistics);
     QMIntervalStatistics->SetValue(IntervalStatistics);
 
+    UpdateRefreshDecimation();
+
     // for derived classes
     this->timerEventDerived();
 }
 
+void mtsIntuitiveResearchKitArmQtWidget::UpdateRefreshDecimation(void)
+{
+    // back to full rate as soon as the arm moves, otherwise slow
+    // down to an eighth of the timer rate
+    const vctDoubleVec & position = StateJoint.Position();
+    if ((position.size() == PreviousPosition.size())
+        && position.AlmostEqual(PreviousPosition, 1.0e-6)) {
+        if (RefreshDecimation < 8) {
+            RefreshDecimation *= 2;
+        }
+    } else {
+        RefreshDecimation = 1;
+        PreviousPosition.ForceAssign(position);
+    }
+}
+
 void mtsIntuitiveResearchKitArmQtWidget::DesiredStateEventHandler(const std::string & state)
 {
     emit SignalDesiredState(QString(state.c_str()));
@@ -54,15 +54,15 @@ void mtsIntuitiveResearchKitConsoleQt::Configure(mtsIntuitiveResearchKitConsole
     mtsIntuitiveResearchKitConsoleQtWidget * consoleGUI = new mtsIntuitiveResearchKitConsoleQtWidget("consoleGUI");
     componentManager->AddComponent(consoleGUI);
     // connect consoleGUI to console
-    Connections.Add("consoleGUI", "Main", "console", "Main");
+    Connections.Add("consoleGUI", "Main", console->GetName(), "Main");
     if (console->GetInterfaceRequired("Clutch")) {
-        Connections.Add("consoleGUI", "Clutch", "console", "Clutch");
+        Connections.Add("consoleGUI", "Clutch", console->GetName(), "Clutch");
     }
     if (console->GetInterfaceRequired("OperatorPresent")) {
-        Connections.Add("consoleGUI", "OperatorPresent", "console", "OperatorPresent");
+        Connections.Add("consoleGUI", "OperatorPresent", console->GetName(), "OperatorPresent");
     }
     if (console->GetInterfaceRequired("Camera")) {
-        Connections.Add("consoleGUI", "Camera", "console", "Camera");
+        Connections.Add("consoleGUI", "Camera", console->GetName(), "Camera");
     }
 
     TabWidget = consoleGUI->GetTabWidget();
@@ -73,7 +73,7 @@ void mtsIntuitiveResearchKitConsoleQt::Configure(mtsIntuitiveResearchKitConsole
         mtsRobotIO1394QtWidgetFactory * robotWidgetFactory = new mtsRobotIO1394QtWidgetFactory("robotWidgetFactory");
         componentManager->AddComponent(robotWidgetFactory);
         // this connect needs to happen now so the factory can figure out the io interfaces
-        componentManager->Connect("robotWidgetFactory", "RobotConfiguration", "io", "Configuration");
+        componentManager->Connect("robotWidgetFactory", "RobotConfiguration", console->m_IO_component_name, "Configuration");
         robotWidgetFactory->Configure();
 
         // add all IO GUI to tab
@@ -186,22 +186,22 @@ void mtsIntuitiveResearchKitConsoleQt::Configure(mtsIntuitiveResearchKitConsole
 
             sujGUI = new mtsIntuitiveResearchKitSUJQtWidget("PSM1-SUJ");
             componentManager->AddComponent(sujGUI);
-            Connections.Add(sujGUI->GetName(), "Manipulator", "SUJ", "PSM1");
+            Connections.Add(sujGUI->GetName(), "Manipulator", armIter->second->ComponentName(), "PSM1");
             armTabWidget->addTab(sujGUI, "PSM1 SUJ");
 
             sujGUI = new mtsIntuitiveResearchKitSUJQtWidget("ECM-SUJ");
             componentManager->AddComponent(sujGUI);
-            Connections.Add(sujGUI->GetName(), "Manipulator", "SUJ", "ECM");
+            Connections.Add(sujGUI->GetName(), "Manipulator", armIter->second->ComponentName(), "ECM");
             armTabWidget->addTab(sujGUI, "ECM SUJ");
 
             sujGUI = new mtsIntuitiveResearchKitSUJQtWidget("PSM2-SUJ");
             componentManager->AddComponent(sujGUI);
-            Connections.Add(sujGUI->GetName(), "Manipulator", "SUJ", "PSM2");
+            Connections.Add(sujGUI->GetName(), "Manipulator", armIter->second->ComponentName(), "PSM2");
             armTabWidget->addTab(sujGUI, "PSM2 SUJ");
 
             sujGUI = new mtsIntuitiveResearchKitSUJQtWidget("PSM3-SUJ");
             componentManager->AddComponent(sujGUI);
-            Connections.Add(sujGUI->GetName(), "Manipulator", "SUJ", "PSM3");
+            Connections.Add(sujGUI->GetName(), "Manipulator", armIter->second->ComponentName(), "PSM3");
             armTabWidget->addTab(sujGUI, "PSM3 SUJ");
 
             break;
@@ -213,7 +213,7 @@ void mtsIntuitiveResearchKitConsoleQt::Configure(mtsIntuitiveResearchKitConsole
             socketGUI->Configure();
             componentManager->AddComponent(socketGUI);
             Connections.Add(socketGUI->GetName(), "SocketBase",
-                            armIter->second->m_name, "System");
+                            armIter->second->ComponentName(), "System");
             armTabWidget->addTab(socketGUI, name.c_str());
             break;
 
@@ -272,7 +272,8 @@ void mtsIntuitiveResearchKitConsoleQt::Configure(mtsIntuitiveResearchKitConsole
         teleopGUI->setObjectName(name.c_str());
         teleopGUI->Configure();
         componentManager->AddComponent(teleopGUI);
-        Connections.Add(teleopGUI->GetName(), "TeleOperation", name, "Setting");
+        Connections.Add(teleopGUI->GetName(), "TeleOperation",
+                        teleopIter->second->ComponentName(), "Setting");
         teleopTabWidget->addTab(teleopGUI, name.c_str());
     }
 
@@ -283,7 +284,8 @@ void mtsIntuitiveResearchKitConsoleQt::Configure(mtsIntuitiveResearchKitConsole
         mtsTeleOperationECMQtWidget * teleopGUI = new mtsTeleOperationECMQtWidget(name + "-GUI");
         teleopGUI->Configure();
         componentManager->AddComponent(teleopGUI);
-        Connections.Add(teleopGUI->GetName(), "TeleOperation", name, "Setting");
+        Connections.Add(teleopGUI->GetName(), "TeleOperation",
+                        console->mTeleopECM->ComponentName(), "Setting");
         TabWidget->addTab(teleopGUI, name.c_str());
     }
 
@@ -58,7 +58,11 @@ void mtsIntuitiveResearchKitMTMQtWidget::setupUiDerived(void)
 
 void mtsIntuitiveResearchKitMTMQtWidget::timerEventDerived(void)
 {
-    gripper_measured_js(m_gripper_measured_js);
+    if (UsesSnapshot()) {
+        m_gripper_measured_js = Snapshot.ToolStateJoint();
+    } else {
+        gripper_measured_js(m_gripper_measured_js);
+    }
     if (m_gripper_measured_js.Position().size() > 0) {
         QString text;
         text.setNum(m_gripper_measured_js.Position().at(0) * cmn180_PI, 'f', 3);
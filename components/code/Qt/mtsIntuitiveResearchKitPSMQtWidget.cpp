@@ -154,7 +154,11 @@ void mtsIntuitiveResearchKitPSMQtWidget::timerEventDerived(void)
     }
 
     // get jaw data
-    Jaw.measured_js(m_jaw_measured_js);
+    if (UsesSnapshot()) {
+        m_jaw_measured_js = Snapshot.ToolStateJoint();
+    } else {
+        Jaw.measured_js(m_jaw_measured_js);
+    }
 
     QString text;
     if (m_jaw_measured_js.Position().size() > 0) {
@@ -173,7 +177,9 @@ void mtsIntuitiveResearchKitPSMQtWidget::timerEventDerived(void)
         m_signal_jaw->AppendPoint(vctDouble2(m_jaw_measured_js.Timestamp(),
                                              -(cmn180_PI) * m_jaw_measured_js.Effort().at(0)));
         m_signal_jaw_zero->AppendPoint(vctDouble2(m_jaw_measured_js.Timestamp(), 0.0));
-        QVP2DJaw->update();
+        if (QVP2DJaw->isVisible()) {
+            QVP2DJaw->update();
+        }
         text.setNum(m_jaw_measured_js.Effort().at(0), 'f', 3);
         QLEJawEffort->setText(text);
     } else {
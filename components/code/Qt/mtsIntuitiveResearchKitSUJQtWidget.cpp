@@ -37,7 +37,8 @@ CMN_IMPLEMENT_SERVICES_DERIVED_ONEARG(mtsIntuitiveResearchKitSUJQtWidget, mtsCom
 
 mtsIntuitiveResearchKitSUJQtWidget::mtsIntuitiveResearchKitSUJQtWidget(const std::string & componentName, double periodInSeconds):
     mtsIntuitiveResearchKitArmQtWidget(componentName, periodInSeconds),
-    mShowMore(false)
+    mShowMore(false),
+    mShowMoreCounter(0)
 {
     CMN_ASSERT(InterfaceRequired);
     InterfaceRequired->AddFunction("GetBrakeCurrent", GetBrakeCurrent);
@@ -183,8 +184,9 @@ void mtsIntuitiveResearchKitSUJQtWidget::setupUiDerived(void)
 
 void mtsIntuitiveResearchKitSUJQtWidget::timerEventDerived(void)
 {
-    // display more if needed
-    if (mShowMore) {
+    // display more if needed, every 4 refreshes
+    if (mShowMore
+        && ((mShowMoreCounter++ % 4) == 0)) {
         // brake voltage
         GetBrakeCurrent(BrakeCurrent);
         QVBrakeCurrentWidget->SetValue(vctDoubleVec(1, BrakeCurrent * 1000.0));
@@ -0,0 +1,137 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+// system include
+#include <cstring>
+#include <fstream>
+
+#include <sawIntuitiveResearchKit/dvrk_batch_kinematics.h>
+#include <sawIntuitiveResearchKit/robBatchKinematics.h>
+
+#include <json/json.h>
+
+struct dvrk_batch_kinematics {
+    robBatchKinematics Batch;
+};
+
+namespace {
+    bool loadJSON(const char * filename, Json::Value & jsonConfig,
+                  std::string & errorMessage)
+    {
+        std::ifstream jsonStream;
+        jsonStream.open(filename);
+        if (!jsonStream.is_open()) {
+            errorMessage = std::string("can't open \"") + filename + "\"";
+            return false;
+        }
+        Json::Reader jsonReader;
+        if (!jsonReader.parse(jsonStream, jsonConfig)) {
+            errorMessage = std::string("failed to parse \"") + filename + "\": "
+                + jsonReader.getFormattedErrorMessages();
+            return false;
+        }
+        return true;
+    }
+
+    void setError(const std::string & errorMessage, char * error, size_t error_size)
+    {
+        if (error && (error_size > 0)) {
+            strncpy(error, errorMessage.c_str(), error_size - 1);
+            error[error_size - 1] = '\0';
+        }
+    }
+}
+
+dvrk_batch_kinematics * dvrk_batch_kinematics_create(const char * type,
+                                                     const char * kinematic_file,
+                                                     const char * gravity_file,
+                                                     char * error,
+                                                     size_t error_size)
+{
+    std::string errorMessage;
+    if (!type || !kinematic_file) {
+        setError("type and kinematic file are required", error, error_size);
+        return nullptr;
+    }
+
+    Json::Value jsonKinematic, jsonGravity;
+    if (!loadJSON(kinematic_file, jsonKinematic, errorMessage)) {
+        setError(errorMessage, error, error_size);
+        return nullptr;
+    }
+    if (gravity_file && (gravity_file[0] != '\0')
+        && !loadJSON(gravity_file, jsonGravity, errorMessage)) {
+        setError(errorMessage, error, error_size);
+        return nullptr;
+    }
+
+    dvrk_batch_kinematics * batch = new dvrk_batch_kinematics;
+    if (!batch->Batch.Configure(type, jsonKinematic, jsonGravity, errorMessage)) {
+        setError(errorMessage, error, error_size);
+        delete batch;
+        return nullptr;
+    }
+    return batch;
+}
+
+void dvrk_batch_kinematics_destroy(dvrk_batch_kinematics * batch)
+{
+    delete batch;
+}
+
+size_t dvrk_batch_kinematics_number_of_joints(const dvrk_batch_kinematics * batch)
+{
+    return batch->Batch.NumberOfJoints();
+}
+
+int dvrk_batch_kinematics_has_gravity_compensation(const dvrk_batch_kinematics * batch)
+{
+    return batch->Batch.HasGravityCompensation() ? 1 : 0;
+}
+
+void dvrk_batch_kinematics_set_number_of_threads(dvrk_batch_kinematics * batch,
+                                                 size_t number_of_threads)
+{
+    batch->Batch.SetNumberOfThreads(number_of_threads);
+}
+
+void dvrk_batch_kinematics_forward(dvrk_batch_kinematics * batch,
+                                   const double * positions,
+                                   size_t samples,
+                                   double * frames)
+{
+    batch->Batch.ForwardKinematics(positions, samples, frames);
+}
+
+size_t dvrk_batch_kinematics_inverse(dvrk_batch_kinematics * batch,
+                                     const double * frames,
+                                     size_t samples,
+                                     double * positions,
+                                     int * status)
+{
+    return batch->Batch.InverseKinematics(frames, samples, positions, status);
+}
+
+int dvrk_batch_kinematics_gravity_compensation(dvrk_batch_kinematics * batch,
+                                               const double * positions,
+                                               const double * velocities,
+                                               size_t samples,
+                                               double * efforts)
+{
+    return batch->Batch.GravityCompensation(positions, velocities, samples, efforts) ? 1 : 0;
+}
@@ -0,0 +1,152 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+// system include
+#include <algorithm>
+
+// cisst
+#include <sawIntuitiveResearchKit/mtsArmEffortStage.h>
+#include <sawIntuitiveResearchKit/mtsIntuitiveResearchKit.h>
+
+#include <cisstMultiTask/mtsInterfaceProvided.h>
+#include <cisstMultiTask/mtsInterfaceRequired.h>
+
+CMN_IMPLEMENT_SERVICES_DERIVED_ONEARG(mtsArmEffortStage, mtsTaskPeriodic, mtsTaskPeriodicConstructorArg);
+
+mtsArmEffortStage::mtsArmEffortStage(const std::string & componentName, const double periodInSeconds):
+    mtsTaskPeriodic(componentName, periodInSeconds)
+{
+    Init();
+}
+
+mtsArmEffortStage::mtsArmEffortStage(const mtsTaskPeriodicConstructorArg & arg):
+    mtsTaskPeriodic(arg)
+{
+    Init();
+}
+
+void mtsArmEffortStage::Init(void)
+{
+    m_model_time = 0.0;
+    m_model_stale = false;
+    m_model_stale_time = 0.0;
+    m_number_of_stale_models = 0;
+
+    m_servo_jf.SetValid(false);
+    StateTable.AddData(m_servo_jf, "servo_jf");
+    StateTable.AddData(m_number_of_stale_models, "number_of_stale_models");
+
+    mtsInterfaceRequired * interfaceRequired = AddInterfaceRequired("PID");
+    if (interfaceRequired) {
+        interfaceRequired->AddFunction("measured_js", PID.measured_js);
+        interfaceRequired->AddFunction("servo_jf", PID.servo_jf);
+    }
+
+    m_interface = AddInterfaceProvided("EffortStage");
+    if (m_interface) {
+        m_interface->AddMessageEvents();
+        m_interface->AddCommandWrite(&mtsArmEffortStage::servo_jf_model,
+                                     this, "servo_jf_model");
+        m_interface->AddCommandReadState(StateTable, StateTable.PeriodStats,
+                                         "period_statistics"); // mtsIntervalStatistics
+        m_interface->AddCommandReadState(StateTable, m_servo_jf,
+                                         "servo_jf");
+        m_interface->AddCommandReadState(StateTable, m_number_of_stale_models,
+                                         "number_of_stale_models");
+    }
+}
+
+void mtsArmEffortStage::Run(void)
+{
+    ProcessQueuedCommands();
+
+    if (!m_model.Enabled()) {
+        m_servo_jf.SetValid(false);
+        return;
+    }
+
+    // efforts at reference point
+    m_servo_jf.ForceTorque().ForceAssign(m_model.Effort());
+
+    // extrapolate using latest joint state if the model is recent
+    // enough, otherwise ramp reference efforts down
+    const double now = StateTable.GetTic();
+    if ((now - m_model_time) < mtsIntuitiveResearchKit::EffortStage::Timeout) {
+        m_model_stale = false;
+        mtsExecutionResult result = PID.measured_js(m_measured_js);
+        if (result) {
+            const size_t nbEfforts = m_model.Effort().size();
+            const size_t nbJoints = std::min(m_model.Position().size(),
+                                             m_measured_js.Position().size());
+            m_delta.SetSize(nbJoints);
+            // stiffness
+            if ((m_model.Stiffness().rows() == nbEfforts)
+                && (m_model.Stiffness().cols() >= nbJoints)) {
+                for (size_t joint = 0; joint < nbJoints; ++joint) {
+                    m_delta.at(joint) = m_measured_js.Position().at(joint) - m_model.Position().at(joint);
+                }
+                for (size_t effort = 0; effort < nbEfforts; ++effort) {
+                    for (size_t joint = 0; joint < nbJoints; ++joint) {
+                        m_servo_jf.ForceTorque().at(effort) += m_model.Stiffness().at(effort, joint) * m_delta.at(joint);
+                    }
+                }
+            }
+            // damping
+            if ((m_model.Damping().rows() == nbEfforts)
+                && (m_model.Damping().cols() >= nbJoints)
+                && (m_model.Velocity().size() >= nbJoints)
+                && (m_measured_js.Velocity().size() >= nbJoints)) {
+                for (size_t joint = 0; joint < nbJoints; ++joint) {
+                    m_delta.at(joint) = m_measured_js.Velocity().at(joint) - m_model.Velocity().at(joint);
+                }
+                for (size_t effort = 0; effort < nbEfforts; ++effort) {
+                    for (size_t joint = 0; joint < nbJoints; ++joint) {
+                        m_servo_jf.ForceTorque().at(effort) += m_model.Damping().at(effort, joint) * m_delta.at(joint);
+                    }
+                }
+            }
+        }
+    } else {
+        if (!m_model_stale) {
+            m_model_stale = true;
+            m_model_stale_time = now;
+            m_number_of_stale_models++;
+            CMN_LOG_CLASS_RUN_WARNING << "Run: " << this->GetName()
+                                      << ", model is older than "
+                                      << mtsIntuitiveResearchKit::EffortStage::Timeout
+                                      << "s, ramping efforts down to zero" << std::endl;
+            m_interface->SendWarning(this->GetName() + ": no recent effort model from arm, ramping efforts down to zero");
+        }
+        const double ratio = 1.0 - (now - m_model_stale_time) / mtsIntuitiveResearchKit::EffortStage::RampDownDuration;
+        if (ratio > 0.0) {
+            m_servo_jf.ForceTorque().Multiply(ratio);
+        } else {
+            m_servo_jf.ForceTorque().SetAll(0.0);
+        }
+    }
+
+    m_servo_jf.SetValid(true);
+    m_servo_jf.SetTimestamp(now);
+    PID.servo_jf(m_servo_jf);
+}
+
+void mtsArmEffortStage::servo_jf_model(const mtsArmEffortStageModel & model)
+{
+    m_model = model;
+    m_model_time = StateTable.GetTic();
+}
@@ -0,0 +1,179 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+// system include
+#include <cerrno>
+#include <cstring>
+
+// cisst
+#include <sawIntuitiveResearchKit/mtsArmStatePublisher.h>
+
+#include <cisstCommon/cmnPortability.h>
+
+#include <json/json.h>
+
+#if (CISST_OS == CISST_LINUX) || (CISST_OS == CISST_DARWIN)
+#define MTS_ARM_STATE_PUBLISHER
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+mtsArmStatePublisher::mtsArmStatePublisher(const cmnGenericObject & owner,
+                                           const std::string & name):
+    OwnerServices(owner.Services()),
+    m_name(name),
+    m_enabled(false),
+    m_shared_memory_name("/dvrk-" + name),
+    m_ring_size(64),
+    m_segment_size(0),
+    m_segment(nullptr),
+    m_current(nullptr),
+    m_written(0)
+{
+}
+
+mtsArmStatePublisher::~mtsArmStatePublisher()
+{
+    Stop();
+}
+
+bool mtsArmStatePublisher::ConfigureJSON(const Json::Value & jsonConfig,
+                                         std::string & errorMessage)
+{
+#ifndef MTS_ARM_STATE_PUBLISHER
+    errorMessage = "shared memory publisher is only supported on Linux and macOS";
+    return false;
+#endif
+    Json::Value jsonValue;
+
+    // POSIX names start with /
+    jsonValue = jsonConfig["name"];
+    if (!jsonValue.empty()) {
+        const std::string name = jsonValue.asString();
+        if (name.empty() || (name.find('/', 1) != std::string::npos)) {
+            errorMessage = "\"name\" must be a non empty string without \"/\"";
+            return false;
+        }
+        m_shared_memory_name = (name[0] == '/') ? name : ("/" + name);
+    }
+
+    jsonValue = jsonConfig["ring-size"];
+    if (!jsonValue.empty()) {
+        if (jsonValue.asInt() < 2) {
+            errorMessage = "\"ring-size\" must be at least 2 records";
+            return false;
+        }
+        m_ring_size = jsonValue.asUInt();
+    }
+
+    m_enabled = true;
+    return true;
+}
+
+bool mtsArmStatePublisher::Start(const double period)
+{
+#ifdef MTS_ARM_STATE_PUBLISHER
+    if (m_segment) {
+        return true;
+    }
+    m_segment_size = DVRK_ARM_STATE_SEGMENT_SIZE(m_ring_size);
+
+    // remove left over from previous process
+    shm_unlink(m_shared_memory_name.c_str());
+    const int descriptor = shm_open(m_shared_memory_name.c_str(),
+                                    O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (descriptor < 0) {
+        CMN_LOG_CLASS_INIT_ERROR << "Start: " << m_name << ", failed to create shared memory \""
+                                 << m_shared_memory_name << "\": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    if (ftruncate(descriptor, m_segment_size) != 0) {
+        CMN_LOG_CLASS_INIT_ERROR << "Start: " << m_name << ", failed to resize shared memory \""
+                                 << m_shared_memory_name << "\": " << std::strerror(errno) << std::endl;
+        close(descriptor);
+        shm_unlink(m_shared_memory_name.c_str());
+        return false;
+    }
+    void * map = mmap(nullptr, m_segment_size, PROT_READ | PROT_WRITE,
+                      MAP_SHARED, descriptor, 0);
+    close(descriptor);
+    if (map == MAP_FAILED) {
+        CMN_LOG_CLASS_INIT_ERROR << "Start: " << m_name << ", failed to map shared memory \""
+                                 << m_shared_memory_name << "\": " << std::strerror(errno) << std::endl;
+        shm_unlink(m_shared_memory_name.c_str());
+        return false;
+    }
+    // touch all pages now, not in control loop
+    std::memset(map, 0, m_segment_size);
+    m_segment = static_cast<dvrk_arm_state_segment *>(map);
+
+    dvrk_arm_state_header & header = m_segment->header;
+    std::memcpy(header.magic, DVRK_ARM_STATE_MAGIC, sizeof(DVRK_ARM_STATE_MAGIC));
+    header.header_size = DVRK_ARM_STATE_HEADER_SIZE;
+    header.record_size = sizeof(dvrk_arm_state_record);
+    header.ring_size = static_cast<uint32_t>(m_ring_size);
+    header.max_joints = DVRK_ARM_STATE_MAX_JOINTS;
+    header.period = period;
+    std::strncpy(header.name, m_name.c_str(), DVRK_ARM_STATE_NAME_SIZE - 1);
+    header.publisher_pid = static_cast<uint64_t>(getpid());
+    m_written = 0;
+    // version last so readers don't use a partially initialized header
+    __atomic_store_n(&(header.version), static_cast<uint32_t>(DVRK_ARM_STATE_VERSION), __ATOMIC_RELEASE);
+
+    CMN_LOG_CLASS_INIT_VERBOSE << "Start: " << m_name << ", publishing arm state in shared memory \""
+                               << m_shared_memory_name << "\"" << std::endl;
+    return true;
+#else
+    (void)period;
+    return false;
+#endif
+}
+
+void mtsArmStatePublisher::Stop(void)
+{
+#ifdef MTS_ARM_STATE_PUBLISHER
+    if (m_segment) {
+        munmap(m_segment, m_segment_size);
+        m_segment = nullptr;
+        m_current = nullptr;
+        // readers already attached keep their mapping
+        shm_unlink(m_shared_memory_name.c_str());
+    }
+#endif
+}
+
+dvrk_arm_state_record * mtsArmStatePublisher::Begin(const double time)
+{
+    m_current = &(m_segment->records[m_written % m_ring_size]);
+    // odd while writing
+    __atomic_store_n(&(m_current->sequence), 2 * m_written + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    m_current->time = time;
+    m_current->valid = 0;
+    return m_current;
+}
+
+void mtsArmStatePublisher::Commit(void)
+{
+    ++m_written;
+    __atomic_store_n(&(m_current->sequence), 2 * m_written, __ATOMIC_RELEASE);
+    __atomic_store_n(&(m_segment->header.written), m_written, __ATOMIC_RELEASE);
+    m_current = nullptr;
+}
@@ -0,0 +1,438 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+// system include
+#include <iostream>
+#include <iomanip>
+#include <limits>
+
+// cisst
+#include <sawIntuitiveResearchKit/mtsCollisionMonitor.h>
+#include <sawIntuitiveResearchKit/mtsIntuitiveResearchKit.h>
+
+#include <cisstCommon/cmnUnits.h>
+#include <cisstOSAbstraction/osaGetTime.h>
+#include <cisstMultiTask/mtsInterfaceProvided.h>
+#include <cisstMultiTask/mtsInterfaceRequired.h>
+
+CMN_IMPLEMENT_SERVICES_DERIVED_ONEARG(mtsCollisionMonitor, mtsTaskPeriodic, mtsTaskPeriodicConstructorArg);
+
+mtsCollisionMonitor::mtsCollisionMonitor(const std::string & componentName, const double periodInSeconds):
+    mtsTaskPeriodic(componentName, periodInSeconds)
+{
+    Init();
+}
+
+mtsCollisionMonitor::mtsCollisionMonitor(const mtsTaskPeriodicConstructorArg & arg):
+    mtsTaskPeriodic(arg)
+{
+    Init();
+}
+
+mtsCollisionMonitor::~mtsCollisionMonitor()
+{
+    for (auto arm : m_arms) {
+        delete arm;
+    }
+}
+
+void mtsCollisionMonitor::Init(void)
+{
+    m_warning_distance = mtsIntuitiveResearchKit::CollisionMonitor::WarningDistance;
+    m_freeze_distance = mtsIntuitiveResearchKit::CollisionMonitor::FreezeDistance;
+    m_hysteresis = mtsIntuitiveResearchKit::CollisionMonitor::Hysteresis;
+    m_minimum_distance = std::numeric_limits<double>::max();
+    m_check_duration = 0.0;
+
+    StateTable.AddData(m_minimum_distance, "minimum_distance");
+    StateTable.AddData(m_check_duration, "check_duration");
+
+    m_interface = AddInterfaceProvided("Monitor");
+    if (m_interface) {
+        m_interface->AddMessageEvents();
+        m_interface->AddCommandReadState(StateTable, StateTable.PeriodStats,
+                                         "period_statistics"); // mtsIntervalStatistics
+        m_interface->AddCommandReadState(StateTable, m_minimum_distance,
+                                         "minimum_distance");
+        m_interface->AddCommandReadState(StateTable, m_check_duration,
+                                         "check_duration");
+    }
+}
+
+void mtsCollisionMonitor::Configure(const std::string & filename)
+{
+    std::ifstream jsonStream;
+    Json::Value jsonConfig;
+    Json::Reader jsonReader;
+
+    if (filename == "") {
+        return;
+    }
+
+    jsonStream.open(filename.c_str());
+    if (!jsonReader.parse(jsonStream, jsonConfig)) {
+        CMN_LOG_CLASS_INIT_ERROR << "Configure " << this->GetName()
+                                 << ": failed to parse configuration file \""
+                                 << filename << "\"\n"
+                                 << jsonReader.getFormattedErrorMessages();
+        exit(EXIT_FAILURE);
+    }
+
+    CMN_LOG_CLASS_INIT_VERBOSE << "Configure: " << this->GetName()
+                               << " using file \"" << filename << "\"" << std::endl
+                               << "----> content of configuration file: " << std::endl
+                               << jsonConfig << std::endl
+                               << "<----" << std::endl;
+
+    mtsCollisionMonitor::Configure(jsonConfig);
+}
+
+void mtsCollisionMonitor::Configure(const Json::Value & jsonConfig)
+{
+    Json::Value jsonValue;
+
+    jsonValue = jsonConfig["warning-distance"];
+    if (!jsonValue.empty()) {
+        m_warning_distance = jsonValue.asDouble();
+    }
+    jsonValue = jsonConfig["freeze-distance"];
+    if (!jsonValue.empty()) {
+        m_freeze_distance = jsonValue.asDouble();
+    }
+    if ((m_freeze_distance < 0.0)
+        || (m_freeze_distance >= m_warning_distance)) {
+        CMN_LOG_CLASS_INIT_ERROR << "Configure " << this->GetName()
+                                 << ": \"freeze-distance\" must be positive and lower than \"warning-distance\""
+                                 << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    const Json::Value jsonArms = jsonConfig["arms"];
+    for (unsigned int index = 0; index < jsonArms.size(); ++index) {
+        const Json::Value jsonArm = jsonArms[index];
+        const std::string name = jsonArm["name"].asString();
+        const std::string type = jsonArm["type"].asString();
+        if (!AddArm(name, type)) {
+            CMN_LOG_CLASS_INIT_ERROR << "Configure " << this->GetName()
+                                     << ": failed to add arms[" << index << "]" << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        jsonValue = jsonArm["capsules"];
+        if (!jsonValue.empty()) {
+            if (!ConfigureCapsules(m_arms.back(), jsonValue)) {
+                CMN_LOG_CLASS_INIT_ERROR << "Configure " << this->GetName()
+                                         << ": failed to configure \"capsules\" for arm \""
+                                         << name << "\"" << std::endl;
+                exit(EXIT_FAILURE);
+            }
+        }
+    }
+}
+
+bool mtsCollisionMonitor::ConfigureCapsules(ArmData * arm,
+                                            const Json::Value & jsonCapsules)
+{
+    arm->m_capsules.clear();
+    for (unsigned int index = 0; index < jsonCapsules.size(); ++index) {
+        const Json::Value jsonCapsule = jsonCapsules[index];
+        if (jsonCapsule["start"].empty()
+            || jsonCapsule["end"].empty()
+            || jsonCapsule["radius"].empty()) {
+            CMN_LOG_CLASS_INIT_ERROR << "ConfigureCapsules " << this->GetName()
+                                     << ": \"start\", \"end\" and \"radius\" are required for capsules["
+                                     << index << "]" << std::endl;
+            return false;
+        }
+        Capsule capsule;
+        capsule.m_start = jsonCapsule["start"].asDouble();
+        capsule.m_end = jsonCapsule["end"].asDouble();
+        capsule.m_radius = jsonCapsule["radius"].asDouble();
+        if ((capsule.m_end < capsule.m_start)
+            || (capsule.m_radius < 0.0)) {
+            CMN_LOG_CLASS_INIT_ERROR << "ConfigureCapsules " << this->GetName()
+                                     << ": invalid start, end or radius for capsules["
+                                     << index << "]" << std::endl;
+            return false;
+        }
+        arm->m_capsules.push_back(capsule);
+    }
+    return !arm->m_capsules.empty();
+}
+
+bool mtsCollisionMonitor::AddArm(const std::string & name,
+                                 const std::string & type)
+{
+    for (const auto arm : m_arms) {
+        if (arm->m_name == name) {
+            CMN_LOG_CLASS_INIT_ERROR << "AddArm " << this->GetName()
+                                     << ": arm \"" << name << "\" already added" << std::endl;
+            return false;
+        }
+    }
+
+    ArmData * arm = new ArmData;
+    arm->m_name = name;
+    arm->m_valid = false;
+
+    // default capsules, first one is the shaft starting at tip
+    Capsule shaft, housing;
+    shaft.m_start = 0.0;
+    if (type == "PSM") {
+        shaft.m_end = mtsIntuitiveResearchKit::CollisionMonitor::PSMShaftLength;
+        shaft.m_radius = mtsIntuitiveResearchKit::CollisionMonitor::PSMShaftRadius;
+        housing.m_end = shaft.m_end + mtsIntuitiveResearchKit::CollisionMonitor::PSMHousingLength;
+        housing.m_radius = mtsIntuitiveResearchKit::CollisionMonitor::PSMHousingRadius;
+    } else if (type == "ECM") {
+        shaft.m_end = mtsIntuitiveResearchKit::CollisionMonitor::ECMShaftLength;
+        shaft.m_radius = mtsIntuitiveResearchKit::CollisionMonitor::ECMShaftRadius;
+        housing.m_end = shaft.m_end + mtsIntuitiveResearchKit::CollisionMonitor::ECMHousingLength;
+        housing.m_radius = mtsIntuitiveResearchKit::CollisionMonitor::ECMHousingRadius;
+    } else {
+        CMN_LOG_CLASS_INIT_ERROR << "AddArm " << this->GetName()
+                                 << ": type \"" << type << "\" for arm \"" << name
+                                 << "\" is not supported, must be \"PSM\" or \"ECM\"" << std::endl;
+        delete arm;
+        return false;
+    }
+    housing.m_start = shaft.m_end;
+    arm->m_capsules.push_back(shaft);
+    arm->m_capsules.push_back(housing);
+
+    mtsInterfaceRequired * interfaceRequired = AddInterfaceRequired(name);
+    if (!interfaceRequired) {
+        CMN_LOG_CLASS_INIT_ERROR << "AddArm " << this->GetName()
+                                 << ": failed to add required interface for arm \""
+                                 << name << "\"" << std::endl;
+        delete arm;
+        return false;
+    }
+    interfaceRequired->AddFunction("measured_cp", arm->measured_cp);
+    interfaceRequired->AddFunction("base_frame", arm->base_frame);
+    interfaceRequired->AddFunction("Freeze", arm->Freeze);
+
+    // new pairs with all existing arms
+    for (auto other : m_arms) {
+        ArmPair pair;
+        pair.m_first = other;
+        pair.m_second = arm;
+        pair.m_level = COLLISION_NONE;
+        m_pairs.push_back(pair);
+    }
+    m_arms.push_back(arm);
+    return true;
+}
+
+std::vector<std::string> mtsCollisionMonitor::ArmNames(void) const
+{
+    std::vector<std::string> names;
+    for (const auto arm : m_arms) {
+        names.push_back(arm->m_name);
+    }
+    return names;
+}
+
+void mtsCollisionMonitor::Startup(void)
+{
+    CMN_LOG_CLASS_INIT_VERBOSE << "Startup" << std::endl;
+}
+
+void mtsCollisionMonitor::Run(void)
+{
+    ProcessQueuedCommands();
+    ProcessQueuedEvents();
+
+    const double startTime = osaGetTime();
+
+    for (auto arm : m_arms) {
+        UpdateArm(arm);
+    }
+
+    m_minimum_distance = std::numeric_limits<double>::max();
+    for (auto & pair : m_pairs) {
+        if (!pair.m_first->m_valid || !pair.m_second->m_valid) {
+            pair.m_level = COLLISION_NONE;
+            continue;
+        }
+        // broad phase, distance between bounding boxes is a lower
+        // bound of the distance between capsules
+        vct3 gap;
+        for (size_t i = 0; i < 3; ++i) {
+            gap.Element(i) = std::max(0.0,
+                                      std::max(pair.m_first->m_min.Element(i) - pair.m_second->m_max.Element(i),
+                                               pair.m_second->m_min.Element(i) - pair.m_first->m_max.Element(i)));
+        }
+        double distance = gap.Norm();
+        // narrow phase only if boxes are close enough to change level
+        if (distance <= (m_warning_distance + m_hysteresis)) {
+            distance = PairDistance(pair);
+        }
+        m_minimum_distance = std::min(m_minimum_distance, distance);
+        UpdatePairLevel(pair, distance);
+    }
+
+    m_check_duration = osaGetTime() - startTime;
+}
+
+void mtsCollisionMonitor::Cleanup(void)
+{
+    CMN_LOG_CLASS_INIT_VERBOSE << "Cleanup" << std::endl;
+}
+
+void mtsCollisionMonitor::UpdateArm(ArmData * arm)
+{
+    arm->m_valid = false;
+
+    // measured_cp is not valid if the arm is not ready or the base frame is not valid
+    mtsExecutionResult executionResult = arm->measured_cp(arm->m_measured_cp);
+    if (!executionResult.IsOK() || !arm->m_measured_cp.Valid()) {
+        return;
+    }
+    executionResult = arm->base_frame(arm->m_base_frame);
+    if (!executionResult.IsOK()) {
+        return;
+    }
+
+    // axis from tip to RCM, i.e. origin of the base frame.  If too
+    // close to RCM, use the tool tip z axis
+    const vct3 tip(arm->m_measured_cp.Position().Translation());
+    vct3 axis;
+    axis.DifferenceOf(arm->m_base_frame.Translation(), tip);
+    const double norm = axis.Norm();
+    if (norm > 1.0 * cmn_mm) {
+        axis.Divide(norm);
+    } else {
+        axis.Assign(arm->m_measured_cp.Position().Rotation().Column(2));
+        axis.NegationSelf();
+    }
+
+    arm->m_min.SetAll(std::numeric_limits<double>::max());
+    arm->m_max.SetAll(-std::numeric_limits<double>::max());
+    for (auto & capsule : arm->m_capsules) {
+        capsule.m_p.SumOf(tip, capsule.m_start * axis);
+        capsule.m_q.SumOf(tip, capsule.m_end * axis);
+        for (size_t i = 0; i < 3; ++i) {
+            arm->m_min.Element(i) = std::min(arm->m_min.Element(i),
+                                             std::min(capsule.m_p.Element(i), capsule.m_q.Element(i)) - capsule.m_radius);
+            arm->m_max.Element(i) = std::max(arm->m_max.Element(i),
+                                             std::max(capsule.m_p.Element(i), capsule.m_q.Element(i)) + capsule.m_radius);
+        }
+    }
+    arm->m_valid = true;
+}
+
+double mtsCollisionMonitor::PairDistance(const ArmPair & pair) const
+{
+    double minimum = std::numeric_limits<double>::max();
+    for (const auto & first : pair.m_first->m_capsules) {
+        for (const auto & second : pair.m_second->m_capsules) {
+            minimum = std::min(minimum,
+                               CapsuleDistance(first.m_p, first.m_q, first.m_radius,
+                                               second.m_p, second.m_q, second.m_radius));
+        }
+    }
+    return minimum;
+}
+
+void mtsCollisionMonitor::UpdatePairLevel(ArmPair & pair, const double distance)
+{
+    CollisionLevel level = COLLISION_NONE;
+    if ((distance < m_freeze_distance)
+        || ((pair.m_level == COLLISION_FREEZE) && (distance < (m_freeze_distance + m_hysteresis)))) {
+        level = COLLISION_FREEZE;
+    } else if ((distance < m_warning_distance)
+               || ((pair.m_level != COLLISION_NONE) && (distance < (m_warning_distance + m_hysteresis)))) {
+        level = COLLISION_WARNING;
+    }
+
+    if (level == pair.m_level) {
+        return;
+    }
+
+    std::stringstream message;
+    message << this->GetName() << ": " << pair.m_first->m_name
+            << " and " << pair.m_second->m_name;
+    if (level > pair.m_level) {
+        message << " are " << std::fixed << std::setprecision(1)
+                << cmnInternalTo_mm(distance) << "mm apart";
+        if (level == COLLISION_FREEZE) {
+            pair.m_first->Freeze();
+            pair.m_second->Freeze();
+            m_interface->SendError(message.str() + ", arms frozen");
+        } else {
+            m_interface->SendWarning(message.str());
+        }
+    } else if (level == COLLISION_NONE) {
+        m_interface->SendStatus(message.str() + " are clear");
+    }
+    pair.m_level = level;
+}
+
+double mtsCollisionMonitor::CapsuleDistance(const vct3 & p1, const vct3 & q1, const double r1,
+                                            const vct3 & p2, const vct3 & q2, const double r2)
+{
+    // closest points between segments, see Ericson, Real-Time
+    // Collision Detection, 5.1.9
+    const double epsilon = 1e-12;
+    vct3 d1, d2, r;
+    d1.DifferenceOf(q1, p1);
+    d2.DifferenceOf(q2, p2);
+    r.DifferenceOf(p1, p2);
+    const double a = d1.DotProduct(d1);
+    const double e = d2.DotProduct(d2);
+    const double f = d2.DotProduct(r);
+    double s, t;
+
+    if ((a <= epsilon) && (e <= epsilon)) {
+        // both segments are points
+        s = 0.0;
+        t = 0.0;
+    } else if (a <= epsilon) {
+        // first segment is a point
+        s = 0.0;
+        t = std::min(1.0, std::max(0.0, f / e));
+    } else {
+        const double c = d1.DotProduct(r);
+        if (e <= epsilon) {
+            // second segment is a point
+            t = 0.0;
+            s = std::min(1.0, std::max(0.0, -c / a));
+        } else {
+            const double b = d1.DotProduct(d2);
+            const double denominator = a * e - b * b;
+            // if segments are parallel, pick arbitrary s
+            if (denominator > epsilon) {
+                s = std::min(1.0, std::max(0.0, (b * f - c * e) / denominator));
+            } else {
+                s = 0.0;
+            }
+            t = (b * s + f) / e;
+            if (t < 0.0) {
+                t = 0.0;
+                s = std::min(1.0, std::max(0.0, -c / a));
+            } else if (t > 1.0) {
+                t = 1.0;
+                s = std::min(1.0, std::max(0.0, (b - c) / a));
+            }
+        }
+    }
+
+    vct3 c1, c2;
+    c1.SumOf(p1, s * d1);
+    c2.SumOf(p2, t * d2);
+    return (c1 - c2).Norm() - r1 - r2;
+}
@@ -0,0 +1,245 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+// system include
+#include <cmath>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+
+// cisst
+#include <sawIntuitiveResearchKit/mtsConsoleExecutor.h>
+
+#include <cisstCommon/cmnUnits.h>
+#include <cisstOSAbstraction/osaGetTime.h>
+#include <cisstMultiTask/mtsInterfaceProvided.h>
+#include <cisstMultiTask/mtsManagerLocal.h>
+
+CMN_IMPLEMENT_SERVICES_DERIVED_ONEARG(mtsConsoleExecutor, mtsTaskPeriodic, mtsTaskPeriodicConstructorArg);
+
+mtsConsoleExecutor::mtsConsoleExecutor(const std::string & componentName, const double periodInSeconds):
+    mtsTaskPeriodic(componentName, periodInSeconds)
+{
+    Init();
+}
+
+mtsConsoleExecutor::mtsConsoleExecutor(const mtsTaskPeriodicConstructorArg & arg):
+    mtsTaskPeriodic(arg)
+{
+    Init();
+}
+
+mtsConsoleExecutor::~mtsConsoleExecutor()
+{
+    for (auto component : m_components) {
+        delete component;
+    }
+}
+
+void mtsConsoleExecutor::Init(void)
+{
+    m_cycle_duration = 0.0;
+    m_cycle_duration_max = 0.0;
+    m_cycle_duration_sum = 0.0;
+    m_number_of_cycles = 0;
+    m_cycle_overruns = 0;
+    m_time_last_report = 0.0;
+
+    StateTable.AddData(m_cycle_duration, "cycle_duration");
+    StateTable.AddData(m_cycle_overruns, "cycle_overruns");
+
+    m_interface = AddInterfaceProvided("Executor");
+    if (m_interface) {
+        m_interface->AddMessageEvents();
+        m_interface->AddCommandReadState(StateTable, StateTable.PeriodStats,
+                                         "period_statistics"); // mtsIntervalStatistics
+        m_interface->AddCommandReadState(StateTable, m_cycle_duration,
+                                         "cycle_duration");
+        m_interface->AddCommandReadState(StateTable, m_cycle_overruns,
+                                         "cycle_overruns");
+    }
+}
+
+std::string mtsConsoleExecutor::InterfaceName(const std::string & name) const
+{
+    return "ExecOut-" + name;
+}
+
+bool mtsConsoleExecutor::Register(const std::string & name)
+{
+    for (auto component : m_components) {
+        if (component->m_name == name) {
+            CMN_LOG_CLASS_INIT_ERROR << "Register: " << this->GetName()
+                                     << ", component \"" << name << "\" already registered" << std::endl;
+            return false;
+        }
+    }
+
+    ComponentData * component = new ComponentData;
+    component->m_name = name;
+    component->m_ratio = 1;
+    component->m_counter = 0;
+    component->m_budget = 0.0;
+    component->m_duration = 0.0;
+    component->m_duration_max = 0.0;
+    component->m_duration_sum = 0.0;
+    component->m_number_of_runs = 0;
+    component->m_overruns = 0;
+    component->m_overruns_reported = 0;
+
+    mtsInterfaceProvided * interfaceProvided = AddInterfaceProvided(InterfaceName(name));
+    if (!interfaceProvided) {
+        CMN_LOG_CLASS_INIT_ERROR << "Register: " << this->GetName()
+                                 << ", failed to add interface for component \"" << name << "\"" << std::endl;
+        delete component;
+        return false;
+    }
+    // same event name as ExecOut so components can use their ExecIn interface
+    interfaceProvided->AddEventVoid(component->RunEvent, "RunEvent");
+
+    StateTable.AddData(component->m_duration, name + "_duration");
+    StateTable.AddData(component->m_overruns, name + "_overruns");
+    m_interface->AddCommandReadState(StateTable, component->m_duration,
+                                     name + "/duration");
+    m_interface->AddCommandReadState(StateTable, component->m_overruns,
+                                     name + "/overruns");
+    m_components.push_back(component);
+    return true;
+}
+
+bool mtsConsoleExecutor::SetBudget(const std::string & name, const double budget)
+{
+    for (auto component : m_components) {
+        if (component->m_name == name) {
+            component->m_budget = budget;
+            return true;
+        }
+    }
+    CMN_LOG_CLASS_INIT_ERROR << "SetBudget: " << this->GetName()
+                             << ", component \"" << name << "\" not registered" << std::endl;
+    return false;
+}
+
+void mtsConsoleExecutor::Startup(void)
+{
+    // run slower components every N periods
+    const double period = this->GetPeriodicity();
+    mtsManagerLocal * componentManager = mtsManagerLocal::GetInstance();
+    for (auto component : m_components) {
+        mtsTaskPeriodic * task
+            = dynamic_cast<mtsTaskPeriodic *>(componentManager->GetComponent(component->m_name));
+        if (task && (period > 0.0)) {
+            const double ratio = std::round(task->GetPeriodicity() / period);
+            component->m_ratio = (ratio > 1.0) ? static_cast<size_t>(ratio) : 1;
+        }
+        CMN_LOG_CLASS_INIT_VERBOSE << "Startup: " << this->GetName() << " running \""
+                                   << component->m_name << "\" every "
+                                   << component->m_ratio << " period(s)" << std::endl;
+    }
+    m_time_last_report = osaGetTime();
+}
+
+void mtsConsoleExecutor::Run(void)
+{
+    ProcessQueuedCommands();
+
+    const double start = osaGetTime();
+
+    for (auto component : m_components) {
+        component->m_counter++;
+        if (component->m_counter < component->m_ratio) {
+            continue;
+        }
+        component->m_counter = 0;
+        const double componentStart = osaGetTime();
+        component->RunEvent();
+        component->m_duration = osaGetTime() - componentStart;
+        // statistics
+        component->m_number_of_runs++;
+        component->m_duration_sum += component->m_duration;
+        if (component->m_duration > component->m_duration_max) {
+            component->m_duration_max = component->m_duration;
+        }
+        if ((component->m_budget > 0.0)
+            && (component->m_duration > component->m_budget)) {
+            component->m_overruns++;
+        }
+    }
+
+    m_cycle_duration = osaGetTime() - start;
+    m_number_of_cycles++;
+    m_cycle_duration_sum += m_cycle_duration;
+    if (m_cycle_duration > m_cycle_duration_max) {
+        m_cycle_duration_max = m_cycle_duration;
+    }
+    if (m_cycle_duration > this->GetPeriodicity()) {
+        m_cycle_overruns++;
+    }
+
+    // report at most once per second
+    if ((start - m_time_last_report) > 1.0 * cmn_s) {
+        m_time_last_report = start;
+        ReportOverruns();
+    }
+}
+
+void mtsConsoleExecutor::ReportOverruns(void)
+{
+    std::stringstream message;
+    bool overruns = false;
+    for (auto component : m_components) {
+        const size_t newOverruns = component->m_overruns - component->m_overruns_reported;
+        if (newOverruns > 0) {
+            message << (overruns ? ", " : "")
+                    << component->m_name << " (" << newOverruns << ")";
+            component->m_overruns_reported = component->m_overruns;
+            overruns = true;
+        }
+    }
+    if (overruns) {
+        m_interface->SendWarning(this->GetName() + ": budget exceeded for " + message.str());
+    }
+}
+
+void mtsConsoleExecutor::Cleanup(void)
+{
+    // timing report
+    if (m_number_of_cycles == 0) {
+        return;
+    }
+    std::stringstream report;
+    report << std::fixed << std::setprecision(3)
+           << "Cleanup: " << this->GetName() << " timing report for "
+           << m_number_of_cycles << " cycles (average/max/budget in ms, overruns)" << std::endl;
+    for (auto component : m_components) {
+        const double runs = (component->m_number_of_runs > 0) ?
+            static_cast<double>(component->m_number_of_runs) : 1.0;
+        report << " - " << component->m_name << ": "
+               << (component->m_duration_sum / runs) / cmn_ms << " / "
+               << component->m_duration_max / cmn_ms << " / "
+               << component->m_budget / cmn_ms << ", "
+               << component->m_overruns << std::endl;
+    }
+    const double cycles = static_cast<double>(m_number_of_cycles);
+    report << " - total: "
+           << (m_cycle_duration_sum / cycles) / cmn_ms << " / "
+           << m_cycle_duration_max / cmn_ms << " / "
+           << this->GetPeriodicity() / cmn_ms << ", "
+           << m_cycle_overruns << std::endl;
+    CMN_LOG_CLASS_INIT_VERBOSE << report.str();
+}
@@ -0,0 +1,223 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+// system include
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+
+#include <sawIntuitiveResearchKit/mtsConsoleSharedMemory.h>
+
+#include <cisstCommon/cmnPortability.h>
+
+#if (CISST_OS == CISST_LINUX) || (CISST_OS == CISST_DARWIN)
+#define MTS_CONSOLE_SHARED_MEMORY
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    const char MagicNumber[8] = {'d', 'V', 'R', 'K', 'G', 'U', 'I', '\0'};
+}
+
+mtsConsoleSharedMemory::mtsConsoleSharedMemory(const std::string & componentName,
+                                               const double periodInSeconds,
+                                               const std::string & sharedMemoryName):
+    mtsTaskPeriodic(componentName, periodInSeconds),
+    m_segment(nullptr),
+    m_owner(false)
+{
+    // POSIX names start with /
+    if (sharedMemoryName.empty() || (sharedMemoryName[0] != '/')) {
+        m_shared_memory_name = "/" + sharedMemoryName;
+    } else {
+        m_shared_memory_name = sharedMemoryName;
+    }
+}
+
+mtsConsoleSharedMemory::~mtsConsoleSharedMemory()
+{
+    Detach();
+}
+
+bool mtsConsoleSharedMemory::Create(std::string & errorMessage)
+{
+#ifdef MTS_CONSOLE_SHARED_MEMORY
+    // remove left over from previous process
+    shm_unlink(m_shared_memory_name.c_str());
+    const int descriptor = shm_open(m_shared_memory_name.c_str(),
+                                    O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (descriptor < 0) {
+        errorMessage = "failed to create shared memory \"" + m_shared_memory_name
+            + "\": " + std::strerror(errno);
+        return false;
+    }
+    if (ftruncate(descriptor, sizeof(Segment)) != 0) {
+        errorMessage = "failed to resize shared memory \"" + m_shared_memory_name
+            + "\": " + std::strerror(errno);
+        close(descriptor);
+        shm_unlink(m_shared_memory_name.c_str());
+        return false;
+    }
+    void * map = mmap(nullptr, sizeof(Segment), PROT_READ | PROT_WRITE,
+                      MAP_SHARED, descriptor, 0);
+    close(descriptor);
+    if (map == MAP_FAILED) {
+        errorMessage = "failed to map shared memory \"" + m_shared_memory_name
+            + "\": " + std::strerror(errno);
+        shm_unlink(m_shared_memory_name.c_str());
+        return false;
+    }
+    std::memset(map, 0, sizeof(Segment));
+    m_segment = static_cast<Segment *>(map);
+    m_owner = true;
+
+    // atomics are shared between processes
+    if (!m_segment->Header.Heartbeat.is_lock_free()) {
+        errorMessage = "64 bits atomics are not lock free on this platform";
+        Detach();
+        return false;
+    }
+    std::memcpy(m_segment->Header.Magic, MagicNumber, sizeof(MagicNumber));
+    m_segment->Header.Version = Version;
+    return true;
+#else
+    errorMessage = "console shared memory is only supported on Linux and macOS";
+    return false;
+#endif
+}
+
+bool mtsConsoleSharedMemory::Attach(std::string & errorMessage)
+{
+#ifdef MTS_CONSOLE_SHARED_MEMORY
+    const int descriptor = shm_open(m_shared_memory_name.c_str(), O_RDWR, 0600);
+    if (descriptor < 0) {
+        errorMessage = "failed to open shared memory \"" + m_shared_memory_name
+            + "\", make sure the console is running with the same shared memory name: "
+            + std::strerror(errno);
+        return false;
+    }
+    struct stat status;
+    if ((fstat(descriptor, &status) != 0)
+        || (static_cast<size_t>(status.st_size) != sizeof(Segment))) {
+        errorMessage = "shared memory \"" + m_shared_memory_name
+            + "\" has an unexpected size, check that both processes use the same version";
+        close(descriptor);
+        return false;
+    }
+    void * map = mmap(nullptr, sizeof(Segment), PROT_READ | PROT_WRITE,
+                      MAP_SHARED, descriptor, 0);
+    close(descriptor);
+    if (map == MAP_FAILED) {
+        errorMessage = "failed to map shared memory \"" + m_shared_memory_name
+            + "\": " + std::strerror(errno);
+        return false;
+    }
+    m_segment = static_cast<Segment *>(map);
+    m_owner = false;
+
+    if ((std::memcmp(m_segment->Header.Magic, MagicNumber, sizeof(MagicNumber)) != 0)
+        || (m_segment->Header.Version != Version)) {
+        errorMessage = "shared memory \"" + m_shared_memory_name
+            + "\" is not a dVRK console or has a different version";
+        Detach();
+        return false;
+    }
+    return true;
+#else
+    errorMessage = "console shared memory is only supported on Linux and macOS";
+    return false;
+#endif
+}
+
+bool mtsConsoleSharedMemory::RegisterClient(std::string & errorMessage)
+{
+#ifdef MTS_CONSOLE_SHARED_MEMORY
+    // claim the slot atomically so two clients starting at the same
+    // time can't both register, slot from a dead client can be reused
+    const int64_t pid = static_cast<int64_t>(getpid());
+    int64_t previous = m_segment->Header.ClientPID.load(std::memory_order_acquire);
+    while (true) {
+        if ((previous != 0)
+            && (previous != pid)
+            && (kill(static_cast<pid_t>(previous), 0) == 0)) {
+            std::stringstream message;
+            message << "another client (process " << previous
+                    << ") is already attached to shared memory \"" << m_shared_memory_name << "\"";
+            errorMessage = message.str();
+            return false;
+        }
+        // on failure, previous is updated with the current value
+        if (m_segment->Header.ClientPID.compare_exchange_strong(previous, pid,
+                                                                std::memory_order_acq_rel,
+                                                                std::memory_order_acquire)) {
+            return true;
+        }
+    }
+#else
+    errorMessage = "console shared memory is only supported on Linux and macOS";
+    return false;
+#endif
+}
+
+void mtsConsoleSharedMemory::Detach(void)
+{
+#ifdef MTS_CONSOLE_SHARED_MEMORY
+    if (m_segment) {
+        if (!m_owner) {
+            int64_t pid = static_cast<int64_t>(getpid());
+            m_segment->Header.ClientPID.compare_exchange_strong(pid, 0);
+        }
+        munmap(m_segment, sizeof(Segment));
+        m_segment = nullptr;
+        if (m_owner) {
+            shm_unlink(m_shared_memory_name.c_str());
+        }
+    }
+#endif
+}
+
+bool mtsConsoleSharedMemory::Pack(const cmnGenericObject & data,
+                                  char * buffer, const size_t bufferSize, uint32_t & size)
+{
+    std::stringstream stream;
+    data.SerializeRaw(stream);
+    const std::string serialized = stream.str();
+    if (serialized.size() > bufferSize) {
+        size = 0;
+        return false;
+    }
+    std::memcpy(buffer, serialized.data(), serialized.size());
+    size = static_cast<uint32_t>(serialized.size());
+    return true;
+}
+
+bool mtsConsoleSharedMemory::Unpack(const char * buffer, const uint32_t size,
+                                    cmnGenericObject & data)
+{
+    std::stringstream stream(std::string(buffer, size));
+    try {
+        data.DeSerializeRaw(stream);
+    } catch (...) {
+        return false;
+    }
+    return !stream.fail();
+}
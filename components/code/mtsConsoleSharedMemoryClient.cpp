@@ -0,0 +1,445 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+// system include
+#include <cstring>
+#include <sstream>
+
+#include <sawIntuitiveResearchKit/mtsConsoleSharedMemoryClient.h>
+
+#include <cisstMultiTask/mtsInterfaceProvided.h>
+
+CMN_IMPLEMENT_SERVICES_DERIVED(mtsConsoleSharedMemoryClient, mtsTaskPeriodic);
+
+mtsConsoleSharedMemoryClient::mtsConsoleSharedMemoryClient(const std::string & componentName,
+                                                           const double periodInSeconds,
+                                                           const std::string & sharedMemoryName):
+    mtsConsoleSharedMemory(componentName, periodInSeconds, sharedMemoryName),
+    m_console_interface(nullptr),
+    m_events_read(0),
+    m_heartbeat(0),
+    m_heartbeat_time(0.0),
+    m_server_alive(false)
+{
+    m_buffer.reserve(ArmDataSize);
+}
+
+mtsConsoleSharedMemoryClient::~mtsConsoleSharedMemoryClient()
+{
+    for (auto arm : m_arms) {
+        delete arm;
+    }
+}
+
+void mtsConsoleSharedMemoryClient::Configure(const std::string & CMN_UNUSED(filename))
+{
+    std::string errorMessage;
+    if (!Attach(errorMessage)) {
+        CMN_LOG_CLASS_INIT_ERROR << "Configure: " << this->GetName()
+                                 << ", " << errorMessage << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    // only new events, server sends latest states when the client registers
+    m_events_read = m_segment->Header.EventsWritten.load(std::memory_order_acquire);
+    if (!RegisterClient(errorMessage)) {
+        CMN_LOG_CLASS_INIT_ERROR << "Configure: " << this->GetName()
+                                 << ", " << errorMessage << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    // console
+    m_console_interface = AddInterfaceProvided("Main");
+    if (m_console_interface) {
+        m_console_interface->AddMessageEvents();
+        m_console_interface->AddCommandVoid(&mtsConsoleSharedMemoryClient::power_off, this,
+                                            "power_off");
+        m_console_interface->AddCommandVoid(&mtsConsoleSharedMemoryClient::power_on, this,
+                                            "power_on");
+        m_console_interface->AddCommandVoid(&mtsConsoleSharedMemoryClient::home, this,
+                                            "home");
+        m_console_interface->AddCommandWrite(&mtsConsoleSharedMemoryClient::teleop_enable, this,
+                                             "teleop_enable", false);
+        m_console_interface->AddCommandWrite(&mtsConsoleSharedMemoryClient::select_teleop_psm, this,
+                                             "select_teleop_psm", prmKeyValue("mtm", "psm"));
+        m_console_interface->AddCommandWrite(&mtsConsoleSharedMemoryClient::set_scale, this,
+                                             "set_scale", 0.5);
+        m_console_interface->AddCommandWrite(&mtsConsoleSharedMemoryClient::set_volume, this,
+                                             "set_volume", 0.5);
+        m_console_interface->AddCommandWrite(&mtsConsoleSharedMemoryClient::emulate_operator_present, this,
+                                             "emulate_operator_present", prmEventButton());
+        m_console_interface->AddCommandWrite(&mtsConsoleSharedMemoryClient::emulate_clutch, this,
+                                             "emulate_clutch", prmEventButton());
+        m_console_interface->AddCommandWrite(&mtsConsoleSharedMemoryClient::emulate_camera, this,
+                                             "emulate_camera", prmEventButton());
+        m_console_interface->AddCommandRead(&mtsConsoleSharedMemoryClient::calibration_mode, this,
+                                            "calibration_mode", false);
+        m_console_interface->AddEventWrite(mConsoleEvents.ArmCurrentState,
+                                           "ArmCurrentState", prmKeyValue());
+        m_console_interface->AddEventWrite(mConsoleEvents.teleop_enabled,
+                                           "teleop_enabled", false);
+        m_console_interface->AddEventWrite(mConsoleEvents.teleop_psm_selected,
+                                           "teleop_psm_selected", prmKeyValue("MTM", "PSM"));
+        m_console_interface->AddEventWrite(mConsoleEvents.teleop_psm_unselected,
+                                           "teleop_psm_unselected", prmKeyValue("MTM", "PSM"));
+        m_console_interface->AddEventWrite(mConsoleEvents.scale,
+                                           "scale", 0.5);
+        m_console_interface->AddEventWrite(mConsoleEvents.volume,
+                                           "volume", 0.5);
+    }
+
+    // arms
+    const size_t numberOfArms = std::min(static_cast<size_t>(m_segment->Header.NumberOfArms),
+                                         static_cast<size_t>(MaxArms));
+    for (size_t index = 0; index < numberOfArms; ++index) {
+        ArmDescription description;
+        description.Name = std::string(m_segment->Header.Arms[index].Name,
+                                       strnlen(m_segment->Header.Arms[index].Name, NameSize));
+        description.Type = std::string(m_segment->Header.Arms[index].Type,
+                                       strnlen(m_segment->Header.Arms[index].Type, NameSize));
+        m_arm_descriptions.push_back(description);
+
+        ArmProxy * arm = new ArmProxy;
+        arm->m_client = this;
+        arm->m_target = static_cast<uint32_t>(index + 1);
+        arm->m_name = description.Name;
+        arm->m_sequence = 0;
+        StateTable.AddData(arm->m_snapshot, arm->m_name + "/gui/snapshot");
+        StateTable.AddData(arm->m_measured_js, arm->m_name + "/measured_js");
+        StateTable.AddData(arm->m_measured_cp, arm->m_name + "/measured_cp");
+        StateTable.AddData(arm->m_measured_cf_body, arm->m_name + "/body/measured_cf");
+        StateTable.AddData(arm->m_period_statistics, arm->m_name + "/period_statistics");
+        StateTable.AddData(arm->m_configuration_js, arm->m_name + "/configuration_js");
+        StateTable.AddData(arm->m_operating_state, arm->m_name + "/operating_state");
+
+        arm->m_interface = AddInterfaceProvided(arm->m_name);
+        if (arm->m_interface) {
+            arm->m_interface->AddMessageEvents();
+            arm->m_interface->AddCommandReadState(StateTable, arm->m_snapshot, "gui/snapshot");
+            arm->m_interface->AddCommandReadState(StateTable, arm->m_measured_js, "measured_js");
+            arm->m_interface->AddCommandReadState(StateTable, arm->m_measured_cp, "measured_cp");
+            arm->m_interface->AddCommandReadState(StateTable, arm->m_measured_cf_body, "body/measured_cf");
+            arm->m_interface->AddCommandReadState(StateTable, arm->m_period_statistics, "period_statistics");
+            arm->m_interface->AddCommandReadState(StateTable, arm->m_configuration_js, "configuration_js");
+            arm->m_interface->AddCommandReadState(StateTable, arm->m_operating_state, "operating_state");
+            arm->m_interface->AddCommandWrite(&ArmProxy::state_command, arm,
+                                              "state_command", std::string(""));
+            arm->m_interface->AddCommandWrite(&ArmProxy::move_jp, arm,
+                                              "move_jp");
+            arm->m_interface->AddCommandWrite(&ArmProxy::trajectory_j_set_ratio, arm,
+                                              "trajectory_j/set_ratio");
+            arm->m_interface->AddEventWrite(arm->desired_state, "desired_state", std::string(""));
+            arm->m_interface->AddEventWrite(arm->operating_state, "operating_state", prmOperatingState());
+        }
+        m_arms.push_back(arm);
+    }
+}
+
+void mtsConsoleSharedMemoryClient::Run(void)
+{
+    ProcessQueuedCommands();
+    ProcessQueuedEvents();
+
+    if (!m_segment) {
+        return;
+    }
+
+    HeartbeatCheck();
+    for (size_t index = 0; index < m_arms.size(); ++index) {
+        ReadArm(index);
+    }
+    ReadEvents();
+}
+
+void mtsConsoleSharedMemoryClient::Cleanup(void)
+{
+    Detach();
+}
+
+void mtsConsoleSharedMemoryClient::HeartbeatCheck(void)
+{
+    const uint64_t heartbeat = m_segment->Header.Heartbeat.load(std::memory_order_acquire);
+    const double now = StateTable.GetTic();
+    if (heartbeat != m_heartbeat) {
+        m_heartbeat = heartbeat;
+        m_heartbeat_time = now;
+        if (!m_server_alive) {
+            m_server_alive = true;
+            m_console_interface->SendStatus(this->GetName() + ": connected to console");
+        }
+    } else if (m_server_alive
+               && ((now - m_heartbeat_time) > 1.0 * cmn_s)) {
+        m_server_alive = false;
+        m_console_interface->SendError(this->GetName() + ": lost connection with console");
+    }
+}
+
+bool mtsConsoleSharedMemoryClient::ReadArm(const size_t index)
+{
+    ArmProxy * arm = m_arms[index];
+    ArmSlot & slot = m_segment->Arms[index];
+
+    // sequence lock, retry a few times if the server is writing
+    for (size_t attempt = 0; attempt < 4; ++attempt) {
+        const uint32_t sequence = slot.Sequence.load(std::memory_order_acquire);
+        if (sequence == arm->m_sequence) {
+            return false; // no new data
+        }
+        if (sequence & 1) {
+            continue;
+        }
+        const uint32_t size = slot.Size;
+        if (size > ArmDataSize) {
+            return false;
+        }
+        m_buffer.assign(slot.Data, slot.Data + size);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.Sequence.load(std::memory_order_relaxed) != sequence) {
+            continue;
+        }
+        arm->m_sequence = sequence;
+
+        std::stringstream stream(std::string(m_buffer.data(), m_buffer.size()));
+        try {
+            arm->m_snapshot.DeSerializeRaw(stream);
+            arm->m_configuration_js.DeSerializeRaw(stream);
+            arm->m_operating_state.DeSerializeRaw(stream);
+        } catch (...) {
+            CMN_LOG_CLASS_RUN_WARNING << "ReadArm: " << this->GetName()
+                                      << ", failed to de-serialize data for " << arm->m_name << std::endl;
+            return false;
+        }
+        arm->m_measured_js = arm->m_snapshot.StateJoint();
+        arm->m_measured_cp = arm->m_snapshot.Position();
+        arm->m_measured_cf_body = arm->m_snapshot.Wrench();
+        arm->m_period_statistics = arm->m_snapshot.PeriodStatistics();
+        return true;
+    }
+    return false;
+}
+
+void mtsConsoleSharedMemoryClient::ReadEvents(void)
+{
+    const uint64_t written = m_segment->Header.EventsWritten.load(std::memory_order_acquire);
+    if ((written - m_events_read) > EventsSize) {
+        std::stringstream message;
+        message << this->GetName() << ": GUI too slow, lost "
+                << (written - m_events_read - EventsSize) << " event(s)";
+        m_console_interface->SendWarning(message.str());
+        m_events_read = written - EventsSize;
+    }
+
+    Entry event;
+    while (m_events_read < written) {
+        const Entry & source = m_segment->Events[m_events_read % EventsSize];
+        event.Target = source.Target;
+        event.Type = source.Type;
+        event.Size = std::min(source.Size, static_cast<uint32_t>(PayloadSize));
+        std::memcpy(event.Payload, source.Payload, event.Size);
+        // make sure the server didn't start overwriting the entry while copying
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const uint64_t latest = m_segment->Header.EventsWritten.load(std::memory_order_relaxed);
+        if ((latest - m_events_read) < EventsSize) {
+            ProcessEvent(event);
+        }
+        ++m_events_read;
+    }
+}
+
+void mtsConsoleSharedMemoryClient::ProcessEvent(const Entry & event)
+{
+    mtsInterfaceProvided * interfaceProvided;
+    ArmProxy * arm = nullptr;
+    if (event.Target == 0) {
+        interfaceProvided = m_console_interface;
+    } else if (event.Target <= m_arms.size()) {
+        arm = m_arms[event.Target - 1];
+        interfaceProvided = arm->m_interface;
+    } else {
+        return;
+    }
+
+    bool valid = true;
+    mtsMessage message;
+    prmKeyValue keyValue;
+    mtsBool flag;
+    mtsDouble value;
+    mtsStdString state;
+    prmOperatingState operatingState;
+    switch (event.Type) {
+    case MESSAGE_STATUS:
+        if ((valid = Unpack(event.Payload, event.Size, message))) {
+            interfaceProvided->SendStatus(message.Message);
+        }
+        break;
+    case MESSAGE_WARNING:
+        if ((valid = Unpack(event.Payload, event.Size, message))) {
+            interfaceProvided->SendWarning(message.Message);
+        }
+        break;
+    case MESSAGE_ERROR:
+        if ((valid = Unpack(event.Payload, event.Size, message))) {
+            interfaceProvided->SendError(message.Message);
+        }
+        break;
+    case ARM_CURRENT_STATE:
+        if ((valid = Unpack(event.Payload, event.Size, keyValue))) {
+            mConsoleEvents.ArmCurrentState(keyValue);
+        }
+        break;
+    case TELEOP_ENABLED:
+        if ((valid = Unpack(event.Payload, event.Size, flag))) {
+            mConsoleEvents.teleop_enabled(flag);
+        }
+        break;
+    case TELEOP_PSM_SELECTED:
+        if ((valid = Unpack(event.Payload, event.Size, keyValue))) {
+            mConsoleEvents.teleop_psm_selected(keyValue);
+        }
+        break;
+    case TELEOP_PSM_UNSELECTED:
+        if ((valid = Unpack(event.Payload, event.Size, keyValue))) {
+            mConsoleEvents.teleop_psm_unselected(keyValue);
+        }
+        break;
+    case SCALE:
+        if ((valid = Unpack(event.Payload, event.Size, value))) {
+            mConsoleEvents.scale(value);
+        }
+        break;
+    case VOLUME:
+        if ((valid = Unpack(event.Payload, event.Size, value))) {
+            mConsoleEvents.volume(value);
+        }
+        break;
+    case DESIRED_STATE:
+        if (arm && (valid = Unpack(event.Payload, event.Size, state))) {
+            arm->desired_state(state);
+        }
+        break;
+    case OPERATING_STATE:
+        if (arm && (valid = Unpack(event.Payload, event.Size, operatingState))) {
+            arm->operating_state(operatingState);
+        }
+        break;
+    default:
+        valid = false;
+    }
+
+    if (!valid) {
+        CMN_LOG_CLASS_RUN_WARNING << "ProcessEvent: " << this->GetName()
+                                  << ", invalid event " << event.Type
+                                  << " for target " << event.Target << std::endl;
+    }
+}
+
+void mtsConsoleSharedMemoryClient::PushCommand(const uint32_t target, const CommandType type,
+                                               const cmnGenericObject * payload)
+{
+    const uint64_t head = m_segment->Header.CommandsHead.load(std::memory_order_relaxed);
+    const uint64_t tail = m_segment->Header.CommandsTail.load(std::memory_order_acquire);
+    if ((head - tail) >= CommandsSize) {
+        m_console_interface->SendWarning(this->GetName() + ": commands queue full, console is not responding");
+        return;
+    }
+    Entry & entry = m_segment->Commands[head % CommandsSize];
+    entry.Target = target;
+    entry.Type = type;
+    entry.Size = 0;
+    entry.Reserved = 0;
+    if (payload
+        && !Pack(*payload, entry.Payload, PayloadSize, entry.Size)) {
+        m_console_interface->SendWarning(this->GetName() + ": command payload too large");
+        return;
+    }
+    m_segment->Header.CommandsHead.store(head + 1, std::memory_order_release);
+}
+
+void mtsConsoleSharedMemoryClient::power_off(void)
+{
+    PushCommand(0, POWER_OFF);
+}
+
+void mtsConsoleSharedMemoryClient::power_on(void)
+{
+    PushCommand(0, POWER_ON);
+}
+
+void mtsConsoleSharedMemoryClient::home(void)
+{
+    PushCommand(0, HOME);
+}
+
+void mtsConsoleSharedMemoryClient::teleop_enable(const bool & enable)
+{
+    const mtsBool payload(enable);
+    PushCommand(0, TELEOP_ENABLE, &payload);
+}
+
+void mtsConsoleSharedMemoryClient::select_teleop_psm(const prmKeyValue & mtmPsm)
+{
+    PushCommand(0, SELECT_TELEOP_PSM, &mtmPsm);
+}
+
+void mtsConsoleSharedMemoryClient::set_scale(const double & scale)
+{
+    const mtsDouble payload(scale);
+    PushCommand(0, SET_SCALE, &payload);
+}
+
+void mtsConsoleSharedMemoryClient::set_volume(const double & volume)
+{
+    const mtsDouble payload(volume);
+    PushCommand(0, SET_VOLUME, &payload);
+}
+
+void mtsConsoleSharedMemoryClient::emulate_operator_present(const prmEventButton & button)
+{
+    PushCommand(0, EMULATE_OPERATOR_PRESENT, &button);
+}
+
+void mtsConsoleSharedMemoryClient::emulate_clutch(const prmEventButton & button)
+{
+    PushCommand(0, EMULATE_CLUTCH, &button);
+}
+
+void mtsConsoleSharedMemoryClient::emulate_camera(const prmEventButton & button)
+{
+    PushCommand(0, EMULATE_CAMERA, &button);
+}
+
+void mtsConsoleSharedMemoryClient::calibration_mode(bool & result) const
+{
+    result = (m_segment && (m_segment->Header.CalibrationMode != 0));
+}
+
+void mtsConsoleSharedMemoryClient::ArmProxy::state_command(const std::string & command)
+{
+    const mtsStdString payload(command);
+    m_client->PushCommand(m_target, STATE_COMMAND, &payload);
+}
+
+void mtsConsoleSharedMemoryClient::ArmProxy::move_jp(const prmPositionJointSet & position)
+{
+    m_client->PushCommand(m_target, MOVE_JP, &position);
+}
+
+void mtsConsoleSharedMemoryClient::ArmProxy::trajectory_j_set_ratio(const double & ratio)
+{
+    const mtsDouble payload(ratio);
+    m_client->PushCommand(m_target, TRAJECTORY_J_SET_RATIO, &payload);
+}
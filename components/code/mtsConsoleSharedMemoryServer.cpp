@@ -0,0 +1,493 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+// system include
+#include <cstring>
+#include <sstream>
+
+#include <sawIntuitiveResearchKit/mtsConsoleSharedMemoryServer.h>
+#include <sawIntuitiveResearchKit/mtsIntuitiveResearchKitConsole.h>
+
+#include <cisstMultiTask/mtsInterfaceRequired.h>
+#include <cisstParameterTypes/prmEventButton.h>
+#include <cisstParameterTypes/prmPositionJointSet.h>
+
+CMN_IMPLEMENT_SERVICES_DERIVED(mtsConsoleSharedMemoryServer, mtsTaskPeriodic);
+
+mtsConsoleSharedMemoryServer::mtsConsoleSharedMemoryServer(const std::string & componentName,
+                                                           const double periodInSeconds,
+                                                           const std::string & sharedMemoryName):
+    mtsConsoleSharedMemory(componentName, periodInSeconds, sharedMemoryName),
+    m_client_pid(0),
+    m_events_failed(0)
+{
+}
+
+mtsConsoleSharedMemoryServer::~mtsConsoleSharedMemoryServer()
+{
+    for (auto arm : m_arms) {
+        delete arm;
+    }
+}
+
+void mtsConsoleSharedMemoryServer::Configure(mtsIntuitiveResearchKitConsole * console)
+{
+    std::string errorMessage;
+    if (!Create(errorMessage)) {
+        CMN_LOG_CLASS_INIT_ERROR << "Configure: " << this->GetName()
+                                 << ", " << errorMessage << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    m_segment->Header.Period = this->GetPeriodicity();
+    m_segment->Header.CalibrationMode = console->calibration_mode() ? 1 : 0;
+
+    // console
+    mtsInterfaceRequired * interfaceRequired = AddInterfaceRequired("Console");
+    if (interfaceRequired) {
+        interfaceRequired->AddFunction("power_off", mConsole.power_off);
+        interfaceRequired->AddFunction("power_on", mConsole.power_on);
+        interfaceRequired->AddFunction("home", mConsole.home);
+        interfaceRequired->AddFunction("teleop_enable", mConsole.teleop_enable);
+        interfaceRequired->AddFunction("select_teleop_psm", mConsole.select_teleop_psm);
+        interfaceRequired->AddFunction("set_scale", mConsole.set_scale);
+        interfaceRequired->AddFunction("set_volume", mConsole.set_volume);
+        interfaceRequired->AddFunction("emulate_operator_present", mConsole.emulate_operator_present);
+        interfaceRequired->AddFunction("emulate_clutch", mConsole.emulate_clutch);
+        interfaceRequired->AddFunction("emulate_camera", mConsole.emulate_camera);
+        interfaceRequired->AddEventHandlerWrite(&mtsConsoleSharedMemoryServer::StatusEventHandler,
+                                                this, "status");
+        interfaceRequired->AddEventHandlerWrite(&mtsConsoleSharedMemoryServer::WarningEventHandler,
+                                                this, "warning");
+        interfaceRequired->AddEventHandlerWrite(&mtsConsoleSharedMemoryServer::ErrorEventHandler,
+                                                this, "error");
+        interfaceRequired->AddEventHandlerWrite(&mtsConsoleSharedMemoryServer::ArmCurrentStateEventHandler,
+                                                this, "ArmCurrentState");
+        interfaceRequired->AddEventHandlerWrite(&mtsConsoleSharedMemoryServer::TeleopEnabledEventHandler,
+                                                this, "teleop_enabled");
+        interfaceRequired->AddEventHandlerWrite(&mtsConsoleSharedMemoryServer::TeleopPSMSelectedEventHandler,
+                                                this, "teleop_psm_selected");
+        interfaceRequired->AddEventHandlerWrite(&mtsConsoleSharedMemoryServer::TeleopPSMUnselectedEventHandler,
+                                                this, "teleop_psm_unselected");
+        interfaceRequired->AddEventHandlerWrite(&mtsConsoleSharedMemoryServer::ScaleEventHandler,
+                                                this, "scale");
+        interfaceRequired->AddEventHandlerWrite(&mtsConsoleSharedMemoryServer::VolumeEventHandler,
+                                                this, "volume");
+        m_connections.Add(this->GetName(), "Console", console->GetName(), "Main");
+    }
+
+    // arms
+    for (auto & armIter : console->mArms) {
+        const mtsIntuitiveResearchKitConsole::Arm * arm = armIter.second;
+        std::string type;
+        switch (arm->m_type) {
+        case mtsIntuitiveResearchKitConsole::Arm::ARM_MTM:
+        case mtsIntuitiveResearchKitConsole::Arm::ARM_MTM_GENERIC:
+        case mtsIntuitiveResearchKitConsole::Arm::ARM_MTM_DERIVED:
+            type = "MTM";
+            break;
+        case mtsIntuitiveResearchKitConsole::Arm::ARM_PSM:
+        case mtsIntuitiveResearchKitConsole::Arm::ARM_PSM_GENERIC:
+        case mtsIntuitiveResearchKitConsole::Arm::ARM_PSM_DERIVED:
+        case mtsIntuitiveResearchKitConsole::Arm::ARM_PSM_SOCKET:
+            type = "PSM";
+            break;
+        case mtsIntuitiveResearchKitConsole::Arm::ARM_ECM:
+        case mtsIntuitiveResearchKitConsole::Arm::ARM_ECM_GENERIC:
+        case mtsIntuitiveResearchKitConsole::Arm::ARM_ECM_DERIVED:
+            type = "ECM";
+            break;
+        case mtsIntuitiveResearchKitConsole::Arm::ARM_SUJ:
+            type = "SUJ";
+            break;
+        default:
+            // focus controller...
+            continue;
+        }
+        if (m_arms.size() == MaxArms) {
+            CMN_LOG_CLASS_INIT_WARNING << "Configure: " << this->GetName()
+                                       << ", too many arms, \"" << arm->Name()
+                                       << "\" won't be available in shared memory" << std::endl;
+            continue;
+        }
+        if ((arm->Name().size() >= NameSize) || (arm->Name() == "Console")) {
+            CMN_LOG_CLASS_INIT_ERROR << "Configure: " << this->GetName()
+                                     << ", invalid arm name \"" << arm->Name() << "\"" << std::endl;
+            exit(EXIT_FAILURE);
+        }
+
+        ArmProxy * proxy = new ArmProxy;
+        proxy->m_server = this;
+        proxy->m_target = static_cast<uint32_t>(m_arms.size() + 1);
+        proxy->m_name = arm->Name();
+
+        // all optional, gui/snapshot is used when available
+        interfaceRequired = AddInterfaceRequired(arm->Name());
+        if (interfaceRequired) {
+            interfaceRequired->AddFunction("gui/snapshot", proxy->gui_snapshot, MTS_OPTIONAL);
+            interfaceRequired->AddFunction("measured_js", proxy->measured_js, MTS_OPTIONAL);
+            interfaceRequired->AddFunction("measured_cp", proxy->measured_cp, MTS_OPTIONAL);
+            interfaceRequired->AddFunction("body/measured_cf", proxy->measured_cf_body, MTS_OPTIONAL);
+            interfaceRequired->AddFunction("period_statistics", proxy->period_statistics, MTS_OPTIONAL);
+            interfaceRequired->AddFunction("configuration_js", proxy->configuration_js, MTS_OPTIONAL);
+            interfaceRequired->AddFunction("operating_state", proxy->operating_state, MTS_OPTIONAL);
+            interfaceRequired->AddFunction("state_command", proxy->state_command, MTS_OPTIONAL);
+            interfaceRequired->AddFunction("move_jp", proxy->move_jp, MTS_OPTIONAL);
+            interfaceRequired->AddFunction("trajectory_j/set_ratio", proxy->trajectory_j_set_ratio, MTS_OPTIONAL);
+            interfaceRequired->AddEventHandlerWrite(&ArmProxy::StatusEventHandler,
+                                                    proxy, "status");
+            interfaceRequired->AddEventHandlerWrite(&ArmProxy::WarningEventHandler,
+                                                    proxy, "warning");
+            interfaceRequired->AddEventHandlerWrite(&ArmProxy::ErrorEventHandler,
+                                                    proxy, "error");
+            interfaceRequired->AddEventHandlerWrite(&ArmProxy::DesiredStateEventHandler,
+                                                    proxy, "desired_state");
+            interfaceRequired->AddEventHandlerWrite(&ArmProxy::OperatingStateEventHandler,
+                                                    proxy, "operating_state");
+            m_connections.Add(this->GetName(), arm->Name(),
+                              arm->ComponentName(), arm->InterfaceName());
+        }
+
+        const size_t index = m_arms.size();
+        std::strncpy(m_segment->Header.Arms[index].Name, arm->Name().c_str(), NameSize - 1);
+        std::strncpy(m_segment->Header.Arms[index].Type, type.c_str(), NameSize - 1);
+        m_arms.push_back(proxy);
+    }
+    m_segment->Header.NumberOfArms = static_cast<uint32_t>(m_arms.size());
+}
+
+void mtsConsoleSharedMemoryServer::Run(void)
+{
+    ProcessQueuedEvents();
+    ProcessQueuedCommands();
+
+    if (!m_segment) {
+        return;
+    }
+
+    ClientAttachedCheck();
+    for (size_t index = 0; index < m_arms.size(); ++index) {
+        UpdateArm(index);
+    }
+    ProcessCommands();
+    m_segment->Header.Heartbeat.fetch_add(1, std::memory_order_release);
+}
+
+void mtsConsoleSharedMemoryServer::Cleanup(void)
+{
+    Detach();
+}
+
+void mtsConsoleSharedMemoryServer::UpdateArm(const size_t index)
+{
+    ArmProxy * arm = m_arms[index];
+
+    // single read if possible, otherwise individual reads (SUJ, socket PSM)
+    mtsIntuitiveResearchKitArmSnapshot & snapshot = arm->m_snapshot;
+    if (arm->gui_snapshot.IsValid()) {
+        arm->gui_snapshot(snapshot);
+    } else {
+        if (arm->measured_js.IsValid()) {
+            arm->measured_js(snapshot.StateJoint());
+        }
+        if (arm->measured_cp.IsValid()) {
+            arm->measured_cp(snapshot.Position());
+        }
+        if (arm->measured_cf_body.IsValid()) {
+            arm->measured_cf_body(snapshot.Wrench());
+        }
+        if (arm->period_statistics.IsValid()) {
+            arm->period_statistics(snapshot.PeriodStatistics());
+        }
+    }
+    // configuration only changes with number of joints (i.e. tools)
+    if ((arm->m_configuration_js.Name().size() != snapshot.StateJoint().Name().size())
+        && arm->configuration_js.IsValid()) {
+        arm->configuration_js(arm->m_configuration_js);
+    }
+    if (arm->operating_state.IsValid()) {
+        arm->operating_state(arm->m_operating_state);
+    }
+
+    std::stringstream stream;
+    snapshot.SerializeRaw(stream);
+    arm->m_configuration_js.SerializeRaw(stream);
+    arm->m_operating_state.SerializeRaw(stream);
+    const std::string data = stream.str();
+    if (data.size() > ArmDataSize) {
+        CMN_LOG_CLASS_RUN_WARNING << "UpdateArm: " << this->GetName()
+                                  << ", data for " << arm->m_name << " too large ("
+                                  << data.size() << " bytes)" << std::endl;
+        return;
+    }
+
+    // sequence is odd while writing
+    ArmSlot & slot = m_segment->Arms[index];
+    slot.Sequence.fetch_add(1, std::memory_order_acq_rel);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(slot.Data, data.data(), data.size());
+    slot.Size = static_cast<uint32_t>(data.size());
+    slot.Sequence.fetch_add(1, std::memory_order_release);
+}
+
+void mtsConsoleSharedMemoryServer::ProcessCommands(void)
+{
+    uint64_t tail = m_segment->Header.CommandsTail.load(std::memory_order_relaxed);
+    const uint64_t head = m_segment->Header.CommandsHead.load(std::memory_order_acquire);
+    if ((head - tail) > CommandsSize) {
+        CMN_LOG_CLASS_RUN_WARNING << "ProcessCommands: " << this->GetName()
+                                  << ", invalid commands queue indices, dropping "
+                                  << (head - tail) << " command(s)" << std::endl;
+        tail = head;
+    }
+    Entry command;
+    while (tail != head) {
+        // copy so the client can't modify the command while it's processed
+        command = m_segment->Commands[tail % CommandsSize];
+        ++tail;
+        if (command.Size > PayloadSize) {
+            CMN_LOG_CLASS_RUN_WARNING << "ProcessCommands: " << this->GetName()
+                                      << ", command " << command.Type
+                                      << " for target " << command.Target
+                                      << " has invalid size " << command.Size << std::endl;
+            continue;
+        }
+        ProcessCommand(command);
+    }
+    m_segment->Header.CommandsTail.store(tail, std::memory_order_release);
+}
+
+void mtsConsoleSharedMemoryServer::ProcessCommand(const Entry & command)
+{
+    bool valid = true;
+    if (command.Target == 0) {
+        mtsBool flag;
+        mtsDouble value;
+        prmKeyValue keyValue;
+        prmEventButton button;
+        switch (command.Type) {
+        case POWER_OFF:
+            mConsole.power_off();
+            break;
+        case POWER_ON:
+            mConsole.power_on();
+            break;
+        case HOME:
+            mConsole.home();
+            break;
+        case TELEOP_ENABLE:
+            if ((valid = Unpack(command.Payload, command.Size, flag))) {
+                mConsole.teleop_enable(flag);
+            }
+            break;
+        case SELECT_TELEOP_PSM:
+            if ((valid = Unpack(command.Payload, command.Size, keyValue))) {
+                mConsole.select_teleop_psm(keyValue);
+            }
+            break;
+        case SET_SCALE:
+            if ((valid = Unpack(command.Payload, command.Size, value))) {
+                mConsole.set_scale(value);
+            }
+            break;
+        case SET_VOLUME:
+            if ((valid = Unpack(command.Payload, command.Size, value))) {
+                mConsole.set_volume(value);
+            }
+            break;
+        case EMULATE_OPERATOR_PRESENT:
+            if ((valid = Unpack(command.Payload, command.Size, button))) {
+                mConsole.emulate_operator_present(button);
+            }
+            break;
+        case EMULATE_CLUTCH:
+            if ((valid = Unpack(command.Payload, command.Size, button))) {
+                mConsole.emulate_clutch(button);
+            }
+            break;
+        case EMULATE_CAMERA:
+            if ((valid = Unpack(command.Payload, command.Size, button))) {
+                mConsole.emulate_camera(button);
+            }
+            break;
+        default:
+            valid = false;
+        }
+    } else if (command.Target <= m_arms.size()) {
+        ArmProxy * arm = m_arms[command.Target - 1];
+        mtsStdString state;
+        mtsDouble value;
+        prmPositionJointSet position;
+        switch (command.Type) {
+        case STATE_COMMAND:
+            if ((valid = Unpack(command.Payload, command.Size, state))) {
+                arm->state_command(state);
+            }
+            break;
+        case MOVE_JP:
+            if ((valid = Unpack(command.Payload, command.Size, position))) {
+                arm->move_jp(position);
+            }
+            break;
+        case TRAJECTORY_J_SET_RATIO:
+            if ((valid = Unpack(command.Payload, command.Size, value))) {
+                arm->trajectory_j_set_ratio(value);
+            }
+            break;
+        default:
+            valid = false;
+        }
+    } else {
+        valid = false;
+    }
+
+    if (!valid) {
+        CMN_LOG_CLASS_RUN_WARNING << "ProcessCommand: " << this->GetName()
+                                  << ", invalid command " << command.Type
+                                  << " for target " << command.Target << std::endl;
+    }
+}
+
+void mtsConsoleSharedMemoryServer::PushEvent(const uint32_t target, const EventType type,
+                                             const cmnGenericObject & payload,
+                                             const std::string & latestKey)
+{
+    if (!m_segment) {
+        return;
+    }
+    Entry entry;
+    entry.Target = target;
+    entry.Type = type;
+    entry.Reserved = 0;
+    if (!Pack(payload, entry.Payload, PayloadSize, entry.Size)) {
+        ++m_events_failed;
+        CMN_LOG_CLASS_RUN_WARNING << "PushEvent: " << this->GetName()
+                                  << ", event payload too large, total failed: "
+                                  << m_events_failed << std::endl;
+        return;
+    }
+    PushEntry(entry);
+    if (!latestKey.empty()) {
+        m_latest_events[latestKey] = entry;
+    }
+}
+
+void mtsConsoleSharedMemoryServer::PushEntry(const Entry & entry)
+{
+    // readers check the index after copying to detect overwritten entries
+    const uint64_t index = m_segment->Header.EventsWritten.load(std::memory_order_relaxed);
+    Entry & destination = m_segment->Events[index % EventsSize];
+    destination.Target = entry.Target;
+    destination.Type = entry.Type;
+    destination.Size = entry.Size;
+    destination.Reserved = 0;
+    std::memcpy(destination.Payload, entry.Payload, entry.Size);
+    m_segment->Header.EventsWritten.store(index + 1, std::memory_order_release);
+}
+
+void mtsConsoleSharedMemoryServer::ClientAttachedCheck(void)
+{
+    const int64_t pid = m_segment->Header.ClientPID.load(std::memory_order_acquire);
+    if (pid == m_client_pid) {
+        return;
+    }
+    m_client_pid = pid;
+    if (pid == 0) {
+        CMN_LOG_CLASS_RUN_VERBOSE << "ClientAttachedCheck: " << this->GetName()
+                                  << ", client detached" << std::endl;
+        return;
+    }
+    CMN_LOG_CLASS_RUN_VERBOSE << "ClientAttachedCheck: " << this->GetName()
+                              << ", client " << pid << " attached" << std::endl;
+    // new client needs latest states
+    for (const auto & latest : m_latest_events) {
+        PushEntry(latest.second);
+    }
+}
+
+void mtsConsoleSharedMemoryServer::StatusEventHandler(const mtsMessage & message)
+{
+    PushEvent(0, MESSAGE_STATUS, message);
+}
+
+void mtsConsoleSharedMemoryServer::WarningEventHandler(const mtsMessage & message)
+{
+    PushEvent(0, MESSAGE_WARNING, message);
+}
+
+void mtsConsoleSharedMemoryServer::ErrorEventHandler(const mtsMessage & message)
+{
+    PushEvent(0, MESSAGE_ERROR, message);
+}
+
+void mtsConsoleSharedMemoryServer::ArmCurrentStateEventHandler(const prmKeyValue & armState)
+{
+    PushEvent(0, ARM_CURRENT_STATE, armState, "arm_current_state/" + armState.Key);
+}
+
+void mtsConsoleSharedMemoryServer::TeleopEnabledEventHandler(const bool & enabled)
+{
+    PushEvent(0, TELEOP_ENABLED, mtsBool(enabled), "teleop_enabled");
+}
+
+void mtsConsoleSharedMemoryServer::TeleopPSMSelectedEventHandler(const prmKeyValue & mtmPsm)
+{
+    PushEvent(0, TELEOP_PSM_SELECTED, mtmPsm, "teleop_psm/" + mtmPsm.Key);
+}
+
+void mtsConsoleSharedMemoryServer::TeleopPSMUnselectedEventHandler(const prmKeyValue & mtmPsm)
+{
+    PushEvent(0, TELEOP_PSM_UNSELECTED, mtmPsm);
+    m_latest_events.erase("teleop_psm/" + mtmPsm.Key);
+}
+
+void mtsConsoleSharedMemoryServer::ScaleEventHandler(const double & scale)
+{
+    PushEvent(0, SCALE, mtsDouble(scale), "scale");
+}
+
+void mtsConsoleSharedMemoryServer::VolumeEventHandler(const double & volume)
+{
+    PushEvent(0, VOLUME, mtsDouble(volume), "volume");
+}
+
+void mtsConsoleSharedMemoryServer::ArmProxy::StatusEventHandler(const mtsMessage & message)
+{
+    m_server->PushEvent(m_target, MESSAGE_STATUS, message);
+}
+
+void mtsConsoleSharedMemoryServer::ArmProxy::WarningEventHandler(const mtsMessage & message)
+{
+    m_server->PushEvent(m_target, MESSAGE_WARNING, message);
+}
+
+void mtsConsoleSharedMemoryServer::ArmProxy::ErrorEventHandler(const mtsMessage & message)
+{
+    m_server->PushEvent(m_target, MESSAGE_ERROR, message);
+}
+
+void mtsConsoleSharedMemoryServer::ArmProxy::DesiredStateEventHandler(const std::string & state)
+{
+    m_server->PushEvent(m_target, DESIRED_STATE, mtsStdString(state),
+                        m_name + "/desired_state");
+}
+
+void mtsConsoleSharedMemoryServer::ArmProxy::OperatingStateEventHandler(const prmOperatingState & state)
+{
+    m_server->PushEvent(m_target, OPERATING_STATE, state,
+                        m_name + "/operating_state");
+}
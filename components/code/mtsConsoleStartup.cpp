@@ -0,0 +1,327 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+// system include
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+#include <sawIntuitiveResearchKit/mtsConsoleStartup.h>
+#include <sawIntuitiveResearchKit/mtsIntuitiveResearchKit.h>
+
+#include <json/json.h>
+
+mtsConsoleStartup::mtsConsoleStartup(const cmnGenericObject & owner):
+    OwnerServices(owner.Services()),
+    m_max_powering(0),
+    m_power_timeout(2.0 * mtsIntuitiveResearchKit::TimeToPower),
+    m_active(false),
+    m_begin(0.0),
+    m_powering(0),
+    m_completed(false)
+{
+}
+
+bool mtsConsoleStartup::ConfigureJSON(const Json::Value & jsonConfig,
+                                      std::string & errorMessage)
+{
+    Json::Value jsonValue;
+
+    // 0 means no limit
+    jsonValue = jsonConfig["max-powering"];
+    if (!jsonValue.empty()) {
+        if (jsonValue.asInt() < 0) {
+            errorMessage = "\"max-powering\" must be positive, use 0 for no limit";
+            return false;
+        }
+        m_max_powering = jsonValue.asUInt();
+    }
+
+    // arms not listed are powered after, in alphabetical order
+    jsonValue = jsonConfig["order"];
+    if (!jsonValue.empty()) {
+        if (!jsonValue.isArray()) {
+            errorMessage = "\"order\" must be an array of arm names";
+            return false;
+        }
+        m_order.clear();
+        for (const auto & name : jsonValue) {
+            m_order.push_back(name.asString());
+        }
+    }
+
+    CMN_LOG_CLASS_INIT_VERBOSE << "ConfigureJSON: max-powering " << m_max_powering
+                               << ", " << m_order.size() << " arm(s) in order" << std::endl;
+    return true;
+}
+
+void mtsConsoleStartup::Begin(const std::string & command,
+                              const std::map<std::string, prmOperatingState> & arms,
+                              const double time,
+                              std::list<std::string> & start)
+{
+    m_active = true;
+    m_completed = false;
+    m_command = command;
+    m_begin = time;
+    m_arms.clear();
+    m_queue.clear();
+    m_powering = 0;
+    m_report.clear();
+
+    // arms listed in order first
+    std::vector<std::string> names;
+    for (const auto & name : m_order) {
+        if ((arms.count(name) != 0)
+            && (std::find(names.begin(), names.end(), name) == names.end())) {
+            names.push_back(name);
+        }
+    }
+    for (const auto & arm : arms) {
+        if (std::find(names.begin(), names.end(), arm.first) == names.end()) {
+            names.push_back(arm.first);
+        }
+    }
+
+    for (const auto & name : names) {
+        const prmOperatingState & state = arms.find(name)->second;
+        ArmSequence & arm = m_arms[name];
+        arm.Queued = time;
+        arm.Powering = time;
+        arm.Ready = time;
+        arm.Phases.clear();
+        arm.NeedsPower = (state.State() != prmOperatingState::ENABLED);
+        if (arm.NeedsPower) {
+            arm.Status = QUEUED;
+            arm.Phases.push_back({"QUEUED", time});
+            m_queue.push_back(name);
+        } else {
+            // already powered, no need to wait
+            arm.Status = IsReady(state) ? READY : STARTED;
+            arm.Phases.push_back({"STARTING", time});
+            start.push_back(name);
+        }
+    }
+    StartNext(time, start);
+}
+
+void mtsConsoleStartup::Abort(const double time)
+{
+    if (m_active && !m_completed && !m_queue.empty()) {
+        CMN_LOG_CLASS_RUN_VERBOSE << "Abort: \"" << m_command << "\" aborted after "
+                                  << time - m_begin << "s, "
+                                  << m_queue.size() << " arm(s) not started" << std::endl;
+    }
+    m_active = false;
+    m_queue.clear();
+    m_powering = 0;
+}
+
+void mtsConsoleStartup::StartNext(const double time,
+                                  std::list<std::string> & start)
+{
+    while (!m_queue.empty()
+           && ((m_max_powering == 0) || (m_powering < m_max_powering))) {
+        const std::string name = m_queue.front();
+        m_queue.pop_front();
+        ArmSequence & arm = m_arms[name];
+        arm.Status = POWERING;
+        arm.Powering = time;
+        // time between command and first state change
+        arm.Phases.push_back({"STARTING", time});
+        ++m_powering;
+        start.push_back(name);
+    }
+}
+
+void mtsConsoleStartup::PowerReleased(ArmSequence & arm, const double time,
+                                      std::list<std::string> & start)
+{
+    if (arm.Status == POWERING) {
+        arm.Status = STARTED;
+        --m_powering;
+        StartNext(time, start);
+    }
+}
+
+void mtsConsoleStartup::PowerFailed(ArmSequence & arm, const double time,
+                                    std::list<std::string> & start)
+{
+    PowerReleased(arm, time, start);
+    if (arm.Status != FAILED) {
+        arm.Status = FAILED;
+        arm.Ready = time;
+    }
+}
+
+bool mtsConsoleStartup::IsReady(const prmOperatingState & state) const
+{
+    if (m_command == "home") {
+        return state.IsEnabledHomedAndNotBusy();
+    }
+    return ((state.State() == prmOperatingState::ENABLED) && !state.IsBusy());
+}
+
+void mtsConsoleStartup::StateChanged(const std::string & name,
+                                     const std::string & state,
+                                     const double time,
+                                     std::list<std::string> & start)
+{
+    if (!m_active) {
+        return;
+    }
+    auto found = m_arms.find(name);
+    if ((found == m_arms.end()) || (found->second.Status == QUEUED)) {
+        return;
+    }
+    ArmSequence & arm = found->second;
+    if (arm.Phases.empty() || (arm.Phases.back().Name != state)) {
+        arm.Phases.push_back({state, time});
+    }
+    // amplifiers failed to power
+    if (state == "FAULT") {
+        PowerReleased(arm, time, start);
+    }
+}
+
+bool mtsConsoleStartup::OperatingStateChanged(const std::string & name,
+                                              const prmOperatingState & state,
+                                              const double time,
+                                              std::list<std::string> & start)
+{
+    if (!m_active) {
+        return false;
+    }
+    auto found = m_arms.find(name);
+    if ((found == m_arms.end()) || (found->second.Status == QUEUED)) {
+        return false;
+    }
+    ArmSequence & arm = found->second;
+
+    // powered, release power slot for next arm
+    if (state.State() == prmOperatingState::ENABLED) {
+        PowerReleased(arm, time, start);
+    }
+
+    if ((state.State() == prmOperatingState::FAULT)
+        // disabled while powering, e.g. power_off on the arm itself
+        || ((arm.Status == POWERING)
+            && (state.State() == prmOperatingState::DISABLED)
+            && !state.IsBusy())) {
+        PowerFailed(arm, time, start);
+    } else if (IsReady(state)) {
+        if (arm.Status != READY) {
+            arm.Status = READY;
+            arm.Ready = time;
+        }
+    } else if (arm.Status == READY) {
+        // new phase after ready, e.g. PSM engaging adapter
+        arm.Status = STARTED;
+        m_completed = false;
+    }
+
+    return CheckCompleted(time);
+}
+
+bool mtsConsoleStartup::CheckTimeouts(const double time,
+                                      std::list<std::string> & start)
+{
+    if (!m_active || (m_powering == 0)) {
+        return false;
+    }
+    for (auto & iter : m_arms) {
+        ArmSequence & arm = iter.second;
+        if ((arm.Status == POWERING)
+            && ((time - arm.Powering) > m_power_timeout)) {
+            CMN_LOG_CLASS_RUN_WARNING << "CheckTimeouts: " << iter.first
+                                      << " not powered after " << time - arm.Powering
+                                      << "s, starting next arm" << std::endl;
+            PowerFailed(arm, time, start);
+        }
+    }
+    return CheckCompleted(time);
+}
+
+bool mtsConsoleStartup::CheckCompleted(const double time)
+{
+    if (m_completed) {
+        return false;
+    }
+    for (const auto & arm : m_arms) {
+        if ((arm.second.Status != READY) && (arm.second.Status != FAILED)) {
+            return false;
+        }
+    }
+    m_completed = true;
+    UpdateReport(time);
+    return true;
+}
+
+void mtsConsoleStartup::UpdateReport(const double time)
+{
+    size_t failed = 0;
+    double last = m_begin;
+    std::stringstream report;
+    report << std::fixed << std::setprecision(2);
+    for (const auto & iter : m_arms) {
+        const ArmSequence & arm = iter.second;
+        if (arm.Status == FAILED) {
+            ++failed;
+        }
+        last = std::max(last, arm.Ready);
+        report << " - " << iter.first << ": "
+               << ((arm.Status == FAILED) ? "failed after " : "ready in ")
+               << arm.Ready - arm.Queued << "s";
+        // sum time per phase, the last phase is the final state
+        std::vector<std::pair<std::string, double> > phases;
+        for (size_t index = 0; index + 1 < arm.Phases.size(); ++index) {
+            const Phase & phase = arm.Phases.at(index);
+            const double duration = arm.Phases.at(index + 1).Start - phase.Start;
+            // arms started right away didn't wait for power
+            if ((phase.Name == "QUEUED") && (duration <= 0.0)) {
+                continue;
+            }
+            auto existing = std::find_if(phases.begin(), phases.end(),
+                                         [&phase](const std::pair<std::string, double> & p) {
+                                             return p.first == phase.Name;
+                                         });
+            if (existing == phases.end()) {
+                phases.push_back(std::make_pair(phase.Name, duration));
+            } else {
+                existing->second += duration;
+            }
+        }
+        for (const auto & phase : phases) {
+            report << ", " << phase.first << " " << phase.second << "s";
+        }
+        report << std::endl;
+    }
+
+    std::stringstream summary;
+    summary << std::fixed << std::setprecision(2)
+            << "startup: \"" << m_command << "\" completed in " << last - m_begin << "s for "
+            << m_arms.size() << " arm(s)";
+    if (failed != 0) {
+        summary << ", " << failed << " failed";
+    }
+    m_summary = summary.str();
+    m_report = m_summary + "\n" + report.str();
+
+    CMN_LOG_CLASS_RUN_VERBOSE << "UpdateReport: report at " << time - m_begin << "s" << std::endl
+                              << m_report << std::flush;
+}
@@ -0,0 +1,425 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+// system include
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <limits>
+#include <sstream>
+
+// cisst
+#include <sawIntuitiveResearchKit/mtsDataRecorder.h>
+
+#include <cisstCommon/cmnPortability.h>
+#include <cisstCommon/cmnUnits.h>
+#include <cisstMultiTask/mtsStateTable.h>
+#include <cisstMultiTask/mtsInterfaceProvided.h>
+
+#include <json/json.h>
+
+#if (CISST_OS == CISST_LINUX) || (CISST_OS == CISST_DARWIN)
+#define MTS_DATA_RECORDER_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    const char MagicNumber[8] = {'d', 'V', 'R', 'K', 'R', 'E', 'C', '\0'};
+    const uint32_t FormatVersion = 1;
+    // magic, version, header size, number of columns, reserved, number of records
+    const size_t PreambleSize = 8 + 4 * sizeof(uint32_t) + sizeof(uint64_t);
+    const size_t NumberOfRecordsOffset = 8 + 4 * sizeof(uint32_t);
+    // file grows by chunks of records
+    const size_t GrowthInRecords = 64 * 1024;
+}
+
+mtsDataRecorder::mtsDataRecorder(const cmnGenericObject & owner,
+                                 const std::string & name):
+    OwnerServices(owner.Services()),
+    m_name(name),
+    m_enabled(false),
+    m_number_of_columns(1), // time
+    m_ring_size(3000),
+    m_flush_period(100.0 * cmn_ms),
+    m_head(0),
+    m_tail(0),
+    m_current(nullptr),
+    m_current_column(0),
+    m_dropped(0),
+    m_file_descriptor(-1),
+    m_map(nullptr),
+    m_map_size(0),
+    m_header_size(0),
+    m_records_capacity(0),
+    m_records_written(0),
+    m_records_state(0),
+    m_dropped_state(0),
+    m_running(false)
+{
+}
+
+mtsDataRecorder::~mtsDataRecorder()
+{
+    Stop();
+}
+
+bool mtsDataRecorder::ConfigureJSON(const Json::Value & jsonConfig,
+                                    std::string & errorMessage)
+{
+#ifndef MTS_DATA_RECORDER_MMAP
+    errorMessage = "data recorder is only supported on Linux and macOS";
+    return false;
+#endif
+    Json::Value jsonValue;
+
+    // file name, default uses name and date
+    jsonValue = jsonConfig["file"];
+    if (!jsonValue.empty()) {
+        m_file_name = jsonValue.asString();
+    } else {
+        char date[32];
+        const std::time_t now = std::time(nullptr);
+        std::strftime(date, sizeof(date), "%Y-%m-%d-%H-%M-%S", std::localtime(&now));
+        m_file_name = m_name + "-" + date + ".dvrk-rec";
+    }
+
+    // signals, all available signals if not specified
+    m_selected.clear();
+    jsonValue = jsonConfig["signals"];
+    for (unsigned int index = 0; index < jsonValue.size(); ++index) {
+        m_selected.push_back(jsonValue[index].asString());
+    }
+
+    jsonValue = jsonConfig["ring-size"];
+    if (!jsonValue.empty()) {
+        if (jsonValue.asInt() < 2) {
+            errorMessage = "\"ring-size\" must be at least 2 records";
+            return false;
+        }
+        m_ring_size = jsonValue.asUInt();
+    }
+
+    jsonValue = jsonConfig["flush-period"];
+    if (!jsonValue.empty()) {
+        m_flush_period = jsonValue.asDouble();
+        if (m_flush_period <= 0.0) {
+            errorMessage = "\"flush-period\" must be a positive number";
+            return false;
+        }
+    }
+
+    m_enabled = true;
+    return true;
+}
+
+bool mtsDataRecorder::AddSignal(const std::string & name, const size_t size)
+{
+    m_available.push_back(name);
+    if (!m_selected.empty()
+        && (std::find(m_selected.begin(), m_selected.end(), name) == m_selected.end())) {
+        return false;
+    }
+    Signal signal;
+    signal.m_name = name;
+    signal.m_size = size;
+    signal.m_first_column = m_number_of_columns;
+    m_signals.push_back(signal);
+    m_number_of_columns += size;
+    return true;
+}
+
+bool mtsDataRecorder::CheckSignals(std::string & errorMessage) const
+{
+    for (const auto & name : m_selected) {
+        if (std::find(m_available.begin(), m_available.end(), name) == m_available.end()) {
+            std::stringstream message;
+            message << "signal \"" << name << "\" is not available, must be one of:";
+            for (const auto & available : m_available) {
+                message << " " << available;
+            }
+            errorMessage = message.str();
+            return false;
+        }
+    }
+    return true;
+}
+
+void mtsDataRecorder::AddToInterface(mtsStateTable & stateTable,
+                                     mtsInterfaceProvided * interfaceProvided)
+{
+    stateTable.AddData(m_records_state, "recorder_records");
+    stateTable.AddData(m_dropped_state, "recorder_dropped");
+    if (interfaceProvided) {
+        interfaceProvided->AddCommandReadState(stateTable, m_records_state, "recorder_records");
+        interfaceProvided->AddCommandReadState(stateTable, m_dropped_state, "recorder_dropped");
+    }
+}
+
+bool mtsDataRecorder::Start(const double period)
+{
+#ifdef MTS_DATA_RECORDER_MMAP
+    if (!m_enabled || m_running) {
+        return false;
+    }
+
+    // description of the file
+    char date[32];
+    const std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+    std::stringstream description;
+    description << "{\"component\": \"" << m_name << "\""
+                << ", \"period\": " << period
+                << ", \"created\": \"" << date << "\""
+                << ", \"columns\": " << m_number_of_columns
+                << ", \"signals\": [{\"name\": \"time\", \"size\": 1, \"first-column\": 0}";
+    for (const auto & signal : m_signals) {
+        description << ", {\"name\": \"" << signal.m_name << "\""
+                    << ", \"size\": " << signal.m_size
+                    << ", \"first-column\": " << signal.m_first_column << "}";
+    }
+    description << "]}";
+    const std::string text = description.str();
+    m_header_size = PreambleSize + text.size() + 1;
+    m_header_size = ((m_header_size + 7) / 8) * 8;
+
+    // preallocate ring, one extra record to detect full ring
+    m_ring.resize((m_ring_size + 1) * m_number_of_columns);
+    m_head = 0;
+    m_tail = 0;
+
+    m_file_descriptor = open(m_file_name.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (m_file_descriptor < 0) {
+        CMN_LOG_CLASS_INIT_ERROR << "DataRecorder::Start: " << m_name
+                                 << ", failed to create file \"" << m_file_name << "\": "
+                                 << strerror(errno) << std::endl;
+        return false;
+    }
+    m_records_written = 0;
+    m_records_capacity = 0;
+    if (!Grow(GrowthInRecords)) {
+        close(m_file_descriptor);
+        m_file_descriptor = -1;
+        return false;
+    }
+
+    // header
+    const uint32_t headerSize = static_cast<uint32_t>(m_header_size);
+    const uint32_t numberOfColumns = static_cast<uint32_t>(m_number_of_columns);
+    const uint32_t reserved = 0;
+    char * header = m_map;
+    memcpy(header, MagicNumber, 8);
+    memcpy(header + 8, &FormatVersion, sizeof(uint32_t));
+    memcpy(header + 12, &headerSize, sizeof(uint32_t));
+    memcpy(header + 16, &numberOfColumns, sizeof(uint32_t));
+    memcpy(header + 20, &reserved, sizeof(uint32_t));
+    memcpy(header + PreambleSize, text.c_str(), text.size() + 1);
+    UpdateHeader();
+
+    CMN_LOG_CLASS_INIT_VERBOSE << "DataRecorder::Start: " << m_name
+                               << ", recording " << m_number_of_columns
+                               << " columns in \"" << m_file_name << "\"" << std::endl;
+
+    m_running = true;
+    const std::string threadName = "Rec" + m_name;
+    m_thread.Create<mtsDataRecorder, void *>(this, &mtsDataRecorder::ThreadRun, nullptr,
+                                             threadName.c_str());
+    return true;
+#else
+    return false;
+#endif
+}
+
+void mtsDataRecorder::Stop(void)
+{
+    if (!m_running) {
+        return;
+    }
+    m_running = false;
+    m_signal.Raise();
+    m_thread.Wait();
+#ifdef MTS_DATA_RECORDER_MMAP
+    // truncate file to actual size
+    const size_t recordSize = m_number_of_columns * sizeof(double);
+    if (m_map) {
+        msync(m_map, m_map_size, MS_SYNC);
+        munmap(m_map, m_map_size);
+        m_map = nullptr;
+    }
+    if (ftruncate(m_file_descriptor, m_header_size + m_records_written * recordSize) != 0) {
+        CMN_LOG_CLASS_INIT_WARNING << "DataRecorder::Stop: " << m_name
+                                   << ", failed to truncate file \"" << m_file_name << "\"" << std::endl;
+    }
+    close(m_file_descriptor);
+    m_file_descriptor = -1;
+#endif
+    CMN_LOG_CLASS_INIT_VERBOSE << "DataRecorder::Stop: " << m_name
+                               << ", " << m_records_written.load() << " records written to \""
+                               << m_file_name << "\", " << m_dropped.load() << " dropped" << std::endl;
+}
+
+bool mtsDataRecorder::Begin(const double time)
+{
+    m_records_state = m_records_written;
+    m_dropped_state = m_dropped;
+    const size_t head = m_head.load(std::memory_order_relaxed);
+    const size_t next = (head + 1) % (m_ring_size + 1);
+    if (next == m_tail.load(std::memory_order_acquire)) {
+        m_dropped++;
+        m_current = nullptr;
+        return false;
+    }
+    m_current = &(m_ring[head * m_number_of_columns]);
+    m_current[0] = time;
+    m_current_column = 1;
+    return true;
+}
+
+void mtsDataRecorder::Append(const double * values, const size_t size,
+                             const size_t declaredSize)
+{
+    if (!m_current
+        || ((m_current_column + declaredSize) > m_number_of_columns)) {
+        return;
+    }
+    double * destination = m_current + m_current_column;
+    const size_t toCopy = std::min(size, declaredSize);
+    if (toCopy > 0) {
+        memcpy(destination, values, toCopy * sizeof(double));
+    }
+    for (size_t index = toCopy; index < declaredSize; ++index) {
+        destination[index] = std::numeric_limits<double>::quiet_NaN();
+    }
+    m_current_column += declaredSize;
+}
+
+void mtsDataRecorder::Append(const double value)
+{
+    Append(&value, 1, 1);
+}
+
+void mtsDataRecorder::Append(const vctFrm4x4 & frame)
+{
+    double values[12];
+    values[0] = frame.Translation().X();
+    values[1] = frame.Translation().Y();
+    values[2] = frame.Translation().Z();
+    for (size_t row = 0; row < 3; ++row) {
+        for (size_t column = 0; column < 3; ++column) {
+            values[3 + row * 3 + column] = frame.Rotation().Element(row, column);
+        }
+    }
+    Append(values, 12, 12);
+}
+
+void mtsDataRecorder::Commit(void)
+{
+    if (!m_current) {
+        return;
+    }
+    // pad if owner didn't append all columns
+    for (; m_current_column < m_number_of_columns; ++m_current_column) {
+        m_current[m_current_column] = std::numeric_limits<double>::quiet_NaN();
+    }
+    m_current = nullptr;
+    const size_t head = m_head.load(std::memory_order_relaxed);
+    m_head.store((head + 1) % (m_ring_size + 1), std::memory_order_release);
+}
+
+void * mtsDataRecorder::ThreadRun(void * CMN_UNUSED(argument))
+{
+#ifdef MTS_DATA_RECORDER_MMAP
+    while (m_running) {
+        m_signal.Wait(m_flush_period);
+        if ((WriteAvailable() > 0) && m_map) {
+            UpdateHeader();
+            msync(m_map, m_map_size, MS_ASYNC);
+        }
+    }
+    // last records
+    WriteAvailable();
+    UpdateHeader();
+#endif
+    return nullptr;
+}
+
+size_t mtsDataRecorder::WriteAvailable(void)
+{
+    const size_t recordSize = m_number_of_columns * sizeof(double);
+    size_t written = 0;
+    size_t tail = m_tail.load(std::memory_order_relaxed);
+    while (tail != m_head.load(std::memory_order_acquire)) {
+        if ((m_records_written == m_records_capacity)
+            && !Grow(GrowthInRecords)) {
+            // can't write anymore, records are lost
+            m_dropped++;
+        } else {
+            memcpy(m_map + m_header_size + m_records_written * recordSize,
+                   &(m_ring[tail * m_number_of_columns]), recordSize);
+            m_records_written++;
+            written++;
+        }
+        tail = (tail + 1) % (m_ring_size + 1);
+        m_tail.store(tail, std::memory_order_release);
+    }
+    return written;
+}
+
+bool mtsDataRecorder::Grow(const size_t numberOfRecords)
+{
+#ifdef MTS_DATA_RECORDER_MMAP
+    const size_t newCapacity = m_records_capacity + numberOfRecords;
+    const size_t newSize = m_header_size + newCapacity * m_number_of_columns * sizeof(double);
+    if (m_map) {
+        munmap(m_map, m_map_size);
+        m_map = nullptr;
+    }
+    if (ftruncate(m_file_descriptor, newSize) != 0) {
+        CMN_LOG_CLASS_RUN_ERROR << "DataRecorder::Grow: " << m_name
+                                << ", failed to resize file \"" << m_file_name << "\": "
+                                << strerror(errno) << std::endl;
+        return false;
+    }
+    void * map = mmap(nullptr, newSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_file_descriptor, 0);
+    if (map == MAP_FAILED) {
+        CMN_LOG_CLASS_RUN_ERROR << "DataRecorder::Grow: " << m_name
+                                << ", failed to map file \"" << m_file_name << "\": "
+                                << strerror(errno) << std::endl;
+        return false;
+    }
+    m_map = static_cast<char *>(map);
+    m_map_size = newSize;
+    m_records_capacity = newCapacity;
+    return true;
+#else
+    return false;
+#endif
+}
+
+void mtsDataRecorder::UpdateHeader(void)
+{
+    if (!m_map) {
+        return;
+    }
+    const uint64_t numberOfRecords = m_records_written;
+    memcpy(m_map + NumberOfRecordsOffset, &numberOfRecords, sizeof(uint64_t));
+}
@@ -0,0 +1,180 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+// cisst
+#include <sawIntuitiveResearchKit/mtsDeadlineMonitor.h>
+#include <sawIntuitiveResearchKit/mtsIntuitiveResearchKit.h>
+
+#include <cisstMultiTask/mtsStateTable.h>
+#include <cisstMultiTask/mtsInterfaceProvided.h>
+
+#include <json/json.h>
+
+mtsDeadlineMonitor::mtsDeadlineMonitor(void):
+    m_budget(0.0),
+    m_skip_outputs_threshold(mtsIntuitiveResearchKit::Deadline::SkipOutputs),
+    m_freeze_threshold(mtsIntuitiveResearchKit::Deadline::Freeze),
+    m_disable_threshold(mtsIntuitiveResearchKit::Deadline::Disable),
+    m_recovery_threshold(mtsIntuitiveResearchKit::Deadline::Recovery),
+    m_level(NOMINAL),
+    m_previous_level(NOMINAL),
+    m_consecutive_overruns(0),
+    m_consecutive_within_budget(0),
+    m_duration(0.0),
+    m_level_int(NOMINAL),
+    m_overruns(0),
+    m_skip_outputs(0),
+    m_freezes(0),
+    m_disables(0)
+{
+}
+
+bool mtsDeadlineMonitor::ConfigureJSON(const Json::Value & jsonConfig,
+                                       std::string & errorMessage)
+{
+    Json::Value jsonValue;
+
+    jsonValue = jsonConfig["budget"];
+    if (!jsonValue.empty()) {
+        m_budget = jsonValue.asDouble();
+        if (m_budget < 0.0) {
+            errorMessage = "\"budget\" must be positive or 0 to disable the deadline monitor";
+            return false;
+        }
+    }
+
+    // thresholds, 0 to skip a level
+    const char * names[] = {"skip-outputs", "freeze", "disable", "recovery"};
+    size_t * thresholds[] = {&m_skip_outputs_threshold, &m_freeze_threshold,
+                             &m_disable_threshold, &m_recovery_threshold};
+    for (size_t index = 0; index < 4; ++index) {
+        jsonValue = jsonConfig[names[index]];
+        if (!jsonValue.empty()) {
+            if (jsonValue.asInt() < 0) {
+                errorMessage = std::string("\"") + names[index] + "\" must be a positive number of cycles";
+                return false;
+            }
+            *(thresholds[index]) = jsonValue.asUInt();
+        }
+    }
+
+    if (m_recovery_threshold == 0) {
+        errorMessage = "\"recovery\" must be at least 1 cycle";
+        return false;
+    }
+    return true;
+}
+
+void mtsDeadlineMonitor::AddToInterface(mtsStateTable & stateTable,
+                                        mtsInterfaceProvided * interfaceProvided)
+{
+    stateTable.AddData(m_duration, "deadline_duration");
+    stateTable.AddData(m_level_int, "deadline_level");
+    stateTable.AddData(m_overruns, "deadline_overruns");
+    stateTable.AddData(m_skip_outputs, "deadline_skip_outputs");
+    stateTable.AddData(m_freezes, "deadline_freezes");
+    stateTable.AddData(m_disables, "deadline_disables");
+    if (interfaceProvided) {
+        interfaceProvided->AddCommandReadState(stateTable, m_duration, "deadline_duration");
+        interfaceProvided->AddCommandReadState(stateTable, m_level_int, "deadline_level");
+        interfaceProvided->AddCommandReadState(stateTable, m_overruns, "deadline_overruns");
+        interfaceProvided->AddCommandReadState(stateTable, m_skip_outputs, "deadline_skip_outputs");
+        interfaceProvided->AddCommandReadState(stateTable, m_freezes, "deadline_freezes");
+        interfaceProvided->AddCommandReadState(stateTable, m_disables, "deadline_disables");
+    }
+}
+
+bool mtsDeadlineMonitor::Update(const double duration)
+{
+    m_duration = duration;
+    if (!Enabled()) {
+        return false;
+    }
+
+    if (duration <= m_budget) {
+        m_consecutive_overruns = 0;
+        if (m_level == NOMINAL) {
+            return false;
+        }
+        ++m_consecutive_within_budget;
+        if (m_consecutive_within_budget >= m_recovery_threshold) {
+            SetLevel(NOMINAL);
+            return true;
+        }
+        return false;
+    }
+
+    // overrun
+    ++m_overruns;
+    ++m_consecutive_overruns;
+    m_consecutive_within_budget = 0;
+
+    // find highest level reached, never go down on overrun
+    Level level = m_level;
+    if ((m_disable_threshold > 0)
+        && (m_consecutive_overruns >= m_disable_threshold)) {
+        level = DISABLE;
+    } else if ((m_freeze_threshold > 0)
+               && (m_consecutive_overruns >= m_freeze_threshold)) {
+        level = FREEZE;
+    } else if ((m_skip_outputs_threshold > 0)
+               && (m_consecutive_overruns >= m_skip_outputs_threshold)) {
+        level = SKIP_OUTPUTS;
+    }
+    if (level > m_level) {
+        SetLevel(level);
+        return true;
+    }
+    return false;
+}
+
+void mtsDeadlineMonitor::SetLevel(const Level level)
+{
+    m_previous_level = m_level;
+    m_level = level;
+    m_level_int = level;
+    m_consecutive_within_budget = 0;
+    switch (level) {
+    case SKIP_OUTPUTS:
+        ++m_skip_outputs;
+        break;
+    case FREEZE:
+        ++m_freezes;
+        break;
+    case DISABLE:
+        ++m_disables;
+        break;
+    default:
+        break;
+    }
+}
+
+const char * mtsDeadlineMonitor::LevelName(const Level level)
+{
+    switch (level) {
+    case NOMINAL:
+        return "nominal";
+    case SKIP_OUTPUTS:
+        return "skipping optional outputs";
+    case FREEZE:
+        return "holding position";
+    case DISABLE:
+        return "disabling tele-operation";
+    }
+    return "undefined";
+}
@@ -17,12 +17,15 @@ http://www.cisst.org/cisst/license.txt.
 */
 
 // system include
+#include <algorithm>
 #include <iostream>
+#include <cstring>
 #include <time.h>
 
 // cisst
 #include <cisstCommon/cmnPath.h>
 #include <cisstNumerical/nmrIsOrthonormal.h>
+#include <cisstOSAbstraction/osaGetTime.h>
 #include <cisstMultiTask/mtsInterfaceProvided.h>
 #include <cisstMultiTask/mtsInterfaceRequired.h>
 #include <cisstParameterTypes/prmEventButton.h>
@@ -39,9 +42,14 @@ mtsIntuitiveResearchKitArm::mtsIntuitiveResearchKitArm(const std::string & compo
     mArmState(componentName, "DISABLED"),
     mStateTableState(100, "State"),
     mStateTableConfiguration(100, "Configuration"),
+    mStateTableLatest(mtsIntuitiveResearchKit::StateTableLatestSize, "Latest"),
+    mStateTableGUI(10, "GUI"),
     mControlCallback(0)
 {
     mCartesianImpedanceController = new osaCartesianImpedanceController();
+    m_messages = new mtsMessageRing(*this, GetName());
+    m_recorder = new mtsDataRecorder(*this, GetName());
+    m_publisher = new mtsArmStatePublisher(*this, GetName());
 }
 
 mtsIntuitiveResearchKitArm::mtsIntuitiveResearchKitArm(const mtsTaskPeriodicConstructorArg & arg):
@@ -49,9 +57,14 @@ mtsIntuitiveResearchKitArm::mtsIntuitiveResearchKitArm(const mtsTaskPeriodicCons
     mArmState(arg.Name, "DISABLED"),
     mStateTableState(100, "State"),
     mStateTableConfiguration(100, "Configuration"),
+    mStateTableLatest(mtsIntuitiveResearchKit::StateTableLatestSize, "Latest"),
+    mStateTableGUI(10, "GUI"),
     mControlCallback(0)
 {
     mCartesianImpedanceController = new osaCartesianImpedanceController();
+    m_messages = new mtsMessageRing(*this, GetName());
+    m_recorder = new mtsDataRecorder(*this, GetName());
+    m_publisher = new mtsArmStatePublisher(*this, GetName());
 }
 
 mtsIntuitiveResearchKitArm::~mtsIntuitiveResearchKitArm()
@@ -62,6 +75,15 @@ mtsIntuitiveResearchKitArm::~mtsIntuitiveResearchKitArm()
     if (mCartesianImpedanceController) {
         delete mCartesianImpedanceController;
     }
+    if (m_messages) {
+        delete m_messages;
+    }
+    if (m_recorder) {
+        delete m_recorder;
+    }
+    if (m_publisher) {
+        delete m_publisher;
+    }
 }
 
 void mtsIntuitiveResearchKitArm::CreateManipulator(void)
@@ -74,6 +96,20 @@ void mtsIntuitiveResearchKitArm::CreateManipulator(void)
 
 void mtsIntuitiveResearchKitArm::Init(void)
 {
+    // messages sent from control loop
+    m_message_codes.measured_js_failed =
+        m_messages->Register(mtsMessageRing::MESSAGE_WARNING, "GetRobotData, call to PID.measured_js failed");
+    m_message_codes.setpoint_js_failed =
+        m_messages->Register(mtsMessageRing::MESSAGE_WARNING, "GetRobotData, call to PID.setpoint_js failed");
+    m_message_codes.inverse_kinematics_failed =
+        m_messages->Register(mtsMessageRing::MESSAGE_ERROR, "unable to solve inverse kinematics{text}");
+    m_message_codes.deadline_degraded =
+        m_messages->Register(mtsMessageRing::MESSAGE_WARNING, "cycle duration {0}ms over budget for {1} consecutive cycles, {text}", 0.0);
+    m_message_codes.deadline_disable =
+        m_messages->Register(mtsMessageRing::MESSAGE_ERROR, "cycle duration {0}ms over budget for {1} consecutive cycles, {text}", 0.0);
+    m_message_codes.deadline_recovered =
+        m_messages->Register(mtsMessageRing::MESSAGE_STATUS, "cycle duration back within budget, recovered from {text}", 0.0);
+
     // configure state machine common to all arms (ECM/MTM/PSM)
     // possible states
     mArmState.AddState("POWERING");
@@ -190,6 +226,17 @@ void mtsIntuitiveResearchKitArm::Init(void)
     AddStateTable(&mStateTableConfiguration);
     mStateTableConfiguration.SetAutomaticAdvance(false);
 
+    // state table for signals without history, advanced with default
+    // state table.  Signals are added in ConfigureStateTables
+    AddStateTable(&mStateTableLatest);
+
+    // single snapshot for GUI, advanced when updated
+    mStateTableGUI.AddData(m_gui_snapshot, "gui/snapshot");
+    AddStateTable(&mStateTableGUI);
+    mStateTableGUI.SetAutomaticAdvance(false);
+    m_gui_snapshot_decimation = static_cast<size_t>(mtsIntuitiveResearchKit::GUISnapshotPeriod
+                                                    / this->GetPeriodicity()) + 1;
+
     m_control_space = mtsIntuitiveResearchKitArmTypes::UNDEFINED_SPACE;
     m_control_mode = mtsIntuitiveResearchKitArmTypes::UNDEFINED_MODE;
 
@@ -209,12 +256,16 @@ void mtsIntuitiveResearchKitArm::Init(void)
     mSafeForCartesianControlCounter = 0;
     mArmNotReadyCounter = 0;
     mArmNotReadyTimeLastMessage = 0.0;
+    mArmFrozenCounter = 0;
+    mArmFrozenTimeLastMessage = 0.0;
 
     // initialize trajectory data
     m_servo_jp.SetSize(NumberOfJoints());
     m_servo_jv.SetSize(NumberOfJoints());
     m_servo_jp_param.Goal().SetSize(NumberOfJoints());
     m_feed_forward_jf.ForceTorque().SetSize(NumberOfJoints());
+    m_actuator_amp_status.SetSize(NumberOfJoints());
+    m_brake_amp_status.SetSize(NumberOfBrakes());
     m_trajectory_j.v_max.SetSize(NumberOfJoints());
     m_trajectory_j.v.SetSize(NumberOfJoints());
     m_trajectory_j.a_max.SetSize(NumberOfJoints());
@@ -235,8 +286,6 @@ void mtsIntuitiveResearchKitArm::Init(void)
 
     // jacobian
     ResizeKinematicsData();
-    this->StateTable.AddData(m_body_jacobian, "body_jacobian");
-    this->StateTable.AddData(m_spatial_jacobian, "spatial_jacobian");
 
     // efforts for kinematics
     mEffortJointSet.SetSize(NumberOfJointsKinematics());
@@ -251,41 +300,29 @@ void mtsIntuitiveResearchKitArm::Init(void)
     m_measured_cp.SetAutomaticTimestamp(false); // based on PID timestamp
     m_measured_cp.SetReferenceFrame(GetName() + "_base");
     m_measured_cp.SetMovingFrame(GetName());
-    this->StateTable.AddData(m_measured_cp, "measured_cp");
 
     m_setpoint_cp.SetAutomaticTimestamp(false); // based on PID timestamp
     m_setpoint_cp.SetReferenceFrame(GetName() + "_base");
     m_setpoint_cp.SetMovingFrame(GetName() + "_setpoint");
-    this->StateTable.AddData(m_setpoint_cp, "setpoint_cp");
 
     m_local_measured_cp.SetAutomaticTimestamp(false); // based on PID timestamp
     m_local_measured_cp.SetReferenceFrame(GetName() + "_base");
     m_local_measured_cp.SetMovingFrame(GetName());
-    this->StateTable.AddData(m_local_measured_cp, "local/measured_cp");
 
     m_local_setpoint_cp.SetAutomaticTimestamp(false); // based on PID timestamp
     m_local_setpoint_cp.SetReferenceFrame(GetName() + "_base");
     m_local_setpoint_cp.SetMovingFrame(GetName() + "_setpoint");
-    this->StateTable.AddData(m_local_setpoint_cp, "local/setpoint_cp");
-
-    this->StateTable.AddData(m_base_frame, "base_frame");
 
     m_measured_cv.SetAutomaticTimestamp(false); // keep PID timestamp
     m_measured_cv.SetMovingFrame(GetName());
     m_measured_cv.SetReferenceFrame(GetName() + "_base");
-    this->StateTable.AddData(m_measured_cv, "measured_cv");
 
     m_body_measured_cf.SetAutomaticTimestamp(false); // keep PID timestamp
-    this->StateTable.AddData(m_body_measured_cf, "body/measured_cf");
-
     m_spatial_measured_cf.SetAutomaticTimestamp(false); // keep PID timestamp
-    this->StateTable.AddData(m_spatial_measured_cf, "spatial/measured_cf");
-
     m_kin_measured_js.SetAutomaticTimestamp(false); // keep PID timestamp
-    this->StateTable.AddData(m_kin_measured_js, "kin/measured_js");
-
     m_kin_setpoint_js.SetAutomaticTimestamp(false); // keep PID timestamp
-    this->StateTable.AddData(m_kin_setpoint_js, "kin/setpoint_js");
+    // all the signals above are added to the state tables in
+    // ConfigureStateTables, once the configuration is known
 
     // PID
     PIDInterface = AddInterfaceRequired("PID");
@@ -309,6 +346,12 @@ void mtsIntuitiveResearchKitArm::Init(void)
         PIDInterface->AddEventHandlerWrite(&mtsIntuitiveResearchKitArm::ErrorEventHandler, this, "error");
     }
 
+    // optional effort stage
+    mtsInterfaceRequired * effortStageInterface = AddInterfaceRequired("EffortStage", MTS_OPTIONAL);
+    if (effortStageInterface) {
+        effortStageInterface->AddFunction("servo_jf_model", m_effort_stage.servo_jf_model);
+    }
+
     // Arm IO
     IOInterface = AddInterfaceRequired("RobotIO");
     if (IOInterface) {
@@ -334,20 +377,12 @@ void mtsIntuitiveResearchKitArm::Init(void)
 
         // Get
         m_arm_interface->AddCommandReadState(this->mStateTableConfiguration, m_kin_configuration_js, "configuration_js");
-        m_arm_interface->AddCommandReadState(this->StateTable, m_kin_measured_js, "measured_js");
-        m_arm_interface->AddCommandReadState(this->StateTable, m_kin_setpoint_js, "setpoint_js");
-        m_arm_interface->AddCommandReadState(this->StateTable, m_local_measured_cp, "local/measured_cp");
-        m_arm_interface->AddCommandReadState(this->StateTable, m_local_setpoint_cp, "local/setpoint_cp");
-        m_arm_interface->AddCommandReadState(this->StateTable, m_measured_cp, "measured_cp");
-        m_arm_interface->AddCommandReadState(this->StateTable, m_setpoint_cp, "setpoint_cp");
-        m_arm_interface->AddCommandReadState(this->StateTable, m_base_frame, "base_frame");
-        m_arm_interface->AddCommandReadState(this->StateTable, m_measured_cv, "measured_cv");
-        m_arm_interface->AddCommandReadState(this->StateTable, m_body_measured_cf, "body/measured_cf");
-        m_arm_interface->AddCommandReadState(this->StateTable, m_body_jacobian, "body/jacobian");
-        m_arm_interface->AddCommandReadState(this->StateTable, m_spatial_measured_cf, "spatial/measured_cf");
-        m_arm_interface->AddCommandReadState(this->StateTable, m_spatial_jacobian, "spatial/jacobian");
         m_arm_interface->AddCommandReadState(this->mStateTableState,
                                              m_operating_state, "operating_state");
+        m_deadline.AddToInterface(this->StateTable, m_arm_interface);
+        m_recorder->AddToInterface(this->StateTable, m_arm_interface);
+        m_arm_interface->AddCommandReadState(this->mStateTableGUI,
+                                             m_gui_snapshot, "gui/snapshot");
         // Set
         m_arm_interface->AddCommandWrite(&mtsIntuitiveResearchKitArm::set_base_frame,
                                          this, "set_base_frame");
@@ -402,6 +437,8 @@ void mtsIntuitiveResearchKitArm::Init(void)
         m_arm_interface->AddEventWrite(state_events.desired_state, "desired_state", std::string(""));
         m_arm_interface->AddEventWrite(state_events.current_state, "current_state", std::string(""));
         m_arm_interface->AddEventWrite(state_events.operating_state, "operating_state", prmOperatingState());
+        // deadline monitor freeze, tele-operation has to re-align on recovery
+        m_arm_interface->AddEventWrite(state_events.frozen, "frozen", false);
 
         // Stats
         m_arm_interface->AddCommandReadState(StateTable, StateTable.PeriodStats,
@@ -531,6 +568,9 @@ void mtsIntuitiveResearchKitArm::ResizeKinematicsData(void)
     mEffortJointSet.ForceTorque().SetAll(0.0);
     mEffortJoint.SetSize(NumberOfJointsKinematics());
     mEffortJoint.SetAll(0.0);
+    // kinematic chain or tool might have changed
+    m_measured_kinematics.Reset();
+    m_setpoint_kinematics.Reset();
 }
 
 void mtsIntuitiveResearchKitArm::Configure(const std::string & filename)
@@ -615,6 +655,55 @@ void mtsIntuitiveResearchKitArm::Configure(const std::string & filename)
             m_re_home = jsonAlwaysHome.asBool();
         }
 
+        // signals without history and history depth, unless set by console
+        const Json::Value jsonStateTable = jsonConfig["state-table"];
+        if (!jsonStateTable.isNull() && !m_state_table_overridden) {
+            const Json::Value jsonHistory = jsonStateTable["history"];
+            if (!jsonHistory.isNull()) {
+                m_state_table_history = jsonHistory.asUInt();
+            }
+            const Json::Value jsonLatest = jsonStateTable["latest"];
+            for (unsigned int index = 0; index < jsonLatest.size(); ++index) {
+                m_state_table_latest.push_back(jsonLatest[index].asString());
+            }
+        }
+
+        // optional cycle duration budget
+        const Json::Value jsonDeadline = jsonConfig["deadline"];
+        if (!jsonDeadline.isNull()) {
+            std::string errorMessage;
+            if (!m_deadline.ConfigureJSON(jsonDeadline, errorMessage)) {
+                CMN_LOG_CLASS_INIT_ERROR << "Configure " << this->GetName()
+                                         << ": \"deadline\", " << errorMessage << std::endl;
+                exit(EXIT_FAILURE);
+            }
+        }
+
+        // optional high rate recording
+        const Json::Value jsonRecorder = jsonConfig["recorder"];
+        if (!jsonRecorder.isNull() && !m_recorder_configured) {
+            std::string errorMessage;
+            if (!m_recorder->ConfigureJSON(jsonRecorder, errorMessage)) {
+                CMN_LOG_CLASS_INIT_ERROR << "Configure " << this->GetName()
+                                         << ": \"recorder\", " << errorMessage << std::endl;
+                exit(EXIT_FAILURE);
+            }
+        }
+
+        // optional state publisher for local processes
+        const Json::Value jsonPublisher = jsonConfig["shared-memory"];
+        if (!jsonPublisher.isNull() && !m_publisher->Running()) {
+            std::string errorMessage;
+            if (!m_publisher->ConfigureJSON(jsonPublisher, errorMessage)) {
+                CMN_LOG_CLASS_INIT_ERROR << "Configure " << this->GetName()
+                                         << ": \"shared-memory\", " << errorMessage << std::endl;
+                exit(EXIT_FAILURE);
+            }
+        }
+
+        ConfigureStateTables();
+        ConfigureRecorder();
+
     } catch (std::exception & e) {
         CMN_LOG_CLASS_INIT_ERROR << "Configure " << this->GetName() << ": parsing file \""
                                  << filename << "\", got error: " << e.what() << std::endl;
@@ -626,6 +715,124 @@ void mtsIntuitiveResearchKitArm::Configure(const std::string & filename)
     }
 }
 
+void mtsIntuitiveResearchKitArm::set_state_table(const size_t history,
+                                                 const std::vector<std::string> & latest)
+{
+    m_state_table_history = history;
+    m_state_table_latest = latest;
+    m_state_table_overridden = true;
+}
+
+mtsStateTable & mtsIntuitiveResearchKitArm::StateTableFor(const std::string & commandName)
+{
+    if (std::find(m_state_table_latest.begin(), m_state_table_latest.end(), commandName)
+        != m_state_table_latest.end()) {
+        return mStateTableLatest;
+    }
+    return this->StateTable;
+}
+
+void mtsIntuitiveResearchKitArm::ConfigureStateTables(void)
+{
+    if (m_state_table_configured) {
+        return;
+    }
+    m_state_table_configured = true;
+
+    // check names before adding anything
+    const std::vector<std::string> signals
+        = {"measured_js", "setpoint_js", "local/measured_cp", "local/setpoint_cp",
+           "measured_cp", "setpoint_cp", "base_frame", "measured_cv",
+           "body/measured_cf", "body/jacobian", "spatial/measured_cf", "spatial/jacobian"};
+    for (const auto & name : m_state_table_latest) {
+        if (std::find(signals.begin(), signals.end(), name) == signals.end()) {
+            std::stringstream message;
+            for (const auto & signal : signals) {
+                message << " " << signal;
+            }
+            CMN_LOG_CLASS_INIT_ERROR << "ConfigureStateTables " << this->GetName()
+                                     << ": \"" << name << "\" can't be used in \"state-table\" \"latest\", must be one of:"
+                                     << message.str() << std::endl;
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    // history depth
+    if (m_state_table_history > 0) {
+        if (m_state_table_history < mtsIntuitiveResearchKit::StateTableLatestSize) {
+            CMN_LOG_CLASS_INIT_ERROR << "ConfigureStateTables " << this->GetName()
+                                     << ": \"history\" must be at least "
+                                     << mtsIntuitiveResearchKit::StateTableLatestSize << ", found "
+                                     << m_state_table_history << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        this->StateTable.SetSize(m_state_table_history);
+    }
+
+    // data name, state table and read command
+    StateTableFor("measured_js").AddData(m_kin_measured_js, "kin/measured_js");
+    StateTableFor("setpoint_js").AddData(m_kin_setpoint_js, "kin/setpoint_js");
+    StateTableFor("local/measured_cp").AddData(m_local_measured_cp, "local/measured_cp");
+    StateTableFor("local/setpoint_cp").AddData(m_local_setpoint_cp, "local/setpoint_cp");
+    StateTableFor("measured_cp").AddData(m_measured_cp, "measured_cp");
+    StateTableFor("setpoint_cp").AddData(m_setpoint_cp, "setpoint_cp");
+    StateTableFor("base_frame").AddData(m_base_frame, "base_frame");
+    StateTableFor("measured_cv").AddData(m_measured_cv, "measured_cv");
+    StateTableFor("body/measured_cf").AddData(m_body_measured_cf, "body/measured_cf");
+    StateTableFor("body/jacobian").AddData(m_body_jacobian, "body_jacobian");
+    StateTableFor("spatial/measured_cf").AddData(m_spatial_measured_cf, "spatial/measured_cf");
+    StateTableFor("spatial/jacobian").AddData(m_spatial_jacobian, "spatial_jacobian");
+
+    if (m_arm_interface) {
+        m_arm_interface->AddCommandReadState(StateTableFor("measured_js"), m_kin_measured_js, "measured_js");
+        m_arm_interface->AddCommandReadState(StateTableFor("setpoint_js"), m_kin_setpoint_js, "setpoint_js");
+        m_arm_interface->AddCommandReadState(StateTableFor("local/measured_cp"), m_local_measured_cp, "local/measured_cp");
+        m_arm_interface->AddCommandReadState(StateTableFor("local/setpoint_cp"), m_local_setpoint_cp, "local/setpoint_cp");
+        m_arm_interface->AddCommandReadState(StateTableFor("measured_cp"), m_measured_cp, "measured_cp");
+        m_arm_interface->AddCommandReadState(StateTableFor("setpoint_cp"), m_setpoint_cp, "setpoint_cp");
+        m_arm_interface->AddCommandReadState(StateTableFor("base_frame"), m_base_frame, "base_frame");
+        m_arm_interface->AddCommandReadState(StateTableFor("measured_cv"), m_measured_cv, "measured_cv");
+        m_arm_interface->AddCommandReadState(StateTableFor("body/measured_cf"), m_body_measured_cf, "body/measured_cf");
+        m_arm_interface->AddCommandReadState(StateTableFor("body/jacobian"), m_body_jacobian, "body/jacobian");
+        m_arm_interface->AddCommandReadState(StateTableFor("spatial/measured_cf"), m_spatial_measured_cf, "spatial/measured_cf");
+        m_arm_interface->AddCommandReadState(StateTableFor("spatial/jacobian"), m_spatial_jacobian, "spatial/jacobian");
+    }
+
+    if (!m_state_table_latest.empty()) {
+        CMN_LOG_CLASS_INIT_VERBOSE << "ConfigureStateTables: " << this->GetName() << ", "
+                                   << m_state_table_latest.size() << " signal(s) without history" << std::endl;
+    }
+}
+
+void mtsIntuitiveResearchKitArm::ConfigureRecorder(void)
+{
+    if (!m_recorder->Enabled() || m_recorder_configured) {
+        return;
+    }
+    m_recorder_configured = true;
+
+    // PSM number of kinematic joints depends on the tool, use largest
+    m_recorder_joints = std::max(NumberOfJoints(), NumberOfJointsKinematics());
+    // signals, order must match Record
+    m_recorder_js[0] = m_recorder->AddSignal("measured_js", 3 * m_recorder_joints);
+    m_recorder_js[1] = m_recorder->AddSignal("setpoint_js", 3 * m_recorder_joints);
+    m_recorder_js[2] = m_recorder->AddSignal("pid/measured_js", 3 * NumberOfJoints());
+    m_recorder_js[3] = m_recorder->AddSignal("pid/setpoint_js", 3 * NumberOfJoints());
+    m_recorder_measured_cp = m_recorder->AddSignal("measured_cp", 12);
+    m_recorder_setpoint_cp = m_recorder->AddSignal("setpoint_cp", 12);
+    m_recorder_measured_cv = m_recorder->AddSignal("measured_cv", 6);
+    m_recorder_body_measured_cf = m_recorder->AddSignal("body/measured_cf", 6);
+    m_recorder_servo_jf = m_recorder->AddSignal("servo_jf", NumberOfJoints());
+    m_recorder_cycle_duration = m_recorder->AddSignal("cycle_duration", 1);
+
+    std::string errorMessage;
+    if (!m_recorder->CheckSignals(errorMessage)) {
+        CMN_LOG_CLASS_INIT_ERROR << "ConfigureRecorder " << this->GetName()
+                                 << ": \"recorder\", " << errorMessage << std::endl;
+        exit(EXIT_FAILURE);
+    }
+}
+
 void mtsIntuitiveResearchKitArm::ConfigureDH(const Json::Value & jsonConfig,
                                              const std::string & filename)
 {
@@ -717,28 +924,231 @@ void mtsIntuitiveResearchKitArm::ConfigureDH(const std::string & filename)
 
 void mtsIntuitiveResearchKitArm::Startup(void)
 {
+    m_messages->Start();
+    if (m_recorder->Enabled() && !m_recorder->Start(this->GetPeriodicity())) {
+        CMN_LOG_CLASS_INIT_ERROR << GetName() << ": Startup, failed to start recorder" << std::endl;
+    }
+    if (m_publisher->Enabled() && !m_publisher->Start(this->GetPeriodicity())) {
+        CMN_LOG_CLASS_INIT_ERROR << GetName() << ": Startup, failed to start shared memory publisher" << std::endl;
+    }
     SetDesiredState("DISABLED");
+    m_effort_stage.used = m_effort_stage.servo_jf_model.IsValid();
+    if (m_effort_stage.used) {
+        CMN_LOG_CLASS_INIT_VERBOSE << GetName() << ": Startup, using effort stage" << std::endl;
+    }
     trajectory_j_set_ratio(mtsIntuitiveResearchKit::JointTrajectory::ratio);
+
+    // number of periods to skip when idle
+    const double period = this->GetPeriodicity();
+    if ((period > 0.0) && (m_idle_period > period)) {
+        m_idle_skip = static_cast<size_t>(m_idle_period / period + 0.5) - 1;
+        CMN_LOG_CLASS_INIT_VERBOSE << GetName() << ": Startup, running every "
+                                   << m_idle_skip + 1 << " period(s) when idle" << std::endl;
+    } else {
+        m_idle_skip = 0;
+    }
+    m_idle_counter = 0;
 }
 
 void mtsIntuitiveResearchKitArm::Run(void)
 {
+    const double start = osaGetTime();
     // collect data from required interfaces
     ProcessQueuedEvents();
-    try {
-        mArmState.Run();
-    } catch (std::exception & e) {
-        m_arm_interface->SendError(this->GetName() + ": in state " + mArmState.CurrentState()
-                                   + ", caught exception \"" + e.what() + "\"");
-        SetDesiredState("DISABLED");
+    // when idle, skip reads and state machine for a few periods.
+    // commands are still processed every period so the arm resumes
+    // on the next period
+    if (IsIdle() && (m_idle_counter < m_idle_skip)) {
+        ++m_idle_counter;
+    } else {
+        m_idle_counter = 0;
+        try {
+            mArmState.Run();
+        } catch (std::exception & e) {
+            m_arm_interface->SendError(this->GetName() + ": in state " + mArmState.CurrentState()
+                                       + ", caught exception \"" + e.what() + "\"");
+            SetDesiredState("DISABLED");
+        }
+        // cycle duration, doesn't include components using ExecIn
+        const double duration = osaGetTime() - start;
+        if (m_deadline.Update(duration)) {
+            DeadlineLevelChanged();
+        }
+        if (m_recorder->Running()) {
+            Record(duration);
+        }
+        if (m_publisher->Running()) {
+            Publish();
+        }
+        // low rate copy for GUI
+        ++m_gui_snapshot_counter;
+        if (m_gui_snapshot_counter >= m_gui_snapshot_decimation) {
+            m_gui_snapshot_counter = 0;
+            UpdateGUISnapshot();
+        }
+        // messages from control loop, if any
+        m_messages->Forward(m_arm_interface);
     }
     // trigger ExecOut event
     RunEvent();
     ProcessQueuedCommands();
 }
 
+void mtsIntuitiveResearchKitArm::UpdateGUISnapshot(void)
+{
+    mStateTableGUI.Start();
+    m_gui_snapshot.StateJoint() = m_kin_measured_js;
+    m_gui_snapshot.Position() = m_measured_cp;
+    m_gui_snapshot.Wrench() = m_body_measured_cf;
+    m_gui_snapshot.PeriodStatistics() = StateTable.PeriodStats;
+    mStateTableGUI.Advance();
+}
+
+void mtsIntuitiveResearchKitArm::DeadlineLevelChanged(void)
+{
+    const mtsDeadlineMonitor::Level level = m_deadline.CurrentLevel();
+    switch (level) {
+    case mtsDeadlineMonitor::NOMINAL:
+        m_messages->Push(m_message_codes.deadline_recovered, 0.0, 0.0,
+                         mtsDeadlineMonitor::LevelName(m_deadline.PreviousLevel()));
+        if (m_deadline.PreviousLevel() >= mtsDeadlineMonitor::FREEZE) {
+            state_events.frozen(false);
+        }
+        break;
+    case mtsDeadlineMonitor::DISABLE:
+        // error event, the console disables tele-operation
+        m_messages->Push(m_message_codes.deadline_disable,
+                         m_deadline.Budget() / cmn_ms,
+                         static_cast<double>(m_deadline.ConsecutiveOverruns()),
+                         mtsDeadlineMonitor::LevelName(level));
+        break;
+    default:
+        m_messages->Push(m_message_codes.deadline_degraded,
+                         m_deadline.Budget() / cmn_ms,
+                         static_cast<double>(m_deadline.ConsecutiveOverruns()),
+                         mtsDeadlineMonitor::LevelName(level));
+        break;
+    }
+    // hold current joint position if the arm is controlled, motion
+    // commands are ignored while frozen (see ArmIsReady)
+    if ((level == mtsDeadlineMonitor::FREEZE)
+        && (mArmState.CurrentState() == "HOMED")
+        && (m_control_mode != mtsIntuitiveResearchKitArmTypes::UNDEFINED_MODE)) {
+        Freeze();
+    }
+    if ((level == mtsDeadlineMonitor::FREEZE)
+        && (m_deadline.PreviousLevel() < mtsDeadlineMonitor::FREEZE)) {
+        state_events.frozen(true);
+    }
+}
+
+void mtsIntuitiveResearchKitArm::Record(const double duration)
+{
+    // ring full, record dropped
+    if (!m_recorder->Begin(StateTable.GetTic())) {
+        return;
+    }
+    const prmStateJoint * states[] = {&m_kin_measured_js, &m_kin_setpoint_js,
+                                      &m_pid_measured_js, &m_pid_setpoint_js};
+    const size_t sizes[] = {m_recorder_joints, m_recorder_joints,
+                            NumberOfJoints(), NumberOfJoints()};
+    for (size_t index = 0; index < 4; ++index) {
+        if (m_recorder_js[index]) {
+            const prmStateJoint & state = *(states[index]);
+            m_recorder->Append(state.Position().Pointer(), state.Position().size(), sizes[index]);
+            m_recorder->Append(state.Velocity().Pointer(), state.Velocity().size(), sizes[index]);
+            m_recorder->Append(state.Effort().Pointer(), state.Effort().size(), sizes[index]);
+        }
+    }
+    if (m_recorder_measured_cp) {
+        m_recorder->Append(m_measured_cp.Position());
+    }
+    if (m_recorder_setpoint_cp) {
+        m_recorder->Append(m_setpoint_cp.Position());
+    }
+    if (m_recorder_measured_cv) {
+        m_recorder->Append(m_measured_cv.VelocityLinear().Pointer(), 3, 3);
+        m_recorder->Append(m_measured_cv.VelocityAngular().Pointer(), 3, 3);
+    }
+    if (m_recorder_body_measured_cf) {
+        m_recorder->Append(m_body_measured_cf.Force().Pointer(), 6, 6);
+    }
+    if (m_recorder_servo_jf) {
+        m_recorder->Append(mTorqueSetParam.ForceTorque().Pointer(),
+                           mTorqueSetParam.ForceTorque().size(), NumberOfJoints());
+    }
+    if (m_recorder_cycle_duration) {
+        m_recorder->Append(duration);
+    }
+    m_recorder->Commit();
+}
+
+void mtsIntuitiveResearchKitArm::Publish(void)
+{
+    dvrk_arm_state_record * record = m_publisher->Begin(StateTable.GetTic());
+    switch (m_operating_state.State()) {
+    case prmOperatingState::DISABLED:
+        record->operating_state = DVRK_ARM_STATE_DISABLED;
+        break;
+    case prmOperatingState::ENABLED:
+        record->operating_state = DVRK_ARM_STATE_ENABLED;
+        break;
+    case prmOperatingState::PAUSED:
+        record->operating_state = DVRK_ARM_STATE_PAUSED;
+        break;
+    case prmOperatingState::FAULT:
+        record->operating_state = DVRK_ARM_STATE_FAULT;
+        break;
+    default:
+        record->operating_state = DVRK_ARM_STATE_UNDEFINED;
+    }
+    record->is_homed = m_operating_state.IsHomed();
+    record->is_busy = m_operating_state.IsBusy();
+
+    const size_t joints = std::min(m_kin_measured_js.Position().size(),
+                                   static_cast<size_t>(DVRK_ARM_STATE_MAX_JOINTS));
+    record->number_of_joints = static_cast<uint32_t>(joints);
+    if (m_kin_measured_js.Valid()) {
+        record->valid |= DVRK_ARM_STATE_VALID_JS;
+    }
+    std::copy_n(m_kin_measured_js.Position().Pointer(), joints, record->position);
+    if (m_kin_measured_js.Velocity().size() >= joints) {
+        std::copy_n(m_kin_measured_js.Velocity().Pointer(), joints, record->velocity);
+    }
+    if (m_kin_measured_js.Effort().size() >= joints) {
+        std::copy_n(m_kin_measured_js.Effort().Pointer(), joints, record->effort);
+    }
+
+    if (m_measured_cp.Valid()) {
+        record->valid |= DVRK_ARM_STATE_VALID_CP;
+    }
+    const vctFrm4x4 & frame = m_measured_cp.Position();
+    std::copy_n(frame.Translation().Pointer(), 3, record->measured_cp);
+    for (size_t row = 0; row < 3; ++row) {
+        for (size_t column = 0; column < 3; ++column) {
+            record->measured_cp[3 + 3 * row + column] = frame.Rotation().Element(row, column);
+        }
+    }
+
+    if (m_measured_cv.Valid()) {
+        record->valid |= DVRK_ARM_STATE_VALID_CV;
+    }
+    std::copy_n(m_measured_cv.VelocityLinear().Pointer(), 3, record->measured_cv);
+    std::copy_n(m_measured_cv.VelocityAngular().Pointer(), 3, record->measured_cv + 3);
+
+    if (m_body_measured_cf.Valid()) {
+        record->valid |= DVRK_ARM_STATE_VALID_CF;
+    }
+    std::copy_n(m_body_measured_cf.Force().Pointer(), 6, record->body_measured_cf);
+
+    m_publisher->Commit();
+}
+
 void mtsIntuitiveResearchKitArm::Cleanup(void)
 {
+    m_messages->Stop();
+    m_recorder->Stop();
+    m_publisher->Stop();
     // engage brakes
     if (HasBrakes()) {
         IO.BrakeEngage();
@@ -754,6 +1164,19 @@ void mtsIntuitiveResearchKitArm::Cleanup(void)
     CMN_LOG_CLASS_INIT_VERBOSE << GetName() << ": Cleanup" << std::endl;
 }
 
+bool mtsIntuitiveResearchKitArm::IsIdle(void)
+{
+    const std::string & state = mArmState.CurrentState();
+    if (state != mArmState.DesiredState()) {
+        return false;
+    }
+    if ((state == "DISABLED") || (state == "FAULT")) {
+        return true;
+    }
+    return ((state == "HOMED")
+            && (m_control_mode == mtsIntuitiveResearchKitArmTypes::UNDEFINED_MODE));
+}
+
 void mtsIntuitiveResearchKitArm::set_simulated(void)
 {
     m_simulated = true;
@@ -761,32 +1184,33 @@ void mtsIntuitiveResearchKitArm::set_simulated(void)
     RemoveInterfaceRequired("RobotIO");
 }
 
+bool mtsIntuitiveResearchKitArm::GetAmpStatus(void)
+{
+    IO.GetActuatorAmpStatus(m_actuator_amp_status);
+    if (HasBrakes()) {
+        IO.GetBrakeAmpStatus(m_brake_amp_status);
+        return m_actuator_amp_status.All() && m_brake_amp_status.All();
+    }
+    return m_actuator_amp_status.All();
+}
+
 void mtsIntuitiveResearchKitArm::GetRobotData(void)
 {
     // check that the robot still has power
-    if (m_powered && !m_simulated) {
-        vctBoolVec actuatorAmplifiersStatus(NumberOfJoints());
-        IO.GetActuatorAmpStatus(actuatorAmplifiersStatus);
-        vctBoolVec brakeAmplifiersStatus(NumberOfBrakes());
-        if (HasBrakes()) {
-            IO.GetBrakeAmpStatus(brakeAmplifiersStatus);
-        }
-        if (!(actuatorAmplifiersStatus.All())) {
-            m_powered = false;
+    if (m_powered && !m_simulated
+        && !GetAmpStatus()) {
+        m_powered = false;
+        if (!(m_actuator_amp_status.All())) {
             CMN_LOG_CLASS_RUN_ERROR << GetName() << ": GetRobotData:\n - Actuator amp status: "
-                                    << actuatorAmplifiersStatus << std::endl;
+                                    << m_actuator_amp_status << std::endl;
             m_arm_interface->SendError(this->GetName() + ": detected power loss (actuators)");
-            SetDesiredState("FAULT");
-            return;
-        }
-        if (!(brakeAmplifiersStatus.All())) {
-            m_powered = false;
+        } else {
             CMN_LOG_CLASS_RUN_ERROR << GetName() << ": GetRobotData:\n - Brake amp status: "
-                                    << brakeAmplifiersStatus << std::endl;
+                                    << m_brake_amp_status << std::endl;
             m_arm_interface->SendError(this->GetName() + ": detected power loss (brakes)");
-            SetDesiredState("FAULT");
-            return;
         }
+        SetDesiredState("FAULT");
+        return;
     }
 
     // we can start reporting some joint values after the robot is powered
@@ -797,8 +1221,7 @@ void mtsIntuitiveResearchKitArm::GetRobotData(void)
         if (executionResult.IsOK()) {
             m_pid_measured_js.SetValid(true);
         } else {
-            CMN_LOG_CLASS_RUN_ERROR << GetName() << ": GetRobotData: call to PID.measured_js failed \""
-                                    << executionResult << "\"" << std::endl;
+            m_messages->Push(m_message_codes.measured_js_failed);
             m_pid_measured_js.SetValid(false);
         }
 
@@ -807,8 +1230,7 @@ void mtsIntuitiveResearchKitArm::GetRobotData(void)
         if (executionResult.IsOK()) {
             m_pid_setpoint_js.SetValid(true);
         } else {
-            CMN_LOG_CLASS_RUN_ERROR << GetName() << ": GetRobotData: call to PID.setpoint_js failed \""
-                                    << executionResult << "\"" << std::endl;
+            m_messages->Push(m_message_codes.setpoint_js_failed);
             m_pid_setpoint_js.SetValid(false);
         }
 
@@ -832,7 +1254,7 @@ void mtsIntuitiveResearchKitArm::GetRobotData(void)
     if (IsCartesianReady()) {
         CMN_ASSERT(IsJointReady());
         // update cartesian position
-        m_local_measured_cp_frame = Manipulator->ForwardKinematics(m_kin_measured_js.Position());
+        m_local_measured_cp_frame = m_measured_kinematics.ForwardKinematics(*Manipulator, m_kin_measured_js.Position());
         m_measured_cp_frame = m_base_frame * m_local_measured_cp_frame;
         // normalize
         m_local_measured_cp_frame.Rotation().NormalizedSelf();
@@ -846,57 +1268,66 @@ void mtsIntuitiveResearchKitArm::GetRobotData(void)
         m_measured_cp.SetValid(m_base_frame_valid);
 
         // update jacobians
-        Manipulator->JacobianSpatial(m_kin_measured_js.Position(), m_spatial_jacobian);
-        Manipulator->JacobianBody(m_kin_measured_js.Position(), m_body_jacobian);
-
-        // update cartesian velocity using the jacobian and joint
-        // velocities.
-        vctDoubleVec cartesianVelocity(6);
-        cartesianVelocity.ProductOf(m_body_jacobian, m_kin_measured_js.Velocity());
-        vct3 relative, absolute;
-        // linear
-        relative.Assign(cartesianVelocity.Ref(3, 0));
-        m_measured_cp_frame.Rotation().ApplyTo(relative, absolute);
-        m_measured_cv.SetVelocityLinear(absolute);
-        // angular
-        relative.Assign(cartesianVelocity.Ref(3, 3));
-        m_measured_cp_frame.Rotation().ApplyTo(relative, absolute);
-        m_measured_cv.SetVelocityAngular(absolute);
-        // valid/timestamp
-        m_measured_cv.SetValid(true);
-        m_measured_cv.SetTimestamp(m_kin_measured_js.Timestamp());
-
-        // update wrench based on measured joint current efforts
-        m_body_jacobian_transpose.Assign(m_body_jacobian.Transpose());
-        nmrPInverse(m_body_jacobian_transpose, mJacobianPInverseData);
-        vctDoubleVec wrench(6);
-        wrench.ProductOf(mJacobianPInverseData.PInverse(), m_kin_measured_js.Effort());
-        if (m_body_cf_orientation_absolute) {
-            // forces
-            relative.Assign(wrench.Ref(3, 0));
+        m_measured_kinematics.JacobianSpatial(*Manipulator, m_kin_measured_js.Position(), m_spatial_jacobian);
+        m_measured_kinematics.JacobianBody(*Manipulator, m_kin_measured_js.Position(), m_body_jacobian);
+
+        // cartesian velocities and wrenches are only reported, skip
+        // them if the cycle duration is over budget
+        if (m_deadline.SkipOutputs()) {
+            m_body_jacobian_transpose.Assign(m_body_jacobian.Transpose());
+            m_measured_cv.SetValid(false);
+            m_body_measured_cf.SetValid(false);
+            m_spatial_measured_cf.SetValid(false);
+        } else {
+            // update cartesian velocity using the jacobian and joint
+            // velocities.
+            vctDoubleVec cartesianVelocity(6);
+            cartesianVelocity.ProductOf(m_body_jacobian, m_kin_measured_js.Velocity());
+            vct3 relative, absolute;
+            // linear
+            relative.Assign(cartesianVelocity.Ref(3, 0));
             m_measured_cp_frame.Rotation().ApplyTo(relative, absolute);
-            m_body_measured_cf.Force().Ref<3>(0).Assign(absolute);
-            // torques
-            relative.Assign(wrench.Ref(3, 3));
+            m_measured_cv.SetVelocityLinear(absolute);
+            // angular
+            relative.Assign(cartesianVelocity.Ref(3, 3));
             m_measured_cp_frame.Rotation().ApplyTo(relative, absolute);
-            m_body_measured_cf.Force().Ref<3>(3).Assign(absolute);
-        } else {
-            m_body_measured_cf.Force().Assign(wrench);
+            m_measured_cv.SetVelocityAngular(absolute);
+            // valid/timestamp
+            m_measured_cv.SetValid(true);
+            m_measured_cv.SetTimestamp(m_kin_measured_js.Timestamp());
+
+            // update wrench based on measured joint current efforts
+            m_body_jacobian_transpose.Assign(m_body_jacobian.Transpose());
+            nmrPInverse(m_body_jacobian_transpose, mJacobianPInverseData);
+            vctDoubleVec wrench(6);
+            wrench.ProductOf(mJacobianPInverseData.PInverse(), m_kin_measured_js.Effort());
+            if (m_body_cf_orientation_absolute) {
+                // forces
+                relative.Assign(wrench.Ref(3, 0));
+                m_measured_cp_frame.Rotation().ApplyTo(relative, absolute);
+                m_body_measured_cf.Force().Ref<3>(0).Assign(absolute);
+                // torques
+                relative.Assign(wrench.Ref(3, 3));
+                m_measured_cp_frame.Rotation().ApplyTo(relative, absolute);
+                m_body_measured_cf.Force().Ref<3>(3).Assign(absolute);
+            } else {
+                m_body_measured_cf.Force().Assign(wrench);
+            }
+            // valid/timestamp
+            m_body_measured_cf.SetValid(true);
+            m_body_measured_cf.SetTimestamp(m_kin_measured_js.Timestamp());
+
+            m_spatial_jacobian_transpose.Assign(m_spatial_jacobian.Transpose());
+            nmrPInverse(m_spatial_jacobian_transpose, mJacobianPInverseData);
+            wrench.ProductOf(mJacobianPInverseData.PInverse(), m_kin_measured_js.Effort());
+            m_spatial_measured_cf.Force().Assign(wrench);
+            // valid/timestamp
+            m_spatial_measured_cf.SetValid(true);
+            m_spatial_measured_cf.SetTimestamp(m_kin_measured_js.Timestamp());
         }
-        // valid/timestamp
-        m_body_measured_cf.SetValid(true);
-        m_body_measured_cf.SetTimestamp(m_kin_measured_js.Timestamp());
-
-        m_spatial_jacobian_transpose.Assign(m_spatial_jacobian.Transpose());
-        nmrPInverse(m_spatial_jacobian_transpose, mJacobianPInverseData);
-        wrench.ProductOf(mJacobianPInverseData.PInverse(), m_kin_measured_js.Effort());
-        m_spatial_measured_cf.Force().Assign(wrench);
-        // valid/timestamp
-        m_spatial_measured_cf.SetValid(true);
-        m_spatial_measured_cf.SetTimestamp(m_kin_measured_js.Timestamp());
 
         // update cartesian position desired based on joint desired
-        m_local_setpoint_cp_frame = Manipulator->ForwardKinematics(m_kin_setpoint_js.Position());
+        m_local_setpoint_cp_frame = m_setpoint_kinematics.ForwardKinematics(*Manipulator, m_kin_setpoint_js.Position());
         m_setpoint_cp_frame = m_base_frame * m_local_setpoint_cp_frame;
         // normalize
         m_local_setpoint_cp_frame.Rotation().NormalizedSelf();
@@ -1064,13 +1495,7 @@ void mtsIntuitiveResearchKitArm::TransitionPowering(void)
     const double currentTime = this->StateTable.GetTic();
 
     // check power status
-    vctBoolVec actuatorAmplifiersStatus(NumberOfJoints());
-    IO.GetActuatorAmpStatus(actuatorAmplifiersStatus);
-    vctBoolVec brakeAmplifiersStatus(NumberOfBrakes());
-    if (HasBrakes()) {
-        IO.GetBrakeAmpStatus(brakeAmplifiersStatus);
-    }
-    if (actuatorAmplifiersStatus.All() && brakeAmplifiersStatus.All()) {
+    if (GetAmpStatus()) {
         m_arm_interface->SendStatus(this->GetName() + ": power on");
         mArmState.SetCurrentState("ENABLED");
     } else {
@@ -1388,13 +1813,15 @@ void mtsIntuitiveResearchKitArm::control_servo_cp(void)
             // finally send new joint values
             servo_jp_internal(jointSet);
         } else {
-            // shows robManipulator error if used
+            // shows robManipulator error if used, the text is truncated
             if (this->Manipulator) {
-                m_arm_interface->SendError(this->GetName()
-                                           + ": unable to solve inverse kinematics ("
-                                           + this->Manipulator->LastError() + ")");
+                const std::string & error = this->Manipulator->LastError();
+                char text[64] = " (";
+                strncat(text, error.c_str(), sizeof(text) - 4);
+                strcat(text, ")");
+                m_messages->Push(m_message_codes.inverse_kinematics_failed, 0.0, 0.0, text);
             } else {
-                m_arm_interface->SendError(this->GetName() + ": unable to solve inverse kinematics");
+                m_messages->Push(m_message_codes.inverse_kinematics_failed);
             }
         }
         // reset flag
@@ -1409,7 +1836,8 @@ void mtsIntuitiveResearchKitArm::control_move_cp(void)
 }
 
 bool mtsIntuitiveResearchKitArm::ArmIsReady(const std::string & methodName,
-                                            const mtsIntuitiveResearchKitArmTypes::ControlSpace space)
+                                            const mtsIntuitiveResearchKitArmTypes::ControlSpace space,
+                                            const bool allowFrozen)
 {
     // reset counter if ready
     if (m_operating_state.State() == prmOperatingState::ENABLED) {
@@ -1419,6 +1847,22 @@ bool mtsIntuitiveResearchKitArm::ArmIsReady(const std::string & methodName,
                 && IsCartesianReady())) {
             mArmNotReadyCounter = 0;
             mArmNotReadyTimeLastMessage = 0.0;
+            // deadline monitor holds current position, ignore commands
+            if (m_deadline.Frozen() && !allowFrozen) {
+                if ((StateTable.GetTic() - mArmFrozenTimeLastMessage) > 2.0 * cmn_s) {
+                    std::stringstream message;
+                    message << this->GetName() << ": " << methodName
+                            << ", arm frozen by deadline monitor, command ignored";
+                    if (mArmFrozenCounter > 1) {
+                        message << " (" << mArmFrozenCounter << " commands)";
+                    }
+                    m_arm_interface->SendWarning(message.str());
+                    mArmFrozenTimeLastMessage = StateTable.GetTic();
+                    mArmFrozenCounter = 0;
+                }
+                mArmFrozenCounter++;
+                return false;
+            }
             return true;
         }
     }
@@ -1541,6 +1985,12 @@ void mtsIntuitiveResearchKitArm::SetControlSpaceAndMode(const mtsIntuitiveResear
 
     if (mode != m_control_mode) {
 
+        // effort stage only used in effort mode
+        if (m_effort_stage.used
+            && (mode != mtsIntuitiveResearchKitArmTypes::EFFORT_MODE)) {
+            effort_stage_disable();
+        }
+
         if ((m_control_mode == mtsIntuitiveResearchKitArmTypes::TRAJECTORY_MODE)
             &&  m_trajectory_j.is_active) {
             control_move_jp_on_stop(false); // move was active and interrupted so assume goal not reached
@@ -1715,6 +2165,9 @@ void mtsIntuitiveResearchKitArm::control_servo_cf(void)
                                                   m_cf_set,
                                                   m_body_cf_orientation_absolute);
             wrench.Assign(m_cf_set.Force());
+            if (m_effort_stage.used) {
+                control_effort_stage_impedance();
+            }
         } else {
             // user provided wrench
             if (m_body_cf_orientation_absolute) {
@@ -1761,18 +2214,117 @@ void mtsIntuitiveResearchKitArm::control_servo_cf(void)
 
 void mtsIntuitiveResearchKitArm::servo_jf_internal(const vctDoubleVec & newEffort)
 {
+    // upload model to effort stage, it will send efforts to the PID
+    if (m_effort_stage.used) {
+        mtsArmEffortStageModel & model = m_effort_stage.model;
+        model.Enabled() = true;
+        model.Effort().ForceAssign(newEffort);
+        model.Position().ForceAssign(m_kin_measured_js.Position());
+        model.Velocity().ForceAssign(m_kin_measured_js.Velocity());
+        if (!m_effort_stage.has_derivatives) {
+            model.Stiffness().SetSize(0, 0);
+            model.Damping().SetSize(0, 0);
+        }
+        m_effort_stage.has_derivatives = false;
+        m_effort_stage.servo_jf_model(model);
+        return;
+    }
     // convert to cisstParameterTypes
     mTorqueSetParam.SetForceTorque(newEffort);
     mTorqueSetParam.SetTimestamp(StateTable.GetTic());
     PID.servo_jf(mTorqueSetParam);
 }
 
+void mtsIntuitiveResearchKitArm::effort_stage_disable(void)
+{
+    m_effort_stage.model.Enabled() = false;
+    m_effort_stage.has_derivatives = false;
+    m_effort_stage.servo_jf_model(m_effort_stage.model);
+}
+
+void mtsIntuitiveResearchKitArm::control_effort_stage_impedance(void)
+{
+    // numerical derivatives of the impedance wrench with respect to
+    // small displacements in body frame and cartesian velocities.
+    // derivative of jacobian is ignored.
+    const double step = mtsIntuitiveResearchKit::EffortStage::DerivativeStep;
+    const size_t nbJoints = NumberOfJointsKinematics();
+    vctDoubleVec reference(6);
+    reference.Assign(m_cf_set.Force());
+    prmPositionCartesianGet pose(m_measured_cp);
+    prmVelocityCartesianGet twist;
+    prmForceCartesianSet wrench;
+    m_effort_stage.cartesian_stiffness.SetSize(6, 6);
+    m_effort_stage.cartesian_damping.SetSize(6, 6);
+
+    for (size_t axis = 0; axis < 6; ++axis) {
+        vct3 direction(0.0);
+        direction.at(axis % 3) = 1.0;
+        // stiffness
+        vctFrm3 displacement;
+        if (axis < 3) {
+            displacement.Translation().Assign(step * direction);
+        } else {
+            displacement.Rotation().From(vctAxAnRot3(direction, step));
+        }
+        pose.Position() = m_measured_cp.Position() * displacement;
+        mCartesianImpedanceController->Update(pose, m_measured_cv,
+                                              wrench, m_body_cf_orientation_absolute);
+        for (size_t row = 0; row < 6; ++row) {
+            m_effort_stage.cartesian_stiffness.at(row, axis) = (wrench.Force().at(row) - reference.at(row)) / step;
+        }
+        // damping
+        twist = m_measured_cv;
+        if (axis < 3) {
+            twist.VelocityLinear().at(axis) += step;
+        } else {
+            twist.VelocityAngular().at(axis - 3) += step;
+        }
+        mCartesianImpedanceController->Update(m_measured_cp, twist,
+                                              wrench, m_body_cf_orientation_absolute);
+        for (size_t row = 0; row < 6; ++row) {
+            m_effort_stage.cartesian_damping.at(row, axis) = (wrench.Force().at(row) - reference.at(row)) / step;
+        }
+    }
+
+    // joint stiffness, J^T * Kx * J
+    m_effort_stage.product.SetSize(6, nbJoints);
+    m_effort_stage.product.ProductOf(m_effort_stage.cartesian_stiffness, m_body_jacobian);
+    m_effort_stage.model.Stiffness().SetSize(nbJoints, nbJoints);
+    m_effort_stage.model.Stiffness().ProductOf(m_body_jacobian_transpose, m_effort_stage.product);
+
+    // joint damping, measured_cv is body velocity with absolute orientation
+    m_effort_stage.rotated_jacobian.SetSize(6, nbJoints);
+    vct3 relative, absolute;
+    for (size_t joint = 0; joint < nbJoints; ++joint) {
+        for (size_t offset = 0; offset < 6; offset += 3) {
+            for (size_t index = 0; index < 3; ++index) {
+                relative.at(index) = m_body_jacobian.at(offset + index, joint);
+            }
+            m_measured_cp_frame.Rotation().ApplyTo(relative, absolute);
+            for (size_t index = 0; index < 3; ++index) {
+                m_effort_stage.rotated_jacobian.at(offset + index, joint) = absolute.at(index);
+            }
+        }
+    }
+    m_effort_stage.product.ProductOf(m_effort_stage.cartesian_damping, m_effort_stage.rotated_jacobian);
+    m_effort_stage.model.Damping().SetSize(nbJoints, nbJoints);
+    m_effort_stage.model.Damping().ProductOf(m_body_jacobian_transpose, m_effort_stage.product);
+
+    m_effort_stage.has_derivatives = true;
+}
+
+void mtsIntuitiveResearchKitArm::feed_forward_internal(void)
+{
+    update_feed_forward(m_feed_forward_jf.ForceTorque());
+    PID.feed_forward_jf(m_feed_forward_jf);
+}
+
 void mtsIntuitiveResearchKitArm::servo_jp_internal(const vctDoubleVec & newPosition)
 {
     // feed forward
     if (use_feed_forward()) {
-        update_feed_forward(m_feed_forward_jf.ForceTorque());
-        PID.feed_forward_jf(m_feed_forward_jf);
+        feed_forward_internal();
     }
     // position
     m_servo_jp_param.Goal().Zeros();
@@ -1783,7 +2335,7 @@ void mtsIntuitiveResearchKitArm::servo_jp_internal(const vctDoubleVec & newPosit
 
 void mtsIntuitiveResearchKitArm::Freeze(void)
 {
-    if (!ArmIsReady("Freeze", mtsIntuitiveResearchKitArmTypes::JOINT_SPACE)) {
+    if (!ArmIsReady("Freeze", mtsIntuitiveResearchKitArmTypes::JOINT_SPACE, true)) {
         return;
     }
 
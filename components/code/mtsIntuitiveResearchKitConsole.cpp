@@ -17,7 +17,9 @@ http://www.cisst.org/cisst/license.txt.
 */
 
 // system include
+#include <algorithm>
 #include <iostream>
+#include <list>
 
 // cisst
 #include <cisstCommon/cmnPath.h>
@@ -44,6 +46,11 @@ http://www.cisst.org/cisst/license.txt.
 #include <sawIntuitiveResearchKit/mtsSocketServerPSM.h>
 #include <sawIntuitiveResearchKit/mtsDaVinciHeadSensor.h>
 #include <sawIntuitiveResearchKit/mtsDaVinciEndoscopeFocus.h>
+#include <sawIntuitiveResearchKit/mtsCollisionMonitor.h>
+#include <sawIntuitiveResearchKit/mtsParallelArmExecutor.h>
+#include <sawIntuitiveResearchKit/mtsArmEffortStage.h>
+#include <sawIntuitiveResearchKit/mtsConsoleExecutor.h>
+#include <sawIntuitiveResearchKit/mtsConsoleStartup.h>
 #include <sawIntuitiveResearchKit/mtsTeleOperationPSM.h>
 #include <sawIntuitiveResearchKit/mtsTeleOperationECM.h>
 #include <sawIntuitiveResearchKit/mtsIntuitiveResearchKitConsole.h>
@@ -59,7 +66,15 @@ mtsIntuitiveResearchKitConsole::Arm::Arm(mtsIntuitiveResearchKitConsole * consol
     m_console(console),
     m_name(name),
     m_IO_component_name(ioComponentName),
+    m_arm_component_name(console->m_component_prefix + name),
+    m_arm_interface_name("Arm"),
     m_arm_period(mtsIntuitiveResearchKit::ArmPeriod),
+    m_arm_idle_period(0.0),
+    m_arm_state_table_set(false),
+    m_arm_state_table_history(0),
+    m_synchronized_with_IO(false),
+    m_parallel(false),
+    m_effort_stage(false),
     IOInterfaceRequired(0),
     PIDInterfaceRequired(0),
     ArmInterfaceRequired(0),
@@ -72,7 +87,7 @@ void mtsIntuitiveResearchKitConsole::Arm::ConfigurePID(const std::string & confi
                                                        const double & periodInSeconds)
 {
     m_PID_configuration_file = configFile;
-    m_PID_component_name = m_name + "-PID";
+    m_PID_component_name = m_console->m_component_prefix + m_name + "-PID";
 
     mtsManagerLocal * componentManager = mtsManagerLocal::GetInstance();
     mtsPID * pid = new mtsPID(m_PID_component_name,
@@ -101,6 +116,23 @@ void mtsIntuitiveResearchKitConsole::Arm::ConfigureArm(const ArmType armType,
     bool armPSMOrDerived = false;
     bool armECMOrDerived = false;
 
+    // period 0 means the arm runs right after its PID, in the IO
+    // thread.  This requires an IO so fall back on default period
+    // for simulated arms
+    double period = periodInSeconds;
+    if (periodInSeconds == 0.0) {
+        if ((m_simulation == SIMULATION_NONE)
+            && ((armType == ARM_MTM) || (armType == ARM_PSM) || (armType == ARM_ECM))) {
+            m_synchronized_with_IO = true;
+            period = mtsIntuitiveResearchKit::IOPeriod;
+        } else {
+            CMN_LOG_INIT_WARNING << "mtsIntuitiveResearchKitConsole::Arm::ConfigureArm: arm \""
+                                 << Name() << "\" period 0 is only supported for non simulated MTM, PSM and ECM, using default period"
+                                 << std::endl;
+            period = mtsIntuitiveResearchKit::ArmPeriod;
+        }
+    }
+
     mtsManagerLocal * componentManager = mtsManagerLocal::GetInstance();
     m_arm_configuration_file = kinematicsConfigFile;
     // for research kit arms, create, add to manager and connect to
@@ -108,11 +140,13 @@ void mtsIntuitiveResearchKitConsole::Arm::ConfigureArm(const ArmType armType,
     switch (armType) {
     case ARM_MTM:
         {
-            mtsIntuitiveResearchKitMTM * mtm = new mtsIntuitiveResearchKitMTM(Name(), periodInSeconds);
+            mtsIntuitiveResearchKitMTM * mtm = new mtsIntuitiveResearchKitMTM(ComponentName(), period);
             if (m_simulation == SIMULATION_KINEMATIC) {
                 mtm->set_simulated();
             }
             mtm->set_calibration_mode(m_calibration_mode);
+            mtm->set_idle_period(m_arm_idle_period);
+            SetStateTableIfNeeded(mtm);
             mtm->Configure(m_arm_configuration_file);
             SetBaseFrameIfNeeded(mtm);
             componentManager->AddComponent(mtm);
@@ -121,18 +155,21 @@ void mtsIntuitiveResearchKitConsole::Arm::ConfigureArm(const ArmType armType,
     case ARM_PSM:
         armPSMOrDerived = true;
         {
-            mtsIntuitiveResearchKitPSM * psm = new mtsIntuitiveResearchKitPSM(Name(), periodInSeconds);
+            mtsIntuitiveResearchKitPSM * psm = new mtsIntuitiveResearchKitPSM(ComponentName(), period);
             if (m_simulation == SIMULATION_KINEMATIC) {
                 psm->set_simulated();
             }
             psm->set_calibration_mode(m_calibration_mode);
+            psm->set_idle_period(m_arm_idle_period);
+            SetStateTableIfNeeded(psm);
             psm->Configure(m_arm_configuration_file);
             SetBaseFrameIfNeeded(psm);
             componentManager->AddComponent(psm);
 
             if (m_socket_server) {
-                mtsSocketServerPSM *serverPSM = new mtsSocketServerPSM(SocketComponentName(), periodInSeconds, m_IP, m_port);
+                mtsSocketServerPSM *serverPSM = new mtsSocketServerPSM(SocketComponentName(), period, m_IP, m_port);
                 serverPSM->Configure();
+                serverPSM->SetExtrapolationHorizon(m_socket_extrapolation);
                 componentManager->AddComponent(serverPSM);
                 m_console->mConnections.Add(SocketComponentName(), "PSM",
                                             ComponentName(), InterfaceName());
@@ -141,19 +178,22 @@ void mtsIntuitiveResearchKitConsole::Arm::ConfigureArm(const ArmType armType,
         break;
     case ARM_PSM_SOCKET:
         {
-            mtsSocketClientPSM * clientPSM = new mtsSocketClientPSM(Name(), periodInSeconds, m_IP, m_port);
+            mtsSocketClientPSM * clientPSM = new mtsSocketClientPSM(ComponentName(), period, m_IP, m_port);
             clientPSM->Configure();
+            clientPSM->SetExtrapolationHorizon(m_socket_extrapolation);
             componentManager->AddComponent(clientPSM);
         }
         break;
     case ARM_ECM:
         armECMOrDerived = true;
         {
-            mtsIntuitiveResearchKitECM * ecm = new mtsIntuitiveResearchKitECM(Name(), periodInSeconds);
+            mtsIntuitiveResearchKitECM * ecm = new mtsIntuitiveResearchKitECM(ComponentName(), period);
             if (m_simulation == SIMULATION_KINEMATIC) {
                 ecm->set_simulated();
             }
             ecm->set_calibration_mode(m_calibration_mode);
+            ecm->set_idle_period(m_arm_idle_period);
+            SetStateTableIfNeeded(ecm);
             ecm->Configure(m_arm_configuration_file);
             SetBaseFrameIfNeeded(ecm);
             componentManager->AddComponent(ecm);
@@ -161,31 +201,31 @@ void mtsIntuitiveResearchKitConsole::Arm::ConfigureArm(const ArmType armType,
         break;
     case ARM_SUJ:
         {
-            mtsIntuitiveResearchKitSUJ * suj = new mtsIntuitiveResearchKitSUJ(Name(), periodInSeconds);
+            mtsIntuitiveResearchKitSUJ * suj = new mtsIntuitiveResearchKitSUJ(ComponentName(), period);
             if (m_simulation == SIMULATION_KINEMATIC) {
                 suj->set_simulated();
             } else if (m_simulation == SIMULATION_NONE) {
-                m_console->mConnections.Add(Name(), "RobotIO",
+                m_console->mConnections.Add(ComponentName(), "RobotIO",
                                             IOComponentName(), Name());
-                m_console->mConnections.Add(Name(), "NoMuxReset",
+                m_console->mConnections.Add(ComponentName(), "NoMuxReset",
                                             IOComponentName(), "NoMuxReset");
-                m_console->mConnections.Add(Name(), "MuxIncrement",
+                m_console->mConnections.Add(ComponentName(), "MuxIncrement",
                                             IOComponentName(), "MuxIncrement");
-                m_console->mConnections.Add(Name(), "ControlPWM",
+                m_console->mConnections.Add(ComponentName(), "ControlPWM",
                                             IOComponentName(), "ControlPWM");
-                m_console->mConnections.Add(Name(), "DisablePWM",
+                m_console->mConnections.Add(ComponentName(), "DisablePWM",
                                             IOComponentName(), "DisablePWM");
-                m_console->mConnections.Add(Name(), "MotorUp",
+                m_console->mConnections.Add(ComponentName(), "MotorUp",
                                             IOComponentName(), "MotorUp");
-                m_console->mConnections.Add(Name(), "MotorDown",
+                m_console->mConnections.Add(ComponentName(), "MotorDown",
                                             IOComponentName(), "MotorDown");
-                m_console->mConnections.Add(Name(), "SUJ-Clutch-1",
+                m_console->mConnections.Add(ComponentName(), "SUJ-Clutch-1",
                                             IOComponentName(), "SUJ-Clutch-1");
-                m_console->mConnections.Add(Name(), "SUJ-Clutch-2",
+                m_console->mConnections.Add(ComponentName(), "SUJ-Clutch-2",
                                             IOComponentName(), "SUJ-Clutch-2");
-                m_console->mConnections.Add(Name(), "SUJ-Clutch-3",
+                m_console->mConnections.Add(ComponentName(), "SUJ-Clutch-3",
                                             IOComponentName(), "SUJ-Clutch-3");
-                m_console->mConnections.Add(Name(), "SUJ-Clutch-4",
+                m_console->mConnections.Add(ComponentName(), "SUJ-Clutch-4",
                                             IOComponentName(), "SUJ-Clutch-4");
             }
             suj->Configure(m_arm_configuration_file);
@@ -195,7 +235,7 @@ void mtsIntuitiveResearchKitConsole::Arm::ConfigureArm(const ArmType armType,
     case ARM_MTM_DERIVED:
         {
             mtsComponent * component;
-            component = componentManager->GetComponent(Name());
+            component = componentManager->GetComponent(ComponentName());
             if (component) {
                 mtsIntuitiveResearchKitMTM * mtm = dynamic_cast<mtsIntuitiveResearchKitMTM *>(component);
                 if (mtm) {
@@ -203,16 +243,18 @@ void mtsIntuitiveResearchKitConsole::Arm::ConfigureArm(const ArmType armType,
                         mtm->set_simulated();
                     }
                     mtm->set_calibration_mode(m_calibration_mode);
+                    mtm->set_idle_period(m_arm_idle_period);
+                    SetStateTableIfNeeded(mtm);
                     mtm->Configure(m_arm_configuration_file);
                     SetBaseFrameIfNeeded(mtm);
                 } else {
                     CMN_LOG_INIT_ERROR << "mtsIntuitiveResearchKitConsole::Arm::ConfigureArm: component \""
-                                       << Name() << "\" doesn't seem to be derived from mtsIntuitiveResearchKitMTM."
+                                       << ComponentName() << "\" doesn't seem to be derived from mtsIntuitiveResearchKitMTM."
                                        << std::endl;
                 }
             } else {
                 CMN_LOG_INIT_ERROR << "mtsIntuitiveResearchKitConsole::Arm::ConfigureArm: component \""
-                                   << Name() << "\" not found."
+                                   << ComponentName() << "\" not found."
                                    << std::endl;
             }
         }
@@ -221,7 +263,7 @@ void mtsIntuitiveResearchKitConsole::Arm::ConfigureArm(const ArmType armType,
         armPSMOrDerived = true;
         {
             mtsComponent * component;
-            component = componentManager->GetComponent(Name());
+            component = componentManager->GetComponent(ComponentName());
             if (component) {
                 mtsIntuitiveResearchKitPSM * psm = dynamic_cast<mtsIntuitiveResearchKitPSM *>(component);
                 if (psm) {
@@ -229,16 +271,18 @@ void mtsIntuitiveResearchKitConsole::Arm::ConfigureArm(const ArmType armType,
                         psm->set_simulated();
                     }
                     psm->set_calibration_mode(m_calibration_mode);
+                    psm->set_idle_period(m_arm_idle_period);
+                    SetStateTableIfNeeded(psm);
                     psm->Configure(m_arm_configuration_file);
                     SetBaseFrameIfNeeded(psm);
                 } else {
                     CMN_LOG_INIT_ERROR << "mtsIntuitiveResearchKitConsole::Arm::ConfigureArm: component \""
-                                       << Name() << "\" doesn't seem to be derived from mtsIntuitiveResearchKitPSM."
+                                       << ComponentName() << "\" doesn't seem to be derived from mtsIntuitiveResearchKitPSM."
                                        << std::endl;
                 }
             } else {
                 CMN_LOG_INIT_ERROR << "mtsIntuitiveResearchKitConsole::Arm::ConfigureArm: component \""
-                                   << Name() << "\" not found."
+                                   << ComponentName() << "\" not found."
                                    << std::endl;
             }
         }
@@ -247,7 +291,7 @@ void mtsIntuitiveResearchKitConsole::Arm::ConfigureArm(const ArmType armType,
         armECMOrDerived = true;
         {
             mtsComponent * component;
-            component = componentManager->GetComponent(Name());
+            component = componentManager->GetComponent(ComponentName());
             if (component) {
                 mtsIntuitiveResearchKitECM * ecm = dynamic_cast<mtsIntuitiveResearchKitECM *>(component);
                 if (ecm) {
@@ -255,16 +299,18 @@ void mtsIntuitiveResearchKitConsole::Arm::ConfigureArm(const ArmType armType,
                         ecm->set_simulated();
                     }
                     ecm->set_calibration_mode(m_calibration_mode);
+                    ecm->set_idle_period(m_arm_idle_period);
+                    SetStateTableIfNeeded(ecm);
                     ecm->Configure(m_arm_configuration_file);
                     SetBaseFrameIfNeeded(ecm);
                 } else {
                     CMN_LOG_INIT_ERROR << "mtsIntuitiveResearchKitConsole::Arm::ConfigureArm: component \""
-                                       << Name() << "\" doesn't seem to be derived from mtsIntuitiveResearchKitECM."
+                                       << ComponentName() << "\" doesn't seem to be derived from mtsIntuitiveResearchKitECM."
                                        << std::endl;
                 }
             } else {
                 CMN_LOG_INIT_ERROR << "mtsIntuitiveResearchKitConsole::Arm::ConfigureArm: component \""
-                                   << Name() << "\" not found."
+                                   << ComponentName() << "\" not found."
                                    << std::endl;
             }
         }
@@ -275,20 +321,46 @@ void mtsIntuitiveResearchKitConsole::Arm::ConfigureArm(const ArmType armType,
     }
 
     if (armPSMOrDerived && (m_simulation == SIMULATION_NONE)) {
-        m_console->mConnections.Add(Name(), "Adapter",
+        m_console->mConnections.Add(ComponentName(), "Adapter",
                                     IOComponentName(), Name() + "-Adapter");
-        m_console->mConnections.Add(Name(), "Tool",
+        m_console->mConnections.Add(ComponentName(), "Tool",
                                     IOComponentName(), Name() + "-Tool");
-        m_console->mConnections.Add(Name(), "ManipClutch",
+        m_console->mConnections.Add(ComponentName(), "ManipClutch",
                                     IOComponentName(), Name() + "-ManipClutch");
-        m_console->mConnections.Add(Name(), "Dallas",
+        m_console->mConnections.Add(ComponentName(), "Dallas",
                                     IOComponentName(), Name() + "-Dallas");
     }
 
     if (armECMOrDerived && (m_simulation == SIMULATION_NONE)) {
-        m_console->mConnections.Add(Name(), "ManipClutch",
+        m_console->mConnections.Add(ComponentName(), "ManipClutch",
                                     IOComponentName(), Name() + "-ManipClutch");
     }
+
+    // run arm after its PID, PID is already connected to IO ExecOut
+    if (m_synchronized_with_IO) {
+        m_console->mConnections.Add(ComponentName(), "ExecIn",
+                                    IOComponentName(), "ExecOut");
+    }
+
+    // efforts evaluated in IO thread after PID, MTMs only
+    if (m_effort_stage) {
+        if (((armType == ARM_MTM) || (armType == ARM_MTM_DERIVED))
+            && (m_simulation == SIMULATION_NONE)) {
+            const std::string stageName = ComponentName() + "-EffortStage";
+            mtsArmEffortStage * stage = new mtsArmEffortStage(stageName, mtsIntuitiveResearchKit::IOPeriod);
+            componentManager->AddComponent(stage);
+            m_console->mConnections.Add(stageName, "PID",
+                                        PIDComponentName(), "Controller");
+            m_console->mConnections.Add(ComponentName(), "EffortStage",
+                                        stageName, "EffortStage");
+            m_console->mConnections.Add(stageName, "ExecIn",
+                                        IOComponentName(), "ExecOut");
+        } else {
+            CMN_LOG_INIT_WARNING << "mtsIntuitiveResearchKitConsole::Arm::ConfigureArm: arm \""
+                                 << Name() << "\" \"effort-stage\" is only supported for non simulated MTMs, ignored"
+                                 << std::endl;
+        }
+    }
 }
 
 void mtsIntuitiveResearchKitConsole::Arm::SetBaseFrameIfNeeded(mtsIntuitiveResearchKitArm * armPointer)
@@ -298,6 +370,14 @@ void mtsIntuitiveResearchKitConsole::Arm::SetBaseFrameIfNeeded(mtsIntuitiveResea
     }
 }
 
+void mtsIntuitiveResearchKitConsole::Arm::SetStateTableIfNeeded(mtsIntuitiveResearchKitArm * armPointer)
+{
+    if (m_arm_state_table_set) {
+        armPointer->set_state_table(m_arm_state_table_history,
+                                    m_arm_state_table_latest);
+    }
+}
+
 bool mtsIntuitiveResearchKitConsole::Arm::Connect(void)
 {
     mtsManagerLocal * componentManager = mtsManagerLocal::GetInstance();
@@ -305,23 +385,24 @@ bool mtsIntuitiveResearchKitConsole::Arm::Connect(void)
     if (m_native_or_derived) {
         // Connect arm to IO if not simulated
         if (m_simulation == SIMULATION_NONE) {
-            componentManager->Connect(Name(), "RobotIO",
+            componentManager->Connect(ComponentName(), "RobotIO",
                                       IOComponentName(), Name());
         }
         // connect MTM gripper to IO
         if (((m_type == ARM_MTM)
              || (m_type == ARM_MTM_DERIVED))
             && (m_simulation == SIMULATION_NONE)) {
-            componentManager->Connect(Name(), "GripperIO",
+            componentManager->Connect(ComponentName(), "GripperIO",
                                       IOComponentName(), Name() + "-Gripper");
         }
         // connect PID
-        componentManager->Connect(Name(), "PID",
+        componentManager->Connect(ComponentName(), "PID",
                                   PIDComponentName(), "Controller");
         // connect m_base_frame if needed
         if ((m_base_frame_component_name != "") && (m_base_frame_interface_name != "")) {
-            componentManager->Connect(m_base_frame_component_name, m_base_frame_interface_name,
-                                      Name(), "Arm");
+            componentManager->Connect(m_console->ConsoleComponentName(m_base_frame_component_name),
+                                      m_base_frame_interface_name,
+                                      ComponentName(), "Arm");
         }
     }
     return true;
@@ -356,8 +437,14 @@ void mtsIntuitiveResearchKitConsole::Arm::CurrentStateEventHandler(const prmOper
     m_console->SetArmCurrentState(m_name, currentState);
 }
 
+void mtsIntuitiveResearchKitConsole::Arm::StateNameEventHandler(const std::string & state)
+{
+    m_console->SetArmStateName(m_name, state);
+}
+
 mtsIntuitiveResearchKitConsole::TeleopECM::TeleopECM(const std::string & name):
-    m_name(name)
+    m_name(name),
+    m_component_name(name)
 {
 }
 
@@ -371,7 +458,7 @@ void mtsIntuitiveResearchKitConsole::TeleopECM::ConfigureTeleop(const TeleopECMT
     switch (type) {
     case TELEOP_ECM:
         {
-            mtsTeleOperationECM * teleop = new mtsTeleOperationECM(m_name, periodInSeconds);
+            mtsTeleOperationECM * teleop = new mtsTeleOperationECM(ComponentName(), periodInSeconds);
             teleop->Configure(jsonConfig);
             componentManager->AddComponent(teleop);
         }
@@ -379,19 +466,19 @@ void mtsIntuitiveResearchKitConsole::TeleopECM::ConfigureTeleop(const TeleopECMT
     case TELEOP_ECM_DERIVED:
         {
             mtsComponent * component;
-            component = componentManager->GetComponent(Name());
+            component = componentManager->GetComponent(ComponentName());
             if (component) {
                 mtsTeleOperationECM * teleop = dynamic_cast<mtsTeleOperationECM *>(component);
                 if (teleop) {
                     teleop->Configure(jsonConfig);
                 } else {
                     CMN_LOG_INIT_ERROR << "mtsIntuitiveResearchKitConsole::Arm::ConfigureTeleop: component \""
-                                       << Name() << "\" doesn't seem to be derived from mtsTeleOperationECM."
+                                       << ComponentName() << "\" doesn't seem to be derived from mtsTeleOperationECM."
                                        << std::endl;
                 }
             } else {
                 CMN_LOG_INIT_ERROR << "mtsIntuitiveResearchKitConsole::Arm::ConfigureTeleop: component \""
-                                   << Name() << "\" not found."
+                                   << ComponentName() << "\" not found."
                                    << std::endl;
             }
         }
@@ -405,12 +492,17 @@ const std::string & mtsIntuitiveResearchKitConsole::TeleopECM::Name(void) const
     return m_name;
 }
 
+const std::string & mtsIntuitiveResearchKitConsole::TeleopECM::ComponentName(void) const {
+    return m_component_name;
+}
+
 
 mtsIntuitiveResearchKitConsole::TeleopPSM::TeleopPSM(const std::string & name,
                                                      const std::string & nameMTM,
                                                      const std::string & namePSM):
     mSelected(false),
     m_name(name),
+    m_component_name(name),
     mMTMName(nameMTM),
     mPSMName(namePSM)
 {
@@ -426,7 +518,7 @@ void mtsIntuitiveResearchKitConsole::TeleopPSM::ConfigureTeleop(const TeleopPSMT
     switch (type) {
     case TELEOP_PSM:
         {
-            mtsTeleOperationPSM * teleop = new mtsTeleOperationPSM(m_name, periodInSeconds);
+            mtsTeleOperationPSM * teleop = new mtsTeleOperationPSM(ComponentName(), periodInSeconds);
             teleop->Configure(jsonConfig);
             componentManager->AddComponent(teleop);
         }
@@ -434,19 +526,19 @@ void mtsIntuitiveResearchKitConsole::TeleopPSM::ConfigureTeleop(const TeleopPSMT
     case TELEOP_PSM_DERIVED:
         {
             mtsComponent * component;
-            component = componentManager->GetComponent(Name());
+            component = componentManager->GetComponent(ComponentName());
             if (component) {
                 mtsTeleOperationPSM * teleop = dynamic_cast<mtsTeleOperationPSM *>(component);
                 if (teleop) {
                     teleop->Configure(jsonConfig);
                 } else {
                     CMN_LOG_INIT_ERROR << "mtsIntuitiveResearchKitConsole::Arm::ConfigureTeleop: component \""
-                                       << Name() << "\" doesn't seem to be derived from mtsTeleOperationPSM."
+                                       << ComponentName() << "\" doesn't seem to be derived from mtsTeleOperationPSM."
                                        << std::endl;
                 }
             } else {
                 CMN_LOG_INIT_ERROR << "mtsIntuitiveResearchKitConsole::Arm::ConfigureTeleop: component \""
-                                   << Name() << "\" not found."
+                                   << ComponentName() << "\" not found."
                                    << std::endl;
             }
         }
@@ -460,6 +552,10 @@ const std::string & mtsIntuitiveResearchKitConsole::TeleopPSM::Name(void) const
     return m_name;
 }
 
+const std::string & mtsIntuitiveResearchKitConsole::TeleopPSM::ComponentName(void) const {
+    return m_component_name;
+}
+
 
 
 mtsIntuitiveResearchKitConsole::mtsIntuitiveResearchKitConsole(const std::string & componentName):
@@ -470,10 +566,15 @@ mtsIntuitiveResearchKitConsole::mtsIntuitiveResearchKitConsole(const std::string
     mTeleopECM(0),
     mDaVinciHeadSensor(0),
     mDaVinciEndoscopeFocus(0),
+    mCollisionMonitor(0),
+    mParallelArmExecutor(0),
+    mConsoleExecutor(0),
     mOperatorPresent(false),
     mCameraPressed(false),
     m_IO_component_name("io")
 {
+    m_startup = new mtsConsoleStartup(*this);
+
     mInterface = AddInterfaceProvided("Main");
     if (mInterface) {
         mInterface->AddMessageEvents();
@@ -483,6 +584,8 @@ mtsIntuitiveResearchKitConsole::mtsIntuitiveResearchKitConsole(const std::string
                                    "power_on");
         mInterface->AddCommandVoid(&mtsIntuitiveResearchKitConsole::home, this,
                                    "home");
+        mInterface->AddCommandRead(&mtsIntuitiveResearchKitConsole::startup_report, this,
+                                   "startup_report", std::string());
         mInterface->AddEventWrite(ConfigurationEvents.ArmCurrentState,
                                   "ArmCurrentState", prmKeyValue());
         mInterface->AddCommandWrite(&mtsIntuitiveResearchKitConsole::teleop_enable, this,
@@ -524,6 +627,27 @@ mtsIntuitiveResearchKitConsole::mtsIntuitiveResearchKitConsole(const std::string
     }
 }
 
+mtsIntuitiveResearchKitConsole::~mtsIntuitiveResearchKitConsole()
+{
+    delete m_startup;
+}
+
+void mtsIntuitiveResearchKitConsole::set_component_prefix(const std::string & prefix)
+{
+    m_component_prefix = prefix;
+}
+
+const std::string & mtsIntuitiveResearchKitConsole::component_prefix(void) const
+{
+    return m_component_prefix;
+}
+
+void mtsIntuitiveResearchKitConsole::set_executor(mtsConsoleExecutor * executor)
+{
+    mConsoleExecutor = executor;
+    m_shared_executor = (executor != 0);
+}
+
 void mtsIntuitiveResearchKitConsole::set_calibration_mode(const bool mode)
 {
     m_calibration_mode = mode;
@@ -558,7 +682,7 @@ void mtsIntuitiveResearchKitConsole::Configure(const std::string & filename)
     std::ifstream jsonStream;
     jsonStream.open(filename.c_str());
 
-    Json::Value jsonConfig, jsonValue;
+    Json::Value jsonConfig;
     Json::Reader jsonReader;
     if (!jsonReader.parse(jsonStream, jsonConfig)) {
         CMN_LOG_CLASS_INIT_ERROR << "Configure: failed to parse configuration" << std::endl
@@ -568,6 +692,15 @@ void mtsIntuitiveResearchKitConsole::Configure(const std::string & filename)
         exit(EXIT_FAILURE);
     }
 
+    Configure(filename, jsonConfig);
+}
+
+void mtsIntuitiveResearchKitConsole::Configure(const std::string & filename,
+                                               const Json::Value & jsonConfig)
+{
+    mConfigured = false;
+    Json::Value jsonValue;
+
     CMN_LOG_CLASS_INIT_VERBOSE << "Configure: " << this->GetName()
                                << " using file \"" << filename << "\"" << std::endl
                                << "----> content of configuration file: " << std::endl
@@ -577,6 +710,9 @@ void mtsIntuitiveResearchKitConsole::Configure(const std::string & filename)
     // base component configuration
     mtsComponent::ConfigureJSON(jsonConfig);
 
+    // components created by the console use the optional prefix
+    m_IO_component_name = m_component_prefix + "io";
+
     // extract path of main json config file to search other files relative to it
     cmnPath configPath(cmnPath::GetWorkingDirectory());
     std::string fullname = configPath.Find(filename);
@@ -600,7 +736,7 @@ void mtsIntuitiveResearchKitConsole::Configure(const std::string & filename)
     }
 
     // add text to speech component for the whole system
-    mTextToSpeech = new mtsTextToSpeech();
+    mTextToSpeech = new mtsTextToSpeech(m_component_prefix + "TextToSpeech");
     manager->AddComponent(mTextToSpeech);
     mtsInterfaceRequired * textToSpeechInterface = this->AddInterfaceRequired("TextToSpeech");
     textToSpeechInterface->AddFunction("Beep", audio.beep);
@@ -832,6 +968,15 @@ void mtsIntuitiveResearchKitConsole::Configure(const std::string & filename)
         }
     }
 
+    // optional parallel execution of arms, after IO read
+    const Json::Value parallelArms = jsonConfig["parallel-arms"];
+    if (!parallelArms.empty()) {
+        if (!ConfigureParallelArmsJSON(parallelArms)) {
+            CMN_LOG_CLASS_INIT_ERROR << "Configure: failed to configure parallel-arms" << std::endl;
+            exit(EXIT_FAILURE);
+        }
+    }
+
     // look for ECM teleop
     const Json::Value ecmTeleop = jsonConfig["ecm-teleop"];
     if (!ecmTeleop.isNull()) {
@@ -857,17 +1002,17 @@ void mtsIntuitiveResearchKitConsole::Configure(const std::string & filename)
     const Json::Value consoleInputs = jsonConfig["console-inputs"];
     if (!consoleInputs.empty()) {
         std::string component, interface;
-        component = consoleInputs["operator-present"]["component"].asString();
+        component = ConsoleComponentName(consoleInputs["operator-present"]["component"].asString());
         interface = consoleInputs["operator-present"]["interface"].asString();
         if ((component != "") && (interface != "")) {
             mDInputSources["OperatorPresent"] = InterfaceComponentType(component, interface);
         }
-        component = consoleInputs["clutch"]["component"].asString();
+        component = ConsoleComponentName(consoleInputs["clutch"]["component"].asString());
         interface = consoleInputs["clutch"]["interface"].asString();
         if ((component != "") && (interface != "")) {
             mDInputSources["Clutch"] = InterfaceComponentType(component, interface);
         }
-        component = consoleInputs["camera"]["component"].asString();
+        component = ConsoleComponentName(consoleInputs["camera"]["component"].asString());
         interface = consoleInputs["camera"]["interface"].asString();
         if ((component != "") && (interface != "")) {
             mDInputSources["Camera"] = InterfaceComponentType(component, interface);
@@ -877,7 +1022,7 @@ void mtsIntuitiveResearchKitConsole::Configure(const std::string & filename)
     // load operator-present settings, this will over write older settings
     const Json::Value operatorPresent = jsonConfig["operator-present"];
     if (!operatorPresent.empty()) {
-        const std::string headSensorName = "daVinciHeadSensor";
+        const std::string headSensorName = m_component_prefix + "daVinciHeadSensor";
         mDaVinciHeadSensor = new mtsDaVinciHeadSensor(headSensorName);
         mtsComponentManager::GetInstance()->AddComponent(mDaVinciHeadSensor);
         // main DInput is OperatorPresent comming from the newly added component
@@ -907,7 +1052,7 @@ void mtsIntuitiveResearchKitConsole::Configure(const std::string & filename)
     // load endoscope-focus settings
     const Json::Value endoscopeFocus = jsonConfig["endoscope-focus"];
     if (!endoscopeFocus.empty()) {
-        const std::string endoscopeFocusName = "daVinciEndoscopeFocus";
+        const std::string endoscopeFocusName = m_component_prefix + "daVinciEndoscopeFocus";
         mDaVinciEndoscopeFocus = new mtsDaVinciEndoscopeFocus(endoscopeFocusName);
         mtsComponentManager::GetInstance()->AddComponent(mDaVinciEndoscopeFocus);
         // make sure we have cam+ and cam- in digital inputs
@@ -935,6 +1080,44 @@ void mtsIntuitiveResearchKitConsole::Configure(const std::string & filename)
                          m_IO_component_name, "Cam-");
     }
 
+    // optional collision monitor
+    const Json::Value collisionMonitor = jsonConfig["collision-monitor"];
+    if (!collisionMonitor.empty()) {
+        if (!ConfigureCollisionMonitorJSON(collisionMonitor)) {
+            CMN_LOG_CLASS_INIT_ERROR << "Configure: failed to configure collision-monitor" << std::endl;
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    // optional staged power on and homing
+    const Json::Value startup = jsonConfig["startup"];
+    if (!startup.empty()) {
+        std::string errorMessage;
+        if (!m_startup->ConfigureJSON(startup, errorMessage)) {
+            CMN_LOG_CLASS_INIT_ERROR << "Configure: failed to configure \"startup\", "
+                                     << errorMessage << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        for (const auto & name : startup["order"]) {
+            if (mArms.find(name.asString()) == mArms.end()) {
+                CMN_LOG_CLASS_INIT_ERROR << "Configure: arm \"" << name.asString()
+                                         << "\" found in \"startup\" \"order\" is not defined" << std::endl;
+                exit(EXIT_FAILURE);
+            }
+        }
+    }
+
+    // optional single threaded execution, needs all components.  A
+    // shared executor (see set_executor) is used even if "executor"
+    // is not defined
+    const Json::Value executor = jsonConfig["executor"];
+    if (!executor.empty() || m_shared_executor) {
+        if (!ConfigureExecutorJSON(executor, periodIO)) {
+            CMN_LOG_CLASS_INIT_ERROR << "Configure: failed to configure executor" << std::endl;
+            exit(EXIT_FAILURE);
+        }
+    }
+
     // if we have any teleoperation component, we need to have the interfaces for the foot pedals
     // unless user explicitly says we can skip
     if (physicalFootpedalsRequired) {
@@ -1057,6 +1240,14 @@ void mtsIntuitiveResearchKitConsole::Run(void)
 {
     ProcessQueuedCommands();
     ProcessQueuedEvents();
+
+    // staged power on, arms that never report power release their slot
+    std::list<std::string> start;
+    if (m_startup->CheckTimeouts(mtsManagerLocal::GetInstance()->GetTimeServer().GetRelativeTime(),
+                                 start)) {
+        mInterface->SendStatus(m_startup->Summary());
+    }
+    StartupSendCommand(start);
 }
 
 void mtsIntuitiveResearchKitConsole::Cleanup(void)
@@ -1100,6 +1291,7 @@ bool mtsIntuitiveResearchKitConsole::AddArm(mtsComponent * genericArm, const mts
 {
     // create new required interfaces to communicate with the components we created
     Arm * newArm = new Arm(this, genericArm->GetName(), "");
+    newArm->m_arm_component_name = genericArm->GetName();
     if (AddArmInterfaces(newArm)) {
         auto armIterator = mArms.find(newArm->m_name);
         if (armIterator != mArms.end()) {
@@ -1313,8 +1505,15 @@ bool mtsIntuitiveResearchKitConsole::ConfigureArmJSON(const Json::Value & jsonAr
         armPointer->m_skip_ROS_bridge = jsonValue.asBool();
     }
 
-    // component and interface, defaults
+    // component and interface, defaults.  Derived and generic arms
+    // are created outside the console so they don't use the prefix
     armPointer->m_arm_component_name = armName;
+    if (!armPointer->m_generic
+        && (armPointer->m_type != Arm::ARM_MTM_DERIVED)
+        && (armPointer->m_type != Arm::ARM_PSM_DERIVED)
+        && (armPointer->m_type != Arm::ARM_ECM_DERIVED)) {
+        armPointer->m_arm_component_name = m_component_prefix + armName;
+    }
     armPointer->m_arm_interface_name = "Arm";
     jsonValue = jsonArm["component"];
     if (!jsonValue.empty()) {
@@ -1327,6 +1526,7 @@ bool mtsIntuitiveResearchKitConsole::ConfigureArmJSON(const Json::Value & jsonAr
 
     // check if we need to create a socket server attached to this arm
     armPointer->m_socket_server = false;
+    armPointer->m_socket_extrapolation = EXTRAPOLATION_HORIZON;
     jsonValue = jsonArm["socket-server"];
     if (!jsonValue.empty()) {
         armPointer->m_socket_server = jsonValue.asBool();
@@ -1334,7 +1534,7 @@ bool mtsIntuitiveResearchKitConsole::ConfigureArmJSON(const Json::Value & jsonAr
 
     // for socket client or server, look for remote IP / port
     if (armPointer->m_type == Arm::ARM_PSM_SOCKET || armPointer->m_socket_server) {
-        armPointer->m_socket_component_name = armPointer->m_name + "-SocketServer";
+        armPointer->m_socket_component_name = m_component_prefix + armPointer->m_name + "-SocketServer";
         jsonValue = jsonArm["remote-ip"];
         if(!jsonValue.empty()){
             armPointer->m_IP = jsonValue.asString();
@@ -1351,6 +1551,16 @@ bool mtsIntuitiveResearchKitConsole::ConfigureArmJSON(const Json::Value & jsonAr
                                      << armName << "\"" << std::endl;
             return false;
         }
+        // in seconds, 0 to disable
+        jsonValue = jsonArm["socket-extrapolation"];
+        if (!jsonValue.empty()) {
+            armPointer->m_socket_extrapolation = jsonValue.asDouble();
+            if (armPointer->m_socket_extrapolation < 0.0) {
+                CMN_LOG_CLASS_INIT_ERROR << "ConfigureArmJSON: \"socket-extrapolation\" must be positive or 0 for arm \""
+                                         << armName << "\"" << std::endl;
+                return false;
+            }
+        }
     }
 
     // IO for anything not simulated or socket client
@@ -1524,6 +1734,34 @@ bool mtsIntuitiveResearchKitConsole::ConfigureArmJSON(const Json::Value & jsonAr
         armPointer->m_arm_period = jsonValue.asFloat();
     }
 
+    // effort stage
+    jsonValue = jsonArm["effort-stage"];
+    if (!jsonValue.empty()) {
+        armPointer->m_effort_stage = jsonValue.asBool();
+    }
+
+    // read idle period if present
+    jsonValue = jsonArm["idle-period"];
+    if (!jsonValue.empty()) {
+        armPointer->m_arm_idle_period = jsonValue.asDouble();
+        if (armPointer->m_arm_idle_period < 0.0) {
+            CMN_LOG_CLASS_INIT_ERROR << "ConfigureArmJSON: \"idle-period\" must be positive or 0 for arm \""
+                                     << armName << "\"" << std::endl;
+            return false;
+        }
+    }
+
+    // signals without history and history depth, overrides arm file
+    jsonValue = jsonArm["state-table"];
+    if (!jsonValue.empty()) {
+        armPointer->m_arm_state_table_set = true;
+        armPointer->m_arm_state_table_history = jsonValue["history"].asUInt();
+        const Json::Value jsonLatest = jsonValue["latest"];
+        for (unsigned int index = 0; index < jsonLatest.size(); ++index) {
+            armPointer->m_arm_state_table_latest.push_back(jsonLatest[index].asString());
+        }
+    }
+
     // add the arm if it's a new one
     if (armIterator == mArms.end()) {
         AddArm(armPointer);
@@ -1624,12 +1862,6 @@ bool mtsIntuitiveResearchKitConsole::ConfigureECMTeleopJSON(const Json::Value &
     if (mTeleopECM == 0) {
         // create a new teleop if needed
         mTeleopECM = new TeleopECM(name);
-        // schedule connections
-        mConnections.Add(name, "MTML", mtmLeftComponent, mtmLeftInterface);
-        mConnections.Add(name, "MTMR", mtmRightComponent, mtmRightInterface);
-        mConnections.Add(name, "ECM", ecmComponent, ecmInterface);
-        mConnections.Add(name, "Clutch", this->GetName(), "Clutch"); // console clutch
-        mConnections.Add(this->GetName(), name, name, "Setting");
     } else {
         CMN_LOG_CLASS_INIT_ERROR << "ConfigureECMTeleopJSON: there is already an ECM teleop" << std::endl;
         return false;
@@ -1655,6 +1887,19 @@ bool mtsIntuitiveResearchKitConsole::ConfigureECMTeleopJSON(const Json::Value &
         mTeleopECM->m_type = TeleopECM::TELEOP_ECM;
     }
 
+    // only tele-operations created by the console use the prefix
+    if (mTeleopECM->m_type == TeleopECM::TELEOP_ECM) {
+        mTeleopECM->m_component_name = m_component_prefix + name;
+    }
+
+    // schedule connections
+    const std::string componentName = mTeleopECM->ComponentName();
+    mConnections.Add(componentName, "MTML", mtmLeftComponent, mtmLeftInterface);
+    mConnections.Add(componentName, "MTMR", mtmRightComponent, mtmRightInterface);
+    mConnections.Add(componentName, "ECM", ecmComponent, ecmInterface);
+    mConnections.Add(componentName, "Clutch", this->GetName(), "Clutch"); // console clutch
+    mConnections.Add(this->GetName(), name, componentName, "Setting");
+
     // read period if present
     double period = mtsIntuitiveResearchKit::TeleopPeriod;
     jsonValue = jsonTeleop["period"];
@@ -1745,22 +1990,47 @@ bool mtsIntuitiveResearchKitConsole::ConfigurePSMTeleopJSON(const Json::Value &
         }
     }
 
-    // check if pair already exist and then add
+    // type is needed to determine the component name
     const std::string name = mtmName + "-" + psmName;
+    TeleopPSM::TeleopPSMType teleopType = TeleopPSM::TELEOP_PSM;
+    jsonValue = jsonTeleop["type"];
+    if (!jsonValue.empty()) {
+        std::string typeString = jsonValue.asString();
+        if (typeString == "TELEOP_PSM") {
+            teleopType = TeleopPSM::TELEOP_PSM;
+        } else if (typeString == "TELEOP_PSM_DERIVED") {
+            teleopType = TeleopPSM::TELEOP_PSM_DERIVED;
+        } else if (typeString == "TELEOP_PSM_GENERIC") {
+            teleopType = TeleopPSM::TELEOP_PSM_GENERIC;
+        } else {
+            CMN_LOG_CLASS_INIT_ERROR << "ConfigurePSMTeleopJSON: teleop " << name << ": invalid type \""
+                                     << typeString << "\", needs to be TELEOP_PSM, TELEOP_PSM_DERIVED or TELEOP_PSM_GENERIC" << std::endl;
+            return false;
+        }
+    }
+
+    // check if pair already exist and then add
     const auto teleopIterator = mTeleopsPSM.find(name);
     TeleopPSM * teleopPointer = 0;
     if (teleopIterator == mTeleopsPSM.end()) {
         // create a new teleop if needed
         teleopPointer = new TeleopPSM(name, mtmName, psmName);
+        teleopPointer->m_type = teleopType;
+        // only tele-operations created by the console use the prefix
+        if (teleopType == TeleopPSM::TELEOP_PSM) {
+            teleopPointer->m_component_name = m_component_prefix + name;
+        }
+
         // schedule connections
-        mConnections.Add(name, "MTM", mtmComponent, mtmInterface);
-        mConnections.Add(name, "PSM", psmComponent, psmInterface);
-        mConnections.Add(name, "Clutch", this->GetName(), "Clutch"); // clutch from console
-        mConnections.Add(this->GetName(), name, name, "Setting");
+        const std::string componentName = teleopPointer->ComponentName();
+        mConnections.Add(componentName, "MTM", mtmComponent, mtmInterface);
+        mConnections.Add(componentName, "PSM", psmComponent, psmInterface);
+        mConnections.Add(componentName, "Clutch", this->GetName(), "Clutch"); // clutch from console
+        mConnections.Add(this->GetName(), name, componentName, "Setting");
         if ((baseFrameComponent != "")
             && (baseFrameInterface != "")) {
-            mConnections.Add(name, "PSM-base-frame",
-                             baseFrameComponent, baseFrameInterface);
+            mConnections.Add(componentName, "PSM-base-frame",
+                             ConsoleComponentName(baseFrameComponent), baseFrameInterface);
         }
 
         // insert
@@ -1806,25 +2076,6 @@ bool mtsIntuitiveResearchKitConsole::ConfigurePSMTeleopJSON(const Json::Value &
         return false;
     }
 
-    jsonValue = jsonTeleop["type"];
-    if (!jsonValue.empty()) {
-        std::string typeString = jsonValue.asString();
-        if (typeString == "TELEOP_PSM") {
-            teleopPointer->m_type = TeleopPSM::TELEOP_PSM;
-        } else if (typeString == "TELEOP_PSM_DERIVED") {
-            teleopPointer->m_type = TeleopPSM::TELEOP_PSM_DERIVED;
-        } else if (typeString == "TELEOP_PSM_GENERIC") {
-            teleopPointer->m_type = TeleopPSM::TELEOP_PSM_GENERIC;
-        } else {
-            CMN_LOG_CLASS_INIT_ERROR << "ConfigurePSMTeleopJSON: teleop " << name << ": invalid type \""
-                                     << typeString << "\", needs to be TELEOP_PSM, TELEOP_PSM_DERIVED or TELEOP_PSM_GENERIC" << std::endl;
-            return false;
-        }
-    } else {
-        // default value
-        teleopPointer->m_type = TeleopPSM::TELEOP_PSM;
-    }
-
     // read period if present
     double period = mtsIntuitiveResearchKit::TeleopPeriod;
     jsonValue = jsonTeleop["period"];
@@ -1843,6 +2094,239 @@ bool mtsIntuitiveResearchKitConsole::ConfigurePSMTeleopJSON(const Json::Value &
     return true;
 }
 
+bool mtsIntuitiveResearchKitConsole::ConfigureCollisionMonitorJSON(const Json::Value & jsonMonitor)
+{
+    const std::string monitorName = m_component_prefix + "CollisionMonitor";
+    double period = mtsIntuitiveResearchKit::TeleopPeriod;
+    const Json::Value jsonPeriod = jsonMonitor["period"];
+    if (!jsonPeriod.empty()) {
+        period = jsonPeriod.asDouble();
+    }
+    mCollisionMonitor = new mtsCollisionMonitor(monitorName, period);
+    mCollisionMonitor->Configure(jsonMonitor);
+
+    // if no arm is specified, monitor all PSMs and ECMs
+    if (jsonMonitor["arms"].empty()) {
+        for (auto & iter : mArms) {
+            switch (iter.second->m_type) {
+            case Arm::ARM_PSM:
+            case Arm::ARM_PSM_DERIVED:
+                mCollisionMonitor->AddArm(iter.first, "PSM");
+                break;
+            case Arm::ARM_ECM:
+            case Arm::ARM_ECM_DERIVED:
+                mCollisionMonitor->AddArm(iter.first, "ECM");
+                break;
+            default:
+                break;
+            }
+        }
+    }
+
+    // connect to arms
+    for (const auto & armName : mCollisionMonitor->ArmNames()) {
+        const auto armIterator = mArms.find(armName);
+        if (armIterator == mArms.end()) {
+            CMN_LOG_CLASS_INIT_ERROR << "ConfigureCollisionMonitorJSON: arm \""
+                                     << armName << "\" is not defined in \"arms\"" << std::endl;
+            return false;
+        }
+        mConnections.Add(monitorName, armName,
+                         armIterator->second->ComponentName(),
+                         armIterator->second->InterfaceName());
+    }
+
+    mtsComponentManager::GetInstance()->AddComponent(mCollisionMonitor);
+
+    // messages, errors will disable tele-operation
+    mtsInterfaceRequired * interfaceRequired = AddInterfaceRequired("CollisionMonitor");
+    if (!interfaceRequired) {
+        CMN_LOG_CLASS_INIT_ERROR << "ConfigureCollisionMonitorJSON: failed to add interface for \""
+                                 << monitorName << "\"" << std::endl;
+        return false;
+    }
+    interfaceRequired->AddEventHandlerWrite(&mtsIntuitiveResearchKitConsole::ErrorEventHandler,
+                                            this, "error");
+    interfaceRequired->AddEventHandlerWrite(&mtsIntuitiveResearchKitConsole::WarningEventHandler,
+                                            this, "warning");
+    interfaceRequired->AddEventHandlerWrite(&mtsIntuitiveResearchKitConsole::StatusEventHandler,
+                                            this, "status");
+    mConnections.Add(this->GetName(), "CollisionMonitor",
+                     monitorName, "Monitor");
+    return true;
+}
+
+bool mtsIntuitiveResearchKitConsole::ConfigureParallelArmsJSON(const Json::Value & jsonParallel)
+{
+    if (!mHasIO) {
+        CMN_LOG_CLASS_INIT_ERROR << "ConfigureParallelArmsJSON: \"parallel-arms\" requires an IO component"
+                                 << std::endl;
+        return false;
+    }
+
+    const std::string executorName = m_component_prefix + "ParallelArms";
+    mParallelArmExecutor = new mtsParallelArmExecutor(executorName, mtsIntuitiveResearchKit::IOPeriod);
+    const Json::Value jsonThreads = jsonParallel["threads"];
+    if (!jsonThreads.empty()) {
+        mParallelArmExecutor->SetNumberOfThreads(jsonThreads.asUInt());
+    }
+
+    // only arms created by the console and using the IO, the arms
+    // ExecIn interfaces are tied to the executor so they don't use
+    // their own thread
+    for (auto & iter : mArms) {
+        Arm * arm = iter.second;
+        if (!arm->m_native_or_derived
+            || (arm->m_simulation != Arm::SIMULATION_NONE)) {
+            continue;
+        }
+        // arms with period 0 already run in the IO thread
+        if (arm->m_synchronized_with_IO) {
+            CMN_LOG_CLASS_INIT_VERBOSE << "ConfigureParallelArmsJSON: arm \"" << iter.first
+                                       << "\" uses period 0, it will run in the IO thread after its PID" << std::endl;
+            continue;
+        }
+        switch (arm->m_type) {
+        case Arm::ARM_MTM:
+        case Arm::ARM_PSM:
+        case Arm::ARM_ECM:
+        case Arm::ARM_MTM_DERIVED:
+        case Arm::ARM_PSM_DERIVED:
+        case Arm::ARM_ECM_DERIVED:
+            if (!mParallelArmExecutor->AddArm(iter.first)) {
+                return false;
+            }
+            arm->m_parallel = true;
+            mConnections.Add(arm->ComponentName(), "ExecIn",
+                             executorName, mParallelArmExecutor->InterfaceName(iter.first));
+            break;
+        default:
+            break;
+        }
+    }
+
+    mtsComponentManager::GetInstance()->AddComponent(mParallelArmExecutor);
+    // PIDs are connected to the IO first so the arms run after them
+    mConnections.Add(executorName, "ExecIn",
+                     m_IO_component_name, "ExecOut");
+    return true;
+}
+
+bool mtsIntuitiveResearchKitConsole::ConfigureExecutorJSON(const Json::Value & jsonExecutor,
+                                                           const double periodIO)
+{
+    Json::Value jsonValue;
+
+    double period = periodIO;
+    jsonValue = jsonExecutor["period"];
+    if (!jsonValue.empty()) {
+        period = jsonValue.asDouble();
+        if (period <= 0.0) {
+            CMN_LOG_CLASS_INIT_ERROR << "ConfigureExecutorJSON: \"period\" must be a positive number" << std::endl;
+            return false;
+        }
+        if (m_shared_executor) {
+            CMN_LOG_CLASS_INIT_WARNING << "ConfigureExecutorJSON: \"period\" is ignored when using a shared executor" << std::endl;
+        }
+    }
+
+    // list components in execution order, IO, PIDs, arms,
+    // tele-operations and others.  Components tied to the IO
+    // ExecOut (PIDs, arms with period 0 or parallel-arms, effort
+    // stages) run with the IO.
+    std::list<std::string> names;
+    if (mHasIO) {
+        names.push_back(m_IO_component_name);
+    }
+    for (auto & iter : mArms) {
+        Arm * arm = iter.second;
+        // PIDs without IO have their own thread
+        if (!arm->m_PID_configuration_file.empty()
+            && (arm->m_simulation == Arm::SIMULATION_KINEMATIC)) {
+            names.push_back(arm->PIDComponentName());
+        }
+    }
+    for (auto & iter : mArms) {
+        Arm * arm = iter.second;
+        // ExecIn already connected to IO or parallel-arms executor
+        if (arm->m_generic || arm->m_synchronized_with_IO || arm->m_parallel) {
+            continue;
+        }
+        names.push_back(arm->ComponentName());
+    }
+    for (auto & iter : mTeleopsPSM) {
+        if (iter.second->m_type != TeleopPSM::TELEOP_PSM_GENERIC) {
+            names.push_back(iter.second->ComponentName());
+        }
+    }
+    if (mTeleopECM
+        && (mTeleopECM->m_type != TeleopECM::TELEOP_ECM_GENERIC)) {
+        names.push_back(mTeleopECM->ComponentName());
+    }
+    if (mCollisionMonitor) {
+        names.push_back(mCollisionMonitor->GetName());
+    }
+    for (auto & iter : mArms) {
+        if (iter.second->m_socket_server) {
+            names.push_back(iter.second->SocketComponentName());
+        }
+    }
+    // other periodic components, e.g. streamers
+    const Json::Value jsonComponents = jsonExecutor["components"];
+    for (unsigned int index = 0; index < jsonComponents.size(); ++index) {
+        names.push_back(jsonComponents[index].asString());
+    }
+
+    // shared executor is owned and added to the component manager by
+    // the caller
+    if (!m_shared_executor) {
+        mConsoleExecutor = new mtsConsoleExecutor(m_component_prefix + "ConsoleExecutor", period);
+    }
+    const std::string executorName = mConsoleExecutor->GetName();
+    for (const auto & name : names) {
+        if (!mConsoleExecutor->Register(name)) {
+            return false;
+        }
+        mConnections.Add(name, "ExecIn",
+                         executorName, mConsoleExecutor->InterfaceName(name));
+    }
+
+    // budgets in seconds
+    const Json::Value jsonBudgets = jsonExecutor["budgets"];
+    const Json::Value::Members budgetNames = jsonBudgets.getMemberNames();
+    for (const auto & name : budgetNames) {
+        // budgets can use component names with or without prefix
+        std::string componentName = name;
+        if (std::find(names.begin(), names.end(), name) == names.end()) {
+            componentName = m_component_prefix + name;
+        }
+        if (!mConsoleExecutor->SetBudget(componentName, jsonBudgets[name].asDouble())) {
+            CMN_LOG_CLASS_INIT_ERROR << "ConfigureExecutorJSON: can't set budget for \""
+                                     << name << "\", component is not run by the executor" << std::endl;
+            return false;
+        }
+    }
+
+    if (!m_shared_executor) {
+        mtsComponentManager::GetInstance()->AddComponent(mConsoleExecutor);
+    }
+
+    // messages
+    mtsInterfaceRequired * interfaceRequired = AddInterfaceRequired("ConsoleExecutor");
+    if (!interfaceRequired) {
+        return false;
+    }
+    interfaceRequired->AddEventHandlerWrite(&mtsIntuitiveResearchKitConsole::ErrorEventHandler,
+                                            this, "error");
+    interfaceRequired->AddEventHandlerWrite(&mtsIntuitiveResearchKitConsole::WarningEventHandler,
+                                            this, "warning");
+    interfaceRequired->AddEventHandlerWrite(&mtsIntuitiveResearchKitConsole::StatusEventHandler,
+                                            this, "status");
+    mConnections.Add(this->GetName(), "ConsoleExecutor",
+                     executorName, "Executor");
+    return true;
+}
+
 bool mtsIntuitiveResearchKitConsole::AddArmInterfaces(Arm * arm)
 {
     // IO
@@ -1898,7 +2382,7 @@ bool mtsIntuitiveResearchKitConsole::AddArmInterfaces(Arm * arm)
             arm->PIDInterfaceRequired->AddEventHandlerWrite(&mtsIntuitiveResearchKitConsole::StatusEventHandler,
                                                             this, "status");
             mConnections.Add(this->GetName(), interfaceNamePID,
-                             arm->Name() + "-PID", "Controller");
+                             arm->PIDComponentName(), "Controller");
         } else {
             CMN_LOG_CLASS_INIT_ERROR << "AddArmInterfaces: failed to add PID interface for arm \""
                                      << arm->Name() << "\"" << std::endl;
@@ -1922,6 +2406,11 @@ bool mtsIntuitiveResearchKitConsole::AddArmInterfaces(Arm * arm)
                                                         this, "status");
         arm->ArmInterfaceRequired->AddEventHandlerWrite(&mtsIntuitiveResearchKitConsole::Arm::CurrentStateEventHandler,
                                                         arm, "operating_state");
+        // state names are only used for the startup timing report
+        if (arm->m_native_or_derived) {
+            arm->ArmInterfaceRequired->AddEventHandlerWrite(&mtsIntuitiveResearchKitConsole::Arm::StateNameEventHandler,
+                                                            arm, "current_state");
+        }
         mConnections.Add(this->GetName(), interfaceNameArm,
                          arm->ComponentName(), arm->InterfaceName());
     } else {
@@ -1932,6 +2421,27 @@ bool mtsIntuitiveResearchKitConsole::AddArmInterfaces(Arm * arm)
     return true;
 }
 
+std::string mtsIntuitiveResearchKitConsole::ConsoleComponentName(const std::string & name) const
+{
+    // arms and tele-operations created by this console
+    const auto arm = mArms.find(name);
+    if (arm != mArms.end()) {
+        return arm->second->ComponentName();
+    }
+    const auto teleopPSM = mTeleopsPSM.find(name);
+    if (teleopPSM != mTeleopsPSM.end()) {
+        return teleopPSM->second->ComponentName();
+    }
+    if (mTeleopECM && (mTeleopECM->Name() == name)) {
+        return mTeleopECM->ComponentName();
+    }
+    if (name == "io") {
+        return m_IO_component_name;
+    }
+    // any other component
+    return name;
+}
+
 bool mtsIntuitiveResearchKitConsole::Connect(void)
 {
     mConnections.Connect();
@@ -1949,7 +2459,7 @@ bool mtsIntuitiveResearchKitConsole::Connect(void)
         // connect to SUJ if needed
         if (arm->SUJInterfaceRequiredFromIO && arm->SUJInterfaceRequiredToSUJ) {
             componentManager->Connect(this->GetName(), arm->SUJInterfaceRequiredToSUJ->GetName(),
-                                      "SUJ", arm->Name());
+                                      ConsoleComponentName("SUJ"), arm->Name());
             componentManager->Connect(this->GetName(), arm->SUJInterfaceRequiredFromIO->GetName(),
                                       arm->IOComponentName(), arm->Name() + "-SUJClutch");
         }
@@ -1961,6 +2471,7 @@ bool mtsIntuitiveResearchKitConsole::Connect(void)
 void mtsIntuitiveResearchKitConsole::power_off(void)
 {
     teleop_enable(false);
+    m_startup->Abort(mtsManagerLocal::GetInstance()->GetTimeServer().GetRelativeTime());
     for (auto & arm : mArms) {
         arm.second->state_command(std::string("disable"));
     }
@@ -1969,17 +2480,57 @@ void mtsIntuitiveResearchKitConsole::power_off(void)
 void mtsIntuitiveResearchKitConsole::power_on(void)
 {
     DisableFaultyArms();
-    for (auto & arm : mArms) {
-        arm.second->state_command(std::string("enable"));
-    }
+    StartupBegin("enable");
 }
 
 void mtsIntuitiveResearchKitConsole::home(void)
 {
     DisableFaultyArms();
-    for (auto & arm : mArms) {
-        arm.second->state_command(std::string("home"));
+    StartupBegin("home");
+}
+
+void mtsIntuitiveResearchKitConsole::startup_report(std::string & report) const
+{
+    report = m_startup->Report();
+}
+
+void mtsIntuitiveResearchKitConsole::StartupBegin(const std::string & command)
+{
+    // last known state for each arm, arms without state yet need power
+    std::map<std::string, prmOperatingState> arms;
+    for (const auto & arm : mArms) {
+        const auto armState = ArmStates.find(arm.first);
+        if (armState != ArmStates.end()) {
+            arms[arm.first] = armState->second;
+        } else {
+            arms[arm.first] = prmOperatingState();
+        }
     }
+    std::list<std::string> start;
+    m_startup->Begin(command, arms,
+                     mtsManagerLocal::GetInstance()->GetTimeServer().GetRelativeTime(),
+                     start);
+    StartupSendCommand(start);
+}
+
+void mtsIntuitiveResearchKitConsole::StartupSendCommand(const std::list<std::string> & arms)
+{
+    for (const auto & name : arms) {
+        const auto arm = mArms.find(name);
+        if (arm != mArms.end()) {
+            arm->second->state_command(m_startup->Command());
+        }
+    }
+}
+
+void mtsIntuitiveResearchKitConsole::SetArmStateName(const std::string & armName,
+                                                     const std::string & state)
+{
+    std::list<std::string> start;
+    m_startup->StateChanged(armName, state,
+                            mtsManagerLocal::GetInstance()->GetTimeServer().GetRelativeTime(),
+                            start);
+    StartupSendCommand(start);
 }
 
 void mtsIntuitiveResearchKitConsole::DisableFaultyArms(void)
@@ -2507,6 +3058,15 @@ void mtsIntuitiveResearchKitConsole::SetArmCurrentState(const std::string & armN
     // save state
     ArmStates[armName] = currentState;
 
+    // staged power on and homing, start next arms if needed
+    std::list<std::string> start;
+    if (m_startup->OperatingStateChanged(armName, currentState,
+                                         mtsManagerLocal::GetInstance()->GetTimeServer().GetRelativeTime(),
+                                         start)) {
+        mInterface->SendStatus(m_startup->Summary());
+    }
+    StartupSendCommand(start);
+
     // emit event (for Qt GUI)
     std::string payload = "";
     if (currentState.IsEnabledAndHomed()) {
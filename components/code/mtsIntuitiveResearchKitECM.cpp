@@ -350,6 +350,8 @@ void mtsIntuitiveResearchKitECM::set_endoscope_type(const std::string & endoscop
     Manipulator->DeleteTools();
     ToolOffset = new robManipulator(ToolOffsetTransformation);
     Manipulator->Attach(ToolOffset);
+    m_measured_kinematics.Reset();
+    m_setpoint_kinematics.Reset();
 
     // update estimated mass for gravity compensation
     double mass;
@@ -145,6 +145,8 @@ void mtsIntuitiveResearchKitMTM::Init(void)
 
     // Gripper
     m_arm_interface->AddCommandReadState(this->StateTable, m_gripper_measured_js, "gripper/measured_js");
+    m_arm_interface->AddCommandWrite(&mtsIntuitiveResearchKitMTM::emulate_gripper_measured_js,
+                                     this, "emulate_gripper_measured_js", m_gripper_measured_js);
     m_arm_interface->AddEventVoid(gripper_events.pinch, "gripper/pinch");
     m_arm_interface->AddEventWrite(gripper_events.closed, "gripper/closed", true);
 }
@@ -294,6 +296,16 @@ void mtsIntuitiveResearchKitMTM::CreateManipulator(void)
     }
 }
 
+void mtsIntuitiveResearchKitMTM::ResizeKinematicsData(void)
+{
+    mtsIntuitiveResearchKitArm::ResizeKinematicsData();
+    // DH parameters might have been reloaded
+    robManipulatorMTM * manipulator = dynamic_cast<robManipulatorMTM *>(Manipulator);
+    if (manipulator) {
+        manipulator->ResetKinematicsCache();
+    }
+}
+
 bool mtsIntuitiveResearchKitMTM::IsHomed(void) const
 {
     return m_powered && m_encoders_biased;
@@ -529,6 +541,12 @@ void mtsIntuitiveResearchKitMTM::GetRobotData(void)
     }
 }
 
+void mtsIntuitiveResearchKitMTM::UpdateGUISnapshot(void)
+{
+    m_gui_snapshot.ToolStateJoint() = m_gripper_measured_js;
+    mtsIntuitiveResearchKitArm::UpdateGUISnapshot();
+}
+
 void mtsIntuitiveResearchKitMTM::control_servo_cf_orientation_locked(void)
 {
     // don't get current joint values!
@@ -650,6 +668,22 @@ void mtsIntuitiveResearchKitMTM::lock_orientation(const vctMatRot3 & orientation
     mtm_events.orientation_locked(m_effort_orientation_locked);
 }
 
+void mtsIntuitiveResearchKitMTM::emulate_gripper_measured_js(const prmStateJoint & gripper)
+{
+    // gripper is read from IO on real arms
+    if (!m_simulated) {
+        m_arm_interface->SendWarning(this->GetName() + ": emulate_gripper_measured_js is only supported in simulation");
+        return;
+    }
+    if (gripper.Position().size() != 1) {
+        m_arm_interface->SendWarning(this->GetName() + ": emulate_gripper_measured_js, incorrect size");
+        return;
+    }
+    m_gripper_measured_js.Position().Assign(gripper.Position());
+    m_gripper_measured_js.Timestamp() = StateTable.GetTic();
+    m_gripper_measured_js.Valid() = true;
+}
+
 void mtsIntuitiveResearchKitMTM::unlock_orientation(void)
 {
     // only unlock if needed
@@ -17,6 +17,7 @@ http://www.cisst.org/cisst/license.txt.
 */
 
 // system include
+#include <cmath>
 #include <iostream>
 #include <time.h>
 
@@ -79,6 +80,53 @@ void mtsIntuitiveResearchKitPSM::tool_full_description(const size_t & index, std
     description = mToolList.FullDescription(index);
 }
 
+void mtsIntuitiveResearchKitPSM::workspace_query(const vctDoubleMat & goals, vctIntVec & status)
+{
+    status.SetSize(goals.rows());
+    if (!m_workspace_map.IsValid() || (goals.cols() != 12)) {
+        status.SetAll(-1);
+        return;
+    }
+    const vctFrm4x4 baseInverse = m_base_frame.Inverse();
+    vctFrm4x4 goal;
+    for (size_t row = 0; row < goals.rows(); ++row) {
+        for (size_t index = 0; index < 3; ++index) {
+            goal.Translation().Element(index) = goals.Element(row, index);
+        }
+        for (size_t r = 0; r < 3; ++r) {
+            for (size_t c = 0; c < 3; ++c) {
+                goal.Rotation().Element(r, c) = goals.Element(row, 3 + 3 * r + c);
+            }
+        }
+        const vctFrm4x4 lastLink = baseInverse * goal * m_tool_offset_inverse;
+        status.Element(row) = m_workspace_map.Query(lastLink.Translation());
+    }
+}
+
+bool mtsIntuitiveResearchKitPSM::WorkspaceMapReachable(const vctFrm4x4 & cartesianGoal) const
+{
+    if (!m_workspace_map.IsValid()) {
+        return true;
+    }
+    const vctFrm4x4 lastLink = cartesianGoal * m_tool_offset_inverse;
+    return (m_workspace_map.Query(lastLink.Translation()) != robPSMWorkspaceMap::UNREACHABLE);
+}
+
+void mtsIntuitiveResearchKitPSM::move_cp(const prmPositionCartesianSet & newPosition)
+{
+    // trajectory goal checked once, servo goals are left to the IK
+    if (m_workspace_map.IsValid()) {
+        vctFrm4x4 goal;
+        goal.From(newPosition.Goal());
+        if (!WorkspaceMapReachable(m_base_frame.Inverse() * goal)) {
+            m_arm_interface->SendError(this->GetName() + ": move_cp, goal outside workspace");
+            m_trajectory_j.goal_reached_event(false);
+            return;
+        }
+    }
+    mtsIntuitiveResearchKitArm::move_cp(newPosition);
+}
+
 void mtsIntuitiveResearchKitPSM::PostConfigure(const Json::Value & jsonConfig,
                                                const cmnPath & configPath,
                                                const std::string & filename)
@@ -101,6 +149,40 @@ void mtsIntuitiveResearchKitPSM::PostConfigure(const Json::Value & jsonConfig,
         load_tool_list(configPath, toolIndexFile);
     }
 
+    // joint compensation, optional
+    const auto jsonCompensationFile = jsonConfig["joint-compensation"];
+    if (!jsonCompensationFile.isNull()) {
+        const auto compensationFile = jsonCompensationFile.asString();
+        const auto fullname = configPath.Find(compensationFile);
+        if (fullname == "") {
+            CMN_LOG_CLASS_INIT_ERROR << "PostConfigure: " << this->GetName()
+                                     << " using file \"" << filename << "\" can't find joint compensation file \""
+                                     << compensationFile << "\" in path: "
+                                     << configPath << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        std::ifstream jsonStream;
+        jsonStream.open(fullname.c_str());
+        Json::Value jsonCompensation;
+        Json::Reader jsonReader;
+        if (!jsonReader.parse(jsonStream, jsonCompensation)) {
+            CMN_LOG_CLASS_INIT_ERROR << "PostConfigure: " << this->GetName()
+                                     << " failed to parse joint compensation file \"" << fullname << "\"" << std::endl
+                                     << jsonReader.getFormattedErrorMessages();
+            exit(EXIT_FAILURE);
+        }
+        std::string errorMessage;
+        m_joint_compensation = new robPSMJointCompensation();
+        if (!m_joint_compensation->ConfigureJSON(jsonCompensation, errorMessage)) {
+            CMN_LOG_CLASS_INIT_ERROR << "PostConfigure: " << this->GetName()
+                                     << " failed to configure joint compensation from \"" << fullname
+                                     << "\": " << errorMessage << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        CMN_LOG_CLASS_INIT_VERBOSE << "PostConfigure: " << this->GetName()
+                                   << " loaded joint compensation from \"" << fullname << "\"" << std::endl;
+    }
+
     // tool detection
     const auto jsonToolDetection = jsonConfig["tool-detection"];
     if (!jsonToolDetection.isNull()) {
@@ -134,6 +216,23 @@ void mtsIntuitiveResearchKitPSM::PostConfigure(const Json::Value & jsonConfig,
     } else {
         mToolDetection = mtsIntuitiveResearchKitToolTypes::AUTOMATIC;
     }
+
+    // velocity feed forward, optional
+    const auto jsonFeedForwardGains = jsonConfig["velocity-feed-forward-gains"];
+    if (!jsonFeedForwardGains.isNull()) {
+        if (jsonFeedForwardGains.size() != 6) {
+            CMN_LOG_CLASS_INIT_ERROR << "PostConfigure: " << this->GetName()
+                                     << ", \"velocity-feed-forward-gains\" in file \""
+                                     << filename << "\" must have 6 elements, found "
+                                     << jsonFeedForwardGains.size() << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        m_velocity_feed_forward.gains.SetSize(6);
+        for (unsigned int index = 0; index < 6; ++index) {
+            m_velocity_feed_forward.gains.at(index) = jsonFeedForwardGains[index].asDouble();
+        }
+        m_velocity_feed_forward.configured = true;
+    }
 }
 
 bool mtsIntuitiveResearchKitPSM::ConfigureTool(const std::string & filename)
@@ -244,6 +343,7 @@ bool mtsIntuitiveResearchKitPSM::ConfigureTool(const std::string & filename)
         }
 
         // load tool tip transform if any (with warning)
+        m_tool_offset_inverse = vctFrm4x4::Identity();
         const Json::Value jsonToolTip = jsonConfig["tooltip-offset"];
         if (jsonToolTip.isNull()) {
             CMN_LOG_CLASS_INIT_WARNING << "ConfigureTool " << this->GetName()
@@ -252,8 +352,12 @@ bool mtsIntuitiveResearchKitPSM::ConfigureTool(const std::string & filename)
             cmnDataJSON<vctFrm4x4>::DeSerializeText(ToolOffsetTransformation, jsonToolTip);
             ToolOffset = new robManipulator(ToolOffsetTransformation);
             Manipulator->Attach(ToolOffset);
+            m_tool_offset_inverse = ToolOffsetTransformation.Inverse();
         }
 
+        // optional workspace map, generated offline with sawIntuitiveResearchKitPSMWorkspaceMap
+        ConfigureWorkspaceMap(fullFilename);
+
         // keep info in log
         std::stringstream dhResult;
         this->Manipulator->PrintKinematics(dhResult);
@@ -362,11 +466,45 @@ bool mtsIntuitiveResearchKitPSM::ConfigureTool(const std::string & filename)
     return true;
 }
 
+void mtsIntuitiveResearchKitPSM::ConfigureWorkspaceMap(const std::string & toolFilename)
+{
+    m_workspace_map = robPSMWorkspaceMap();
+    std::string mapFilename = toolFilename;
+    const std::string extension = ".json";
+    if ((mapFilename.size() > extension.size())
+        && (mapFilename.compare(mapFilename.size() - extension.size(), extension.size(), extension) == 0)) {
+        mapFilename.resize(mapFilename.size() - extension.size());
+    }
+    mapFilename.append(".dvrk-ws");
+    if (!cmnPath::Exists(mapFilename)) {
+        CMN_LOG_CLASS_INIT_VERBOSE << "ConfigureWorkspaceMap " << this->GetName()
+                                   << ": no workspace map \"" << mapFilename << "\"" << std::endl;
+        return;
+    }
+    std::string errorMessage;
+    if (!m_workspace_map.Load(mapFilename, errorMessage)) {
+        CMN_LOG_CLASS_INIT_WARNING << "ConfigureWorkspaceMap " << this->GetName()
+                                   << ": failed to load workspace map, " << errorMessage << std::endl;
+        return;
+    }
+    // map generated for different DH or joint limits, ignore it
+    if (!m_workspace_map.Matches(*Manipulator)) {
+        CMN_LOG_CLASS_INIT_WARNING << "ConfigureWorkspaceMap " << this->GetName()
+                                   << ": workspace map \"" << mapFilename
+                                   << "\" doesn't match the current kinematics, map ignored" << std::endl;
+        m_workspace_map = robPSMWorkspaceMap();
+        return;
+    }
+    CMN_LOG_CLASS_INIT_VERBOSE << "ConfigureWorkspaceMap " << this->GetName()
+                               << ": loaded workspace map \"" << mapFilename << "\"" << std::endl;
+}
+
 void mtsIntuitiveResearchKitPSM::UpdateStateJointKinematics(void)
 {
     // if there is no tool, report joints as PID joints
     if (!IsCartesianReady()) {
         mtsIntuitiveResearchKitArm::UpdateStateJointKinematics();
+        ApplyJointCompensation();
         return;
     }
 
@@ -442,6 +580,25 @@ void mtsIntuitiveResearchKitPSM::UpdateStateJointKinematics(void)
         m_kin_setpoint_js.Timestamp() = m_pid_setpoint_js.Timestamp();
         m_kin_setpoint_js.Valid() = m_pid_setpoint_js.Valid();
     }
+
+    ApplyJointCompensation();
+}
+
+void mtsIntuitiveResearchKitPSM::ApplyJointCompensation(void)
+{
+    // in place so forward kinematics uses corrected positions in same cycle
+    if (m_joint_compensation
+        && (m_kin_measured_js.Position().size() >= 3)
+        && (m_kin_measured_js.Effort().size() >= 2)) {
+        m_joint_compensation->Apply(m_kin_measured_js.Position(),
+                                    m_kin_measured_js.Effort());
+    }
+}
+
+void mtsIntuitiveResearchKitPSM::UpdateGUISnapshot(void)
+{
+    m_gui_snapshot.ToolStateJoint() = m_jaw_measured_js;
+    mtsIntuitiveResearchKitArm::UpdateGUISnapshot();
 }
 
 void mtsIntuitiveResearchKitPSM::ToJointsPID(const vctDoubleVec & jointsKinematics, vctDoubleVec & jointsPID)
@@ -475,7 +632,7 @@ robManipulator::Errno mtsIntuitiveResearchKitPSM::InverseKinematics(vctDoubleVec
 
     // if too close to zero we're going to run into issue in any case
     if (distanceToRCM < 1.0 * cmn_mm) {
-        m_arm_interface->SendWarning(GetName() + ": InverseKinematics, can't solve IK too close to RCM");
+        m_messages->Push(m_PSM_message_codes.too_close_to_RCM);
         return robManipulator::EFAILURE;
     }
 
@@ -487,7 +644,7 @@ robManipulator::Errno mtsIntuitiveResearchKitPSM::InverseKinematics(vctDoubleVec
         // Check for equality Snake joints (4,7) and (5,6)
         if (fabs(jointSet.at(4) - jointSet.at(7)) > 0.00001 ||
             fabs(jointSet.at(5) - jointSet.at(6)) > 0.00001) {
-            m_arm_interface->SendWarning(GetName() + ": InverseKinematics, equality constraint violated");
+            m_messages->Push(m_PSM_message_codes.snake_constraint);
         }
     }
 
@@ -501,9 +658,9 @@ robManipulator::Errno mtsIntuitiveResearchKitPSM::InverseKinematics(vctDoubleVec
         // project away from RCM if not safe, using axis at end of shaft
         vctFrm4x4 f4;
         if (Manipulator->links.size() >= 4) {
-            f4 = Manipulator->ForwardKinematics(jointSet, 4);
+            f4 = m_setpoint_kinematics.ForwardKinematics(*Manipulator, jointSet, 4);
         } else {
-            f4 = Manipulator->ForwardKinematics(jointSet);
+            f4 = m_setpoint_kinematics.ForwardKinematics(*Manipulator, jointSet);
         }
         distanceToRCM = f4.Translation().Norm();
 
@@ -529,9 +686,9 @@ bool mtsIntuitiveResearchKitPSM::IsSafeForCartesianControl(void) const
 {
     vctFrm4x4 f4;
     if (Manipulator->links.size() >= 4) {
-        f4 = Manipulator->ForwardKinematics(m_kin_measured_js.Position(), 4);
+        f4 = m_measured_kinematics.ForwardKinematics(*Manipulator, m_kin_measured_js.Position(), 4);
     } else {
-        f4 = Manipulator->ForwardKinematics(m_kin_measured_js.Position());
+        f4 = m_measured_kinematics.ForwardKinematics(*Manipulator, m_kin_measured_js.Position());
     }
     const double distanceToRCM = f4.Translation().Norm();
     return (distanceToRCM >=  (mtsIntuitiveResearchKit::PSM::SafeDistanceFromRCM
@@ -543,6 +700,12 @@ void mtsIntuitiveResearchKitPSM::Init(void)
     // main initialization from base type
     mtsIntuitiveResearchKitArm::Init();
 
+    // messages sent from control loop
+    m_PSM_message_codes.too_close_to_RCM =
+        m_messages->Register(mtsMessageRing::MESSAGE_WARNING, "InverseKinematics, can't solve IK too close to RCM");
+    m_PSM_message_codes.snake_constraint =
+        m_messages->Register(mtsMessageRing::MESSAGE_WARNING, "InverseKinematics, equality constraint violated");
+
     // state machine specific to PSM, see base class for other states
     mArmState.AddState("CHANGING_COUPLING_ADAPTER");
     mArmState.AddState("ENGAGING_ADAPTER");
@@ -674,6 +837,7 @@ void mtsIntuitiveResearchKitPSM::Init(void)
     m_arm_interface->AddCommandRead(&mtsIntuitiveResearchKitPSM::tool_list_size, this, "tool_list_size");
     m_arm_interface->AddCommandQualifiedRead(&mtsIntuitiveResearchKitPSM::tool_name, this, "tool_name");
     m_arm_interface->AddCommandQualifiedRead(&mtsIntuitiveResearchKitPSM::tool_full_description, this, "tool_full_description");
+    m_arm_interface->AddCommandWriteReturn(&mtsIntuitiveResearchKitPSM::workspace_query, this, "workspace/query");
 
     m_arm_interface->AddCommandWrite(&mtsIntuitiveResearchKitPSM::set_adapter_present, this, "set_adapter_present");
     m_arm_interface->AddCommandWrite(&mtsIntuitiveResearchKitPSM::set_tool_present, this, "set_tool_present");
@@ -1361,9 +1525,130 @@ void mtsIntuitiveResearchKitPSM::servo_jp_internal(const vctDoubleVec & newPosit
     ToJointsPID(newPosition, m_servo_jp_param.Goal());
     m_servo_jp_param.Goal().at(6) = m_jaw_servo_jp;
     m_servo_jp_param.SetTimestamp(StateTable.GetTic());
+    // velocity feed forward
+    if (use_feed_forward()) {
+        feed_forward_internal();
+    }
     PID.servo_jp(m_servo_jp_param);
 }
 
+void mtsIntuitiveResearchKitPSM::servo_cp(const prmPositionCartesianSet & newPosition)
+{
+    mtsIntuitiveResearchKitArm::servo_cp(newPosition);
+    if (!m_velocity_feed_forward.configured) {
+        return;
+    }
+    // ignore velocities not set by user, i.e. not reasonable
+    const vct3 & linear = newPosition.Velocity();
+    const vct3 & angular = newPosition.VelocityAngular();
+    if (linear.IsFinite() && angular.IsFinite()
+        && (linear.Norm() < mtsIntuitiveResearchKit::PSM::VelocityFeedForwardMaxLinear)
+        && (angular.Norm() < mtsIntuitiveResearchKit::PSM::VelocityFeedForwardMaxAngular)) {
+        m_velocity_feed_forward.linear.Assign(linear);
+        m_velocity_feed_forward.angular.Assign(angular);
+    } else {
+        m_velocity_feed_forward.linear.SetAll(0.0);
+        m_velocity_feed_forward.angular.SetAll(0.0);
+    }
+    m_velocity_feed_forward.new_goal = true;
+}
+
+bool mtsIntuitiveResearchKitPSM::use_feed_forward(void) const
+{
+    return m_velocity_feed_forward.configured && IsCartesianReady();
+}
+
+void mtsIntuitiveResearchKitPSM::update_feed_forward(vctDoubleVec & feedForward)
+{
+    feedForward.SetAll(0.0);
+    m_velocity_feed_forward.used = true;
+    // only use velocity for the servo_cp it came with
+    if (!m_velocity_feed_forward.new_goal) {
+        m_velocity_feed_forward.active = false;
+        return;
+    }
+    m_velocity_feed_forward.new_goal = false;
+
+    // world frame to body frame, see measured_cv in GetRobotData
+    vct3 linear, angular;
+    m_measured_cp_frame.Rotation().ApplyInverseTo(m_velocity_feed_forward.linear, linear);
+    m_measured_cp_frame.Rotation().ApplyInverseTo(m_velocity_feed_forward.angular, angular);
+    m_velocity_feed_forward.twist.SetSize(6);
+    m_velocity_feed_forward.twist.Ref(3, 0).Assign(linear);
+    m_velocity_feed_forward.twist.Ref(3, 3).Assign(angular);
+
+    // joint velocities, number of kinematic joints depends on tool
+    m_velocity_feed_forward.jacobian.ForceAssign(m_body_jacobian);
+    if ((m_velocity_feed_forward.pinverse_data.PInverse().rows() != m_body_jacobian.cols())
+        || (m_velocity_feed_forward.pinverse_data.PInverse().cols() != 6)) {
+        m_velocity_feed_forward.pinverse_data.Allocate(m_velocity_feed_forward.jacobian);
+    }
+    nmrPInverse(m_velocity_feed_forward.jacobian, m_velocity_feed_forward.pinverse_data);
+    m_velocity_feed_forward.joint_velocity.SetSize(NumberOfJointsKinematics());
+    m_velocity_feed_forward.joint_velocity.ProductOf(m_velocity_feed_forward.pinverse_data.PInverse(),
+                                                     m_velocity_feed_forward.twist);
+    m_velocity_feed_forward.joint_velocity_pid.SetSize(NumberOfJoints());
+    m_velocity_feed_forward.joint_velocity_pid.SetAll(0.0);
+    ToJointsPID(m_velocity_feed_forward.joint_velocity, m_velocity_feed_forward.joint_velocity_pid);
+
+    // pseudo-inverse is unbounded near singularities and RCM, clamp
+    // joint velocities to the trajectory limits
+    for (size_t index = 0; index < 6; ++index) {
+        const double velocityMax = m_trajectory_j.v_max.at(index);
+        double & velocity = m_velocity_feed_forward.joint_velocity_pid.at(index);
+        if (!std::isfinite(velocity)) {
+            velocity = 0.0;
+        } else if (velocity > velocityMax) {
+            velocity = velocityMax;
+        } else if (velocity < -velocityMax) {
+            velocity = -velocityMax;
+        }
+    }
+
+    // jaw is not affected
+    feedForward.Ref(6).ElementwiseProductOf(m_velocity_feed_forward.gains,
+                                            m_velocity_feed_forward.joint_velocity_pid.Ref(6));
+
+    // never more than PID/IO effort limits
+    if ((m_pid_configuration_js.EffortMin().size() == feedForward.size())
+        && (m_pid_configuration_js.EffortMax().size() == feedForward.size())) {
+        for (size_t index = 0; index < 6; ++index) {
+            double & effort = feedForward.at(index);
+            if (effort > m_pid_configuration_js.EffortMax().at(index)) {
+                effort = m_pid_configuration_js.EffortMax().at(index);
+            } else if (effort < m_pid_configuration_js.EffortMin().at(index)) {
+                effort = m_pid_configuration_js.EffortMin().at(index);
+            }
+        }
+    }
+    m_velocity_feed_forward.active = true;
+}
+
+void mtsIntuitiveResearchKitPSM::RunHomed(void)
+{
+    mtsIntuitiveResearchKitArm::RunHomed();
+    // servo_cp stopped or other control mode, remove velocity feed
+    // forward since the PID keeps the last one
+    if (m_velocity_feed_forward.used) {
+        m_velocity_feed_forward.used = false;
+    } else if (m_velocity_feed_forward.active) {
+        m_feed_forward_jf.ForceTorque().SetAll(0.0);
+        PID.feed_forward_jf(m_feed_forward_jf);
+        m_velocity_feed_forward.active = false;
+    }
+}
+
+void mtsIntuitiveResearchKitPSM::LeaveHomed(void)
+{
+    if (m_velocity_feed_forward.active) {
+        m_feed_forward_jf.ForceTorque().SetAll(0.0);
+        PID.feed_forward_jf(m_feed_forward_jf);
+        m_velocity_feed_forward.active = false;
+    }
+    m_velocity_feed_forward.new_goal = false;
+    mtsIntuitiveResearchKitArm::LeaveHomed();
+}
+
 void mtsIntuitiveResearchKitPSM::jaw_servo_jf(const prmForceTorqueJointSet & effort)
 {
     if (!ArmIsReady("servo_jf", mtsIntuitiveResearchKitArmTypes::CARTESIAN_SPACE)) {
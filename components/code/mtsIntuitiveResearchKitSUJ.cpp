@@ -399,10 +399,21 @@ mtsIntuitiveResearchKitSUJ::mtsIntuitiveResearchKitSUJ(const mtsTaskPeriodicCons
     Init();
 }
 
+mtsIntuitiveResearchKitSUJ::~mtsIntuitiveResearchKitSUJ()
+{
+    delete m_messages;
+}
+
 void mtsIntuitiveResearchKitSUJ::Init(void)
 {
     mSimulatedTimer = 0.0;
 
+    // messages sent from control loop
+    m_messages = new mtsMessageRing(*this, GetName());
+    m_message_mux_unexpected =
+        m_messages->Register(mtsMessageRing::MESSAGE_WARNING,
+                             "unexpected multiplexer value, actual: {0}, expected: {1}");
+
     // initialize arm pointers
     for (size_t armIndex = 0; armIndex < 4; ++armIndex) {
         Arms[armIndex] = 0;
@@ -849,6 +860,7 @@ void mtsIntuitiveResearchKitSUJ::TransitionEnabled(void)
 
 void mtsIntuitiveResearchKitSUJ::Startup(void)
 {
+    m_messages->Start();
     SetDesiredState("DISABLED");
 }
 
@@ -863,6 +875,8 @@ void mtsIntuitiveResearchKitSUJ::Run(void)
                       + ", caught exception \"" + e.what() + "\"");
         SetDesiredState("DISABLED");
     }
+    // messages from control loop, if any
+    DispatchMessages();
     // trigger ExecOut event
     RunEvent();
     ProcessQueuedCommands();
@@ -919,6 +933,7 @@ void mtsIntuitiveResearchKitSUJ::Run(void)
 
 void mtsIntuitiveResearchKitSUJ::Cleanup(void)
 {
+    m_messages->Stop();
     // Disable PWM
     SetLiftVelocity(0.0);
     PWM.DisablePWM(true);
@@ -1002,8 +1017,7 @@ void mtsIntuitiveResearchKitSUJ::GetAndConvertPotentiometerValues(void)
     // compute pot index
     mMuxIndex = (mMuxState[0]?1:0) + (mMuxState[1]?2:0) + (mMuxState[2]?4:0) + (mMuxState[3]?8:0);
     if (mMuxIndex != mMuxIndexExpected) {
-        DispatchWarning(this->GetName() + ": unexpected multiplexer value.");
-        CMN_LOG_CLASS_RUN_ERROR << "GetAndConvertPotentiometerValues: mux from IO board, actual: " << mMuxIndex << ", expected: " << mMuxIndexExpected << std::endl;
+        m_messages->Push(m_message_mux_unexpected, mMuxIndex, mMuxIndexExpected);
         ResetMux();
         SetHomed(false);
         return;
@@ -1355,6 +1369,25 @@ void mtsIntuitiveResearchKitSUJ::DispatchStatus(const std::string & message)
     }
 }
 
+void mtsIntuitiveResearchKitSUJ::DispatchMessages(void)
+{
+    mtsMessageRing::Level level;
+    std::string message;
+    while (m_messages->Pop(level, message)) {
+        switch (level) {
+        case mtsMessageRing::MESSAGE_ERROR:
+            DispatchError(message);
+            break;
+        case mtsMessageRing::MESSAGE_WARNING:
+            DispatchWarning(message);
+            break;
+        default:
+            DispatchStatus(message);
+            break;
+        }
+    }
+}
+
 void mtsIntuitiveResearchKitSUJ::DispatchState(void)
 {
     state_events.current_state(mArmState.CurrentState());
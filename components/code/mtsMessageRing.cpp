@@ -0,0 +1,358 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+// system include
+#include <cstring>
+#include <sstream>
+
+// cisst
+#include <sawIntuitiveResearchKit/mtsMessageRing.h>
+
+#include <cisstCommon/cmnUnits.h>
+#include <cisstOSAbstraction/osaGetTime.h>
+#include <cisstMultiTask/mtsInterfaceProvided.h>
+
+namespace {
+    // replace all occurrences of pattern in message
+    void mtsMessageRingReplace(std::string & message,
+                               const std::string & pattern,
+                               const std::string & value)
+    {
+        size_t position = message.find(pattern);
+        while (position != std::string::npos) {
+            message.replace(position, pattern.size(), value);
+            position = message.find(pattern, position + value.size());
+        }
+    }
+}
+
+mtsMessageRing::mtsMessageRing(const cmnGenericObject & owner,
+                               const std::string & name,
+                               const size_t size):
+    OwnerServices(owner.Services()),
+    m_name(name),
+    m_errors_pending(false),
+    m_dropped(0),
+    m_running(false)
+{
+    m_records.SetSize(size);
+    m_messages.SetSize(size);
+}
+
+mtsMessageRing::~mtsMessageRing()
+{
+    Stop();
+}
+
+size_t mtsMessageRing::Register(const Level level,
+                                const std::string & format,
+                                const double minimumInterval)
+{
+    if (m_running) {
+        CMN_LOG_CLASS_INIT_ERROR << "MessageRing::Register: " << m_name
+                                 << ", can't register \"" << format
+                                 << "\" after Start" << std::endl;
+        return m_formats.size();
+    }
+    Format newFormat;
+    newFormat.m_level = level;
+    newFormat.m_format = format;
+    newFormat.m_minimum_interval = minimumInterval;
+    newFormat.m_last_sent = 0.0;
+    newFormat.m_suppressed = 0;
+    newFormat.m_has_values = (format.find('{') != std::string::npos);
+    newFormat.m_prefixed = m_name + ": " + format;
+    newFormat.m_error_pending = 0;
+    newFormat.m_error_repeats = 0;
+    newFormat.m_error_last_sent = -minimumInterval;
+    m_formats.push_back(newFormat);
+    return m_formats.size() - 1;
+}
+
+bool mtsMessageRing::Push(const size_t code,
+                          const double value0,
+                          const double value1,
+                          const char * text)
+{
+    // errors bypass the ring and formatting thread
+    if ((code < m_formats.size())
+        && (m_formats[code].m_level == MESSAGE_ERROR)) {
+        PushError(m_formats[code], value0, value1, text);
+        return true;
+    }
+
+    Record * record = m_records.Next();
+    if (!record) {
+        m_dropped++;
+        return false;
+    }
+    record->m_code = code;
+    record->m_values[0] = value0;
+    record->m_values[1] = value1;
+    if (text) {
+        strncpy(record->m_text, text, TEXT_SIZE - 1);
+        record->m_text[TEXT_SIZE - 1] = '\0';
+    } else {
+        record->m_text[0] = '\0';
+    }
+    m_records.Commit();
+    return true;
+}
+
+void mtsMessageRing::PushError(Format & format,
+                               const double value0,
+                               const double value1,
+                               const char * text)
+{
+    // keep first record, only count repeats
+    if (format.m_error_pending == 0) {
+        Record & record = format.m_error_first;
+        record.m_values[0] = value0;
+        record.m_values[1] = value1;
+        if (text) {
+            strncpy(record.m_text, text, TEXT_SIZE - 1);
+            record.m_text[TEXT_SIZE - 1] = '\0';
+        } else {
+            record.m_text[0] = '\0';
+        }
+    }
+    format.m_error_pending++;
+    m_errors_pending = true;
+}
+
+void mtsMessageRing::DrainErrors(const double now)
+{
+    if (!m_errors_pending) {
+        return;
+    }
+    m_errors_pending = false;
+    for (auto & format : m_formats) {
+        if ((format.m_error_pending == 0) && (format.m_error_repeats == 0)) {
+            continue;
+        }
+        // within minimum interval, count until it has elapsed
+        if ((now - format.m_error_last_sent) < format.m_minimum_interval) {
+            format.m_error_repeats += format.m_error_pending;
+            format.m_error_pending = 0;
+            m_errors_pending = true;
+            continue;
+        }
+        Message error;
+        error.m_level = MESSAGE_ERROR;
+        size_t repeats = format.m_error_repeats;
+        if (format.m_error_pending > 0) {
+            repeats += format.m_error_pending - 1;
+            if (format.m_has_values) {
+                const Record & record = format.m_error_first;
+                error.m_message = m_name + ": " + FormatRecord(format, record.m_values[0],
+                                                               record.m_values[1], record.m_text);
+            } else {
+                error.m_message = format.m_prefixed;
+            }
+        } else {
+            // only repeats left from previous interval
+            error.m_message = format.m_prefixed;
+            mtsMessageRingReplace(error.m_message, "{0}", "?");
+            mtsMessageRingReplace(error.m_message, "{1}", "?");
+            mtsMessageRingReplace(error.m_message, "{text}", "");
+        }
+        if (repeats > 0) {
+            std::stringstream suppressed;
+            suppressed << " (" << repeats << " similar message(s) suppressed)";
+            error.m_message.append(suppressed.str());
+        }
+        format.m_error_pending = 0;
+        format.m_error_repeats = 0;
+        format.m_error_last_sent = now;
+        CMN_LOG_CLASS_RUN_ERROR << error.m_message << std::endl;
+        m_errors.push_back(error);
+    }
+}
+
+void mtsMessageRing::Start(void)
+{
+    if (m_running) {
+        return;
+    }
+    m_running = true;
+    const std::string threadName = "Msg" + m_name;
+    m_thread.Create<mtsMessageRing, void *>(this, &mtsMessageRing::ThreadRun, nullptr,
+                                            threadName.c_str());
+}
+
+void mtsMessageRing::Stop(void)
+{
+    if (!m_running) {
+        return;
+    }
+    m_running = false;
+    m_signal.Raise();
+    m_thread.Wait();
+}
+
+void * mtsMessageRing::ThreadRun(void * CMN_UNUSED(argument))
+{
+    while (m_running) {
+        // low rate is fine, messages are for humans
+        m_signal.Wait(20.0 * cmn_ms);
+        const double now = osaGetTime();
+        Record * record = m_records.Front();
+        while (record) {
+            ProcessRecord(*record, now);
+            m_records.Release();
+            record = m_records.Front();
+        }
+        FlushSuppressed(now);
+    }
+    return nullptr;
+}
+
+std::string mtsMessageRing::FormatRecord(const Format & format,
+                                         const double value0,
+                                         const double value1,
+                                         const char * text) const
+{
+    std::string message = format.m_format;
+    std::stringstream value;
+    value << value0;
+    mtsMessageRingReplace(message, "{0}", value.str());
+    value.str("");
+    value << value1;
+    mtsMessageRingReplace(message, "{1}", value.str());
+    mtsMessageRingReplace(message, "{text}", text ? text : "");
+    return message;
+}
+
+void mtsMessageRing::ProcessRecord(const Record & record, const double now)
+{
+    if (record.m_code >= m_formats.size()) {
+        CMN_LOG_CLASS_RUN_ERROR << "MessageRing: " << m_name
+                                << ", unknown message code " << record.m_code << std::endl;
+        return;
+    }
+    Format & format = m_formats.at(record.m_code);
+
+    // rate limit, only count
+    if ((now - format.m_last_sent) < format.m_minimum_interval) {
+        format.m_suppressed++;
+        return;
+    }
+
+    std::string message = FormatRecord(format, record.m_values[0], record.m_values[1],
+                                       record.m_text);
+    if (format.m_suppressed > 0) {
+        std::stringstream suppressed;
+        suppressed << " (" << format.m_suppressed << " similar message(s) suppressed)";
+        message.append(suppressed.str());
+        format.m_suppressed = 0;
+    }
+    format.m_last_sent = now;
+    Send(format.m_level, m_name + ": " + message);
+}
+
+void mtsMessageRing::FlushSuppressed(const double now)
+{
+    // report messages suppressed since last one sent
+    for (auto & format : m_formats) {
+        if ((format.m_suppressed > 0)
+            && ((now - format.m_last_sent) >= format.m_minimum_interval)) {
+            std::stringstream message;
+            message << m_name << ": " << format.m_format
+                    << " (" << format.m_suppressed << " similar message(s) suppressed)";
+            std::string result = message.str();
+            mtsMessageRingReplace(result, "{0}", "?");
+            mtsMessageRingReplace(result, "{1}", "?");
+            mtsMessageRingReplace(result, "{text}", "");
+            format.m_suppressed = 0;
+            format.m_last_sent = now;
+            Send(format.m_level, result);
+        }
+    }
+}
+
+void mtsMessageRing::Send(const Level level, const std::string & message)
+{
+    switch (level) {
+    case MESSAGE_ERROR:
+        CMN_LOG_CLASS_RUN_ERROR << message << std::endl;
+        break;
+    case MESSAGE_WARNING:
+        CMN_LOG_CLASS_RUN_WARNING << message << std::endl;
+        break;
+    default:
+        CMN_LOG_CLASS_RUN_VERBOSE << message << std::endl;
+        break;
+    }
+    Message * slot = m_messages.Next();
+    if (!slot) {
+        m_dropped++;
+        return;
+    }
+    slot->m_level = level;
+    slot->m_message = message;
+    m_messages.Commit();
+}
+
+bool mtsMessageRing::Pop(Level & level, std::string & message)
+{
+    // errors first
+    DrainErrors(osaGetTime());
+    if (!m_errors.empty()) {
+        level = MESSAGE_ERROR;
+        message.assign(m_errors.front().m_message);
+        m_errors.pop_front();
+        return true;
+    }
+    Message * slot = m_messages.Front();
+    if (!slot) {
+        return false;
+    }
+    level = slot->m_level;
+    message.assign(slot->m_message);
+    m_messages.Release();
+    return true;
+}
+
+void mtsMessageRing::Forward(mtsInterfaceProvided * interfaceProvided,
+                             const size_t maxMessages)
+{
+    Level level;
+    std::string message;
+    // errors are never deferred
+    DrainErrors(osaGetTime());
+    while (!m_errors.empty()) {
+        Pop(level, message);
+        interfaceProvided->SendError(message);
+    }
+    for (size_t index = 0; index < maxMessages; ++index) {
+        if (!Pop(level, message)) {
+            return;
+        }
+        switch (level) {
+        case MESSAGE_ERROR:
+            interfaceProvided->SendError(message);
+            break;
+        case MESSAGE_WARNING:
+            interfaceProvided->SendWarning(message);
+            break;
+        default:
+            interfaceProvided->SendStatus(message);
+            break;
+        }
+    }
+}
@@ -0,0 +1,241 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+// system include
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+
+// cisst
+#include <sawIntuitiveResearchKit/mtsParallelArmExecutor.h>
+
+#include <cisstCommon/cmnUnits.h>
+#include <cisstOSAbstraction/osaGetTime.h>
+#include <cisstMultiTask/mtsInterfaceProvided.h>
+
+CMN_IMPLEMENT_SERVICES_DERIVED_ONEARG(mtsParallelArmExecutor, mtsTaskPeriodic, mtsTaskPeriodicConstructorArg);
+
+mtsParallelArmExecutor::mtsParallelArmExecutor(const std::string & componentName, const double periodInSeconds):
+    mtsTaskPeriodic(componentName, periodInSeconds)
+{
+    Init();
+}
+
+mtsParallelArmExecutor::mtsParallelArmExecutor(const mtsTaskPeriodicConstructorArg & arg):
+    mtsTaskPeriodic(arg)
+{
+    Init();
+}
+
+mtsParallelArmExecutor::~mtsParallelArmExecutor()
+{
+    for (auto worker : m_workers) {
+        delete worker;
+    }
+    for (auto arm : m_arms) {
+        delete arm;
+    }
+}
+
+void mtsParallelArmExecutor::Init(void)
+{
+    m_number_of_threads_set = false;
+    m_number_of_threads = 0;
+    m_workers_stop = false;
+
+    m_cycle_duration = 0.0;
+    m_cycle_duration_max = 0.0;
+    m_cycle_duration_sum = 0.0;
+    m_number_of_cycles = 0;
+
+    StateTable.AddData(m_cycle_duration, "cycle_duration");
+
+    m_interface = AddInterfaceProvided("Executor");
+    if (m_interface) {
+        m_interface->AddCommandReadState(StateTable, StateTable.PeriodStats,
+                                         "period_statistics"); // mtsIntervalStatistics
+        m_interface->AddCommandReadState(StateTable, m_cycle_duration,
+                                         "cycle_duration");
+    }
+}
+
+std::string mtsParallelArmExecutor::InterfaceName(const std::string & armName) const
+{
+    return "ExecOut-" + armName;
+}
+
+bool mtsParallelArmExecutor::AddArm(const std::string & name)
+{
+    for (auto arm : m_arms) {
+        if (arm->m_name == name) {
+            CMN_LOG_CLASS_INIT_ERROR << "AddArm: " << this->GetName()
+                                     << ", arm \"" << name << "\" already added" << std::endl;
+            return false;
+        }
+    }
+
+    ArmData * arm = new ArmData;
+    arm->m_name = name;
+    arm->m_duration = 0.0;
+    arm->m_duration_max = 0.0;
+    arm->m_duration_sum = 0.0;
+
+    mtsInterfaceProvided * interfaceProvided = AddInterfaceProvided(InterfaceName(name));
+    if (!interfaceProvided) {
+        CMN_LOG_CLASS_INIT_ERROR << "AddArm: " << this->GetName()
+                                 << ", failed to add interface for arm \"" << name << "\"" << std::endl;
+        delete arm;
+        return false;
+    }
+    // same event name as ExecOut so arms can use their ExecIn interface
+    interfaceProvided->AddEventVoid(arm->RunEvent, "RunEvent");
+
+    StateTable.AddData(arm->m_duration, name + "_duration");
+    m_interface->AddCommandReadState(StateTable, arm->m_duration,
+                                     name + "/duration");
+    m_arms.push_back(arm);
+    return true;
+}
+
+void mtsParallelArmExecutor::SetNumberOfThreads(const size_t numberOfThreads)
+{
+    m_number_of_threads_set = true;
+    m_number_of_threads = numberOfThreads;
+}
+
+void mtsParallelArmExecutor::Startup(void)
+{
+    if (!m_number_of_threads_set) {
+        m_number_of_threads = m_arms.empty() ? 0 : m_arms.size() - 1;
+    }
+    if (m_number_of_threads >= m_arms.size()) {
+        m_number_of_threads = m_arms.empty() ? 0 : m_arms.size() - 1;
+    }
+
+    // static distribution, arm i goes to slot i modulo number of
+    // slots, slot 0 being the IO thread
+    for (size_t index = 0; index < m_number_of_threads; ++index) {
+        m_workers.push_back(new Worker);
+    }
+    const size_t nbSlots = m_number_of_threads + 1;
+    for (size_t index = 0; index < m_arms.size(); ++index) {
+        const size_t slot = index % nbSlots;
+        if (slot == 0) {
+            m_local_arms.push_back(m_arms.at(index));
+        } else {
+            m_workers.at(slot - 1)->m_arms.push_back(m_arms.at(index));
+        }
+    }
+
+    m_workers_stop = false;
+    for (size_t index = 0; index < m_workers.size(); ++index) {
+        const std::string threadName = "ArmExec" + std::to_string(index);
+        m_workers.at(index)->m_thread.Create<mtsParallelArmExecutor, Worker *>
+            (this, &mtsParallelArmExecutor::WorkerRun, m_workers.at(index), threadName.c_str());
+    }
+
+    CMN_LOG_CLASS_INIT_VERBOSE << "Startup: " << this->GetName() << " running "
+                               << m_arms.size() << " arm(s) using "
+                               << m_number_of_threads << " worker thread(s)" << std::endl;
+}
+
+void * mtsParallelArmExecutor::WorkerRun(Worker * worker)
+{
+    while (true) {
+        worker->m_start.Wait();
+        if (m_workers_stop) {
+            break;
+        }
+        RunArms(worker->m_arms);
+        worker->m_done.Raise();
+    }
+    return 0;
+}
+
+void mtsParallelArmExecutor::RunArms(const std::vector<ArmData *> & arms)
+{
+    for (auto arm : arms) {
+        const double start = osaGetTime();
+        arm->RunEvent();
+        arm->m_duration = osaGetTime() - start;
+    }
+}
+
+void mtsParallelArmExecutor::Run(void)
+{
+    ProcessQueuedCommands();
+
+    const double start = osaGetTime();
+
+    // fork
+    for (auto worker : m_workers) {
+        worker->m_start.Raise();
+    }
+    RunArms(m_local_arms);
+    // join
+    for (auto worker : m_workers) {
+        worker->m_done.Wait();
+    }
+
+    m_cycle_duration = osaGetTime() - start;
+
+    // statistics, each arm's duration is only written by one thread
+    // and read after the barrier
+    m_number_of_cycles++;
+    m_cycle_duration_sum += m_cycle_duration;
+    if (m_cycle_duration > m_cycle_duration_max) {
+        m_cycle_duration_max = m_cycle_duration;
+    }
+    for (auto arm : m_arms) {
+        arm->m_duration_sum += arm->m_duration;
+        if (arm->m_duration > arm->m_duration_max) {
+            arm->m_duration_max = arm->m_duration;
+        }
+    }
+}
+
+void mtsParallelArmExecutor::Cleanup(void)
+{
+    // stop and join workers
+    m_workers_stop = true;
+    for (auto worker : m_workers) {
+        worker->m_start.Raise();
+    }
+    for (auto worker : m_workers) {
+        worker->m_thread.Wait();
+    }
+
+    // timing report
+    if (m_number_of_cycles == 0) {
+        return;
+    }
+    const double cycles = static_cast<double>(m_number_of_cycles);
+    std::stringstream report;
+    report << std::fixed << std::setprecision(3)
+           << "Cleanup: " << this->GetName() << " timing report for "
+           << m_number_of_cycles << " cycles (average/max in ms)" << std::endl;
+    for (auto arm : m_arms) {
+        report << " - " << arm->m_name << ": "
+               << (arm->m_duration_sum / cycles) / cmn_ms << " / "
+               << arm->m_duration_max / cmn_ms << std::endl;
+    }
+    report << " - total: "
+           << (m_cycle_duration_sum / cycles) / cmn_ms << " / "
+           << m_cycle_duration_max / cmn_ms << std::endl;
+    CMN_LOG_CLASS_INIT_VERBOSE << report.str();
+}
@@ -5,7 +5,7 @@
   Author(s):  Pretham Chalasani, Anton Deguet
   Created on: 2016-11-04
 
-  (C) Copyright 2016-2017 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2016-2021 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -16,7 +16,11 @@ http://www.cisst.org/cisst/license.txt.
 --- end cisst license ---
 */
 
+#include <algorithm>
+#include <cstring>
+
 #include <sawIntuitiveResearchKit/mtsSocketBasePSM.h>
+#include <cisstVector/vctAxisAngleRotation3.h>
 #include <cisstMultiTask/mtsInterfaceProvided.h>
 #include <cisstMultiTask/mtsManagerLocal.h>
 
@@ -25,8 +29,11 @@ mtsSocketBasePSM::mtsSocketBasePSM(const std::string & componentName, const doub
     mtsTaskPeriodic(componentName, periodInSeconds),
     mIsServer(isServer),
     mTimeServer(mtsComponentManager::GetInstance()->GetTimeServer()),
+    mExtrapolationHorizon(EXTRAPOLATION_HORIZON),
+    mExtrapolating(false),
     mPacketsLost(0),
-    mPacketsDelayed(0)
+    mPacketsDelayed(0),
+    mPacketsExtrapolated(0)
 {
     Command.Socket = new osaSocket(osaSocket::UDP);
     Command.IpPort = port;
@@ -37,6 +44,8 @@ mtsSocketBasePSM::mtsSocketBasePSM(const std::string & componentName, const doub
     this->StateTable.AddData(mPacketsLost, "PacketsLost");
     this->StateTable.AddData(mPacketsDelayed, "PacketsDelayed");
     this->StateTable.AddData(mLoopTime, "LoopTime");
+    this->StateTable.AddData(mExtrapolating, "Extrapolating");
+    this->StateTable.AddData(mPacketsExtrapolated, "PacketsExtrapolated");
     this->StateTable.AddData(Command.Data.Header.Id, "CommandId");
     this->StateTable.AddData(State.Data.Header.Id, "StateId");
 
@@ -47,6 +56,8 @@ mtsSocketBasePSM::mtsSocketBasePSM(const std::string & componentName, const doub
         interfaceProvided->AddCommandReadState(this->StateTable, mPacketsLost, "GetPacketsLost");
         interfaceProvided->AddCommandReadState(this->StateTable, mPacketsDelayed, "GetPacketsDelayed");
         interfaceProvided->AddCommandReadState(this->StateTable, mLoopTime, "GetLoopTime");
+        interfaceProvided->AddCommandReadState(this->StateTable, mExtrapolating, "GetExtrapolating");
+        interfaceProvided->AddCommandReadState(this->StateTable, mPacketsExtrapolated, "GetPacketsExtrapolated");
         if (mIsServer) {
             interfaceProvided->AddCommandReadState(this->StateTable, Command.Data.Header.Id, "GetLastReceivedPacketId");
             interfaceProvided->AddCommandReadState(this->StateTable, State.Data.Header.Id, "GetLastSentPacketId");
@@ -72,6 +83,7 @@ void mtsSocketBasePSM::UpdateStatistics(void)
             State.Data.Header.Id = 1;
             mPacketsLost = 0;
             mPacketsDelayed = 0;
+            mPacketsExtrapolated = 0;
         } else {
             if (State.Data.Header.Id != 0) {
                 deltaPacket = Command.Data.Header.Id - State.Data.Header.LastId;
@@ -83,6 +95,7 @@ void mtsSocketBasePSM::UpdateStatistics(void)
             Command.Data.Header.Id = 1;
             mPacketsLost = 0;
             mPacketsDelayed = 0;
+            mPacketsExtrapolated = 0;
         } else {
             if (Command.Data.Header.Id != 0) {
                 deltaPacket = State.Data.Header.Id - Command.Data.Header.LastId;
@@ -96,3 +109,88 @@ void mtsSocketBasePSM::UpdateStatistics(void)
         mPacketsLost += (deltaPacket - 1);
     }
 }
+
+void mtsSocketBasePSM::SetExtrapolationHorizon(const double horizon)
+{
+    mExtrapolationHorizon = horizon;
+}
+
+int mtsSocketBasePSM::ReceiveLatest(osaSocket * socket, char * buffer)
+{
+    // timeout of 0, returns right away if there's nothing to read
+    int bytesRead = 0;
+    int dropped = -1;
+    int received = socket->Receive(mReceiveBuffer, BUFFER_SIZE, 0.0);
+    while (received > 0) {
+        memcpy(buffer, mReceiveBuffer, received);
+        bytesRead = received;
+        ++dropped;
+        received = socket->Receive(mReceiveBuffer, BUFFER_SIZE, 0.0);
+    }
+    if (dropped > 0) {
+        CMN_LOG_CLASS_RUN_DEBUG << "ReceiveLatest: catching up, dropped "
+                                << dropped << " packet(s)" << std::endl;
+    }
+    return bytesRead;
+}
+
+bool mtsSocketBasePSM::Extrapolate(vctFrm3 & pose, double & jaw)
+{
+    mExtrapolating = (mExtrapolationHorizon > 0.0)
+        && mExtrapolator.Predict(mTimeServer.GetRelativeTime(), mExtrapolationHorizon,
+                                 pose, jaw);
+    if (mExtrapolating) {
+        mPacketsExtrapolated++;
+    }
+    return mExtrapolating;
+}
+
+constexpr double mtsSocketBasePSM::Extrapolator::MaxRatio;
+
+void mtsSocketBasePSM::Extrapolator::Reset(void)
+{
+    m_count = 0;
+}
+
+void mtsSocketBasePSM::Extrapolator::Add(const vctFrm3 & pose, const double jaw,
+                                         const double remoteTime, const double localTime)
+{
+    m_pose[0] = m_pose[1];
+    m_jaw[0] = m_jaw[1];
+    m_remote_time[0] = m_remote_time[1];
+    m_pose[1] = pose;
+    m_jaw[1] = jaw;
+    m_remote_time[1] = remoteTime;
+    m_local_time = localTime;
+    if (m_count < 2) {
+        m_count++;
+    }
+}
+
+bool mtsSocketBasePSM::Extrapolator::Predict(const double localTime, const double horizon,
+                                             vctFrm3 & pose, double & jaw) const
+{
+    const double elapsed = localTime - m_local_time;
+    const double delta = m_remote_time[1] - m_remote_time[0];
+    if ((m_count < 2) || (elapsed > horizon) || (delta <= 0.0)) {
+        return false;
+    }
+    // don't extrapolate further than a couple of sender periods
+    const double ratio = std::min(elapsed / delta, MaxRatio);
+
+    // translation and jaw
+    pose.Translation().DifferenceOf(m_pose[1].Translation(), m_pose[0].Translation());
+    pose.Translation().Multiply(ratio);
+    pose.Translation().Add(m_pose[1].Translation());
+    jaw = m_jaw[1] + ratio * (m_jaw[1] - m_jaw[0]);
+
+    // rotation, same angular velocity around same axis
+    vctMatRot3 step;
+    step.ProductOf(m_pose[1].Rotation(), m_pose[0].Rotation().Inverse());
+    vctAxAnRot3 axisAngle;
+    axisAngle.FromNormalized(step);
+    axisAngle.Angle() *= ratio;
+    step.FromNormalized(axisAngle);
+    pose.Rotation().ProductOf(step, m_pose[1].Rotation());
+    return true;
+}
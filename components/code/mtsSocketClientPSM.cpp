@@ -134,41 +134,49 @@ void mtsSocketClientPSM::jaw_servo_jp(const prmPositionJointSet & position)
 
 void mtsSocketClientPSM::ReceivePSMStateData(void)
 {
-    // Recv Scoket Data
-    size_t bytesRead = 0;
-    bytesRead = State.Socket->Receive(State.Buffer, BUFFER_SIZE, TIMEOUT);
+    // Recv Socket Data, doesn't block
+    const int bytesRead = ReceiveLatest(State.Socket, State.Buffer);
     if (bytesRead > 0) {
-        if (bytesRead != State.Data.Header.Size){
-            std::cerr << CMN_LOG_DETAILS << "Incorrect bytes read " << bytesRead << ". Looking for " << State.Data.Header.Size << " bytes." << std::endl;
+        if (bytesRead != SERVER_MSG_SIZE) {
+            std::cerr << CMN_LOG_DETAILS << "Incorrect bytes read " << bytesRead << ". Looking for " << SERVER_MSG_SIZE << " bytes." << std::endl;
         }
 
         std::stringstream ss;
         cmnDataFormat local, remote;
         ss.write(State.Buffer, bytesRead);
-
-        // Dequeue all the datagrams and only use the latest one.
-        int readCounter = 0;
-        int dataLeft = bytesRead;
-        while (dataLeft > 0) {
-            dataLeft = State.Socket->Receive(State.Buffer, BUFFER_SIZE, 0);
-            if (dataLeft != 0) {
-                bytesRead = dataLeft;
+        socketStatePSM received;
+        cmnData<socketStatePSM>::DeSerializeBinary(received, ss, local, remote);
+
+        // ignore packets received out of order, id 1 is a server restart
+        const bool restart = (received.Header.Id == 1) && (State.Data.Header.Id > 1);
+        if ((received.Header.Id > State.Data.Header.Id) || restart) {
+            if (restart) {
+                mExtrapolator.Reset();
             }
-
-            readCounter++;
-        }
-
-        if (readCounter > 1) {
-            std::cerr << CMN_LOG_DETAILS << "Catching up : " << readCounter << std::endl;
+            State.Data = received;
+            State.Data.CurrentPose.NormalizedSelf();
+            mExtrapolator.Add(State.Data.CurrentPose, State.Data.CurrentJaw,
+                              State.Data.Header.Timestamp, mTimeServer.GetRelativeTime());
+            mExtrapolating = false;
+            UpdateApplication();
+            return;
         }
+    }
 
-        ss.write(State.Buffer, bytesRead);
-        cmnData<socketStatePSM>::DeSerializeBinary(State.Data, ss, local, remote);
-
-        State.Data.CurrentPose.NormalizedSelf();
-        UpdateApplication();
+    // late packet, extrapolate from last two packets
+    const bool wasExtrapolating = mExtrapolating;
+    vctFrm3 pose;
+    double jaw;
+    if (Extrapolate(pose, jaw)) {
+        m_measured_cp.Position().FromNormalized(pose);
+        m_jaw_measured_js.Position().at(0) = jaw;
     } else {
-        CMN_LOG_CLASS_RUN_DEBUG << "RecvPSMStateData: UDP receive failed" << std::endl;
+        // past the horizon, go back to the last values received
+        if (wasExtrapolating) {
+            m_measured_cp.Position().FromNormalized(State.Data.CurrentPose);
+            m_jaw_measured_js.Position().at(0) = State.Data.CurrentJaw;
+        }
+        CMN_LOG_CLASS_RUN_DEBUG << "RecvPSMStateData: no new UDP packet" << std::endl;
     }
 }
 
@@ -84,15 +84,20 @@ void mtsSocketServerPSM::ExecutePSMCommands(void)
         }
     }
 
+    ServoPSM(Command.Data.GoalPose, Command.Data.GoalJaw);
+}
+
+void mtsSocketServerPSM::ServoPSM(const vctFrm3 & pose, const double jaw)
+{
     // Only send when in cartesian mode
     switch (CurrentState) {
     case socketMessages::SCK_CART_POS:
         // send cartesian goal
-        m_setpoint_cp.Goal().From(Command.Data.GoalPose);
+        m_setpoint_cp.Goal().From(pose);
         servo_cp(m_setpoint_cp);
         // send jaw goal
         m_jaw_setpoint_jp.Goal().SetSize(1);
-        m_jaw_setpoint_jp.Goal().Element(0) = Command.Data.GoalJaw;
+        m_jaw_setpoint_jp.Goal().Element(0) = jaw;
         jaw_servo_jp(m_jaw_setpoint_jp);
         break;
     default:
@@ -102,41 +107,47 @@ void mtsSocketServerPSM::ExecutePSMCommands(void)
 
 void mtsSocketServerPSM::ReceivePSMCommandData(void)
 {
-    // Recv Socket Data
-    int bytesRead = 0;
-    bytesRead = Command.Socket->Receive(Command.Buffer, BUFFER_SIZE, TIMEOUT);
+    // Recv Socket Data, doesn't block
+    const int bytesRead = ReceiveLatest(Command.Socket, Command.Buffer);
     if (bytesRead > 0) {
-        if (bytesRead != Command.Data.Header.Size) {
-            std::cerr << CMN_LOG_DETAILS << "Incorrect bytes read " << bytesRead << ". Looking for " << Command.Data.Header.Size << " bytes." << std::endl;
+        if (bytesRead != CLIENT_MSG_SIZE) {
+            std::cerr << CMN_LOG_DETAILS << "Incorrect bytes read " << bytesRead << ". Looking for " << CLIENT_MSG_SIZE << " bytes." << std::endl;
         }
 
         std::stringstream ss;
         cmnDataFormat local, remote;
         ss.write(Command.Buffer, bytesRead);
-
-        // Dequeue all the datagrams and only use the latest one.
-        int readCounter = 0;
-        int dataLeft = bytesRead;
-        while (dataLeft > 0) {
-            dataLeft = Command.Socket->Receive(Command.Buffer, BUFFER_SIZE, 0);
-            if (dataLeft != 0) {
-                bytesRead = dataLeft;
+        socketCommandPSM received;
+        cmnData<socketCommandPSM>::DeSerializeBinary(received, ss, local, remote);
+
+        // ignore packets received out of order, id 1 is a client restart
+        const bool restart = (received.Header.Id == 1) && (Command.Data.Header.Id > 1);
+        if ((received.Header.Id > Command.Data.Header.Id) || restart) {
+            if (restart) {
+                mExtrapolator.Reset();
             }
-            readCounter++;
-        }
-
-        if (readCounter > 1) {
-            std::cerr << CMN_LOG_DETAILS << "Catching up : " << readCounter << std::endl;
+            Command.Data = received;
+            Command.Data.GoalPose.NormalizedSelf();
+            mExtrapolator.Add(Command.Data.GoalPose, Command.Data.GoalJaw,
+                              Command.Data.Header.Timestamp, mTimeServer.GetRelativeTime());
+            mExtrapolating = false;
+            ExecutePSMCommands();
+            return;
         }
+    }
 
-        ss.write(Command.Buffer, bytesRead);
-        cmnData<socketCommandPSM>::DeSerializeBinary(Command.Data, ss, local, remote);
-
-        Command.Data.GoalPose.NormalizedSelf();
-        ExecutePSMCommands();
-
+    // late packet, extrapolate goals from last two packets
+    const bool wasExtrapolating = mExtrapolating;
+    vctFrm3 pose;
+    double jaw;
+    if (Extrapolate(pose, jaw)) {
+        ServoPSM(pose, jaw);
     } else {
-        CMN_LOG_CLASS_RUN_DEBUG << "RecvPSMCommandData: UDP receive failed" << std::endl;
+        // past the horizon, hold the last goal received, not the last extrapolated one
+        if (wasExtrapolating) {
+            ServoPSM(Command.Data.GoalPose, Command.Data.GoalJaw);
+        }
+        CMN_LOG_CLASS_RUN_DEBUG << "RecvPSMCommandData: no new UDP packet" << std::endl;
     }
 }
 
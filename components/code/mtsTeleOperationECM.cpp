@@ -19,6 +19,7 @@ http://www.cisst.org/cisst/license.txt.
 
 // system include
 #include <iostream>
+#include <sstream>
 
 // cisst
 #include <sawIntuitiveResearchKit/mtsTeleOperationECM.h>
@@ -26,6 +27,7 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstCommon/cmnUnits.h>
 #include <cisstMultiTask/mtsInterfaceProvided.h>
 #include <cisstMultiTask/mtsInterfaceRequired.h>
+#include <cisstOSAbstraction/osaGetTime.h>
 #include <cisstParameterTypes/prmOperatingState.h>
 #include <cisstParameterTypes/prmForceCartesianSet.h>
 
@@ -190,6 +192,7 @@ void mtsTeleOperationECM::Init(void)
         mInterface->AddCommandReadState(StateTable,
                                         mECM.m_measured_cp,
                                         "ECM/measured_cp");
+        m_deadline.AddToInterface(StateTable, mInterface);
         // events
         mInterface->AddEventWrite(MessageEvents.desired_state,
                                   "desired_state", std::string(""));
@@ -247,6 +250,17 @@ void mtsTeleOperationECM::Configure(const Json::Value & jsonConfig)
     if (!jsonValue.empty()) {
         m_scale = jsonValue.asDouble();
     }
+
+    // optional cycle duration budget
+    jsonValue = jsonConfig["deadline"];
+    if (!jsonValue.empty()) {
+        std::string errorMessage;
+        if (!m_deadline.ConfigureJSON(jsonValue, errorMessage)) {
+            CMN_LOG_CLASS_INIT_ERROR << "Configure " << this->GetName()
+                                     << ": \"deadline\", " << errorMessage << std::endl;
+            exit(EXIT_FAILURE);
+        }
+    }
 }
 
 void mtsTeleOperationECM::Startup(void)
@@ -258,11 +272,57 @@ void mtsTeleOperationECM::Startup(void)
 
 void mtsTeleOperationECM::Run(void)
 {
+    const double start = osaGetTime();
     ProcessQueuedCommands();
     ProcessQueuedEvents();
 
     // run based on state
     mTeleopState.Run();
+
+    if (m_deadline.Update(osaGetTime() - start)) {
+        DeadlineLevelChanged();
+    }
+}
+
+void mtsTeleOperationECM::DeadlineLevelChanged(void)
+{
+    std::stringstream message;
+    const mtsDeadlineMonitor::Level level = m_deadline.CurrentLevel();
+    if (level == mtsDeadlineMonitor::NOMINAL) {
+        mInterface->SendStatus(this->GetName() + ": cycle duration back within budget, recovered from "
+                               + mtsDeadlineMonitor::LevelName(m_deadline.PreviousLevel()));
+        // re-align arms as when the clutch is released
+        if ((m_deadline.PreviousLevel() >= mtsDeadlineMonitor::FREEZE)
+            && (mTeleopState.CurrentState() == "ENABLED")
+            && !m_clutched) {
+            mTeleopState.SetCurrentState("SETTING_ARMS_STATE");
+        }
+        return;
+    }
+
+    message << this->GetName() << ": cycle duration over budget ("
+            << m_deadline.Budget() / cmn_ms << "ms) for "
+            << m_deadline.ConsecutiveOverruns() << " consecutive cycles, "
+            << mtsDeadlineMonitor::LevelName(level);
+    switch (level) {
+    case mtsDeadlineMonitor::DISABLE:
+        // error event, the console disables all tele-operations
+        mTeleopState.SetDesiredState("DISABLED");
+        mInterface->SendError(message.str());
+        break;
+    case mtsDeadlineMonitor::FREEZE:
+        // ECM holds its last goal, MTMs are held as if clutched
+        mInterface->SendWarning(message.str());
+        if ((mTeleopState.CurrentState() == "ENABLED")
+            && !m_clutched) {
+            Clutch(true);
+        }
+        break;
+    default:
+        // no optional outputs, just report
+        mInterface->SendWarning(message.str());
+        break;
+    }
 }
 
 void mtsTeleOperationECM::Cleanup(void)
@@ -490,7 +550,7 @@ void mtsTeleOperationECM::EnterEnabled(void)
 
 void mtsTeleOperationECM::RunEnabled(void)
 {
-    if (m_clutched) {
+    if (m_clutched || m_deadline.Frozen()) {
         return;
     }
 
@@ -18,12 +18,14 @@
 
 // system include
 #include <iostream>
+#include <sstream>
 
 // cisst
 #include <sawIntuitiveResearchKit/mtsIntuitiveResearchKit.h>
 #include <sawIntuitiveResearchKit/mtsTeleOperationPSM.h>
 #include <cisstMultiTask/mtsInterfaceProvided.h>
 #include <cisstMultiTask/mtsInterfaceRequired.h>
+#include <cisstOSAbstraction/osaGetTime.h>
 #include <cisstParameterTypes/prmOperatingState.h>
 #include <cisstParameterTypes/prmForceCartesianSet.h>
 
@@ -45,10 +47,15 @@ mtsTeleOperationPSM::mtsTeleOperationPSM(const mtsTaskPeriodicConstructorArg & a
 
 mtsTeleOperationPSM::~mtsTeleOperationPSM()
 {
+    if (m_recorder) {
+        delete m_recorder;
+    }
 }
 
 void mtsTeleOperationPSM::Init(void)
 {
+    m_recorder = new mtsDataRecorder(*this, GetName());
+
     // configure state machine
     mTeleopState.AddState("SETTING_ARMS_STATE");
     mTeleopState.AddState("ALIGNING_MTM");
@@ -120,6 +127,7 @@ void mtsTeleOperationPSM::Init(void)
     mtsInterfaceRequired * interfaceRequired = AddInterfaceRequired("MTM");
     if (interfaceRequired) {
         interfaceRequired->AddFunction("measured_cp", mMTM.measured_cp);
+        interfaceRequired->AddFunction("measured_cv", mMTM.measured_cv, MTS_OPTIONAL);
         interfaceRequired->AddFunction("setpoint_cp", mMTM.setpoint_cp);
         interfaceRequired->AddFunction("move_cp", mMTM.move_cp);
         interfaceRequired->AddFunction("gripper/measured_js", mMTM.gripper_measured_js);
@@ -145,6 +153,8 @@ void mtsTeleOperationPSM::Init(void)
         interfaceRequired->AddFunction("state_command", mPSM.state_command);
         interfaceRequired->AddEventHandlerWrite(&mtsTeleOperationPSM::PSMErrorEventHandler,
                                                 this, "error");
+        interfaceRequired->AddEventHandlerWrite(&mtsTeleOperationPSM::PSMFrozenEventHandler,
+                                                this, "frozen");
     }
 
     // footpedal events
@@ -198,6 +208,8 @@ void mtsTeleOperationPSM::Init(void)
         mInterface->AddCommandReadState(this->StateTable,
                                         m_alignment_offset,
                                         "alignment_offset");
+        m_deadline.AddToInterface(this->StateTable, mInterface);
+        m_recorder->AddToInterface(this->StateTable, mInterface);
         // events
         mInterface->AddEventWrite(MessageEvents.desired_state,
                                   "desired_state", std::string(""));
@@ -218,6 +230,10 @@ void mtsTeleOperationPSM::Init(void)
 
     // so sent commands can be used with ros-bridge
     mPSM.m_servo_cp.Valid() = true;
+    // velocity is used by PSM for feed forward
+    mPSM.m_servo_cp.Velocity().SetAll(0.0);
+    mPSM.m_servo_cp.VelocityAngular().SetAll(0.0);
+    mMTM.m_measured_cv.SetValid(false);
     mPSM.m_jaw_servo_jp.Valid() = true;
 }
 
@@ -381,6 +397,55 @@ void mtsTeleOperationPSM::Configure(const Json::Value & jsonConfig)
     if (!jsonValue.empty()) {
         m_align_mtm = jsonValue.asBool();
     }
+
+    // period used when teleop is disabled
+    jsonValue = jsonConfig["idle-period"];
+    if (!jsonValue.empty()) {
+        m_idle_period = jsonValue.asDouble();
+    }
+    if (m_idle_period < 0.0) {
+        CMN_LOG_CLASS_INIT_ERROR << "Configure " << this->GetName()
+                                 << ": \"idle-period\" must be a positive number or 0 to disable.  Found " << m_idle_period << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    // optional cycle duration budget
+    jsonValue = jsonConfig["deadline"];
+    if (!jsonValue.empty()) {
+        std::string errorMessage;
+        if (!m_deadline.ConfigureJSON(jsonValue, errorMessage)) {
+            CMN_LOG_CLASS_INIT_ERROR << "Configure " << this->GetName()
+                                     << ": \"deadline\", " << errorMessage << std::endl;
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    // optional high rate recording
+    jsonValue = jsonConfig["recorder"];
+    if (!jsonValue.empty()) {
+        std::string errorMessage;
+        if (!m_recorder->ConfigureJSON(jsonValue, errorMessage)) {
+            CMN_LOG_CLASS_INIT_ERROR << "Configure " << this->GetName()
+                                     << ": \"recorder\", " << errorMessage << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        // signals, order must match Record
+        m_recorder_mtm_measured_cp = m_recorder->AddSignal("MTM/measured_cp", 12);
+        m_recorder_mtm_measured_cv = m_recorder->AddSignal("MTM/measured_cv", 6);
+        m_recorder_mtm_gripper = m_recorder->AddSignal("MTM/gripper", 1);
+        m_recorder_psm_setpoint_cp = m_recorder->AddSignal("PSM/setpoint_cp", 12);
+        m_recorder_psm_servo_cp = m_recorder->AddSignal("PSM/servo_cp", 12);
+        m_recorder_psm_jaw_servo_jp = m_recorder->AddSignal("PSM/jaw_servo_jp", 1);
+        m_recorder_clutch = m_recorder->AddSignal("clutch", 1);
+        m_recorder_enabled = m_recorder->AddSignal("enabled", 1);
+        m_recorder_following = m_recorder->AddSignal("following", 1);
+        m_recorder_cycle_duration = m_recorder->AddSignal("cycle_duration", 1);
+        if (!m_recorder->CheckSignals(errorMessage)) {
+            CMN_LOG_CLASS_INIT_ERROR << "Configure " << this->GetName()
+                                     << ": \"recorder\", " << errorMessage << std::endl;
+            exit(EXIT_FAILURE);
+        }
+    }
 }
 
 void mtsTeleOperationPSM::Startup(void)
@@ -391,6 +456,18 @@ void mtsTeleOperationPSM::Startup(void)
     lock_rotation(m_rotation_locked);
     lock_translation(m_translation_locked);
     set_align_mtm(m_align_mtm);
+    if (m_recorder->Enabled() && !m_recorder->Start(this->GetPeriodicity())) {
+        CMN_LOG_CLASS_INIT_ERROR << GetName() << ": Startup, failed to start recorder" << std::endl;
+    }
+
+    // number of periods to skip when idle
+    const double period = this->GetPeriodicity();
+    if ((period > 0.0) && (m_idle_period > period)) {
+        m_idle_skip = static_cast<size_t>(m_idle_period / period + 0.5) - 1;
+    } else {
+        m_idle_skip = 0;
+    }
+    m_idle_counter = 0;
 
     // check if functions for jaw are connected
     if (!m_jaw.ignore) {
@@ -404,16 +481,124 @@ void mtsTeleOperationPSM::Startup(void)
 
 void mtsTeleOperationPSM::Run(void)
 {
+    const double start = osaGetTime();
     ProcessQueuedCommands();
     ProcessQueuedEvents();
 
+    // when idle, only read from arms at reduced rate.  Commands and
+    // events are still processed every period so any state_command
+    // (e.g. "enable" from console) takes effect immediately
+    if (IsIdle()) {
+        if (m_idle_counter < m_idle_skip) {
+            ++m_idle_counter;
+            return;
+        }
+    }
+    m_idle_counter = 0;
+
     // run based on state
     mTeleopState.Run();
+
+    const double duration = osaGetTime() - start;
+    if (m_deadline.Update(duration)) {
+        DeadlineLevelChanged();
+    }
+    if (m_recorder->Running()) {
+        Record(duration);
+    }
+}
+
+void mtsTeleOperationPSM::Record(const double duration)
+{
+    // ring full, record dropped
+    if (!m_recorder->Begin(StateTable.GetTic())) {
+        return;
+    }
+    if (m_recorder_mtm_measured_cp) {
+        m_recorder->Append(mMTM.m_measured_cp.Position());
+    }
+    if (m_recorder_mtm_measured_cv) {
+        m_recorder->Append(mMTM.m_measured_cv.VelocityLinear().Pointer(), 3, 3);
+        m_recorder->Append(mMTM.m_measured_cv.VelocityAngular().Pointer(), 3, 3);
+    }
+    if (m_recorder_mtm_gripper) {
+        m_recorder->Append(mMTM.m_gripper_measured_js.Position().Pointer(),
+                           mMTM.m_gripper_measured_js.Position().size(), 1);
+    }
+    if (m_recorder_psm_setpoint_cp) {
+        m_recorder->Append(mPSM.m_setpoint_cp.Position());
+    }
+    if (m_recorder_psm_servo_cp) {
+        m_recorder->Append(mPSM.m_servo_cp.Goal());
+    }
+    if (m_recorder_psm_jaw_servo_jp) {
+        m_recorder->Append(mPSM.m_jaw_servo_jp.Goal().Pointer(),
+                           mPSM.m_jaw_servo_jp.Goal().size(), 1);
+    }
+    if (m_recorder_clutch) {
+        m_recorder->Append(m_clutched ? 1.0 : 0.0);
+    }
+    if (m_recorder_enabled) {
+        // desired state set by console based on operator present
+        m_recorder->Append((mTeleopState.DesiredState() == "ENABLED") ? 1.0 : 0.0);
+    }
+    if (m_recorder_following) {
+        m_recorder->Append(m_following ? 1.0 : 0.0);
+    }
+    if (m_recorder_cycle_duration) {
+        m_recorder->Append(duration);
+    }
+    m_recorder->Commit();
+}
+
+void mtsTeleOperationPSM::DeadlineLevelChanged(void)
+{
+    std::stringstream message;
+    const mtsDeadlineMonitor::Level level = m_deadline.CurrentLevel();
+    if (level == mtsDeadlineMonitor::NOMINAL) {
+        mInterface->SendStatus(this->GetName() + ": cycle duration back within budget, recovered from "
+                               + mtsDeadlineMonitor::LevelName(m_deadline.PreviousLevel()));
+        // re-align arms as when the clutch is released
+        if ((m_deadline.PreviousLevel() >= mtsDeadlineMonitor::FREEZE)
+            && (mTeleopState.CurrentState() == "ENABLED")) {
+            mTeleopState.SetCurrentState("SETTING_ARMS_STATE");
+        }
+        return;
+    }
+
+    message << this->GetName() << ": cycle duration over budget ("
+            << m_deadline.Budget() / cmn_ms << "ms) for "
+            << m_deadline.ConsecutiveOverruns() << " consecutive cycles, "
+            << mtsDeadlineMonitor::LevelName(level);
+    switch (level) {
+    case mtsDeadlineMonitor::DISABLE:
+        // error event, the console disables all tele-operations
+        mTeleopState.SetDesiredState("DISABLED");
+        mInterface->SendError(message.str());
+        break;
+    case mtsDeadlineMonitor::FREEZE:
+        mInterface->SendWarning(message.str());
+        if (mTeleopState.CurrentState() == "ENABLED") {
+            set_following(false);
+            mPSM.Freeze();
+        }
+        break;
+    default:
+        mInterface->SendWarning(message.str());
+        break;
+    }
+}
+
+bool mtsTeleOperationPSM::IsIdle(void)
+{
+    return ((mTeleopState.CurrentState() == "DISABLED")
+            && (mTeleopState.DesiredState() == "DISABLED"));
 }
 
 void mtsTeleOperationPSM::Cleanup(void)
 {
     CMN_LOG_CLASS_INIT_VERBOSE << "Cleanup" << std::endl;
+    m_recorder->Stop();
 }
 
 void mtsTeleOperationPSM::MTMErrorEventHandler(const mtsMessage & message)
@@ -428,6 +613,20 @@ void mtsTeleOperationPSM::PSMErrorEventHandler(const mtsMessage & message)
     mInterface->SendError(this->GetName() + ": received from PSM [" + message.Message + "]");
 }
 
+void mtsTeleOperationPSM::PSMFrozenEventHandler(const bool & frozen)
+{
+    m_PSM_frozen = frozen;
+    if (mTeleopState.CurrentState() != "ENABLED") {
+        return;
+    }
+    if (frozen) {
+        set_following(false);
+    } else {
+        // MTM kept moving, re-align arms as when the clutch is released
+        mTeleopState.SetCurrentState("SETTING_ARMS_STATE");
+    }
+}
+
 void mtsTeleOperationPSM::ClutchEventHandler(const prmEventButton & button)
 {
     switch (button.Type()) {
@@ -639,6 +838,16 @@ void mtsTeleOperationPSM::RunAllStates(void)
         CMN_LOG_CLASS_RUN_ERROR << "Run: call to MTM.setpoint_cp failed \""
                                 << executionResult << "\"" << std::endl;
     }
+    // MTM velocity is optional, used for PSM feed forward.  Skipped if
+    // cycle duration is over budget
+    if (m_deadline.SkipOutputs()) {
+        mMTM.m_measured_cv.SetValid(false);
+    } else if (mMTM.measured_cv.IsValid()) {
+        executionResult = mMTM.measured_cv(mMTM.m_measured_cv);
+        if (!executionResult.IsOK()) {
+            mMTM.m_measured_cv.SetValid(false);
+        }
+    }
 
     // get PSM Cartesian position
     executionResult = mPSM.setpoint_cp(mPSM.m_setpoint_cp);
@@ -903,6 +1112,11 @@ void mtsTeleOperationPSM::EnterEnabled(void)
 
 void mtsTeleOperationPSM::RunEnabled(void)
 {
+    // PSM has been frozen by deadline monitor, wait for recovery
+    if (m_deadline.Frozen() || m_PSM_frozen) {
+        return;
+    }
+
     if (mMTM.m_measured_cp.Valid()
         && mPSM.m_setpoint_cp.Valid()) {
         // follow mode
@@ -943,6 +1157,30 @@ void mtsTeleOperationPSM::RunEnabled(void)
                 mtmPosition.Rotation().ApplyInverseTo(psmCartesianGoal.Rotation(), m_alignment_offset);
             }
 
+            // velocity for PSM feed forward, same transformations as position
+            if (mMTM.m_measured_cv.Valid()) {
+                vct3 psmVelocity(0.0), psmVelocityAngular(0.0);
+                if (!m_translation_locked) {
+                    psmVelocity = m_registration_rotation * mMTM.m_measured_cv.VelocityLinear() * m_scale;
+                }
+                if (!m_rotation_locked) {
+                    psmVelocityAngular = m_registration_rotation * mMTM.m_measured_cv.VelocityAngular();
+                }
+                if (mBaseFrame.measured_cp.IsValid()) {
+                    vctFrm4x4 baseFrame(mBaseFrame.m_measured_cp.Position());
+                    vctMatRot3 baseFrameChange;
+                    baseFrame.Rotation().ApplyInverseTo(mBaseFrame.CartesianInitial.Rotation(), baseFrameChange);
+                    psmVelocity = baseFrameChange * psmVelocity;
+                    psmVelocityAngular = baseFrameChange * psmVelocityAngular;
+                }
+                mPSM.m_servo_cp.Velocity().Assign(psmVelocity);
+                mPSM.m_servo_cp.VelocityAngular().Assign(psmVelocityAngular);
+            } else {
+                // don't resend last velocities received
+                mPSM.m_servo_cp.Velocity().SetAll(0.0);
+                mPSM.m_servo_cp.VelocityAngular().SetAll(0.0);
+            }
+
             // PSM go this cartesian position
             mPSM.m_servo_cp.Goal().FromNormalized(psmCartesianGoal);
             mPSM.servo_cp(mPSM.m_servo_cp);
@@ -0,0 +1,663 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+// system include
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+// cisst
+#include <sawIntuitiveResearchKit/mtsTeleOperationReplay.h>
+#include <cisstMultiTask/mtsInterfaceProvided.h>
+#include <cisstMultiTask/mtsInterfaceRequired.h>
+#include <cisstOSAbstraction/osaGetTime.h>
+#include <cisstParameterTypes/prmEventButton.h>
+
+#include <json/json.h>
+
+CMN_IMPLEMENT_SERVICES_DERIVED_ONEARG(mtsTeleOperationReplay, mtsTaskPeriodic, mtsTaskPeriodicConstructorArg);
+
+namespace {
+    // see mtsDataRecorder.h for file format
+    const char MagicNumber[8] = {'d', 'V', 'R', 'K', 'R', 'E', 'C', '\0'};
+    const size_t PreambleSize = 32;
+
+    // frames are recorded as translation followed by row major rotation
+    void FrameFromRecord(const double * values, vctFrm4x4 & frame) {
+        frame.Translation().Assign(values[0], values[1], values[2]);
+        for (size_t row = 0; row < 3; ++row) {
+            for (size_t column = 0; column < 3; ++column) {
+                frame.Rotation().Element(row, column) = values[3 + row * 3 + column];
+            }
+        }
+    }
+
+    // angle of rotation between two orientations, acos((trace(A^T B) - 1) / 2)
+    double AngleBetween(const vctFrm4x4 & a, const vctFrm4x4 & b) {
+        double trace = 0.0;
+        for (size_t row = 0; row < 3; ++row) {
+            for (size_t column = 0; column < 3; ++column) {
+                trace += a.Rotation().Element(row, column) * b.Rotation().Element(row, column);
+            }
+        }
+        double cosine = 0.5 * (trace - 1.0);
+        if (cosine > 1.0) {
+            cosine = 1.0;
+        } else if (cosine < -1.0) {
+            cosine = -1.0;
+        }
+        return std::acos(cosine);
+    }
+}
+
+bool mtsTeleOperationReplay::Recording::Load(const std::string & filename,
+                                             std::string & errorMessage)
+{
+    std::ifstream file(filename.c_str(), std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        errorMessage = "unable to open \"" + filename + "\"";
+        return false;
+    }
+    const size_t fileSize = file.tellg();
+    file.seekg(0);
+
+    char preamble[PreambleSize];
+    if ((fileSize < PreambleSize)
+        || !file.read(preamble, PreambleSize)
+        || (memcmp(preamble, MagicNumber, 8) != 0)) {
+        errorMessage = "\"" + filename + "\" is not a dVRK recorder file";
+        return false;
+    }
+    uint32_t version, headerSize, numberOfColumns;
+    uint64_t numberOfRecords;
+    memcpy(&version, preamble + 8, sizeof(uint32_t));
+    memcpy(&headerSize, preamble + 12, sizeof(uint32_t));
+    memcpy(&numberOfColumns, preamble + 16, sizeof(uint32_t));
+    memcpy(&numberOfRecords, preamble + 24, sizeof(uint64_t));
+    if ((version != 1) || (headerSize < PreambleSize) || (headerSize > fileSize)
+        || (numberOfColumns == 0)) {
+        errorMessage = "\"" + filename + "\" has an unsupported or corrupted header";
+        return false;
+    }
+
+    // JSON description
+    std::string text(headerSize - PreambleSize, '\0');
+    file.read(&(text[0]), text.size());
+    Json::Value jsonDescription;
+    Json::Reader jsonReader;
+    if (!jsonReader.parse(text.c_str(), jsonDescription)) {
+        errorMessage = "failed to parse description in \"" + filename + "\"";
+        return false;
+    }
+    m_signals.clear();
+    const Json::Value jsonSignals = jsonDescription["signals"];
+    for (unsigned int index = 0; index < jsonSignals.size(); ++index) {
+        m_signals[jsonSignals[index]["name"].asString()]
+            = std::make_pair(static_cast<size_t>(jsonSignals[index]["first-column"].asUInt()),
+                             static_cast<size_t>(jsonSignals[index]["size"].asUInt()));
+    }
+
+    // file might not have been closed properly, use what's available
+    const size_t recordSize = numberOfColumns * sizeof(double);
+    const size_t available = (fileSize - headerSize) / recordSize;
+    if ((numberOfRecords == 0) || (numberOfRecords > available)) {
+        numberOfRecords = available;
+    }
+    m_number_of_columns = numberOfColumns;
+    m_number_of_records = numberOfRecords;
+    m_data.resize(m_number_of_records * m_number_of_columns);
+    if (m_number_of_records > 0) {
+        file.seekg(headerSize);
+        file.read(reinterpret_cast<char *>(m_data.data()), m_number_of_records * recordSize);
+    }
+    // drop records not written yet (time is 0) at end of file
+    while ((m_number_of_records > 0) && (Time(m_number_of_records - 1) == 0.0)) {
+        --m_number_of_records;
+    }
+    if (m_number_of_records == 0) {
+        errorMessage = "\"" + filename + "\" doesn't contain any record";
+        return false;
+    }
+    return true;
+}
+
+bool mtsTeleOperationReplay::Recording::Column(const std::string & name,
+                                               size_t & column, size_t & size) const
+{
+    const auto found = m_signals.find(name);
+    if (found == m_signals.end()) {
+        return false;
+    }
+    column = found->second.first;
+    size = found->second.second;
+    return true;
+}
+
+void mtsTeleOperationReplay::Recording::Advance(size_t & index, const double time) const
+{
+    while (((index + 1) < m_number_of_records)
+           && (Time(index + 1) <= time)) {
+        ++index;
+    }
+}
+
+mtsTeleOperationReplay::mtsTeleOperationReplay(const std::string & componentName, const double periodInSeconds):
+    mtsTaskPeriodic(componentName, periodInSeconds)
+{
+    Init();
+}
+
+mtsTeleOperationReplay::mtsTeleOperationReplay(const mtsTaskPeriodicConstructorArg & arg):
+    mtsTaskPeriodic(arg)
+{
+    Init();
+}
+
+void mtsTeleOperationReplay::Init(void)
+{
+    m_speed = 1.0;
+    m_auto_start = false;
+    m_tolerance.translation = 2.0 * cmn_mm;
+    m_tolerance.orientation = 2.0 * cmnPI_180;
+    m_tolerance.jaw = 2.0 * cmnPI_180;
+    m_tolerance.transition = 0.5 * cmn_s;
+    m_state = IDLE;
+    m_replay_following = false;
+
+    mMTM.m_gripper.Position().SetSize(1);
+
+    mtsInterfaceRequired * interfaceRequired = AddInterfaceRequired("MTM");
+    if (interfaceRequired) {
+        interfaceRequired->AddFunction("operating_state", mMTM.operating_state);
+        interfaceRequired->AddFunction("servo_jp", mMTM.servo_jp);
+        interfaceRequired->AddFunction("move_jp", mMTM.move_jp);
+        interfaceRequired->AddFunction("emulate_gripper_measured_js", mMTM.emulate_gripper_measured_js);
+    }
+
+    interfaceRequired = AddInterfaceRequired("PSM");
+    if (interfaceRequired) {
+        interfaceRequired->AddFunction("operating_state", mPSM.operating_state);
+        interfaceRequired->AddFunction("setpoint_cp", mPSM.setpoint_cp);
+        interfaceRequired->AddFunction("jaw/setpoint_js", mPSM.jaw_setpoint_js, MTS_OPTIONAL);
+        interfaceRequired->AddFunction("move_cp", mPSM.move_cp);
+    }
+
+    interfaceRequired = AddInterfaceRequired("TeleOperation");
+    if (interfaceRequired) {
+        interfaceRequired->AddFunction("deadline_duration", mTeleop.deadline_duration);
+        interfaceRequired->AddEventHandlerWrite(&mtsTeleOperationReplay::FollowingEventHandler,
+                                                this, "following");
+    }
+
+    interfaceRequired = AddInterfaceRequired("Console");
+    if (interfaceRequired) {
+        interfaceRequired->AddFunction("home", mConsole.home);
+        interfaceRequired->AddFunction("teleop_enable", mConsole.teleop_enable);
+        interfaceRequired->AddFunction("emulate_clutch", mConsole.emulate_clutch);
+        interfaceRequired->AddFunction("emulate_operator_present", mConsole.emulate_operator_present);
+    }
+
+    mInterface = AddInterfaceProvided("Replay");
+    if (mInterface) {
+        mInterface->AddMessageEvents();
+        mInterface->AddCommandVoid(&mtsTeleOperationReplay::start, this, "start");
+        mInterface->AddCommandVoid(&mtsTeleOperationReplay::stop, this, "stop");
+        mInterface->AddEventWrite(mEvents.finished, "finished", false);
+    }
+}
+
+void mtsTeleOperationReplay::Configure(const std::string & filename)
+{
+    std::ifstream jsonStream;
+    Json::Value jsonConfig;
+    Json::Reader jsonReader;
+
+    if (filename == "") {
+        return;
+    }
+
+    jsonStream.open(filename.c_str());
+    if (!jsonReader.parse(jsonStream, jsonConfig)) {
+        CMN_LOG_CLASS_INIT_ERROR << "Configure " << this->GetName()
+                                 << ": failed to parse configuration file \""
+                                 << filename << "\"\n"
+                                 << jsonReader.getFormattedErrorMessages();
+        exit(EXIT_FAILURE);
+    }
+
+    CMN_LOG_CLASS_INIT_VERBOSE << "Configure: " << this->GetName()
+                               << " using file \"" << filename << "\"" << std::endl
+                               << "----> content of configuration file: " << std::endl
+                               << jsonConfig << std::endl
+                               << "<----" << std::endl;
+
+    // base component configuration
+    mtsComponent::ConfigureJSON(jsonConfig);
+
+    // JSON part
+    mtsTeleOperationReplay::Configure(jsonConfig);
+}
+
+void mtsTeleOperationReplay::Configure(const Json::Value & jsonConfig)
+{
+    Json::Value jsonValue;
+    std::string errorMessage;
+
+    // recordings, see mtsDataRecorder
+    m_mtm_recording_file = jsonConfig["mtm-recording"].asString();
+    m_teleop_recording_file = jsonConfig["teleop-recording"].asString();
+    if ((m_mtm_recording_file == "") || (m_teleop_recording_file == "")) {
+        CMN_LOG_CLASS_INIT_ERROR << "Configure " << this->GetName()
+                                 << ": \"mtm-recording\" and \"teleop-recording\" are required" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    if (!m_mtm_recording.Load(m_mtm_recording_file, errorMessage)
+        || !m_teleop_recording.Load(m_teleop_recording_file, errorMessage)) {
+        CMN_LOG_CLASS_INIT_ERROR << "Configure " << this->GetName()
+                                 << ": " << errorMessage << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    // required signals
+    size_t size;
+    if (!m_mtm_recording.Column("measured_js", m_mtm_measured_js, size)) {
+        CMN_LOG_CLASS_INIT_ERROR << "Configure " << this->GetName()
+                                 << ": signal \"measured_js\" not found in \""
+                                 << m_mtm_recording_file << "\"" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    // position, velocity and effort, padded with NaN
+    m_mtm_joints = size / 3;
+    const double * first = m_mtm_recording.Record(0) + m_mtm_measured_js;
+    while ((m_mtm_joints > 0) && std::isnan(first[m_mtm_joints - 1])) {
+        --m_mtm_joints;
+    }
+    mMTM.m_servo_jp.Goal().SetSize(m_mtm_joints);
+
+    const char * names[] = {"MTM/gripper", "clutch", "enabled", "PSM/servo_cp", "PSM/jaw_servo_jp", "following"};
+    size_t * columns[] = {&m_gripper, &m_clutch, &m_enabled, &m_servo_cp, &m_jaw_servo_jp, &m_following};
+    for (size_t index = 0; index < 6; ++index) {
+        if (!m_teleop_recording.Column(names[index], *(columns[index]), size)) {
+            CMN_LOG_CLASS_INIT_ERROR << "Configure " << this->GetName()
+                                     << ": signal \"" << names[index] << "\" not found in \""
+                                     << m_teleop_recording_file << "\"" << std::endl;
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    jsonValue = jsonConfig["speed"];
+    if (!jsonValue.empty()) {
+        m_speed = jsonValue.asDouble();
+        if (m_speed <= 0.0) {
+            CMN_LOG_CLASS_INIT_ERROR << "Configure " << this->GetName()
+                                     << ": \"speed\" must be a positive number" << std::endl;
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    jsonValue = jsonConfig["auto-start"];
+    if (!jsonValue.empty()) {
+        m_auto_start = jsonValue.asBool();
+    }
+
+    m_report_file = jsonConfig["report"].asString();
+
+    const Json::Value jsonTolerance = jsonConfig["tolerance"];
+    if (!jsonTolerance.empty()) {
+        const char * toleranceNames[] = {"translation", "orientation", "jaw", "transition"};
+        double * tolerances[] = {&m_tolerance.translation, &m_tolerance.orientation,
+                                 &m_tolerance.jaw, &m_tolerance.transition};
+        for (size_t index = 0; index < 4; ++index) {
+            jsonValue = jsonTolerance[toleranceNames[index]];
+            if (!jsonValue.empty()) {
+                *(tolerances[index]) = jsonValue.asDouble();
+            }
+        }
+    }
+
+    CMN_LOG_CLASS_INIT_VERBOSE << "Configure " << this->GetName() << ": loaded "
+                               << m_mtm_recording.NumberOfRecords() << " MTM and "
+                               << m_teleop_recording.NumberOfRecords() << " tele-operation records" << std::endl;
+}
+
+void mtsTeleOperationReplay::Startup(void)
+{
+    if (m_auto_start) {
+        start();
+    }
+}
+
+void mtsTeleOperationReplay::start(void)
+{
+    if (m_teleop_recording.NumberOfRecords() == 0) {
+        mInterface->SendError(this->GetName() + ": nothing to replay, check configuration");
+        return;
+    }
+    if ((m_state != IDLE) && (m_state != FINISHED)) {
+        mInterface->SendWarning(this->GetName() + ": replay already in progress");
+        return;
+    }
+    // replay covers the tele-operation recording
+    m_start_time = m_teleop_recording.Time(0);
+    m_end_time = m_teleop_recording.Time(m_teleop_recording.NumberOfRecords() - 1);
+    m_replay_time = m_start_time;
+    m_mtm_index = 0;
+    m_teleop_index = 0;
+    m_mtm_recording.Advance(m_mtm_index, m_replay_time);
+    m_clutch_pressed = false;
+    m_operator_present = false;
+    m_recorded_transitions.clear();
+    m_replayed_transitions.clear();
+    memset(&m_statistics, 0, sizeof(m_statistics));
+
+    mInterface->SendStatus(this->GetName() + ": homing arms");
+    mConsole.teleop_enable(false);
+    mConsole.home();
+    m_state = HOMING;
+    m_state_timer = StateTable.GetTic();
+}
+
+void mtsTeleOperationReplay::stop(void)
+{
+    if ((m_state == IDLE) || (m_state == FINISHED)) {
+        return;
+    }
+    mConsole.teleop_enable(false);
+    Report();
+}
+
+void mtsTeleOperationReplay::Run(void)
+{
+    ProcessQueuedCommands();
+    ProcessQueuedEvents();
+
+    switch (m_state) {
+    case HOMING:
+        RunHoming();
+        break;
+    case POSITIONING:
+        RunPositioning();
+        break;
+    case RUNNING:
+        RunReplay();
+        break;
+    default:
+        break;
+    }
+}
+
+void mtsTeleOperationReplay::RunHoming(void)
+{
+    mMTM.operating_state(mMTM.m_operating_state);
+    mPSM.operating_state(mPSM.m_operating_state);
+    if ((mMTM.m_operating_state.State() == prmOperatingState::ENABLED) && mMTM.m_operating_state.IsHomed()
+        && (mPSM.m_operating_state.State() == prmOperatingState::ENABLED) && mPSM.m_operating_state.IsHomed()) {
+        // move both arms to initial recorded positions
+        const double * mtm = m_mtm_recording.Record(m_mtm_index) + m_mtm_measured_js;
+        mMTM.m_servo_jp.Goal().Assign(vctDynamicConstVectorRef<double>(m_mtm_joints, mtm));
+        mMTM.move_jp(mMTM.m_servo_jp);
+        FrameFromRecord(m_teleop_recording.Record(0) + m_servo_cp, mPSM.m_move_cp.Goal());
+        mPSM.move_cp(mPSM.m_move_cp);
+        mInterface->SendStatus(this->GetName() + ": moving arms to initial recorded positions");
+        m_state = POSITIONING;
+        m_state_timer = StateTable.GetTic();
+        return;
+    }
+    if ((StateTable.GetTic() - m_state_timer) > 60.0 * cmn_s) {
+        mInterface->SendError(this->GetName() + ": timeout while homing arms");
+        m_state = IDLE;
+    }
+}
+
+void mtsTeleOperationReplay::RunPositioning(void)
+{
+    // give some time for trajectories to start
+    if ((StateTable.GetTic() - m_state_timer) < 0.5 * cmn_s) {
+        return;
+    }
+    mMTM.operating_state(mMTM.m_operating_state);
+    mPSM.operating_state(mPSM.m_operating_state);
+    if (!mMTM.m_operating_state.IsBusy() && !mPSM.m_operating_state.IsBusy()) {
+        mConsole.teleop_enable(true);
+        mInterface->SendStatus(this->GetName() + ": replaying "
+                               + std::to_string(m_end_time - m_start_time) + "s");
+        m_wall_start = osaGetTime();
+        m_state = RUNNING;
+        return;
+    }
+    if ((StateTable.GetTic() - m_state_timer) > 30.0 * cmn_s) {
+        mInterface->SendError(this->GetName() + ": timeout while moving arms to initial positions");
+        m_state = IDLE;
+    }
+}
+
+void mtsTeleOperationReplay::RunReplay(void)
+{
+    // deterministic, doesn't depend on wall clock
+    m_replay_time += m_speed * this->GetPeriodicity();
+    if (m_replay_time > m_end_time) {
+        mConsole.teleop_enable(false);
+        Report();
+        return;
+    }
+
+    // MTM joint positions
+    m_mtm_recording.Advance(m_mtm_index, m_replay_time);
+    mMTM.m_servo_jp.Goal().Assign(vctDynamicConstVectorRef<double>(m_mtm_joints,
+                                                                   m_mtm_recording.Record(m_mtm_index) + m_mtm_measured_js));
+    mMTM.servo_jp(mMTM.m_servo_jp);
+
+    // buttons and gripper from tele-operation recording
+    const size_t previous = m_teleop_index;
+    m_teleop_recording.Advance(m_teleop_index, m_replay_time);
+    const double * record = m_teleop_recording.Record(m_teleop_index);
+    if (!std::isnan(record[m_gripper])) {
+        mMTM.m_gripper.Position().at(0) = record[m_gripper];
+        mMTM.emulate_gripper_measured_js(mMTM.m_gripper);
+    }
+    const bool clutch = (record[m_clutch] > 0.5);
+    if (clutch != m_clutch_pressed) {
+        m_clutch_pressed = clutch;
+        prmEventButton button;
+        button.SetType(clutch ? prmEventButton::PRESSED : prmEventButton::RELEASED);
+        mConsole.emulate_clutch(button);
+    }
+    const bool present = (record[m_enabled] > 0.5);
+    if (present != m_operator_present) {
+        m_operator_present = present;
+        prmEventButton button;
+        button.SetType(present ? prmEventButton::PRESSED : prmEventButton::RELEASED);
+        mConsole.emulate_operator_present(button);
+    }
+    // recorded following transitions
+    if ((m_teleop_index != previous)
+        && ((record[m_following] > 0.5) != (m_teleop_recording.Record(previous)[m_following] > 0.5))) {
+        m_recorded_transitions.push_back(m_replay_time);
+    }
+
+    Compare();
+}
+
+void mtsTeleOperationReplay::Compare(void)
+{
+    const double * record = m_teleop_recording.Record(m_teleop_index);
+    const bool recordedFollowing = (record[m_following] > 0.5);
+    if (recordedFollowing != m_replay_following) {
+        m_statistics.following_mismatches++;
+    }
+
+    // tele-operation cycle duration
+    double duration;
+    if (mTeleop.deadline_duration(duration).IsOK()) {
+        m_statistics.cycles++;
+        m_statistics.cycle_sum += duration;
+        m_statistics.cycle_sum_square += duration * duration;
+        if (duration > m_statistics.cycle_max) {
+            m_statistics.cycle_max = duration;
+        }
+    }
+
+    // only compare outputs when both are following
+    if (!recordedFollowing || !m_replay_following) {
+        return;
+    }
+    m_statistics.samples++;
+
+    vctFrm4x4 expected;
+    FrameFromRecord(record + m_servo_cp, expected);
+    mPSM.setpoint_cp(mPSM.m_setpoint_cp);
+    const vctFrm4x4 & actual = mPSM.m_setpoint_cp.Position();
+    const double translation = (expected.Translation() - actual.Translation()).Norm();
+    const double orientation = AngleBetween(expected, actual);
+    m_statistics.translation_sum += translation;
+    m_statistics.orientation_sum += orientation;
+    if (translation > m_statistics.translation_max) {
+        m_statistics.translation_max = translation;
+    }
+    if (orientation > m_statistics.orientation_max) {
+        m_statistics.orientation_max = orientation;
+    }
+    if (translation > m_tolerance.translation) {
+        m_statistics.translation_failures++;
+    }
+    if (orientation > m_tolerance.orientation) {
+        m_statistics.orientation_failures++;
+    }
+
+    if (mPSM.jaw_setpoint_js.IsValid()
+        && !std::isnan(record[m_jaw_servo_jp])
+        && mPSM.jaw_setpoint_js(mPSM.m_jaw_setpoint_js).IsOK()
+        && (mPSM.m_jaw_setpoint_js.Position().size() > 0)) {
+        const double jaw = std::abs(record[m_jaw_servo_jp] - mPSM.m_jaw_setpoint_js.Position().at(0));
+        m_statistics.jaw_sum += jaw;
+        if (jaw > m_statistics.jaw_max) {
+            m_statistics.jaw_max = jaw;
+        }
+        if (jaw > m_tolerance.jaw) {
+            m_statistics.jaw_failures++;
+        }
+    }
+}
+
+void mtsTeleOperationReplay::FollowingEventHandler(const bool & following)
+{
+    m_replay_following = following;
+    if (m_state == RUNNING) {
+        m_replayed_transitions.push_back(m_replay_time);
+    }
+}
+
+void mtsTeleOperationReplay::Report(void)
+{
+    m_state = FINISHED;
+    const double wallDuration = osaGetTime() - m_wall_start;
+    const double replayDuration = m_replay_time - m_start_time;
+    const size_t samples = std::max(m_statistics.samples, static_cast<size_t>(1));
+    const size_t cycles = std::max(m_statistics.cycles, static_cast<size_t>(1));
+    const double cycleMean = m_statistics.cycle_sum / cycles;
+    const double cycleVariance = m_statistics.cycle_sum_square / cycles - cycleMean * cycleMean;
+
+    // delays between recorded and replayed following transitions, in order
+    const size_t transitions = std::min(m_recorded_transitions.size(), m_replayed_transitions.size());
+    double delayMax = 0.0, delaySum = 0.0;
+    for (size_t index = 0; index < transitions; ++index) {
+        const double delay = std::abs(m_replayed_transitions[index] - m_recorded_transitions[index]);
+        delaySum += delay;
+        delayMax = std::max(delayMax, delay);
+    }
+
+    // all recorded following transitions must be reproduced, in time
+    const bool transitionsReproduced = (m_recorded_transitions.size() == m_replayed_transitions.size())
+        && (delayMax <= m_tolerance.transition);
+
+    // only the input timeline is deterministic, the tele-operation
+    // still runs on the wall clock so outputs can't be evaluated
+    // when the replay is faster or slower than real time
+    const bool evaluated = (m_speed == 1.0);
+
+    const bool passed = evaluated
+        && (m_statistics.samples > 0)
+        && transitionsReproduced
+        && (m_statistics.translation_failures == 0)
+        && (m_statistics.orientation_failures == 0)
+        && (m_statistics.jaw_failures == 0);
+
+    Json::Value jsonReport;
+    jsonReport["mtm-recording"] = m_mtm_recording_file;
+    jsonReport["teleop-recording"] = m_teleop_recording_file;
+    jsonReport["passed"] = passed;
+    jsonReport["evaluated"] = evaluated;
+    jsonReport["speed"] = m_speed;
+    jsonReport["duration"]["replayed"] = replayDuration;
+    jsonReport["duration"]["wall-clock"] = wallDuration;
+    jsonReport["samples"] = static_cast<Json::UInt>(m_statistics.samples);
+    jsonReport["translation"]["tolerance"] = m_tolerance.translation;
+    jsonReport["translation"]["mean"] = m_statistics.translation_sum / samples;
+    jsonReport["translation"]["max"] = m_statistics.translation_max;
+    jsonReport["translation"]["failures"] = static_cast<Json::UInt>(m_statistics.translation_failures);
+    jsonReport["orientation"]["tolerance"] = m_tolerance.orientation;
+    jsonReport["orientation"]["mean"] = m_statistics.orientation_sum / samples;
+    jsonReport["orientation"]["max"] = m_statistics.orientation_max;
+    jsonReport["orientation"]["failures"] = static_cast<Json::UInt>(m_statistics.orientation_failures);
+    jsonReport["jaw"]["tolerance"] = m_tolerance.jaw;
+    jsonReport["jaw"]["mean"] = m_statistics.jaw_sum / samples;
+    jsonReport["jaw"]["max"] = m_statistics.jaw_max;
+    jsonReport["jaw"]["failures"] = static_cast<Json::UInt>(m_statistics.jaw_failures);
+    jsonReport["following"]["mismatches"] = static_cast<Json::UInt>(m_statistics.following_mismatches);
+    jsonReport["following"]["recorded-transitions"] = static_cast<Json::UInt>(m_recorded_transitions.size());
+    jsonReport["following"]["replayed-transitions"] = static_cast<Json::UInt>(m_replayed_transitions.size());
+    jsonReport["following"]["delay-mean"] = transitions ? delaySum / transitions : 0.0;
+    jsonReport["following"]["delay-max"] = delayMax;
+    jsonReport["following"]["tolerance"] = m_tolerance.transition;
+    jsonReport["following"]["reproduced"] = transitionsReproduced;
+    jsonReport["cycle-duration"]["mean"] = cycleMean;
+    jsonReport["cycle-duration"]["std-dev"] = std::sqrt(std::max(cycleVariance, 0.0));
+    jsonReport["cycle-duration"]["max"] = m_statistics.cycle_max;
+
+    CMN_LOG_CLASS_RUN_VERBOSE << "Report " << this->GetName() << std::endl << jsonReport << std::endl;
+    if (m_report_file != "") {
+        std::ofstream reportStream(m_report_file.c_str());
+        reportStream << jsonReport;
+    }
+
+    std::stringstream message;
+    message << this->GetName() << ": replay ";
+    if (!evaluated) {
+        message << "not evaluated (speed " << m_speed << ", only speed 1 is deterministic)";
+    } else if (m_statistics.samples == 0) {
+        message << "failed (no samples compared)";
+    } else if (!transitionsReproduced) {
+        message << "failed (following transitions not reproduced)";
+    } else {
+        message << (passed ? "passed" : "failed");
+    }
+    message << ", translation max " << m_statistics.translation_max / cmn_mm << "mm"
+            << ", orientation max " << m_statistics.orientation_max / cmnPI_180 << "deg"
+            << ", jaw max " << m_statistics.jaw_max / cmnPI_180 << "deg"
+            << ", tele-operation cycle mean " << cycleMean / cmn_ms << "ms";
+    if (passed) {
+        mInterface->SendStatus(message.str());
+    } else {
+        mInterface->SendWarning(message.str());
+    }
+    mEvents.finished(passed);
+}
@@ -0,0 +1,360 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+// system include
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+#include <cisstCommon/cmnConstants.h>
+#include <cisstVector/vctDataFunctionsTransformationsJSON.h>
+#include <cisstOSAbstraction/osaThread.h>
+#include <cisstRobot/robManipulator.h>
+
+#include <sawIntuitiveResearchKit/robBatchKinematics.h>
+#include <sawIntuitiveResearchKit/robManipulatorMTM.h>
+#include <sawIntuitiveResearchKit/robManipulatorECM.h>
+#include "robGravityCompensationMTM.h"
+
+#include <json/json.h>
+
+robBatchKinematics::robBatchKinematics(void):
+    m_type(GENERIC),
+    m_json_kinematic(nullptr),
+    m_json_gravity(nullptr),
+    m_number_of_joints(0),
+    m_number_of_threads(0)
+{
+}
+
+robBatchKinematics::~robBatchKinematics()
+{
+    DeleteWorkers();
+    delete m_json_kinematic;
+    delete m_json_gravity;
+}
+
+bool robBatchKinematics::Configure(const std::string & type,
+                                   const Json::Value & jsonKinematic,
+                                   const Json::Value & jsonGravity,
+                                   std::string & errorMessage)
+{
+    DeleteWorkers();
+    delete m_json_kinematic;
+    m_json_kinematic = nullptr;
+    delete m_json_gravity;
+    m_json_gravity = nullptr;
+    m_number_of_joints = 0;
+
+    if ((type == "MTM") || (type == "MTML") || (type == "MTMR")) {
+        m_type = MTM;
+    } else if (type == "ECM") {
+        m_type = ECM;
+    } else if (type == "generic") {
+        m_type = GENERIC;
+    } else {
+        errorMessage = "invalid manipulator type \"" + type + "\", must be one of MTM, ECM or generic";
+        return false;
+    }
+
+    if (jsonKinematic["DH"].isNull()) {
+        errorMessage = "kinematic configuration needs \"DH\"";
+        return false;
+    }
+    m_json_kinematic = new Json::Value(jsonKinematic);
+
+    if (!jsonGravity.isNull()) {
+        if (m_type != MTM) {
+            errorMessage = "gravity compensation is only supported for the MTMs";
+            return false;
+        }
+        m_json_gravity = new Json::Value(jsonGravity);
+    }
+
+    // create first worker to validate configuration
+    return CreateWorkers(1, errorMessage);
+}
+
+void robBatchKinematics::SetNumberOfThreads(const size_t numberOfThreads)
+{
+    m_number_of_threads = numberOfThreads;
+}
+
+robManipulator * robBatchKinematics::CreateManipulator(std::string & errorMessage) const
+{
+    robManipulator * manipulator;
+    switch (m_type) {
+    case MTM:
+        manipulator = new robManipulatorMTM();
+        break;
+    case ECM:
+        manipulator = new robManipulatorECM();
+        break;
+    default:
+        manipulator = new robManipulator();
+        break;
+    }
+
+    const Json::Value jsonBase = (*m_json_kinematic)["base-offset"];
+    if (!jsonBase.isNull()) {
+        if (m_type == ECM) {
+            errorMessage = "\"base-offset\" can't be defined for the ECM, see mtsIntuitiveResearchKitECM";
+            delete manipulator;
+            return nullptr;
+        }
+        try {
+            cmnDataJSON<vctFrm4x4>::DeSerializeText(manipulator->Rtw0, jsonBase);
+        } catch (...) {
+            errorMessage = "failed to load \"base-offset\"";
+            delete manipulator;
+            return nullptr;
+        }
+    }
+
+    if (manipulator->LoadRobot((*m_json_kinematic)["DH"]) != robManipulator::ESUCCESS) {
+        errorMessage = "failed to load \"DH\": " + manipulator->LastError();
+        delete manipulator;
+        return nullptr;
+    }
+
+    // same as mtsIntuitiveResearchKitECM::PostConfigure
+    if (m_type == ECM) {
+        vctFrame4x4<double> Rt(vctMatRot3(1.0,            0.0,            0.0,
+                                          0.0,  sqrt(2.0)/2.0,  sqrt(2.0)/2.0,
+                                          0.0, -sqrt(2.0)/2.0,  sqrt(2.0)/2.0),
+                               vct3(0.0, 0.0, 0.0));
+        manipulator->Rtw0 = Rt;
+    }
+    return manipulator;
+}
+
+bool robBatchKinematics::CreateWorkers(const size_t numberOfWorkers,
+                                       std::string & errorMessage)
+{
+    while (m_workers.size() < numberOfWorkers) {
+        Worker * worker = new Worker;
+        worker->Manipulator = CreateManipulator(errorMessage);
+        if (!worker->Manipulator) {
+            delete worker;
+            return false;
+        }
+        if (m_json_gravity) {
+            robGravityCompensationMTM::CreationResult result;
+            try {
+                result = robGravityCompensationMTM::Create(*m_json_gravity);
+            } catch (...) {
+                result.Pointer = nullptr;
+                result.ErrorMessage = "make sure the gravity compensation file is in JSON format";
+            }
+            if (!result.Pointer) {
+                errorMessage = "failed to create gravity compensation: " + result.ErrorMessage;
+                delete worker->Manipulator;
+                delete worker;
+                return false;
+            }
+            worker->GravityCompensation = result.Pointer;
+        }
+        m_number_of_joints = worker->Manipulator->links.size();
+        worker->Positions.SetSize(m_number_of_joints);
+        worker->Velocities.SetSize(m_number_of_joints);
+        worker->Efforts.SetSize(m_number_of_joints);
+        m_workers.push_back(worker);
+    }
+    return true;
+}
+
+void robBatchKinematics::DeleteWorkers(void)
+{
+    for (auto worker : m_workers) {
+        delete worker->Manipulator;
+        delete worker->GravityCompensation;
+        delete worker;
+    }
+    m_workers.clear();
+}
+
+void robBatchKinematics::ForwardKinematics(const double * positions,
+                                           const size_t samples,
+                                           double * frames)
+{
+    Job job;
+    job.Type = FORWARD_KINEMATICS;
+    job.Input = positions;
+    job.Velocities = nullptr;
+    job.Output = frames;
+    job.Status = nullptr;
+    Run(job, samples);
+}
+
+size_t robBatchKinematics::InverseKinematics(const double * frames,
+                                             const size_t samples,
+                                             double * positions,
+                                             int * status)
+{
+    Job job;
+    job.Type = INVERSE_KINEMATICS;
+    job.Input = frames;
+    job.Velocities = nullptr;
+    job.Output = positions;
+    job.Status = status;
+    return Run(job, samples);
+}
+
+bool robBatchKinematics::GravityCompensation(const double * positions,
+                                             const double * velocities,
+                                             const size_t samples,
+                                             double * efforts)
+{
+    if (!m_json_gravity) {
+        return false;
+    }
+    Job job;
+    job.Type = GRAVITY_COMPENSATION;
+    job.Input = positions;
+    job.Velocities = velocities;
+    job.Output = efforts;
+    job.Status = nullptr;
+    Run(job, samples);
+    return true;
+}
+
+size_t robBatchKinematics::Run(const Job & job, const size_t samples)
+{
+    if (m_workers.empty() || (samples == 0)) {
+        return 0;
+    }
+
+    // one block of samples per thread, at least a few hundred samples
+    // per block so the thread creation cost doesn't dominate
+    size_t numberOfThreads = m_number_of_threads;
+    if (numberOfThreads == 0) {
+        numberOfThreads = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    const size_t minimumBlockSize = 256;
+    numberOfThreads = std::max(std::min(numberOfThreads,
+                                        samples / minimumBlockSize), static_cast<size_t>(1));
+    std::string errorMessage;
+    if (!CreateWorkers(numberOfThreads, errorMessage)) {
+        // configuration was valid for first worker, should not happen
+        numberOfThreads = m_workers.size();
+    }
+
+    const size_t blockSize = (samples + numberOfThreads - 1) / numberOfThreads;
+    for (size_t index = 0; index < numberOfThreads; ++index) {
+        Worker * worker = m_workers.at(index);
+        worker->CurrentJob = &job;
+        worker->Begin = std::min(index * blockSize, samples);
+        worker->End = std::min(worker->Begin + blockSize, samples);
+        worker->Failures = 0;
+    }
+
+    // first block is computed in the calling thread
+    std::vector<osaThread *> threads;
+    for (size_t index = 1; index < numberOfThreads; ++index) {
+        osaThread * thread = new osaThread;
+        const std::string threadName = "Batch" + std::to_string(index);
+        thread->Create<robBatchKinematics, Worker *>
+            (this, &robBatchKinematics::WorkerRun, m_workers.at(index), threadName.c_str());
+        threads.push_back(thread);
+    }
+    WorkerRun(m_workers.at(0));
+
+    size_t failures = m_workers.at(0)->Failures;
+    for (size_t index = 1; index < numberOfThreads; ++index) {
+        threads.at(index - 1)->Wait();
+        delete threads.at(index - 1);
+        failures += m_workers.at(index)->Failures;
+    }
+    return failures;
+}
+
+void * robBatchKinematics::WorkerRun(Worker * worker)
+{
+    const Job & job = *(worker->CurrentJob);
+    const size_t joints = m_number_of_joints;
+    vctFrm4x4 frame;
+
+    for (size_t sample = worker->Begin; sample < worker->End; ++sample) {
+        switch (job.Type) {
+
+        case FORWARD_KINEMATICS:
+            {
+                worker->Positions.Assign(job.Input + sample * joints);
+                frame = worker->Manipulator->ForwardKinematics(worker->Positions);
+                double * output = job.Output + sample * 16;
+                for (size_t row = 0; row < 4; ++row) {
+                    for (size_t col = 0; col < 4; ++col) {
+                        *output = frame.Element(row, col);
+                        ++output;
+                    }
+                }
+            }
+            break;
+
+        case INVERSE_KINEMATICS:
+            {
+                const double * input = job.Input + sample * 16;
+                for (size_t row = 0; row < 4; ++row) {
+                    for (size_t col = 0; col < 4; ++col) {
+                        frame.Element(row, col) = *input;
+                        ++input;
+                    }
+                }
+                double * output = job.Output + sample * joints;
+                worker->Positions.Assign(output);
+                const double seed = (joints > 3) ? worker->Positions.Element(3) : 0.0;
+                const robManipulator::Errno result =
+                    worker->Manipulator->InverseKinematics(worker->Positions, frame);
+                if (result == robManipulator::ESUCCESS) {
+                    // same as mtsIntuitiveResearchKitECM::InverseKinematics,
+                    // closest solution mod 2 pi
+                    if (m_type == ECM) {
+                        const double difference = seed - worker->Positions.Element(3);
+                        const double differenceInTurns = nearbyint(difference / (2.0 * cmnPI));
+                        worker->Positions.Element(3) += differenceInTurns * 2.0 * cmnPI;
+                    }
+                    std::copy(worker->Positions.begin(), worker->Positions.end(), output);
+                } else {
+                    ++(worker->Failures);
+                }
+                if (job.Status) {
+                    job.Status[sample] = static_cast<int>(result);
+                }
+            }
+            break;
+
+        case GRAVITY_COMPENSATION:
+            {
+                worker->Positions.Assign(job.Input + sample * joints);
+                if (job.Velocities) {
+                    worker->Velocities.Assign(job.Velocities + sample * joints);
+                } else {
+                    worker->Velocities.SetAll(0.0);
+                }
+                worker->Efforts.SetAll(0.0);
+                worker->GravityCompensation->AddGravityCompensationEfforts(worker->Positions,
+                                                                           worker->Velocities,
+                                                                           worker->Efforts);
+                std::copy(worker->Efforts.begin(), worker->Efforts.end(),
+                          job.Output + sample * joints);
+            }
+            break;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,184 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+  --- begin cisst license - do not edit ---
+
+  This software is provided "as is" under an open source license, with
+  no warranty.  The complete license can be found in license.txt and
+  http://www.cisst.org/cisst/license.txt.
+
+  --- end cisst license ---
+*/
+
+#include <sawIntuitiveResearchKit/robForwardKinematicsCache.h>
+
+robForwardKinematicsCache::robForwardKinematicsCache(void):
+    m_manipulator(0),
+    m_valid(0),
+    m_tool_valid(false)
+{
+    m_prefixes.resize(1);
+    m_prefixes[0] = vctFrm4x4::Identity();
+}
+
+void robForwardKinematicsCache::Reset(void)
+{
+    m_valid = 0;
+    m_tool_valid = false;
+}
+
+bool robForwardKinematicsCache::Update(const robManipulator & manipulator,
+                                       const vctDoubleVec & q,
+                                       const size_t N)
+{
+    const size_t nbLinks = manipulator.links.size();
+
+    // new manipulator or kinematic chain changed
+    if ((&manipulator != m_manipulator)
+        || (m_prefixes.size() != (nbLinks + 1))) {
+        m_manipulator = &manipulator;
+        m_prefixes.resize(nbLinks + 1);
+        m_q.SetSize(nbLinks);
+        Reset();
+    }
+
+    if ((N > nbLinks) || (q.size() < N)) {
+        return false;
+    }
+
+    // find first joint that changed, all prefixes before can be reused
+    size_t first = 0;
+    while ((first < m_valid)
+           && (first < N)
+           && (q.Element(first) == m_q.Element(first))) {
+        ++first;
+    }
+
+    if (first < N) {
+        for (size_t link = first; link < N; ++link) {
+            m_q.Element(link) = q.Element(link);
+            m_prefixes[link + 1] = m_prefixes[link] * manipulator.links[link].ForwardKinematics(q.Element(link));
+        }
+        // prefixes past N were computed from the previous joint values
+        m_valid = N;
+    }
+    return true;
+}
+
+bool robForwardKinematicsCache::UpdateFull(const robManipulator & manipulator,
+                                           const vctDoubleVec & q)
+{
+    const size_t nbLinks = manipulator.links.size();
+    if (!Update(manipulator, q, nbLinks)) {
+        return false;
+    }
+    // tool offset is constant so we can extract it once from the
+    // full chain computed by robManipulator
+    if (!m_tool_valid) {
+        const vctFrm4x4 chain = manipulator.Rtw0 * m_prefixes[nbLinks];
+        m_tool = chain.Inverse() * manipulator.ForwardKinematics(q);
+        m_tool_valid = true;
+    }
+    return true;
+}
+
+vctFrm4x4 robForwardKinematicsCache::ForwardKinematics(const robManipulator & manipulator,
+                                                       const vctDoubleVec & q,
+                                                       const int N)
+{
+    // full chain, including tool
+    if ((N < 0) || (static_cast<size_t>(N) == manipulator.links.size())) {
+        if (!UpdateFull(manipulator, q)) {
+            return manipulator.ForwardKinematics(q);
+        }
+        return manipulator.Rtw0 * m_prefixes[manipulator.links.size()] * m_tool;
+    }
+    if (!Update(manipulator, q, N)) {
+        return manipulator.ForwardKinematics(q, N);
+    }
+    return manipulator.Rtw0 * m_prefixes[N];
+}
+
+void robForwardKinematicsCache::JacobianSpatial(const robManipulator & manipulator,
+                                                const vctDoubleVec & q,
+                                                vctDoubleMat & J)
+{
+    const size_t nbLinks = manipulator.links.size();
+    if (!Update(manipulator, q, nbLinks)
+        || (J.rows() != 6) || (J.cols() != nbLinks)) {
+        manipulator.JacobianSpatial(q, J);
+        return;
+    }
+
+    vctFrm4x4 frame;
+    vct3 z, p, v;
+    for (size_t link = 0; link < nbLinks; ++link) {
+        const robKinematics * kinematics = manipulator.links[link].GetKinematics();
+        // joint axis is z of previous frame for DH, current frame for modified DH
+        if (kinematics->GetConvention() == robKinematics::STANDARD_DH) {
+            frame = manipulator.Rtw0 * m_prefixes[link];
+        } else {
+            frame = manipulator.Rtw0 * m_prefixes[link + 1];
+        }
+        z.Assign(frame.Rotation().Column(2));
+        p.Assign(frame.Translation());
+
+        switch (kinematics->GetType()) {
+        case robJoint::HINGE:
+            v.CrossProductOf(p, z);
+            for (size_t i = 0; i < 3; ++i) {
+                J.Element(i, link) = v.Element(i);
+                J.Element(i + 3, link) = z.Element(i);
+            }
+            break;
+        case robJoint::SLIDER:
+            for (size_t i = 0; i < 3; ++i) {
+                J.Element(i, link) = z.Element(i);
+                J.Element(i + 3, link) = 0.0;
+            }
+            break;
+        default:
+            J.Column(link).SetAll(0.0);
+            break;
+        }
+    }
+}
+
+void robForwardKinematicsCache::JacobianBody(const robManipulator & manipulator,
+                                             const vctDoubleVec & q,
+                                             vctDoubleMat & J)
+{
+    const size_t nbLinks = manipulator.links.size();
+    if (!UpdateFull(manipulator, q)
+        || (J.rows() != 6) || (J.cols() != nbLinks)) {
+        manipulator.JacobianBody(q, J);
+        return;
+    }
+
+    // start from spatial jacobian and express in tool frame
+    JacobianSpatial(manipulator, q, J);
+    const vctFrm4x4 tip = manipulator.Rtw0 * m_prefixes[nbLinks] * m_tool;
+    const vct3 p(tip.Translation());
+    vct3 vs, ws, vb, wb, wxp;
+    for (size_t link = 0; link < nbLinks; ++link) {
+        for (size_t i = 0; i < 3; ++i) {
+            vs.Element(i) = J.Element(i, link);
+            ws.Element(i) = J.Element(i + 3, link);
+        }
+        // linear velocity of the tool tip rather than world origin
+        wxp.CrossProductOf(ws, p);
+        vs.Add(wxp);
+        tip.Rotation().ApplyInverseTo(vs, vb);
+        tip.Rotation().ApplyInverseTo(ws, wb);
+        for (size_t i = 0; i < 3; ++i) {
+            J.Element(i, link) = vb.Element(i);
+            J.Element(i + 3, link) = wb.Element(i);
+        }
+    }
+}
@@ -246,18 +246,23 @@ void robGravityCompensationMTM::ComputeAlphaVel(const vctVec & q_dot)
          ++fric_comp_ratio,
          ++alpha) {
 
-        if (*qd >= *sat_vel) {
-            *alpha = 0.5 + 0.5*(*fric_comp_ratio);
-        } else if (*qd <= -(*sat_vel)) {
-            *alpha = 0.5 - 0.5*(*fric_comp_ratio);
-        } else if ( (*qd <= *bd_vel) && (*qd >= -(*bd_vel)) ) {
-            *alpha = 0.5;
-        } else if ( (*qd > *bd_vel) && (*qd < *sat_vel) ) {
-            *alpha = 0.5*(*fric_comp_ratio)*(*qd - *bd_vel)/(*sat_vel - *bd_vel) + 0.5;
-        } else {
-            *alpha = -0.5*(*fric_comp_ratio)*((-*qd) - *bd_vel)/(*sat_vel - *bd_vel) + 0.5;
-        }
+        *alpha = AlphaVel(*qd, *bd_vel, *sat_vel, *fric_comp_ratio);
+    }
+}
+
+double robGravityCompensationMTM::AlphaVel(const double qd, const double dbVel,
+                                           const double satVel, const double fricCompRatio)
+{
+    if (qd >= satVel) {
+        return 0.5 + 0.5*fricCompRatio;
+    } else if (qd <= -satVel) {
+        return 0.5 - 0.5*fricCompRatio;
+    } else if ( (qd <= dbVel) && (qd >= -dbVel) ) {
+        return 0.5;
+    } else if ( (qd > dbVel) && (qd < satVel) ) {
+        return 0.5*fricCompRatio*(qd - dbVel)/(satVel - dbVel) + 0.5;
     }
+    return -0.5*fricCompRatio*((-qd) - dbVel)/(satVel - dbVel) + 0.5;
 }
 
 void robGravityCompensationMTM::ComputeBetaVel(const vctVec & q_dot)
@@ -57,8 +57,17 @@ public:
     void AddGravityCompensationEfforts(const vctVec & q, const vctVec & q_dot,
                                        vctVec & totalEfforts);
 
-private:
+    /*! Regressor for the dynamic parameters (Pos and Neg), 7 rows
+      and 40 columns.  Only the non-zero elements are assigned so the
+      regressor must be initialized to zero. */
     static void AssignRegressor(const vctVec & q, vctMat & regressor);
+
+    /*! Weight of Pos parameters for version 2 based on the joint
+      velocity, Neg parameters are weighted by 1 - alpha. */
+    static double AlphaVel(const double qd, const double dbVel,
+                           const double satVel, const double fricCompRatio);
+
+private:
     void LimitEfforts(vctVec & efforts) const;
     void ComputeAlphaVel(const vctVec & q_dot);
     void ComputeBetaVel(const vctVec & q_dot);
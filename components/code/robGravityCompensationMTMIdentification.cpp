@@ -0,0 +1,274 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+// system include
+#include <algorithm>
+#include <cmath>
+
+#include <cisstCommon/cmnDataFunctionsJSON.h>
+
+#include <sawIntuitiveResearchKit/robGravityCompensationMTMIdentification.h>
+#include "robGravityCompensationMTM.h"
+
+robGravityCompensationMTMIdentification::robGravityCompensationMTMIdentification(void):
+    m_regularization(1e-6),
+    m_regressor(NumberOfJoints, NumberOfDynamicParameters, 0.0),
+    m_number_of_samples(0),
+    m_effort_min(NumberOfJoints, 0.0),
+    m_effort_max(NumberOfJoints, 0.0),
+    m_pos(NumberOfDynamicParameters, 0.0),
+    m_neg(NumberOfDynamicParameters, 0.0),
+    m_residual_rms(NumberOfJoints, 0.0)
+{
+    // same as share/jhu-dVRK/gc-MTML-22723.json
+    m_db_vel.SetSize(NumberOfJoints);
+    m_db_vel.Assign(0.02, 0.02, 0.02, 0.01, 0.008, 0.008, 0.01);
+    m_sat_vel.SetSize(NumberOfJoints);
+    m_sat_vel.Assign(0.4, 0.2, 0.2, 0.4, 0.4, 0.2, 0.4);
+    m_fric_comp_ratio.SetSize(NumberOfJoints);
+    m_fric_comp_ratio.Assign(0.8, 0.8, 0.8, 0.4, 0.6, 0.6, 1.0);
+
+    for (size_t joint = 0; joint < NumberOfModeledJoints; ++joint) {
+        m_normal[joint].SetSize(NumberOfUnknowns, NumberOfUnknowns);
+        m_normal[joint].SetAll(0.0);
+        m_right_hand_side[joint].SetSize(NumberOfUnknowns);
+        m_right_hand_side[joint].SetAll(0.0);
+        m_effort_square[joint] = 0.0;
+    }
+}
+
+bool robGravityCompensationMTMIdentification::ConfigureJSON(const Json::Value & jsonConfig,
+                                                            std::string & errorMessage)
+{
+    const Json::Value jsonController = jsonConfig["GC_controller"];
+    if (jsonController.isNull()) {
+        errorMessage = "can't find \"GC_controller\"";
+        return false;
+    }
+    const char * names[] = {"db_vel_vec", "sat_vec_vec", "fric_comp_ratio_vec"};
+    vctDoubleVec * vectors[] = {&m_db_vel, &m_sat_vel, &m_fric_comp_ratio};
+    for (size_t index = 0; index < 3; ++index) {
+        const Json::Value jsonValue = jsonController[names[index]];
+        if (jsonValue.isNull()) {
+            continue;
+        }
+        vctDoubleVec vector;
+        cmnDataJSON<vctDoubleVec>::DeSerializeText(vector, jsonValue);
+        if (vector.size() != NumberOfJoints) {
+            errorMessage = std::string("\"") + names[index] + "\" must have "
+                + std::to_string(NumberOfJoints) + " elements";
+            return false;
+        }
+        *(vectors[index]) = vector;
+    }
+    for (size_t joint = 0; joint < NumberOfModeledJoints; ++joint) {
+        if (m_sat_vel.Element(joint) <= m_db_vel.Element(joint)) {
+            errorMessage = "\"sat_vec_vec\" must be greater than \"db_vel_vec\" for joint "
+                + std::to_string(joint + 1);
+            return false;
+        }
+    }
+    return true;
+}
+
+void robGravityCompensationMTMIdentification::Add(const vctDoubleVec & position,
+                                                  const vctDoubleVec & velocity,
+                                                  const vctDoubleVec & effort)
+{
+    // regressor structure doesn't change, no need to reset
+    robGravityCompensationMTM::AssignRegressor(position, m_regressor);
+
+    for (size_t joint = 0; joint < NumberOfModeledJoints; ++joint) {
+        // direction only (ratio 1), the friction compensation ratio
+        // is applied at runtime on top of the identified Pos/Neg models
+        const double alpha = robGravityCompensationMTM::AlphaVel(velocity.Element(joint),
+                                                                 m_db_vel.Element(joint),
+                                                                 m_sat_vel.Element(joint),
+                                                                 1.0);
+        // sparse row, shared gravity parameters then Pos and Neg
+        // polynomials for this joint, indices in increasing order
+        size_t nonZero = 0;
+        for (size_t column = 0; column < NumberOfSharedParameters; ++column) {
+            const double value = m_regressor.Element(joint, column);
+            if (value != 0.0) {
+                m_row[nonZero] = value;
+                m_row_indices[nonZero] = column;
+                ++nonZero;
+            }
+        }
+        const size_t polynomialSize = 5;
+        const size_t first = NumberOfSharedParameters + joint * polynomialSize;
+        const size_t negOffset = NumberOfDynamicParameters - NumberOfSharedParameters;
+        for (size_t column = first; column < first + polynomialSize; ++column) {
+            m_row[nonZero] = alpha * m_regressor.Element(joint, column);
+            m_row_indices[nonZero] = column;
+            ++nonZero;
+        }
+        for (size_t column = first; column < first + polynomialSize; ++column) {
+            m_row[nonZero] = (1.0 - alpha) * m_regressor.Element(joint, column);
+            m_row_indices[nonZero] = column + negOffset;
+            ++nonZero;
+        }
+
+        // upper triangle of normal equations
+        vctDoubleMat & normal = m_normal[joint];
+        vctDoubleVec & rightHandSide = m_right_hand_side[joint];
+        const double tau = effort.Element(joint);
+        for (size_t i = 0; i < nonZero; ++i) {
+            const size_t row = m_row_indices[i];
+            const double value = m_row[i];
+            for (size_t j = i; j < nonZero; ++j) {
+                normal.Element(row, m_row_indices[j]) += value * m_row[j];
+            }
+            rightHandSide.Element(row) += value * tau;
+        }
+        m_effort_square[joint] += tau * tau;
+    }
+
+    if (m_number_of_samples == 0) {
+        m_effort_min.Assign(effort);
+        m_effort_max.Assign(effort);
+    } else {
+        for (size_t joint = 0; joint < NumberOfJoints; ++joint) {
+            m_effort_min.Element(joint) = std::min(m_effort_min.Element(joint), effort.Element(joint));
+            m_effort_max.Element(joint) = std::max(m_effort_max.Element(joint), effort.Element(joint));
+        }
+    }
+    ++m_number_of_samples;
+}
+
+bool robGravityCompensationMTMIdentification::Solve(std::string & errorMessage)
+{
+    if (m_number_of_samples == 0) {
+        errorMessage = "no sample";
+        return false;
+    }
+
+    // sum over joints, full symmetric matrix
+    vctDoubleMat normal(NumberOfUnknowns, NumberOfUnknowns, 0.0);
+    vctDoubleVec rightHandSide(NumberOfUnknowns, 0.0);
+    for (size_t joint = 0; joint < NumberOfModeledJoints; ++joint) {
+        normal.Add(m_normal[joint]);
+        rightHandSide.Add(m_right_hand_side[joint]);
+    }
+    for (size_t row = 0; row < NumberOfUnknowns; ++row) {
+        for (size_t column = 0; column < row; ++column) {
+            normal.Element(row, column) = normal.Element(column, row);
+        }
+    }
+
+    // scale so all diagonal elements are 1, then ridge.  Parameters
+    // not excited by the data are set to 0
+    vctDoubleVec scale(NumberOfUnknowns);
+    for (size_t index = 0; index < NumberOfUnknowns; ++index) {
+        const double diagonal = normal.Element(index, index);
+        scale.Element(index) = (diagonal > 0.0) ? std::sqrt(diagonal) : 1.0;
+    }
+    for (size_t row = 0; row < NumberOfUnknowns; ++row) {
+        for (size_t column = 0; column < NumberOfUnknowns; ++column) {
+            normal.Element(row, column) /= (scale.Element(row) * scale.Element(column));
+        }
+        normal.Element(row, row) += m_regularization;
+        rightHandSide.Element(row) /= scale.Element(row);
+    }
+
+    // Cholesky, in place lower triangle
+    for (size_t column = 0; column < NumberOfUnknowns; ++column) {
+        double pivot = normal.Element(column, column);
+        for (size_t k = 0; k < column; ++k) {
+            pivot -= normal.Element(column, k) * normal.Element(column, k);
+        }
+        if (pivot <= 0.0) {
+            errorMessage = "normal equations are not positive definite, increase the regularization or add more data";
+            return false;
+        }
+        pivot = std::sqrt(pivot);
+        normal.Element(column, column) = pivot;
+        for (size_t row = column + 1; row < NumberOfUnknowns; ++row) {
+            double value = normal.Element(row, column);
+            for (size_t k = 0; k < column; ++k) {
+                value -= normal.Element(row, k) * normal.Element(column, k);
+            }
+            normal.Element(row, column) = value / pivot;
+        }
+    }
+    // forward and back substitution
+    vctDoubleVec solution(rightHandSide);
+    for (size_t row = 0; row < NumberOfUnknowns; ++row) {
+        for (size_t k = 0; k < row; ++k) {
+            solution.Element(row) -= normal.Element(row, k) * solution.Element(k);
+        }
+        solution.Element(row) /= normal.Element(row, row);
+    }
+    for (size_t row = NumberOfUnknowns; row-- > 0; ) {
+        for (size_t k = row + 1; k < NumberOfUnknowns; ++k) {
+            solution.Element(row) -= normal.Element(k, row) * solution.Element(k);
+        }
+        solution.Element(row) /= normal.Element(row, row);
+    }
+    solution.ElementwiseDivide(scale);
+
+    const size_t negOffset = NumberOfDynamicParameters - NumberOfSharedParameters;
+    for (size_t index = 0; index < NumberOfDynamicParameters; ++index) {
+        m_pos.Element(index) = solution.Element(index);
+        m_neg.Element(index) = (index < NumberOfSharedParameters) ?
+            solution.Element(index) : solution.Element(index + negOffset);
+    }
+
+    // residual from normal equations: e'e - 2 x'A'e + x'A'Ax
+    m_residual_rms.SetAll(0.0);
+    for (size_t joint = 0; joint < NumberOfModeledJoints; ++joint) {
+        const vctDoubleMat & jointNormal = m_normal[joint];
+        double quadratic = 0.0;
+        for (size_t row = 0; row < NumberOfUnknowns; ++row) {
+            // upper triangle only
+            quadratic += jointNormal.Element(row, row) * solution.Element(row) * solution.Element(row);
+            for (size_t column = row + 1; column < NumberOfUnknowns; ++column) {
+                quadratic += 2.0 * jointNormal.Element(row, column)
+                    * solution.Element(row) * solution.Element(column);
+            }
+        }
+        const double residual = m_effort_square[joint]
+            - 2.0 * solution.DotProduct(m_right_hand_side[joint])
+            + quadratic;
+        m_residual_rms.Element(joint) = std::sqrt(std::max(residual, 0.0) / m_number_of_samples);
+    }
+    return true;
+}
+
+void robGravityCompensationMTMIdentification::ToJSON(Json::Value & jsonConfig) const
+{
+    // efforts limits, measured range with 10% margin, last joint
+    // is not compensated
+    vctDoubleVec upper(NumberOfJoints, 0.0), lower(NumberOfJoints, 0.0);
+    for (size_t joint = 0; joint < NumberOfModeledJoints; ++joint) {
+        const double margin = 0.1 * (m_effort_max.Element(joint) - m_effort_min.Element(joint));
+        upper.Element(joint) = m_effort_max.Element(joint) + margin;
+        lower.Element(joint) = m_effort_min.Element(joint) - margin;
+    }
+
+    jsonConfig["version"] = "2.0";
+    Json::Value & jsonController = jsonConfig["GC_controller"];
+    cmnDataJSON<vctDoubleVec>::SerializeText(m_pos, jsonController["gc_dynamic_params_pos"]);
+    cmnDataJSON<vctDoubleVec>::SerializeText(m_neg, jsonController["gc_dynamic_params_neg"]);
+    cmnDataJSON<vctDoubleVec>::SerializeText(upper, jsonController["safe_upper_torque_limit"]);
+    cmnDataJSON<vctDoubleVec>::SerializeText(lower, jsonController["safe_lower_torque_limit"]);
+    cmnDataJSON<vctDoubleVec>::SerializeText(m_db_vel, jsonController["db_vel_vec"]);
+    cmnDataJSON<vctDoubleVec>::SerializeText(m_sat_vel, jsonController["sat_vec_vec"]);
+    cmnDataJSON<vctDoubleVec>::SerializeText(m_fric_comp_ratio, jsonController["fric_comp_ratio_vec"]);
+}
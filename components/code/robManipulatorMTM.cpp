@@ -146,7 +146,7 @@ double robManipulatorMTM::ComputeGimbalIK(vctDynamicVector<double> &q,
     Rt78.Rotation().Assign(Rt8);
     Rt08 = Rt07 * Rt78;
 
-    const vctFrm4x4 Rt04 = ForwardKinematics(q, 4);
+    const vctFrm4x4 Rt04 = m_ik_kinematics.ForwardKinematics(*this, q, 4);
 
     vctFrm4x4 Rt48;
     Rt04.ApplyInverseTo(Rt08, Rt48);
@@ -260,7 +260,7 @@ double robManipulatorMTM::FindOptimalPlatformAngle(const vctDynamicVector<double
 {
     // RISHI'S METHOD
     if (method == 0) {
-        const vctFrm4x4 Rt03 = ForwardKinematics(q, 3);
+        const vctFrm4x4 Rt03 = m_ik_kinematics.ForwardKinematics(*this, q, 3);
         vctFrm4x4 Rt37;
         Rt03.ApplyInverseTo(Rt07, Rt37);
 
@@ -339,7 +339,7 @@ double robManipulatorMTM::FindOptimalPlatformAngle(const vctDynamicVector<double
         Rt78.Rotation().Assign(Rt8);
         Rt08 = Rt07 * Rt78;
 
-        const vctFrm4x4 Rt04 = ForwardKinematics(q, 4);
+        const vctFrm4x4 Rt04 = m_ik_kinematics.ForwardKinematics(*this, q, 4);
 
         vctFrm4x4 Rt48;
         Rt04.ApplyInverseTo(Rt08, Rt48);
@@ -0,0 +1,108 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <sawIntuitiveResearchKit/robPSMJointCompensation.h>
+
+#include <json/json.h>
+
+robPSMJointCompensation::robPSMJointCompensation(void)
+{
+    for (auto & joint : m_joints) {
+        joint.Compliance[0] = joint.Compliance[1] = joint.Compliance[2] = joint.Compliance[3] = 0.0;
+        joint.TorqueOffset[0] = joint.TorqueOffset[1] = 0.0;
+        joint.Backlash = 0.0;
+    }
+}
+
+bool robPSMJointCompensation::ConfigureJSON(const Json::Value & jsonConfig,
+                                            std::string & errorMessage)
+{
+    const Json::Value parameters = jsonConfig["parameters"];
+    if (parameters.size() == 0) {
+        errorMessage = "configuration needs \"parameters\"";
+        return false;
+    }
+
+    for (unsigned int index = 0; index < parameters.size(); ++index) {
+        const Json::Value parameter = parameters[index];
+        const Json::Value jsonName = parameter["parameter"];
+        if (jsonName.empty()) {
+            errorMessage = "can't find \"parameter\" for parameters[" + std::to_string(index) + "]";
+            return false;
+        }
+        const double a = parameter["value-a"].asDouble();
+        const double b = parameter["value-b"].asDouble();
+        const double c = parameter["value-c"].asDouble();
+        const double d = parameter["value-d"].asDouble();
+
+        const std::string name = jsonName.asString();
+        Joint * joint;
+        std::string type;
+        const std::string first = "_first";
+        const std::string second = "_second";
+        if ((name.size() > first.size())
+            && (name.compare(name.size() - first.size(), first.size(), first) == 0)) {
+            joint = &(m_joints[0]);
+            type = name.substr(0, name.size() - first.size());
+        } else if ((name.size() > second.size())
+                   && (name.compare(name.size() - second.size(), second.size(), second) == 0)) {
+            joint = &(m_joints[1]);
+            type = name.substr(0, name.size() - second.size());
+        } else {
+            errorMessage = "invalid parameter name \"" + name + "\"";
+            return false;
+        }
+
+        if (type == "compliance") {
+            joint->Compliance[0] = a;
+            joint->Compliance[1] = b;
+            joint->Compliance[2] = c;
+            joint->Compliance[3] = d;
+        } else if (type == "torque_offset") {
+            // constant for first joint, linear in insertion for second
+            if (joint == &(m_joints[0])) {
+                joint->TorqueOffset[0] = 0.0;
+                joint->TorqueOffset[1] = a;
+            } else {
+                joint->TorqueOffset[0] = a;
+                joint->TorqueOffset[1] = b;
+            }
+        } else if (type == "backlash") {
+            joint->Backlash = a;
+        } else {
+            errorMessage = "invalid parameter name \"" + name + "\"";
+            return false;
+        }
+    }
+    return true;
+}
+
+void robPSMJointCompensation::Apply(vctDoubleVec & position,
+                                    const vctDoubleVec & effort) const
+{
+    const double insertion = position.Element(2);
+    for (size_t index = 0; index < 2; ++index) {
+        const Joint & joint = m_joints[index];
+        // Horner's method
+        const double compliance =
+            ((joint.Compliance[0] * insertion + joint.Compliance[1]) * insertion
+             + joint.Compliance[2]) * insertion + joint.Compliance[3];
+        const double torqueOffset = joint.TorqueOffset[0] * insertion + joint.TorqueOffset[1];
+        position.Element(index) -= (joint.Backlash + compliance) * (effort.Element(index) - torqueOffset);
+    }
+}
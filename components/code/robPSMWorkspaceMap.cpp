@@ -0,0 +1,483 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+// system include
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+
+#include <sawIntuitiveResearchKit/robPSMWorkspaceMap.h>
+
+#include <cisstCommon/cmnConstants.h>
+#include <cisstCommon/cmnUnits.h>
+#include <cisstVector/vctDynamicVectorTypes.h>
+#include <cisstVector/vctTransformationTypes.h>
+
+/*
+  File format, host byte order (little endian on all supported
+  platforms):
+  - 8 bytes magic number "dVRKWSM" (null terminated)
+  - uint32 format version (1)
+  - uint32 number of voxels along x, y and z
+  - double voxel size, safe distance from RCM
+  - double origin (corner of first voxel) x, y and z
+  - uint32 number of signature positions, followed by x, y and z for each
+  - one byte per voxel, x first, then y, then z
+*/
+
+namespace {
+    const char MagicNumber[8] = {'d', 'V', 'R', 'K', 'W', 'S', 'M', '\0'};
+    const uint32_t FormatVersion = 1;
+
+    template <typename _type>
+    void Write(std::ostream & output, const _type & value) {
+        output.write(reinterpret_cast<const char *>(&value), sizeof(_type));
+    }
+
+    template <typename _type>
+    bool Read(std::istream & input, _type & value) {
+        input.read(reinterpret_cast<char *>(&value), sizeof(_type));
+        return input.good();
+    }
+
+    // sampled range for each joint, revolute joints limited to one turn
+    void SampledRanges(const robManipulator & manipulator,
+                       vctDoubleVec & lower, vctDoubleVec & upper,
+                       std::vector<robJoint::Type> & types) {
+        const size_t nbLinks = manipulator.links.size();
+        lower.SetSize(nbLinks);
+        upper.SetSize(nbLinks);
+        types.resize(nbLinks);
+        for (size_t joint = 0; joint < nbLinks; ++joint) {
+            const robKinematics * kinematics = manipulator.links[joint].GetKinematics();
+            types[joint] = kinematics->GetType();
+            lower[joint] = kinematics->PositionMin();
+            upper[joint] = kinematics->PositionMax();
+            if ((types[joint] == robJoint::HINGE) && ((upper[joint] - lower[joint]) >= 2.0 * cmnPI)) {
+                lower[joint] = -cmnPI;
+                upper[joint] = cmnPI;
+            }
+        }
+    }
+
+    size_t NumberOfSamples(const double lower, const double upper, const double step) {
+        return static_cast<size_t>(std::ceil((upper - lower) / step)) + 1;
+    }
+
+    double Sample(const double lower, const double upper, const size_t numberOfSamples, const size_t index) {
+        if (numberOfSamples < 2) {
+            return 0.5 * (lower + upper);
+        }
+        return lower + (upper - lower) * static_cast<double>(index) / static_cast<double>(numberOfSamples - 1);
+    }
+}
+
+robPSMWorkspaceMap::robPSMWorkspaceMap(void):
+    m_voxel_size(0.0),
+    m_safe_distance(0.0)
+{
+    m_origin.SetAll(0.0);
+    m_size[0] = m_size[1] = m_size[2] = 0;
+}
+
+std::string robPSMWorkspaceMap::StatusName(const Status status)
+{
+    switch (status) {
+    case UNREACHABLE:
+        return "UNREACHABLE";
+    case REACHABLE_UNSAFE:
+        return "REACHABLE_UNSAFE";
+    case REACHABLE:
+        return "REACHABLE";
+    default:
+        break;
+    }
+    return "UNDEFINED";
+}
+
+bool robPSMWorkspaceMap::Build(const robManipulator & manipulator,
+                               const double voxelSize,
+                               const double safeDistanceFromRCM,
+                               std::string & errorMessage,
+                               std::ostream * progress)
+{
+    m_cells.clear();
+    const size_t nbLinks = manipulator.links.size();
+    if (nbLinks < 5) {
+        errorMessage = "manipulator must have at least 5 links (PSM with tool)";
+        return false;
+    }
+    if (voxelSize <= 0.0) {
+        errorMessage = "voxel size must be positive";
+        return false;
+    }
+    m_voxel_size = voxelSize;
+    m_safe_distance = safeDistanceFromRCM;
+
+    vctDoubleVec lower, upper;
+    std::vector<robJoint::Type> types;
+    SampledRanges(manipulator, lower, upper, types);
+
+    // the first 2 joints must rotate around the RCM
+    for (size_t index = 0; index < 3; ++index) {
+        vctFrm4x4 prefix = manipulator.Rtw0;
+        for (size_t joint = 0; joint < 2; ++joint) {
+            prefix = prefix * manipulator.links[joint].ForwardKinematics(Sample(lower[joint], upper[joint], 3, index));
+        }
+        if (prefix.Translation().Norm() > 1.0e-9) {
+            errorMessage = "the first two joints must rotate around the RCM (origin)";
+            return false;
+        }
+    }
+
+    // the last joint doesn't move the origin of its frame with modified DH
+    size_t lastSampled = nbLinks - 1;
+    if (manipulator.links[nbLinks - 1].GetKinematics()->GetConvention() != robKinematics::STANDARD_DH) {
+        lastSampled = nbLinks - 2;
+    }
+
+    // upper bound of the distance between each joint axis and the
+    // last frame origin, using prismatic joints at their maximum
+    vctDoubleVec q(nbLinks);
+    for (size_t joint = 0; joint < nbLinks; ++joint) {
+        q[joint] = (types[joint] == robJoint::SLIDER) ? upper[joint] : 0.5 * (lower[joint] + upper[joint]);
+    }
+    std::vector<vct3> origins(nbLinks + 1);
+    vctFrm4x4 prefix;
+    origins[0].Assign(prefix.Translation());
+    for (size_t joint = 0; joint < nbLinks; ++joint) {
+        prefix = prefix * manipulator.links[joint].ForwardKinematics(q[joint]);
+        origins[joint + 1].Assign(prefix.Translation());
+    }
+    vctDoubleVec step(nbLinks, 0.0);
+    for (size_t joint = 2; joint <= lastSampled; ++joint) {
+        if (types[joint] == robJoint::SLIDER) {
+            step[joint] = 0.5 * m_voxel_size;
+        } else {
+            double lever = 1.0 * cmn_mm;
+            for (size_t origin = joint; origin < nbLinks; ++origin) {
+                lever += (origins[origin + 1] - origins[origin]).Norm();
+            }
+            step[joint] = 0.5 * m_voxel_size / lever;
+        }
+    }
+
+    // sample joints past the first two, positions relative to frame
+    // after the first two links.  Points closer than a quarter of a
+    // voxel are merged.
+    std::vector<size_t> numberOfSamples(nbLinks, 1);
+    size_t totalLocal = 1;
+    for (size_t joint = 2; joint <= lastSampled; ++joint) {
+        numberOfSamples[joint] = NumberOfSamples(lower[joint], upper[joint], step[joint]);
+        totalLocal *= numberOfSamples[joint];
+    }
+    if (progress) {
+        *progress << "Sampling " << totalLocal << " configurations for joints 3 to "
+                  << lastSampled + 1 << std::endl;
+    }
+
+    struct LocalPoint {
+        vct3 Position;
+        bool Safe;
+    };
+    std::vector<LocalPoint> localPoints;
+    std::unordered_map<int64_t, size_t> merged;
+    const double mergeSize = 0.25 * m_voxel_size;
+    double maxRadius = 0.0;
+    std::vector<size_t> counter(nbLinks, 0);
+    q.SetAll(0.0);
+    for (size_t sample = 0; sample < totalLocal; ++sample) {
+        for (size_t joint = 2; joint <= lastSampled; ++joint) {
+            q[joint] = Sample(lower[joint], upper[joint], numberOfSamples[joint], counter[joint]);
+        }
+        vctFrm4x4 local;
+        bool safe = false;
+        for (size_t joint = 2; joint < nbLinks; ++joint) {
+            local = local * manipulator.links[joint].ForwardKinematics(q[joint]);
+            // shaft end, frame 4, see mtsIntuitiveResearchKitPSM::InverseKinematics
+            if (joint == 3) {
+                safe = (local.Translation().Norm() >= m_safe_distance);
+            }
+        }
+        const vct3 position(local.Translation());
+        int64_t key = 0;
+        for (size_t axis = 0; axis < 3; ++axis) {
+            key = (key << 21) + (static_cast<int64_t>(std::floor(position.Element(axis) / mergeSize)) & 0x1FFFFF);
+        }
+        const auto found = merged.find(key);
+        if (found == merged.end()) {
+            merged[key] = localPoints.size();
+            localPoints.push_back({position, safe});
+            maxRadius = std::max(maxRadius, position.Norm());
+        } else if (safe) {
+            localPoints[found->second].Safe = true;
+        }
+        // next configuration
+        for (size_t joint = 2; joint <= lastSampled; ++joint) {
+            ++counter[joint];
+            if (counter[joint] < numberOfSamples[joint]) {
+                break;
+            }
+            counter[joint] = 0;
+        }
+    }
+
+    // grid large enough for all rotations of local points
+    const double halfSize = maxRadius + m_voxel_size;
+    const size_t size = static_cast<size_t>(std::ceil(2.0 * halfSize / m_voxel_size));
+    m_origin.SetAll(-halfSize);
+    m_size[0] = m_size[1] = m_size[2] = size;
+    m_cells.assign(size * size * size, 0);
+
+    // first two joints, two consecutive samples move points less than half a voxel
+    const double angularStep = 0.5 * m_voxel_size / std::max(maxRadius, m_voxel_size);
+    const size_t samples0 = NumberOfSamples(lower[0], upper[0], angularStep);
+    const size_t samples1 = NumberOfSamples(lower[1], upper[1], angularStep);
+    if (progress) {
+        *progress << "Rotating " << localPoints.size() << " points for "
+                  << samples0 * samples1 << " configurations of joints 1 and 2" << std::endl;
+    }
+    int index[3];
+    vct3 position;
+    for (size_t i0 = 0; i0 < samples0; ++i0) {
+        const vctFrm4x4 frame0 = manipulator.Rtw0 * manipulator.links[0].ForwardKinematics(Sample(lower[0], upper[0], samples0, i0));
+        for (size_t i1 = 0; i1 < samples1; ++i1) {
+            const vctFrm4x4 frame1 = frame0 * manipulator.links[1].ForwardKinematics(Sample(lower[1], upper[1], samples1, i1));
+            const vctMatRot3 & rotation = frame1.Rotation();
+            for (const auto & point : localPoints) {
+                position.ProductOf(rotation, point.Position);
+                for (size_t axis = 0; axis < 3; ++axis) {
+                    index[axis] = static_cast<int>((position.Element(axis) - m_origin.Element(axis)) / m_voxel_size);
+                }
+                m_cells[Index(index[0], index[1], index[2])] |= (point.Safe ? (REACHABLE_BIT | SAFE_BIT) : REACHABLE_BIT);
+            }
+        }
+        if (progress && (((i0 + 1) % std::max(samples0 / 10, static_cast<size_t>(1))) == 0)) {
+            *progress << "  " << (100 * (i0 + 1)) / samples0 << "%" << std::endl;
+        }
+    }
+
+    // conservative map
+    Dilate();
+
+    // crop to non empty voxels, outside the grid is unreachable
+    size_t minimum[3] = {size, size, size};
+    size_t maximum[3] = {0, 0, 0};
+    for (size_t z = 0; z < size; ++z) {
+        for (size_t y = 0; y < size; ++y) {
+            for (size_t x = 0; x < size; ++x) {
+                if (m_cells[Index(x, y, z)]) {
+                    const size_t current[3] = {x, y, z};
+                    for (size_t axis = 0; axis < 3; ++axis) {
+                        minimum[axis] = std::min(minimum[axis], current[axis]);
+                        maximum[axis] = std::max(maximum[axis], current[axis]);
+                    }
+                }
+            }
+        }
+    }
+    if (minimum[0] > maximum[0]) {
+        errorMessage = "no reachable position found";
+        m_cells.clear();
+        return false;
+    }
+    std::vector<unsigned char> cropped;
+    size_t croppedSize[3];
+    for (size_t axis = 0; axis < 3; ++axis) {
+        croppedSize[axis] = maximum[axis] - minimum[axis] + 1;
+    }
+    cropped.reserve(croppedSize[0] * croppedSize[1] * croppedSize[2]);
+    for (size_t z = minimum[2]; z <= maximum[2]; ++z) {
+        for (size_t y = minimum[1]; y <= maximum[1]; ++y) {
+            for (size_t x = minimum[0]; x <= maximum[0]; ++x) {
+                cropped.push_back(m_cells[Index(x, y, z)]);
+            }
+        }
+    }
+    for (size_t axis = 0; axis < 3; ++axis) {
+        m_origin.Element(axis) += static_cast<double>(minimum[axis]) * m_voxel_size;
+        m_size[axis] = croppedSize[axis];
+    }
+    m_cells.swap(cropped);
+
+    Signature(manipulator, m_signature);
+    return true;
+}
+
+void robPSMWorkspaceMap::Dilate(void)
+{
+    // separable, 3 passes give a 3x3x3 neighborhood
+    const size_t strides[3] = {1, m_size[0], m_size[0] * m_size[1]};
+    std::vector<unsigned char> source;
+    for (size_t axis = 0; axis < 3; ++axis) {
+        source = m_cells;
+        for (size_t z = 0; z < m_size[2]; ++z) {
+            for (size_t y = 0; y < m_size[1]; ++y) {
+                for (size_t x = 0; x < m_size[0]; ++x) {
+                    const size_t current[3] = {x, y, z};
+                    const size_t index = Index(x, y, z);
+                    if (current[axis] > 0) {
+                        m_cells[index] |= source[index - strides[axis]];
+                    }
+                    if (current[axis] + 1 < m_size[axis]) {
+                        m_cells[index] |= source[index + strides[axis]];
+                    }
+                }
+            }
+        }
+    }
+}
+
+void robPSMWorkspaceMap::Signature(const robManipulator & manipulator,
+                                   std::vector<vct3> & signature)
+{
+    const size_t nbLinks = manipulator.links.size();
+    vctDoubleVec lower, upper;
+    std::vector<robJoint::Type> types;
+    SampledRanges(manipulator, lower, upper, types);
+    signature.resize(3);
+    const double ratios[3] = {0.25, 0.5, 0.75};
+    for (size_t index = 0; index < 3; ++index) {
+        vctFrm4x4 frame = manipulator.Rtw0;
+        for (size_t joint = 0; joint < nbLinks; ++joint) {
+            frame = frame * manipulator.links[joint].ForwardKinematics(lower[joint] + ratios[index] * (upper[joint] - lower[joint]));
+        }
+        signature[index].Assign(frame.Translation());
+    }
+}
+
+bool robPSMWorkspaceMap::Matches(const robManipulator & manipulator) const
+{
+    std::vector<vct3> signature;
+    Signature(manipulator, signature);
+    if (signature.size() != m_signature.size()) {
+        return false;
+    }
+    for (size_t index = 0; index < signature.size(); ++index) {
+        if ((signature[index] - m_signature[index]).Norm() > 0.1 * m_voxel_size) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void robPSMWorkspaceMap::Count(size_t & reachable, size_t & unsafe, size_t & unreachable) const
+{
+    reachable = unsafe = unreachable = 0;
+    for (const auto cell : m_cells) {
+        switch (cell) {
+        case REACHABLE:
+            ++reachable;
+            break;
+        case REACHABLE_UNSAFE:
+            ++unsafe;
+            break;
+        default:
+            ++unreachable;
+        }
+    }
+}
+
+bool robPSMWorkspaceMap::Save(const std::string & filename, std::string & errorMessage) const
+{
+    if (!IsValid()) {
+        errorMessage = "map is empty";
+        return false;
+    }
+    std::ofstream output(filename.c_str(), std::ios::binary | std::ios::trunc);
+    if (!output.is_open()) {
+        errorMessage = "can't open \"" + filename + "\" for writing";
+        return false;
+    }
+    output.write(MagicNumber, sizeof(MagicNumber));
+    Write(output, FormatVersion);
+    for (size_t axis = 0; axis < 3; ++axis) {
+        Write(output, static_cast<uint32_t>(m_size[axis]));
+    }
+    Write(output, m_voxel_size);
+    Write(output, m_safe_distance);
+    for (size_t axis = 0; axis < 3; ++axis) {
+        Write(output, m_origin.Element(axis));
+    }
+    Write(output, static_cast<uint32_t>(m_signature.size()));
+    for (const auto & position : m_signature) {
+        for (size_t axis = 0; axis < 3; ++axis) {
+            Write(output, position.Element(axis));
+        }
+    }
+    output.write(reinterpret_cast<const char *>(m_cells.data()), m_cells.size());
+    if (!output.good()) {
+        errorMessage = "failed to write \"" + filename + "\"";
+        return false;
+    }
+    return true;
+}
+
+bool robPSMWorkspaceMap::Load(const std::string & filename, std::string & errorMessage)
+{
+    m_cells.clear();
+    std::ifstream input(filename.c_str(), std::ios::binary);
+    if (!input.is_open()) {
+        errorMessage = "can't open \"" + filename + "\"";
+        return false;
+    }
+    char magic[8];
+    uint32_t version;
+    input.read(magic, sizeof(magic));
+    if (!input.good() || (std::memcmp(magic, MagicNumber, sizeof(MagicNumber)) != 0)) {
+        errorMessage = "\"" + filename + "\" is not a dVRK workspace map";
+        return false;
+    }
+    if (!Read(input, version) || (version != FormatVersion)) {
+        errorMessage = "\"" + filename + "\" has an unsupported version";
+        return false;
+    }
+    uint32_t size[3], signatureSize;
+    bool ok = Read(input, size[0]) && Read(input, size[1]) && Read(input, size[2])
+        && Read(input, m_voxel_size) && Read(input, m_safe_distance);
+    for (size_t axis = 0; ok && (axis < 3); ++axis) {
+        ok = Read(input, m_origin.Element(axis));
+    }
+    ok = ok && Read(input, signatureSize) && (signatureSize < 16);
+    if (ok) {
+        m_signature.resize(signatureSize);
+        for (auto & position : m_signature) {
+            for (size_t axis = 0; ok && (axis < 3); ++axis) {
+                ok = Read(input, position.Element(axis));
+            }
+        }
+    }
+    if (!ok || (m_voxel_size <= 0.0)) {
+        errorMessage = "\"" + filename + "\" has an invalid header";
+        return false;
+    }
+    std::vector<unsigned char> cells(static_cast<size_t>(size[0]) * size[1] * size[2]);
+    input.read(reinterpret_cast<char *>(cells.data()), cells.size());
+    if (static_cast<size_t>(input.gcount()) != cells.size()) {
+        errorMessage = "\"" + filename + "\" is truncated";
+        return false;
+    }
+    for (size_t axis = 0; axis < 3; ++axis) {
+        m_size[axis] = size[axis];
+    }
+    m_cells.swap(cells);
+    return true;
+}
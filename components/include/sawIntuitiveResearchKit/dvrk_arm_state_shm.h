@@ -0,0 +1,234 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=c softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+/*
+  Plain C description of the shared memory segment written by
+  mtsArmStatePublisher (see arm configuration "shared-memory").  This
+  header doesn't depend on cisst so it can be used by any local
+  process.  All values are in host byte order, SI units.
+
+  The segment is a header followed by a ring of records.  The arm
+  writes one record per cycle.  Each record has its own sequence
+  number, odd while the record is written and equal to 2 * (index + 1)
+  once record "index" is complete.  Readers can access records in
+  place (no copy) and check the sequence number before and after to
+  make sure the record has not been overwritten.
+
+  Example:
+
+    dvrk_arm_state_segment * segment = dvrk_arm_state_open("/dvrk-PSM1");
+    dvrk_arm_state_record record;
+    uint64_t index;
+    if (dvrk_arm_state_read_latest(segment, &record, &index)) {
+        ...
+    }
+    dvrk_arm_state_close(segment);
+
+  With strict ISO C, define _POSIX_C_SOURCE (200809L) before including
+  this header for shm_open and mmap.  On older glibc, link with -lrt.
+  See also share/shared-memory/dvrk_arm_state_shm.py for Python.
+*/
+
+#ifndef _dvrk_arm_state_shm_h
+#define _dvrk_arm_state_shm_h
+
+#include <stdint.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DVRK_ARM_STATE_MAGIC "dVRKARM"
+#define DVRK_ARM_STATE_VERSION 1
+#define DVRK_ARM_STATE_MAX_JOINTS 16
+#define DVRK_ARM_STATE_NAME_SIZE 64
+
+/* operating state, same as crtk */
+enum {
+    DVRK_ARM_STATE_UNDEFINED = 0,
+    DVRK_ARM_STATE_DISABLED = 1,
+    DVRK_ARM_STATE_ENABLED = 2,
+    DVRK_ARM_STATE_PAUSED = 3,
+    DVRK_ARM_STATE_FAULT = 4
+};
+
+/* bits for dvrk_arm_state_record.valid */
+enum {
+    DVRK_ARM_STATE_VALID_JS = 1,
+    DVRK_ARM_STATE_VALID_CP = 2,
+    DVRK_ARM_STATE_VALID_CV = 4,
+    DVRK_ARM_STATE_VALID_CF = 8
+};
+
+typedef struct {
+    uint64_t sequence;          /* odd while writing, 2 * (index + 1) when done */
+    double time;                /* arm state table time, in seconds */
+    uint32_t number_of_joints;  /* used in position, velocity and effort */
+    uint32_t valid;             /* DVRK_ARM_STATE_VALID_* bits */
+    uint32_t operating_state;   /* DVRK_ARM_STATE_* */
+    uint32_t is_homed;
+    uint32_t is_busy;
+    uint32_t reserved;
+    double position[DVRK_ARM_STATE_MAX_JOINTS];  /* measured_js */
+    double velocity[DVRK_ARM_STATE_MAX_JOINTS];
+    double effort[DVRK_ARM_STATE_MAX_JOINTS];
+    double measured_cp[12];     /* translation followed by row major rotation */
+    double measured_cv[6];      /* linear then angular */
+    double body_measured_cf[6]; /* force then torque, body frame */
+} dvrk_arm_state_record;
+
+typedef struct {
+    char magic[8];              /* DVRK_ARM_STATE_MAGIC, null terminated */
+    uint32_t version;           /* DVRK_ARM_STATE_VERSION */
+    uint32_t header_size;       /* offset of first record in bytes */
+    uint32_t record_size;       /* sizeof(dvrk_arm_state_record) */
+    uint32_t ring_size;         /* number of records in ring */
+    uint32_t max_joints;        /* DVRK_ARM_STATE_MAX_JOINTS */
+    uint32_t reserved;
+    double period;              /* arm period in seconds */
+    char name[DVRK_ARM_STATE_NAME_SIZE]; /* arm name */
+    uint64_t written;           /* number of records written, index of latest is written - 1 */
+    uint64_t publisher_pid;
+} dvrk_arm_state_header;
+
+typedef struct {
+    dvrk_arm_state_header header;
+    /* padding so records are cache line aligned */
+    char padding[256 - sizeof(dvrk_arm_state_header)];
+    dvrk_arm_state_record records[1]; /* ring_size records */
+} dvrk_arm_state_segment;
+
+#define DVRK_ARM_STATE_HEADER_SIZE 256
+#define DVRK_ARM_STATE_SEGMENT_SIZE(ring_size) \
+    (DVRK_ARM_STATE_HEADER_SIZE + (ring_size) * sizeof(dvrk_arm_state_record))
+
+#if defined(__GNUC__) || defined(__clang__)
+
+/* returns a pointer to record "index" in the ring, data can be read in
+   place between two calls to dvrk_arm_state_record_valid */
+static inline const dvrk_arm_state_record *
+dvrk_arm_state_record_at(const dvrk_arm_state_segment * segment, const uint64_t index)
+{
+    return &(segment->records[index % segment->header.ring_size]);
+}
+
+/* number of records written so far, 0 if none */
+static inline uint64_t
+dvrk_arm_state_written(const dvrk_arm_state_segment * segment)
+{
+    return __atomic_load_n(&(segment->header.written), __ATOMIC_ACQUIRE);
+}
+
+/* true if record at "index" is complete and has not been overwritten */
+static inline int
+dvrk_arm_state_record_valid(const dvrk_arm_state_segment * segment, const uint64_t index)
+{
+    const dvrk_arm_state_record * record = dvrk_arm_state_record_at(segment, index);
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return __atomic_load_n(&(record->sequence), __ATOMIC_ACQUIRE) == 2 * (index + 1);
+}
+
+/* copy record "index", returns 0 if the record is not available
+   anymore (overwritten) or not yet written */
+static inline int
+dvrk_arm_state_read(const dvrk_arm_state_segment * segment, const uint64_t index,
+                    dvrk_arm_state_record * result)
+{
+    if (!dvrk_arm_state_record_valid(segment, index)) {
+        return 0;
+    }
+    memcpy(result, dvrk_arm_state_record_at(segment, index), sizeof(dvrk_arm_state_record));
+    return dvrk_arm_state_record_valid(segment, index);
+}
+
+/* copy latest record and its index, returns 0 if no record is available */
+static inline int
+dvrk_arm_state_read_latest(const dvrk_arm_state_segment * segment,
+                           dvrk_arm_state_record * result, uint64_t * index)
+{
+    int attempt;
+    for (attempt = 0; attempt < 4; ++attempt) {
+        const uint64_t written = dvrk_arm_state_written(segment);
+        if (written == 0) {
+            return 0;
+        }
+        if (dvrk_arm_state_read(segment, written - 1, result)) {
+            *index = written - 1;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+#endif /* __GNUC__ || __clang__ */
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* map an existing segment read only, returns NULL on failure */
+static inline dvrk_arm_state_segment *
+dvrk_arm_state_open(const char * name)
+{
+    struct stat status;
+    void * map;
+    const dvrk_arm_state_segment * segment;
+    const int descriptor = shm_open(name, O_RDONLY, 0);
+    if (descriptor < 0) {
+        return NULL;
+    }
+    if ((fstat(descriptor, &status) != 0)
+        || ((size_t)(status.st_size) < DVRK_ARM_STATE_HEADER_SIZE)) {
+        close(descriptor);
+        return NULL;
+    }
+    map = mmap(NULL, (size_t)(status.st_size), PROT_READ, MAP_SHARED, descriptor, 0);
+    close(descriptor);
+    if (map == MAP_FAILED) {
+        return NULL;
+    }
+    segment = (const dvrk_arm_state_segment *)(map);
+    if ((memcmp(segment->header.magic, DVRK_ARM_STATE_MAGIC, sizeof(DVRK_ARM_STATE_MAGIC)) != 0)
+        || (segment->header.version != DVRK_ARM_STATE_VERSION)
+        || (segment->header.record_size != sizeof(dvrk_arm_state_record))
+        || ((size_t)(status.st_size) < DVRK_ARM_STATE_SEGMENT_SIZE(segment->header.ring_size))) {
+        munmap(map, (size_t)(status.st_size));
+        return NULL;
+    }
+    return (dvrk_arm_state_segment *)(map);
+}
+
+static inline void
+dvrk_arm_state_close(dvrk_arm_state_segment * segment)
+{
+    if (segment) {
+        munmap(segment, DVRK_ARM_STATE_SEGMENT_SIZE(segment->header.ring_size));
+    }
+}
+
+#endif /* __unix__ || __APPLE__ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _dvrk_arm_state_shm_h */
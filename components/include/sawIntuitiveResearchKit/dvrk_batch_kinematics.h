@@ -0,0 +1,100 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=c softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+/*
+  Plain C interface for robBatchKinematics, compiled in the shared
+  library sawIntuitiveResearchKitBatch so it can be loaded from any
+  language with a C foreign function interface (e.g. Python ctypes,
+  see examples/cisstRobotPython/dvrk_batch_kinematics.py).  All
+  arrays are contiguous, row major, doubles in SI units:
+  - joint positions, velocities and efforts: samples x joints
+  - cartesian positions: samples x 4 x 4
+
+  Example:
+
+    char error[256];
+    dvrk_batch_kinematics * batch =
+        dvrk_batch_kinematics_create("MTM", "mtml.json", "gc-MTML-22723.json",
+                                     error, sizeof(error));
+    if (!batch) {
+        ...
+    }
+    dvrk_batch_kinematics_forward(batch, positions, samples, frames);
+    dvrk_batch_kinematics_destroy(batch);
+
+  A given handle can't be used by multiple threads at the same time,
+  computations are already spread across all cores.
+*/
+
+#ifndef _dvrk_batch_kinematics_h
+#define _dvrk_batch_kinematics_h
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct dvrk_batch_kinematics dvrk_batch_kinematics;
+
+/* Type is "MTM", "ECM" or "generic".  The gravity compensation file
+   is optional (NULL or empty) and only used for MTMs.  Returns NULL
+   on failure with the reason in error (if not NULL). */
+dvrk_batch_kinematics * dvrk_batch_kinematics_create(const char * type,
+                                                     const char * kinematic_file,
+                                                     const char * gravity_file,
+                                                     char * error,
+                                                     size_t error_size);
+
+void dvrk_batch_kinematics_destroy(dvrk_batch_kinematics * batch);
+
+size_t dvrk_batch_kinematics_number_of_joints(const dvrk_batch_kinematics * batch);
+
+int dvrk_batch_kinematics_has_gravity_compensation(const dvrk_batch_kinematics * batch);
+
+/* 0 means one thread per core (default) */
+void dvrk_batch_kinematics_set_number_of_threads(dvrk_batch_kinematics * batch,
+                                                 size_t number_of_threads);
+
+void dvrk_batch_kinematics_forward(dvrk_batch_kinematics * batch,
+                                   const double * positions,
+                                   size_t samples,
+                                   double * frames);
+
+/* Positions are the initial guesses, replaced by the solutions.
+   Status (can be NULL) is 0 for success.  Returns the number of
+   failed samples. */
+size_t dvrk_batch_kinematics_inverse(dvrk_batch_kinematics * batch,
+                                     const double * frames,
+                                     size_t samples,
+                                     double * positions,
+                                     int * status);
+
+/* Velocities can be NULL.  Returns 0 if there is no gravity
+   compensation configured. */
+int dvrk_batch_kinematics_gravity_compensation(dvrk_batch_kinematics * batch,
+                                               const double * positions,
+                                               const double * velocities,
+                                               size_t samples,
+                                               double * efforts);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _dvrk_batch_kinematics_h */
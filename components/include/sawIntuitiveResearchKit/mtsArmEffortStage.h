@@ -0,0 +1,91 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#ifndef _mtsArmEffortStage_h
+#define _mtsArmEffortStage_h
+
+#include <cisstMultiTask/mtsTaskPeriodic.h>
+#include <cisstParameterTypes/prmStateJoint.h>
+#include <cisstParameterTypes/prmForceTorqueJointSet.h>
+
+#include <sawIntuitiveResearchKit/mtsArmEffortStageModel.h>
+
+// always include last
+#include <sawIntuitiveResearchKit/sawIntuitiveResearchKitExport.h>
+
+/*!
+  Joint effort stage running at the PID rate.
+
+  This component is meant to be tied to the IO using the ExecIn/ExecOut
+  interfaces so it runs in the IO thread, right after the arm's PID.
+  The arm doesn't send its efforts (gravity compensation, cartesian
+  impedance...) to the PID anymore, it uploads a local model instead
+  (see mtsArmEffortStageModel): efforts, stiffness and damping around
+  the joint state used by the arm.  Every IO cycle, this component
+  reads the latest joint state from the PID, evaluates the model and
+  sends the efforts to the PID.
+
+  If the arm stops sending models (e.g. arm thread too slow), the
+  model is only extrapolated for mtsIntuitiveResearchKit::EffortStage::Timeout.
+  After that, a warning is sent and the last reference efforts are
+  ramped down to zero over EffortStage::RampDownDuration.  Zero
+  efforts are then sent until a new model is received.
+*/
+class CISST_EXPORT mtsArmEffortStage: public mtsTaskPeriodic
+{
+    CMN_DECLARE_SERVICES(CMN_DYNAMIC_CREATION_ONEARG, CMN_LOG_ALLOW_DEFAULT);
+
+public:
+    mtsArmEffortStage(const std::string & componentName, const double periodInSeconds);
+    mtsArmEffortStage(const mtsTaskPeriodicConstructorArg & arg);
+    ~mtsArmEffortStage() {};
+
+    void Configure(const std::string & CMN_UNUSED(filename) = "") {};
+    void Startup(void) {};
+    void Run(void);
+    void Cleanup(void) {};
+
+protected:
+
+    void Init(void);
+
+    /*! Command to upload new model */
+    void servo_jf_model(const mtsArmEffortStageModel & model);
+
+    // interface to PID component
+    struct {
+        mtsFunctionRead measured_js;
+        mtsFunctionWrite servo_jf;
+    } PID;
+
+    mtsInterfaceProvided * m_interface;
+
+    mtsArmEffortStageModel m_model;
+    double m_model_time;
+    bool m_model_stale;
+    double m_model_stale_time;
+
+    prmStateJoint m_measured_js;
+    prmForceTorqueJointSet m_servo_jf;
+    vctDoubleVec m_delta;
+    size_t m_number_of_stale_models;
+};
+
+CMN_DECLARE_SERVICES_INSTANTIATION(mtsArmEffortStage);
+
+#endif // _mtsArmEffortStage_h
@@ -0,0 +1,112 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#ifndef _mtsArmStatePublisher_h
+#define _mtsArmStatePublisher_h
+
+#include <string>
+
+#include <cisstCommon/cmnGenericObject.h>
+#include <cisstCommon/cmnLogger.h>
+
+#include <sawIntuitiveResearchKit/dvrk_arm_state_shm.h>
+
+// always include last
+#include <sawIntuitiveResearchKit/sawIntuitiveResearchKitExport.h>
+
+namespace Json {
+    class Value;
+}
+
+/*!
+  Publishes the arm state in a POSIX shared memory segment so local
+  processes can read it at the arm's rate without any bridge nor
+  network stack.  The segment layout is defined in the plain C header
+  dvrk_arm_state_shm.h, it is a versioned header followed by a ring of
+  fixed size records.
+
+  The owner fills the record in place between Begin and Commit, there
+  is no allocation, lock nor system call.  Readers map the segment
+  read only and use the per record sequence number to detect records
+  being written or overwritten, so any number of readers can be
+  attached without slowing down the control loop.
+
+  Only supported on Linux and macOS.
+*/
+class CISST_EXPORT mtsArmStatePublisher
+{
+public:
+    mtsArmStatePublisher(const cmnGenericObject & owner,
+                         const std::string & name);
+    ~mtsArmStatePublisher();
+
+    /*! Configure from JSON, i.e. "name" and "ring-size".  Returns
+      false and sets the error message if the configuration is
+      invalid. */
+    bool ConfigureJSON(const Json::Value & jsonConfig,
+                       std::string & errorMessage);
+
+    /*! Create and initialize the shared memory segment.  The period
+      is saved in the segment header for readers. */
+    bool Start(const double period);
+    void Stop(void);
+
+    /*! True if the user configured the publisher */
+    inline bool Enabled(void) const {
+        return m_enabled;
+    }
+
+    inline bool Running(void) const {
+        return m_segment != nullptr;
+    }
+
+    inline const std::string & SharedMemoryName(void) const {
+        return m_shared_memory_name;
+    }
+
+    /*! Real-time safe, to be called from the control thread.  Begin
+      returns the next record in the ring, marked as being written.
+      The owner must fill the record and call Commit. */
+    //@{
+    dvrk_arm_state_record * Begin(const double time);
+    void Commit(void);
+    //@}
+
+protected:
+    // for logs
+    const cmnClassServicesBase * OwnerServices;
+
+    inline const cmnClassServicesBase * Services(void) const {
+        return this->OwnerServices;
+    }
+
+    inline cmnLogger::StreamBufType * GetLogMultiplexer(void) const {
+        return cmnLogger::GetMultiplexer();
+    }
+
+    std::string m_name;
+    bool m_enabled;
+    std::string m_shared_memory_name;
+    size_t m_ring_size;
+    size_t m_segment_size;
+    dvrk_arm_state_segment * m_segment;
+    dvrk_arm_state_record * m_current;
+    uint64_t m_written;
+};
+
+#endif // _mtsArmStatePublisher_h
@@ -0,0 +1,130 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#ifndef _mtsCollisionMonitor_h
+#define _mtsCollisionMonitor_h
+
+#include <cisstMultiTask/mtsTaskPeriodic.h>
+#include <cisstParameterTypes/prmPositionCartesianGet.h>
+
+// always include last
+#include <sawIntuitiveResearchKit/sawIntuitiveResearchKitExport.h>
+
+/*!
+  Inter-arm collision monitor for PSMs and ECM.
+
+  Each arm is modeled as a set of capsules (segment and radius)
+  along the instrument/endoscope axis, i.e. the line going from the
+  tool tip through the RCM point.  Capsules are defined by their
+  distance from the tip along this axis so the part above the RCM
+  (shaft, tool housing and carriage) follows the insertion.  Tool tip
+  and RCM are provided in the same world frame by the arm's
+  `measured_cp` and `base_frame` (set by the SUJ on a full system).
+
+  Every cycle, arm pairs are first checked using an axis aligned
+  bounding box per arm (broad phase), then capsule pairs for arms
+  that might collide (narrow phase).  When two arms get closer than
+  the warning distance, a warning is sent.  Below the freeze
+  distance, both arms are frozen and an error is sent, the console
+  then disables tele-operation.  Messages and freeze are only sent
+  when a pair changes level, with some hysteresis.
+*/
+class CISST_EXPORT mtsCollisionMonitor: public mtsTaskPeriodic
+{
+    CMN_DECLARE_SERVICES(CMN_DYNAMIC_CREATION_ONEARG, CMN_LOG_ALLOW_DEFAULT);
+
+public:
+    mtsCollisionMonitor(const std::string & componentName, const double periodInSeconds);
+    mtsCollisionMonitor(const mtsTaskPeriodicConstructorArg & arg);
+    ~mtsCollisionMonitor();
+
+    void Configure(const std::string & filename = "");
+    virtual void Configure(const Json::Value & jsonConfig);
+    void Startup(void);
+    void Run(void);
+    void Cleanup(void);
+
+    /*! Add an arm to monitor with default capsules for given type
+      ("PSM" or "ECM").  This creates a required interface named
+      after the arm, to be connected to the arm's provided
+      interface. */
+    bool AddArm(const std::string & name, const std::string & type);
+
+    /*! Names of arms monitored, i.e. names of required interfaces */
+    std::vector<std::string> ArmNames(void) const;
+
+    /*! Minimum distance between the surfaces of two segments with
+      radius, negative if they intersect. */
+    static double CapsuleDistance(const vct3 & p1, const vct3 & q1, const double r1,
+                                  const vct3 & p2, const vct3 & q2, const double r2);
+
+protected:
+
+    void Init(void);
+
+    struct Capsule {
+        double m_start; // distance from tip along axis
+        double m_end;
+        double m_radius;
+        vct3 m_p, m_q;  // end points in world frame, updated every cycle
+    };
+
+    struct ArmData {
+        std::string m_name;
+        mtsFunctionRead measured_cp;
+        mtsFunctionRead base_frame;
+        mtsFunctionVoid Freeze;
+
+        prmPositionCartesianGet m_measured_cp;
+        vctFrm4x4 m_base_frame;
+        std::vector<Capsule> m_capsules;
+        bool m_valid;
+        // broad phase, axis aligned bounding box including radius
+        vct3 m_min, m_max;
+    };
+
+    typedef enum {COLLISION_NONE, COLLISION_WARNING, COLLISION_FREEZE} CollisionLevel;
+
+    struct ArmPair {
+        ArmData * m_first;
+        ArmData * m_second;
+        CollisionLevel m_level;
+    };
+
+    bool ConfigureCapsules(ArmData * arm, const Json::Value & jsonCapsules);
+    void UpdateArm(ArmData * arm);
+    double PairDistance(const ArmPair & pair) const;
+    void UpdatePairLevel(ArmPair & pair, const double distance);
+
+    std::vector<ArmData *> m_arms;
+    std::vector<ArmPair> m_pairs;
+
+    double m_warning_distance;
+    double m_freeze_distance;
+    double m_hysteresis;
+
+    // for users
+    double m_minimum_distance;
+    double m_check_duration;
+
+    mtsInterfaceProvided * m_interface;
+};
+
+CMN_DECLARE_SERVICES_INSTANTIATION(mtsCollisionMonitor);
+
+#endif // _mtsCollisionMonitor_h
@@ -0,0 +1,107 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#ifndef _mtsConsoleExecutor_h
+#define _mtsConsoleExecutor_h
+
+#include <cisstMultiTask/mtsTaskPeriodic.h>
+
+// always include last
+#include <sawIntuitiveResearchKit/sawIntuitiveResearchKitExport.h>
+
+/*!
+  Single threaded execution of all the periodic components of a
+  console.
+
+  Each registered component's ExecIn interface is connected to one of
+  the ExecOut interfaces of this component (see InterfaceName) so the
+  component doesn't use its own thread anymore.  Every period, this
+  component runs the registered components in the order they have
+  been registered (IO, PIDs, arms, tele-operations...).  Components
+  with a period longer than the executor's period are only run every
+  N periods, N being the closest integer to the ratio between the two
+  periods.  The periods are retrieved from the component manager when
+  the executor starts.
+
+  Each component can be given a budget (in seconds).  The duration
+  of each run is measured and runs exceeding the budget are counted.
+  New overruns are reported as warnings at most once per second and a
+  timing summary is logged when the component is stopped.
+*/
+class CISST_EXPORT mtsConsoleExecutor: public mtsTaskPeriodic
+{
+    CMN_DECLARE_SERVICES(CMN_DYNAMIC_CREATION_ONEARG, CMN_LOG_ALLOW_DEFAULT);
+
+public:
+    mtsConsoleExecutor(const std::string & componentName, const double periodInSeconds);
+    mtsConsoleExecutor(const mtsTaskPeriodicConstructorArg & arg);
+    ~mtsConsoleExecutor();
+
+    void Configure(const std::string & CMN_UNUSED(filename) = "") {};
+    void Startup(void);
+    void Run(void);
+    void Cleanup(void);
+
+    /*! Add a component, this creates a provided interface to be
+      connected to the component's ExecIn interface.  Must be called
+      before the component is started. */
+    bool Register(const std::string & name);
+
+    /*! Set budget in seconds for a registered component, 0 means no
+      budget. */
+    bool SetBudget(const std::string & name, const double budget);
+
+    /*! Name of provided interface for a given component */
+    std::string InterfaceName(const std::string & name) const;
+
+protected:
+
+    void Init(void);
+    void ReportOverruns(void);
+
+    struct ComponentData {
+        std::string m_name;
+        mtsFunctionVoid RunEvent;
+        size_t m_ratio;
+        size_t m_counter;
+        double m_budget;
+        // timing, m_duration and m_overruns are in state table
+        double m_duration;
+        double m_duration_max;
+        double m_duration_sum;
+        size_t m_number_of_runs;
+        size_t m_overruns;
+        size_t m_overruns_reported;
+    };
+
+    std::vector<ComponentData *> m_components;
+
+    // timing for the whole cycle
+    double m_cycle_duration;
+    double m_cycle_duration_max;
+    double m_cycle_duration_sum;
+    size_t m_number_of_cycles;
+    size_t m_cycle_overruns;
+    double m_time_last_report;
+
+    mtsInterfaceProvided * m_interface;
+};
+
+CMN_DECLARE_SERVICES_INSTANTIATION(mtsConsoleExecutor);
+
+#endif // _mtsConsoleExecutor_h
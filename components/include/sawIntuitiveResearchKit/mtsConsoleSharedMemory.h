@@ -0,0 +1,153 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#ifndef _mtsConsoleSharedMemory_h
+#define _mtsConsoleSharedMemory_h
+
+#include <atomic>
+#include <cstdint>
+
+#include <cisstMultiTask/mtsTaskPeriodic.h>
+
+// always include last
+#include <sawIntuitiveResearchKit/sawIntuitiveResearchKitExport.h>
+
+/*!
+  Base class for mtsConsoleSharedMemoryServer (control process) and
+  mtsConsoleSharedMemoryClient (GUI process).  The server creates a
+  POSIX shared memory segment ("/dev/shm/<name>" on Linux), the
+  client attaches to it.
+
+  Segment layout:
+  - header with list of arms (name and type), server heartbeat and
+    indices for the two queues
+  - one slot per arm with the arm's snapshot (see
+    mtsIntuitiveResearchKitArmSnapshot), configuration and operating
+    state.  Slots are written by the server using a sequence lock,
+    the client retries if the sequence changed while copying.
+  - events queue, written by the server and read by the client
+    (messages, operating states, console events).  If the client is
+    too slow, oldest events are lost.
+  - commands queue, single producer (client) and single consumer
+    (server).
+
+  Payloads are cisst objects serialized with SerializeRaw so both
+  processes must be built against the same cisst/dVRK versions (see
+  Version).  Only one client can be attached at a time.
+*/
+class CISST_EXPORT mtsConsoleSharedMemory: public mtsTaskPeriodic
+{
+public:
+    mtsConsoleSharedMemory(const std::string & componentName,
+                           const double periodInSeconds,
+                           const std::string & sharedMemoryName);
+    ~mtsConsoleSharedMemory();
+
+    enum {
+        Version = 1,
+        MaxArms = 16,
+        NameSize = 64,
+        ArmDataSize = 8192,
+        PayloadSize = 1024,
+        EventsSize = 256,
+        CommandsSize = 64
+    };
+
+    typedef enum {
+        // console
+        POWER_OFF, POWER_ON, HOME, TELEOP_ENABLE, SELECT_TELEOP_PSM,
+        SET_SCALE, SET_VOLUME,
+        EMULATE_OPERATOR_PRESENT, EMULATE_CLUTCH, EMULATE_CAMERA,
+        // arms
+        STATE_COMMAND, MOVE_JP, TRAJECTORY_J_SET_RATIO
+    } CommandType;
+
+    typedef enum {
+        // console and arms
+        MESSAGE_STATUS, MESSAGE_WARNING, MESSAGE_ERROR,
+        // console
+        ARM_CURRENT_STATE, TELEOP_ENABLED,
+        TELEOP_PSM_SELECTED, TELEOP_PSM_UNSELECTED,
+        SCALE, VOLUME,
+        // arms
+        DESIRED_STATE, OPERATING_STATE
+    } EventType;
+
+    /*! Event or command, target is 0 for the console and arm index + 1 for arms */
+    struct Entry {
+        uint32_t Target;
+        uint32_t Type;
+        uint32_t Size;
+        uint32_t Reserved;
+        char Payload[PayloadSize];
+    };
+
+    struct ArmSlot {
+        std::atomic<uint32_t> Sequence;
+        uint32_t Size;
+        char Data[ArmDataSize];
+    };
+
+    struct SegmentHeader {
+        char Magic[8];
+        uint32_t Version;
+        uint32_t NumberOfArms;
+        uint32_t CalibrationMode;
+        uint32_t Reserved;
+        double Period;
+        std::atomic<uint64_t> Heartbeat;
+        std::atomic<int64_t> ClientPID;
+        std::atomic<uint64_t> EventsWritten;
+        std::atomic<uint64_t> CommandsHead;
+        std::atomic<uint64_t> CommandsTail;
+        struct {
+            char Name[NameSize];
+            char Type[NameSize];
+        } Arms[MaxArms];
+    };
+
+    struct Segment {
+        SegmentHeader Header;
+        ArmSlot Arms[MaxArms];
+        Entry Events[EventsSize];
+        Entry Commands[CommandsSize];
+    };
+
+protected:
+    /*! Create and map the segment, server only */
+    bool Create(std::string & errorMessage);
+    /*! Map an existing segment and check version, client only */
+    bool Attach(std::string & errorMessage);
+    /*! Save client process Id in segment so the server can send
+      latest states.  Fails if another client is still running. */
+    bool RegisterClient(std::string & errorMessage);
+    void Detach(void);
+
+    /*! Serialize/de-serialize cisst object in a buffer, return false
+      if the buffer is too small or data can't be de-serialized. */
+    static bool Pack(const cmnGenericObject & data,
+                     char * buffer, const size_t bufferSize, uint32_t & size);
+    static bool Unpack(const char * buffer, const uint32_t size,
+                       cmnGenericObject & data);
+
+    std::string m_shared_memory_name;
+    Segment * m_segment;
+    bool m_owner;
+};
+
+#endif // _mtsConsoleSharedMemory_h
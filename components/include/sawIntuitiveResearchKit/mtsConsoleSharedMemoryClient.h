@@ -0,0 +1,142 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#ifndef _mtsConsoleSharedMemoryClient_h
+#define _mtsConsoleSharedMemoryClient_h
+
+#include <vector>
+
+#include <cisstMultiTask/mtsIntervalStatistics.h>
+#include <cisstParameterTypes/prmConfigurationJoint.h>
+#include <cisstParameterTypes/prmEventButton.h>
+#include <cisstParameterTypes/prmForceCartesianGet.h>
+#include <cisstParameterTypes/prmKeyValue.h>
+#include <cisstParameterTypes/prmOperatingState.h>
+#include <cisstParameterTypes/prmPositionCartesianGet.h>
+#include <cisstParameterTypes/prmPositionJointSet.h>
+#include <cisstParameterTypes/prmStateJoint.h>
+
+#include <sawIntuitiveResearchKit/mtsConsoleSharedMemory.h>
+#include <sawIntuitiveResearchKit/mtsIntuitiveResearchKitArmSnapshot.h>
+
+// always include last
+#include <sawIntuitiveResearchKit/sawIntuitiveResearchKitExport.h>
+
+/*!
+  Attaches to the shared memory created by
+  mtsConsoleSharedMemoryServer and provides the console interface
+  ("Main") and one interface per arm (named after the arm) so the
+  existing console and arm widgets can be used in a separate process.
+  Commands are sent back to the control process through the shared
+  memory commands queue.
+*/
+class CISST_EXPORT mtsConsoleSharedMemoryClient: public mtsConsoleSharedMemory
+{
+    CMN_DECLARE_SERVICES(CMN_NO_DYNAMIC_CREATION, CMN_LOG_ALLOW_DEFAULT);
+
+public:
+    mtsConsoleSharedMemoryClient(const std::string & componentName,
+                                 const double periodInSeconds,
+                                 const std::string & sharedMemoryName);
+    ~mtsConsoleSharedMemoryClient();
+
+    /*! Attach to shared memory and create interfaces for the console
+      and all arms published by the server.  The file name is not
+      used. */
+    void Configure(const std::string & filename = "") override;
+    void Startup(void) override {};
+    void Run(void) override;
+    void Cleanup(void) override;
+
+    struct ArmDescription {
+        std::string Name;
+        std::string Type; // MTM, PSM, ECM or SUJ
+    };
+
+    /*! Arms found in shared memory, available after Configure */
+    inline const std::vector<ArmDescription> & Arms(void) const {
+        return m_arm_descriptions;
+    }
+
+protected:
+    class ArmProxy {
+    public:
+        mtsConsoleSharedMemoryClient * m_client;
+        uint32_t m_target;
+        std::string m_name;
+        uint32_t m_sequence;
+        mtsInterfaceProvided * m_interface;
+        mtsIntuitiveResearchKitArmSnapshot m_snapshot;
+        prmStateJoint m_measured_js;
+        prmPositionCartesianGet m_measured_cp;
+        prmForceCartesianGet m_measured_cf_body;
+        mtsIntervalStatistics m_period_statistics;
+        prmConfigurationJoint m_configuration_js;
+        prmOperatingState m_operating_state;
+        mtsFunctionWrite desired_state;
+        mtsFunctionWrite operating_state;
+
+        void state_command(const std::string & command);
+        void move_jp(const prmPositionJointSet & position);
+        void trajectory_j_set_ratio(const double & ratio);
+    };
+
+    bool ReadArm(const size_t index);
+    void ReadEvents(void);
+    void ProcessEvent(const Entry & event);
+    void PushCommand(const uint32_t target, const CommandType type,
+                     const cmnGenericObject * payload = nullptr);
+    void HeartbeatCheck(void);
+
+    // console commands
+    void power_off(void);
+    void power_on(void);
+    void home(void);
+    void teleop_enable(const bool & enable);
+    void select_teleop_psm(const prmKeyValue & mtmPsm);
+    void set_scale(const double & scale);
+    void set_volume(const double & volume);
+    void emulate_operator_present(const prmEventButton & button);
+    void emulate_clutch(const prmEventButton & button);
+    void emulate_camera(const prmEventButton & button);
+    void calibration_mode(bool & result) const;
+
+    struct {
+        mtsFunctionWrite ArmCurrentState;
+        mtsFunctionWrite teleop_enabled;
+        mtsFunctionWrite teleop_psm_selected;
+        mtsFunctionWrite teleop_psm_unselected;
+        mtsFunctionWrite scale;
+        mtsFunctionWrite volume;
+    } mConsoleEvents;
+
+    mtsInterfaceProvided * m_console_interface;
+    std::vector<ArmProxy *> m_arms;
+    std::vector<ArmDescription> m_arm_descriptions;
+    std::vector<char> m_buffer;
+    uint64_t m_events_read;
+
+    // server heartbeat
+    uint64_t m_heartbeat;
+    double m_heartbeat_time;
+    bool m_server_alive;
+};
+
+CMN_DECLARE_SERVICES_INSTANTIATION(mtsConsoleSharedMemoryClient);
+
+#endif // _mtsConsoleSharedMemoryClient_h
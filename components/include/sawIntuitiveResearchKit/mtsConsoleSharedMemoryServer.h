@@ -0,0 +1,144 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#ifndef _mtsConsoleSharedMemoryServer_h
+#define _mtsConsoleSharedMemoryServer_h
+
+#include <map>
+#include <vector>
+
+#include <cisstMultiTask/mtsDelayedConnections.h>
+#include <cisstParameterTypes/prmConfigurationJoint.h>
+#include <cisstParameterTypes/prmKeyValue.h>
+#include <cisstParameterTypes/prmOperatingState.h>
+
+#include <sawIntuitiveResearchKit/mtsConsoleSharedMemory.h>
+#include <sawIntuitiveResearchKit/mtsIntuitiveResearchKitArmSnapshot.h>
+
+// always include last
+#include <sawIntuitiveResearchKit/sawIntuitiveResearchKitExport.h>
+
+class mtsIntuitiveResearchKitConsole;
+
+/*!
+  Publishes the console and arms state in shared memory for a GUI
+  running in a separate process (see mtsConsoleSharedMemoryClient and
+  sawIntuitiveResearchKitQtConsoleRemote).  This component runs at a
+  low rate in the control process and uses gui/snapshot to read each
+  arm once per period.  Commands sent by the GUI are forwarded to the
+  console and arms.
+*/
+class CISST_EXPORT mtsConsoleSharedMemoryServer: public mtsConsoleSharedMemory
+{
+    CMN_DECLARE_SERVICES(CMN_NO_DYNAMIC_CREATION, CMN_LOG_ALLOW_DEFAULT);
+
+public:
+    mtsConsoleSharedMemoryServer(const std::string & componentName,
+                                 const double periodInSeconds,
+                                 const std::string & sharedMemoryName);
+    ~mtsConsoleSharedMemoryServer();
+
+    /*! Create interfaces for the console and all its arms and the
+      shared memory segment. */
+    void Configure(mtsIntuitiveResearchKitConsole * console);
+
+    inline void Connect(void) {
+        m_connections.Connect();
+    }
+
+    void Startup(void) override {};
+    void Run(void) override;
+    void Cleanup(void) override;
+
+protected:
+    /*! Required interface and event handlers for each arm */
+    class ArmProxy {
+    public:
+        mtsConsoleSharedMemoryServer * m_server;
+        uint32_t m_target;
+        std::string m_name;
+        mtsFunctionRead gui_snapshot;
+        mtsFunctionRead measured_js;
+        mtsFunctionRead measured_cp;
+        mtsFunctionRead measured_cf_body;
+        mtsFunctionRead period_statistics;
+        mtsFunctionRead configuration_js;
+        mtsFunctionRead operating_state;
+        mtsFunctionWrite state_command;
+        mtsFunctionWrite move_jp;
+        mtsFunctionWrite trajectory_j_set_ratio;
+        mtsIntuitiveResearchKitArmSnapshot m_snapshot;
+        prmConfigurationJoint m_configuration_js;
+        prmOperatingState m_operating_state;
+
+        void StatusEventHandler(const mtsMessage & message);
+        void WarningEventHandler(const mtsMessage & message);
+        void ErrorEventHandler(const mtsMessage & message);
+        void DesiredStateEventHandler(const std::string & state);
+        void OperatingStateEventHandler(const prmOperatingState & state);
+    };
+
+    void UpdateArm(const size_t index);
+    void ProcessCommands(void);
+    void ProcessCommand(const Entry & command);
+
+    /*! Push event in shared memory queue.  Console events (not
+      messages) are also saved so they can be sent again when a new
+      client attaches. */
+    void PushEvent(const uint32_t target, const EventType type,
+                   const cmnGenericObject & payload,
+                   const std::string & latestKey = "");
+    void PushEntry(const Entry & entry);
+    void ClientAttachedCheck(void);
+
+    // console event handlers
+    void StatusEventHandler(const mtsMessage & message);
+    void WarningEventHandler(const mtsMessage & message);
+    void ErrorEventHandler(const mtsMessage & message);
+    void ArmCurrentStateEventHandler(const prmKeyValue & armState);
+    void TeleopEnabledEventHandler(const bool & enabled);
+    void TeleopPSMSelectedEventHandler(const prmKeyValue & mtmPsm);
+    void TeleopPSMUnselectedEventHandler(const prmKeyValue & mtmPsm);
+    void ScaleEventHandler(const double & scale);
+    void VolumeEventHandler(const double & volume);
+
+    struct {
+        mtsFunctionVoid power_off;
+        mtsFunctionVoid power_on;
+        mtsFunctionVoid home;
+        mtsFunctionWrite teleop_enable;
+        mtsFunctionWrite select_teleop_psm;
+        mtsFunctionWrite set_scale;
+        mtsFunctionWrite set_volume;
+        mtsFunctionWrite emulate_operator_present;
+        mtsFunctionWrite emulate_clutch;
+        mtsFunctionWrite emulate_camera;
+    } mConsole;
+
+    std::vector<ArmProxy *> m_arms;
+    mtsDelayedConnections m_connections;
+
+    // latest console and arm events, sent again to new clients
+    std::map<std::string, Entry> m_latest_events;
+    int64_t m_client_pid;
+    size_t m_events_failed;
+};
+
+CMN_DECLARE_SERVICES_INSTANTIATION(mtsConsoleSharedMemoryServer);
+
+#endif // _mtsConsoleSharedMemoryServer_h
@@ -0,0 +1,177 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#ifndef _mtsConsoleStartup_h
+#define _mtsConsoleStartup_h
+
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <cisstCommon/cmnGenericObject.h>
+#include <cisstCommon/cmnLogger.h>
+#include <cisstParameterTypes/prmOperatingState.h>
+
+// always include last
+#include <sawIntuitiveResearchKit/sawIntuitiveResearchKitExport.h>
+
+namespace Json {
+    class Value;
+}
+
+/*!
+  Orchestrates the console power_on and home commands across all arms
+  and keeps track of the time spent by each arm in each state.
+
+  Arms that need to be powered are staged: at most "max-powering"
+  arms can be in state POWERING at the same time, the next arm in the
+  list is started as soon as an arm is powered (leaves POWERING).
+  This limits the inrush current on shared power supplies.  An arm
+  that faults, goes back to DISABLED or doesn't report power within
+  twice mtsIntuitiveResearchKit::TimeToPower is marked as failed and
+  releases its slot so the remaining arms can still be started.  Arms
+  already powered are started immediately.  All other phases
+  (encoder calibration, homing, MTM roll calibration, PSM adapter and
+  tool engagement) run in parallel since each arm follows its own
+  state machine once started.
+
+  When all arms are ready (or faulted), a report with the duration of
+  each phase per arm is generated.  If an arm starts a new phase
+  after the report (e.g. PSM engaging the adapter right after
+  homing), the report is updated when the arm is ready again.
+
+  This class is not a component, all methods must be called from the
+  console's thread.
+*/
+class CISST_EXPORT mtsConsoleStartup
+{
+public:
+    mtsConsoleStartup(const cmnGenericObject & owner);
+
+    /*! Configure from JSON, i.e. "max-powering" and "order".  Returns
+      false and sets the error message if the configuration is
+      invalid. */
+    bool ConfigureJSON(const Json::Value & jsonConfig,
+                       std::string & errorMessage);
+
+    /*! Start a new sequence for the command "enable" or "home".  Each
+      arm is provided with its last known operating state.  Returns
+      the list of arms the command should be sent to now, the other
+      arms are returned later by StateChanged and
+      OperatingStateChanged. */
+    void Begin(const std::string & command,
+               const std::map<std::string, prmOperatingState> & arms,
+               const double time,
+               std::list<std::string> & start);
+
+    /*! Abort the current sequence, e.g. on power_off.  Arms not
+      started yet are dropped. */
+    void Abort(const double time);
+
+    /*! To be called on arm's current_state events.  Returns arms to
+      start now. */
+    void StateChanged(const std::string & arm,
+                      const std::string & state,
+                      const double time,
+                      std::list<std::string> & start);
+
+    /*! To be called on arm's operating_state events.  Returns arms to
+      start now.  Returns true if all arms are ready and the report
+      has been updated. */
+    bool OperatingStateChanged(const std::string & arm,
+                               const prmOperatingState & state,
+                               const double time,
+                               std::list<std::string> & start);
+
+    /*! Fails arms that have been powering for too long and releases
+      their slots.  To be called periodically, i.e. from the console's
+      Run method.  Returns arms to start now.  Returns true if all arms
+      are ready and the report has been updated. */
+    bool CheckTimeouts(const double time,
+                       std::list<std::string> & start);
+
+    /*! Command of current sequence, i.e. "enable" or "home" */
+    inline const std::string & Command(void) const {
+        return m_command;
+    }
+
+    /*! Full report, one line per arm with the duration of each phase */
+    inline const std::string & Report(void) const {
+        return m_report;
+    }
+
+    /*! One line summary of last completed sequence */
+    inline const std::string & Summary(void) const {
+        return m_summary;
+    }
+
+protected:
+    // for logs
+    const cmnClassServicesBase * OwnerServices;
+
+    inline const cmnClassServicesBase * Services(void) const {
+        return this->OwnerServices;
+    }
+
+    inline cmnLogger::StreamBufType * GetLogMultiplexer(void) const {
+        return cmnLogger::GetMultiplexer();
+    }
+
+    typedef enum {QUEUED, POWERING, STARTED, READY, FAILED} ArmStatus;
+
+    struct Phase {
+        std::string Name;
+        double Start;
+    };
+
+    struct ArmSequence {
+        ArmStatus Status;
+        bool NeedsPower;
+        double Queued;
+        double Powering;
+        double Ready;
+        std::vector<Phase> Phases;
+    };
+
+    void StartNext(const double time, std::list<std::string> & start);
+    void PowerReleased(ArmSequence & arm, const double time,
+                       std::list<std::string> & start);
+    void PowerFailed(ArmSequence & arm, const double time,
+                     std::list<std::string> & start);
+    bool IsReady(const prmOperatingState & state) const;
+    bool CheckCompleted(const double time);
+    void UpdateReport(const double time);
+
+    size_t m_max_powering;
+    double m_power_timeout;
+    std::vector<std::string> m_order;
+
+    bool m_active;
+    std::string m_command;
+    double m_begin;
+    std::map<std::string, ArmSequence> m_arms;
+    std::list<std::string> m_queue;
+    size_t m_powering;
+    bool m_completed;
+
+    std::string m_report;
+    std::string m_summary;
+};
+
+#endif // _mtsConsoleStartup_h
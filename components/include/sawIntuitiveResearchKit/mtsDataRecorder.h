@@ -0,0 +1,204 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#ifndef _mtsDataRecorder_h
+#define _mtsDataRecorder_h
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include <cisstCommon/cmnGenericObject.h>
+#include <cisstCommon/cmnLogger.h>
+#include <cisstOSAbstraction/osaThread.h>
+#include <cisstOSAbstraction/osaThreadSignal.h>
+#include <cisstVector/vctTransformationTypes.h>
+
+// always include last
+#include <sawIntuitiveResearchKit/sawIntuitiveResearchKitExport.h>
+
+namespace Json {
+    class Value;
+}
+
+class mtsStateTable;
+class mtsInterfaceProvided;
+
+/*!
+  High rate binary data recorder for control loops.
+
+  The owner registers the signals it can provide and the user selects
+  a subset in the JSON configuration ("signals").  Each cycle, the
+  control thread copies the selected signals in a row of a
+  preallocated lock-free ring using Begin, Append and Commit, there is
+  no allocation, lock nor system call.  If the ring is full, the row
+  is dropped and counted.
+
+  A low priority thread copies the rows to a memory mapped,
+  append-only file and periodically updates the number of records in
+  the header and flushes the file.  The file is grown by large chunks
+  and truncated to its actual size on Stop.
+
+  File format, all little endian:
+  - 8 bytes magic number "dVRKREC" (null terminated)
+  - uint32 format version (1)
+  - uint32 header size in bytes, i.e. offset of first record
+  - uint32 number of columns (doubles per record)
+  - uint32 reserved
+  - uint64 number of records, updated while recording
+  - null terminated JSON description of the file (component name,
+    period, creation time and list of signals with name, size and
+    first column), padded to 8 bytes
+  - records, each with number of columns doubles.  The first column
+    is always the time in seconds.
+
+  See share/collection/dvrk-recorder-convert.py to convert files to
+  CSV or NumPy.  Only supported on Linux and macOS.
+*/
+class CISST_EXPORT mtsDataRecorder
+{
+public:
+    mtsDataRecorder(const cmnGenericObject & owner,
+                    const std::string & name);
+    ~mtsDataRecorder();
+
+    /*! Configure from JSON, i.e. "file", "signals", "ring-size" and
+      "flush-period".  Returns false and sets the error message if
+      the configuration is invalid. */
+    bool ConfigureJSON(const Json::Value & jsonConfig,
+                       std::string & errorMessage);
+
+    /*! Declare a signal the owner can provide, name and number of
+      values.  Must be called before Start, in the same order as the
+      values are appended in each record.  Returns false if the signal
+      has not been selected by the user so the owner can skip it. */
+    bool AddSignal(const std::string & name, const size_t size);
+
+    /*! Check that all signals selected by the user have been added
+      by the owner.  Returns false and sets the error message
+      otherwise. */
+    bool CheckSignals(std::string & errorMessage) const;
+
+    /*! Add counters to state table and read commands to interface,
+      i.e. "recorder_records" and "recorder_dropped". */
+    void AddToInterface(mtsStateTable & stateTable,
+                        mtsInterfaceProvided * interfaceProvided);
+
+    /*! Create file, write header and start the writing thread.  The
+      period is only used for the file description. */
+    bool Start(const double period);
+    void Stop(void);
+
+    /*! True if the user configured the recorder */
+    inline bool Enabled(void) const {
+        return m_enabled;
+    }
+
+    inline bool Running(void) const {
+        return m_running;
+    }
+
+    /*! Real-time safe, to be called from the control thread.  Begin
+      returns false if the ring is full, in which case the owner
+      should not call Append nor Commit. */
+    //@{
+    bool Begin(const double time);
+    /*! Append size values to the current record.  If the number of
+      values is different from the one declared with AddSignal
+      (declaredSize), the values are truncated or padded with NaN. */
+    void Append(const double * values, const size_t size,
+                const size_t declaredSize);
+    void Append(const double value);
+    /*! Append 12 values, translation followed by row major rotation */
+    void Append(const vctFrm4x4 & frame);
+    void Commit(void);
+    //@}
+
+    /*! Number of records dropped because the ring was full. */
+    inline size_t NumberOfDropped(void) const {
+        return m_dropped;
+    }
+
+    /*! Number of records written to file */
+    inline size_t NumberOfRecords(void) const {
+        return m_records_written;
+    }
+
+    /*! Selected signal names */
+    inline const std::vector<std::string> & SelectedSignals(void) const {
+        return m_selected;
+    }
+
+protected:
+    struct Signal {
+        std::string m_name;
+        size_t m_size;
+        size_t m_first_column;
+    };
+
+    void * ThreadRun(void * argument);
+    size_t WriteAvailable(void);
+    bool Grow(const size_t numberOfRecords);
+    void UpdateHeader(void);
+
+    // for logs
+    const cmnClassServicesBase * OwnerServices;
+
+    inline const cmnClassServicesBase * Services(void) const {
+        return this->OwnerServices;
+    }
+
+    inline cmnLogger::StreamBufType * GetLogMultiplexer(void) const {
+        return cmnLogger::GetMultiplexer();
+    }
+
+    std::string m_name;
+    bool m_enabled;
+    std::string m_file_name;
+    std::vector<std::string> m_selected;
+    std::vector<std::string> m_available;
+    std::vector<Signal> m_signals;
+    size_t m_number_of_columns;
+    size_t m_ring_size;
+    double m_flush_period;
+
+    // ring of records, single producer, single consumer
+    std::vector<double> m_ring;
+    std::atomic<size_t> m_head, m_tail;
+    double * m_current;
+    size_t m_current_column;
+    std::atomic<size_t> m_dropped;
+
+    // memory mapped file
+    int m_file_descriptor;
+    char * m_map;
+    size_t m_map_size;
+    size_t m_header_size;
+    size_t m_records_capacity;
+    std::atomic<size_t> m_records_written;
+
+    // counters, in state table, updated by control thread
+    size_t m_records_state;
+    size_t m_dropped_state;
+
+    osaThread m_thread;
+    osaThreadSignal m_signal;
+    std::atomic<bool> m_running;
+};
+
+#endif // _mtsDataRecorder_h
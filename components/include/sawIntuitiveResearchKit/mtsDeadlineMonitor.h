@@ -0,0 +1,135 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#ifndef _mtsDeadlineMonitor_h
+#define _mtsDeadlineMonitor_h
+
+#include <string>
+
+// always include last
+#include <sawIntuitiveResearchKit/sawIntuitiveResearchKitExport.h>
+
+namespace Json {
+    class Value;
+}
+
+class mtsStateTable;
+class mtsInterfaceProvided;
+
+/*!
+  Deadline miss detector with graceful degradation, used by arms and
+  tele-operation components.
+
+  The component measures the duration of each cycle and calls Update.
+  If the duration exceeds the budget, the number of consecutive
+  overruns increases and the degradation level is raised when the
+  configured thresholds are reached:
+  - SKIP_OUTPUTS, the component skips optional computations
+  - FREEZE, the component holds its current joint position, arms
+    ignore motion commands until the level goes back down and emit
+    the event frozen so tele-operation can re-align on recovery
+  - DISABLE, arms send an error (they stay powered and frozen) and
+    tele-operation is disabled
+  The level goes back to NOMINAL after a number of consecutive cycles
+  within budget.  The component is responsible for the actions
+  associated to each level.  A threshold set to 0 skips the
+  corresponding level.  The monitor is disabled if the budget is 0.
+
+  Counters are added to the component's state table and provided
+  interface with AddToInterface.  Update doesn't allocate memory so
+  it can be used in the control loop.
+*/
+class CISST_EXPORT mtsDeadlineMonitor
+{
+public:
+    typedef enum {NOMINAL = 0, SKIP_OUTPUTS, FREEZE, DISABLE} Level;
+
+    mtsDeadlineMonitor(void);
+
+    /*! Configure from JSON, i.e. "budget", "skip-outputs",
+      "freeze", "disable" and "recovery".  Returns false and sets
+      the error message if the configuration is invalid. */
+    bool ConfigureJSON(const Json::Value & jsonConfig,
+                       std::string & errorMessage);
+
+    /*! Add counters to state table and read commands to interface,
+      all prefixed by "deadline_". */
+    void AddToInterface(mtsStateTable & stateTable,
+                        mtsInterfaceProvided * interfaceProvided);
+
+    inline bool Enabled(void) const {
+        return m_budget > 0.0;
+    }
+
+    /*! Update with last cycle duration, returns true if the level
+      changed. */
+    bool Update(const double duration);
+
+    inline Level CurrentLevel(void) const {
+        return m_level;
+    }
+
+    /*! Level before last change, to detect recovery. */
+    inline Level PreviousLevel(void) const {
+        return m_previous_level;
+    }
+
+    inline bool SkipOutputs(void) const {
+        return m_level >= SKIP_OUTPUTS;
+    }
+
+    inline bool Frozen(void) const {
+        return m_level >= FREEZE;
+    }
+
+    inline double Budget(void) const {
+        return m_budget;
+    }
+
+    inline size_t ConsecutiveOverruns(void) const {
+        return m_consecutive_overruns;
+    }
+
+    /*! Human readable level name */
+    static const char * LevelName(const Level level);
+
+protected:
+    void SetLevel(const Level level);
+
+    double m_budget;
+    // thresholds in consecutive cycles
+    size_t m_skip_outputs_threshold;
+    size_t m_freeze_threshold;
+    size_t m_disable_threshold;
+    size_t m_recovery_threshold;
+
+    Level m_level;
+    Level m_previous_level;
+    size_t m_consecutive_overruns;
+    size_t m_consecutive_within_budget;
+
+    // counters, in state table
+    double m_duration;
+    int m_level_int;
+    size_t m_overruns;
+    size_t m_skip_outputs;
+    size_t m_freezes;
+    size_t m_disables;
+};
+
+#endif // _mtsDeadlineMonitor_h
@@ -39,6 +39,14 @@ namespace mtsIntuitiveResearchKit {
     // https://github.com/jhu-cisst/QLA/issues/1
     const double TimeToPower = 3.0 * cmn_s;
 
+    // history depth of arm state table used for signals exposed with
+    // latest value only, see mtsIntuitiveResearchKitArm::set_state_table
+    const size_t StateTableLatestSize = 10;
+
+    // period used by the arms to update the snapshot read by the GUI
+    // (gui/snapshot), see mtsIntuitiveResearchKitArmSnapshot
+    const double GUISnapshotPeriod = 20.0 * cmn_ms;
+
     // joint trajectory ratios
     namespace JointTrajectory {
         const double ratio = 1.0;
@@ -59,6 +67,10 @@ namespace mtsIntuitiveResearchKit {
 
         // range of motion used for 4 last actuators to engage the sterile adapter
         const double AdapterEngageRange = 171.0 * cmnPI_180;
+
+        // servo_cp velocities above these are ignored for feed forward
+        const double VelocityFeedForwardMaxLinear = 0.5; // m/s
+        const double VelocityFeedForwardMaxAngular = 10.0; // rad/s
     }
 
     // MTM constants
@@ -69,6 +81,40 @@ namespace mtsIntuitiveResearchKit {
         const double EffortMax = 0.4;
     }
 
+    // collision monitor constants, capsules are defined by distance
+    // from tip along the tool axis, dimensions are approximate
+    namespace CollisionMonitor {
+        const double WarningDistance = 10.0 * cmn_mm;
+        const double FreezeDistance = 3.0 * cmn_mm;
+        const double Hysteresis = 2.0 * cmn_mm;
+        // 8 mm instruments, shaft then tool housing and sterile adapter
+        const double PSMShaftLength = 430.0 * cmn_mm;
+        const double PSMShaftRadius = 4.5 * cmn_mm;
+        const double PSMHousingLength = 100.0 * cmn_mm;
+        const double PSMHousingRadius = 40.0 * cmn_mm;
+        // 12 mm endoscope, shaft then camera head
+        const double ECMShaftLength = 440.0 * cmn_mm;
+        const double ECMShaftRadius = 6.5 * cmn_mm;
+        const double ECMHousingLength = 150.0 * cmn_mm;
+        const double ECMHousingRadius = 45.0 * cmn_mm;
+    }
+
+    // effort stage, see mtsArmEffortStage
+    namespace EffortStage {
+        const double Timeout = 10.0 * cmn_ms; // stop extrapolation if model is older
+        const double RampDownDuration = 500.0 * cmn_ms; // then ramp efforts to zero
+        const double DerivativeStep = 1.0e-5; // numerical derivatives, in meters, radians, m/s, rad/s
+    }
+
+    // deadline monitor, see mtsDeadlineMonitor.  Thresholds are
+    // numbers of consecutive cycles
+    namespace Deadline {
+        const size_t SkipOutputs = 2;
+        const size_t Freeze = 10;
+        const size_t Disable = 50;
+        const size_t Recovery = 500;
+    }
+
     // teleoperation constants
     namespace TeleOperationPSM {
         const double Scale = 0.2;
@@ -78,6 +124,7 @@ namespace mtsIntuitiveResearchKit {
         const double JawRate =  2.0 * cmnPI * cmn_s; // 360 d/s
         const double JawRateBackFromClutch =  0.2 * cmnPI * cmn_s; // 36.0 d/s
         const double ToleranceBackFromClutch =  2.0 * cmnPI_180; // in radians
+        const double IdlePeriod = 50.0 * cmn_ms; // 20 Hz when disabled
     }
 };
 
@@ -42,6 +42,13 @@ http://www.cisst.org/cisst/license.txt.
 #include <sawIntuitiveResearchKit/mtsIntuitiveResearchKit.h>
 #include <sawIntuitiveResearchKit/mtsIntuitiveResearchKitArmTypes.h>
 #include <sawIntuitiveResearchKit/mtsStateMachine.h>
+#include <sawIntuitiveResearchKit/mtsMessageRing.h>
+#include <sawIntuitiveResearchKit/mtsDeadlineMonitor.h>
+#include <sawIntuitiveResearchKit/mtsDataRecorder.h>
+#include <sawIntuitiveResearchKit/mtsArmStatePublisher.h>
+#include <sawIntuitiveResearchKit/mtsArmEffortStageModel.h>
+#include <sawIntuitiveResearchKit/mtsIntuitiveResearchKitArmSnapshot.h>
+#include <sawIntuitiveResearchKit/robForwardKinematicsCache.h>
 
 // forward declarations
 class osaCartesianImpedanceController;
@@ -70,6 +77,24 @@ class CISST_EXPORT mtsIntuitiveResearchKitArm: public mtsTaskPeriodic
         m_calibration_mode = mode;
     }
 
+    /*! Period used while the arm is idle, i.e. DISABLED, FAULT or
+      HOMED without any control mode.  The arm still processes
+      commands and events at its nominal rate and resumes full rate
+      as soon as a control mode or a new state is requested.  Use 0
+      (default) to always run at the nominal rate. */
+    inline void set_idle_period(const double idlePeriod) {
+        m_idle_period = idlePeriod;
+    }
+
+    /*! Signals exposed with their latest value only, i.e. not
+      recorded with history in the default state table, and history
+      depth of the default state table (0 to keep default).  Signals
+      are identified by their read command name (e.g. "body/jacobian",
+      "measured_cv").  Overrides the "state-table" settings from the
+      arm configuration file, must be called before Configure. */
+    void set_state_table(const size_t history,
+                         const std::vector<std::string> & latest);
+
  protected:
 
     /*! Define wrench reference frame */
@@ -94,7 +119,7 @@ class CISST_EXPORT mtsIntuitiveResearchKitArm: public mtsTaskPeriodic
     virtual void Init(void);
 
     void UpdateConfigurationJointKinematic(void);
-    void ResizeKinematicsData(void);
+    virtual void ResizeKinematicsData(void);
 
     /*! Verify that the state transition is possible, initialize
       global variables for the desired state and finally set the
@@ -160,10 +185,41 @@ class CISST_EXPORT mtsIntuitiveResearchKitArm: public mtsTaskPeriodic
     // state table for configuration parameters
     mtsStateTable mStateTableConfiguration;
 
+    // state table for signals without history, see set_state_table
+    mtsStateTable mStateTableLatest;
+    size_t m_state_table_history = 0;
+    std::vector<std::string> m_state_table_latest;
+    bool m_state_table_overridden = false;
+    bool m_state_table_configured = false;
+    /*! Add signals to default or latest state table and read
+      commands to the arm interface.  Called at the end of Configure. */
+    void ConfigureStateTables(void);
+    /*! State table used for a given read command */
+    mtsStateTable & StateTableFor(const std::string & commandName);
+
+    // state table for GUI, updated every GUISnapshotPeriod
+    mtsStateTable mStateTableGUI;
+    mtsIntuitiveResearchKitArmSnapshot m_gui_snapshot;
+    size_t m_gui_snapshot_counter = 0;
+    size_t m_gui_snapshot_decimation = 1;
+    /*! Copy signals displayed by the GUI in m_gui_snapshot, derived
+      classes can add signals and must call this method. */
+    virtual void UpdateGUISnapshot(void);
+
     /*! Wrapper to convert vector of joint values to prmPositionJointSet and send to PID */
     virtual void servo_jp_internal(const vctDoubleVec & newPosition);
     virtual void servo_jf_internal(const vctDoubleVec & newEffort);
     inline virtual void update_feed_forward(vctDoubleVec & CMN_UNUSED(feedForward)) {};
+    /*! Compute feed forward using update_feed_forward and send it
+      to the PID. */
+    void feed_forward_internal(void);
+
+    /*! Compute stiffness and damping in joint space for the
+      cartesian impedance controller, used by the effort stage to
+      update efforts between two arm cycles. */
+    void control_effort_stage_impedance(void);
+    /*! Tell the effort stage to stop sending efforts to the PID */
+    void effort_stage_disable(void);
 
     /*! Methods used for commands */
     virtual void Freeze(void);
@@ -202,6 +258,11 @@ class CISST_EXPORT mtsIntuitiveResearchKitArm: public mtsTaskPeriodic
         return (NumberOfBrakes() > 0);
     }
 
+    /*! Read actuator and brake amplifiers status from IO in
+      preallocated buffers.  Returns true if all amplifiers are
+      enabled. */
+    bool GetAmpStatus(void);
+
     inline virtual bool UsePIDTrackingError(void) const {
         return true;
     }
@@ -288,11 +349,18 @@ class CISST_EXPORT mtsIntuitiveResearchKitArm: public mtsTaskPeriodic
         mtsFunctionWrite desired_state;
         mtsFunctionWrite current_state;
         mtsFunctionWrite operating_state;
+        mtsFunctionWrite frozen;
     } state_events;
 
     robManipulator * Manipulator;
     std::string mConfigurationFile;
 
+    // link transformations cached for measured and setpoint joint
+    // values, reused by forward kinematics, jacobians and IK within
+    // a cycle.  Use m_setpoint_kinematics for IK, the solution is
+    // usually the next setpoint.
+    mutable robForwardKinematicsCache m_measured_kinematics, m_setpoint_kinematics;
+
     // cache cartesian goal position and increment
     bool m_new_pid_goal;
     prmPositionCartesianSet CartesianSetParam;
@@ -333,6 +401,48 @@ class CISST_EXPORT mtsIntuitiveResearchKitArm: public mtsTaskPeriodic
 
     // cartesian impendance controller
     osaCartesianImpedanceController * mCartesianImpedanceController;
+
+    // optional effort stage running at PID rate, see mtsArmEffortStage.
+    // when used, efforts are uploaded as a model instead of being sent to the PID
+    struct {
+        mtsFunctionWrite servo_jf_model;
+        bool used = false;
+        bool has_derivatives = false;
+        mtsArmEffortStageModel model;
+        vctDoubleMat cartesian_stiffness, cartesian_damping;
+        vctDoubleMat product, rotated_jacobian;
+    } m_effort_stage;
+
+    // messages from control loop, formatted and rate limited in
+    // separate thread
+    mtsMessageRing * m_messages;
+    struct {
+        size_t measured_js_failed;
+        size_t setpoint_js_failed;
+        size_t inverse_kinematics_failed;
+        size_t deadline_degraded;
+        size_t deadline_disable;
+        size_t deadline_recovered;
+    } m_message_codes;
+
+    // cycle duration check, see mtsDeadlineMonitor
+    mtsDeadlineMonitor m_deadline;
+    void DeadlineLevelChanged(void);
+
+    // optional high rate recording, see mtsDataRecorder
+    mtsDataRecorder * m_recorder;
+    bool m_recorder_configured = false;
+    size_t m_recorder_joints = 0;
+    // selected signals, measured_js, setpoint_js, pid/measured_js and pid/setpoint_js
+    bool m_recorder_js[4];
+    bool m_recorder_measured_cp, m_recorder_setpoint_cp, m_recorder_measured_cv,
+        m_recorder_body_measured_cf, m_recorder_servo_jf, m_recorder_cycle_duration;
+    void ConfigureRecorder(void);
+    void Record(const double duration);
+
+    // optional state publisher for local processes, see mtsArmStatePublisher
+    mtsArmStatePublisher * m_publisher;
+    void Publish(void);
     bool m_cartesian_impedance;
 
     // used by MTM only
@@ -354,15 +464,22 @@ class CISST_EXPORT mtsIntuitiveResearchKitArm: public mtsTaskPeriodic
     bool m_base_frame_valid;
 
     bool m_powered = false;
+    // preallocated to avoid dynamic allocation in GetRobotData
+    vctBoolVec m_actuator_amp_status, m_brake_amp_status;
 
     mtsIntuitiveResearchKitArmTypes::ControlSpace m_control_space;
     mtsIntuitiveResearchKitArmTypes::ControlMode m_control_mode;
 
-    /*! Method used to check if the arm is ready and throttle messages sent. */
+    /*! Check if the arm is ready for a motion command.  When the
+      deadline monitor freezes the arm, all motion commands are
+      rejected except if allowFrozen is set (i.e. Freeze). */
     bool ArmIsReady(const std::string & methodName,
-                    const mtsIntuitiveResearchKitArmTypes::ControlSpace space);
+                    const mtsIntuitiveResearchKitArmTypes::ControlSpace space,
+                    const bool allowFrozen = false);
     size_t mArmNotReadyCounter;
     double mArmNotReadyTimeLastMessage;
+    size_t mArmFrozenCounter;
+    double mArmFrozenTimeLastMessage;
 
     /*! Set joint velocity ratio for trajectory generation.  Computes
       joint velocities based on maximum joint velocities.  Ratio must
@@ -493,6 +610,12 @@ class CISST_EXPORT mtsIntuitiveResearchKitArm: public mtsTaskPeriodic
 
     // flag to determine if the arm is running in calibration mode, i.e. turn off checks using potentiometers
     bool m_calibration_mode;
+
+    // reduced rate when idle
+    bool IsIdle(void);
+    double m_idle_period = 0.0;
+    size_t m_idle_skip = 0;
+    size_t m_idle_counter = 0;
 };
 
 CMN_DECLARE_SERVICES_INSTANTIATION(mtsIntuitiveResearchKitArm);
@@ -36,6 +36,7 @@ http://www.cisst.org/cisst/license.txt.
 
 #include <QWidget>
 
+#include <sawIntuitiveResearchKit/mtsIntuitiveResearchKitArmSnapshot.h>
 #include <sawIntuitiveResearchKit/sawIntuitiveResearchKitQtExport.h>
 
 class QCheckBox;
@@ -57,6 +58,7 @@ public:
 
 protected:
     virtual void closeEvent(QCloseEvent * event);
+    virtual void showEvent(QShowEvent * event);
 
 signals:
     void SignalDesiredState(QString state);
@@ -75,6 +77,13 @@ private:
     void setupUi(void);
     int TimerPeriodInMilliseconds;
 
+    // refresh rate is lowered when the arm doesn't move, the display
+    // is updated every RefreshDecimation timer events
+    size_t RefreshDecimation;
+    size_t RefreshCounter;
+    vctDoubleVec PreviousPosition;
+    void UpdateRefreshDecimation(void);
+
 protected:
     struct ArmStruct {
         mtsFunctionRead configuration_js;
@@ -83,6 +92,7 @@ protected:
         mtsFunctionRead measured_cf_body;
         mtsFunctionWrite move_jp;
         mtsFunctionRead period_statistics;
+        mtsFunctionRead gui_snapshot;
         mtsEventReceiverWrite trajectory_j_ratio;
         mtsFunctionWrite trajectory_j_set_ratio;
     } Arm;
@@ -93,7 +103,14 @@ protected:
 
     mtsInterfaceRequired * InterfaceRequired;
     inline virtual void setupUiDerived(void) {};
+    /*! Called after the arm data has been read.  If the arm provides
+      gui/snapshot (see UsesSnapshot), derived classes should use the
+      data from Snapshot instead of issuing more read commands. */
     inline virtual void timerEventDerived(void) {};
+    inline bool UsesSnapshot(void) const {
+        return Arm.gui_snapshot.IsValid();
+    }
+    mtsIntuitiveResearchKitArmSnapshot Snapshot;
     virtual void SetDirectControl(const bool direct);
 
     bool DirectControl;
@@ -20,6 +20,8 @@ http://www.cisst.org/cisst/license.txt.
 #ifndef _mtsIntuitiveResearchKitConsole_h
 #define _mtsIntuitiveResearchKitConsole_h
 
+#include <list>
+
 #include <cisstMultiTask/mtsTaskFromSignal.h>
 #include <cisstMultiTask/mtsDelayedConnections.h>
 #include <cisstParameterTypes/prmOperatingState.h>
@@ -39,6 +41,11 @@ namespace dvrk {
 class mtsTextToSpeech;
 class mtsDaVinciHeadSensor;
 class mtsDaVinciEndoscopeFocus;
+class mtsCollisionMonitor;
+class mtsParallelArmExecutor;
+class mtsConsoleExecutor;
+class mtsConsoleSharedMemoryServer;
+class mtsConsoleStartup;
 class mtsIntuitiveResearchKitArm;
 
 class CISST_EXPORT mtsIntuitiveResearchKitConsole: public mtsTaskFromSignal
@@ -47,6 +54,7 @@ class CISST_EXPORT mtsIntuitiveResearchKitConsole: public mtsTaskFromSignal
 
  public:
     friend class mtsIntuitiveResearchKitConsoleQt;
+    friend class mtsConsoleSharedMemoryServer;
     friend class dvrk::console;
 
     class CISST_EXPORT Arm {
@@ -64,6 +72,7 @@ class CISST_EXPORT mtsIntuitiveResearchKitConsole: public mtsTaskFromSignal
 
         friend class mtsIntuitiveResearchKitConsole;
         friend class mtsIntuitiveResearchKitConsoleQt;
+        friend class mtsConsoleSharedMemoryServer;
         friend class dvrk::console;
 
         Arm(mtsIntuitiveResearchKitConsole * console,
@@ -84,6 +93,10 @@ class CISST_EXPORT mtsIntuitiveResearchKitConsole: public mtsTaskFromSignal
         /*! Check if mBaseFrame has a valid name and if it does
           set_base_frame on the arm. */
         void SetBaseFrameIfNeeded(mtsIntuitiveResearchKitArm * armPointer);
+        /*! Set signals without history and history depth if the
+          console file has a "state-table" for this arm.  Must be
+          called before the arm's Configure. */
+        void SetStateTableIfNeeded(mtsIntuitiveResearchKitArm * armPointer);
 
         /*! Connect all interfaces specific to this arm. */
         bool Connect(void);
@@ -117,10 +130,18 @@ class CISST_EXPORT mtsIntuitiveResearchKitConsole: public mtsTaskFromSignal
         std::string m_arm_interface_name;
         std::string m_arm_configuration_file;
         double m_arm_period;
+        double m_arm_idle_period;
+        bool m_arm_state_table_set;
+        size_t m_arm_state_table_history;
+        std::vector<std::string> m_arm_state_table_latest;
+        bool m_synchronized_with_IO; // runs after PID in IO thread, period 0
+        bool m_parallel; // runs in parallel-arms executor, after IO
+        bool m_effort_stage; // efforts evaluated in IO thread, see mtsArmEffortStage
         // socket
         std::string m_IP;
         int m_port;
         bool m_socket_server;
+        double m_socket_extrapolation;
         std::string m_socket_component_name;
         // generic arm
         bool m_generic;
@@ -156,6 +177,7 @@ class CISST_EXPORT mtsIntuitiveResearchKitConsole: public mtsTaskFromSignal
         }
 
         void CurrentStateEventHandler(const prmOperatingState & currentState);
+        void StateNameEventHandler(const std::string & state);
         prmOperatingState m_operating_state;
     };
 
@@ -175,9 +197,11 @@ class CISST_EXPORT mtsIntuitiveResearchKitConsole: public mtsTaskFromSignal
 
         /*! Accessors */
         const std::string & Name(void) const;
+        const std::string & ComponentName(void) const;
 
     protected:
         std::string m_name;
+        std::string m_component_name;
         TeleopECMType m_type;
         mtsFunctionWrite state_command;
         mtsInterfaceRequired * InterfaceRequired;
@@ -201,6 +225,7 @@ class CISST_EXPORT mtsIntuitiveResearchKitConsole: public mtsTaskFromSignal
 
         /*! Accessors */
         const std::string & Name(void) const;
+        const std::string & ComponentName(void) const;
 
         /*! Turn on/off selected */
         inline const bool & Selected(void) const {
@@ -213,6 +238,7 @@ class CISST_EXPORT mtsIntuitiveResearchKitConsole: public mtsTaskFromSignal
     protected:
         bool mSelected;
         std::string m_name;
+        std::string m_component_name;
         TeleopPSMType m_type;
         std::string mMTMName;
         std::string mPSMName;
@@ -222,7 +248,7 @@ class CISST_EXPORT mtsIntuitiveResearchKitConsole: public mtsTaskFromSignal
     };
 
     mtsIntuitiveResearchKitConsole(const std::string & componentName);
-    inline virtual ~mtsIntuitiveResearchKitConsole() {}
+    virtual ~mtsIntuitiveResearchKitConsole();
 
     /*! Tells the application to run in calibration mode, i.e. turn
       off all checks using potentiometers and force encoder re-bias
@@ -232,11 +258,32 @@ class CISST_EXPORT mtsIntuitiveResearchKitConsole: public mtsTaskFromSignal
     const bool & calibration_mode(void) const;
     void calibration_mode(bool & result) const;
 
+    /*! Prefix added to the names of all components created by the
+      console (IO, PIDs, arms, tele-operations...) so multiple
+      consoles can be created in the same process.  Interface names
+      and arm names used in the configuration files are not modified.
+      Components created outside the console (derived and generic
+      arms or tele-operations) keep their names.  This method must be
+      called before Configure. */
+    void set_component_prefix(const std::string & prefix);
+    const std::string & component_prefix(void) const;
+
+    /*! Use an existing executor for all the console components, see
+      mtsConsoleExecutor.  The executor can be shared between
+      consoles, it has to be added to the component manager by the
+      caller.  This method must be called before Configure. */
+    void set_executor(mtsConsoleExecutor * executor);
+
     /*! Configure console using JSON file. To test is the configuration
       succeeded, used method Configured().
     */
     void Configure(const std::string & filename);
 
+    /*! Configure console using JSON content already parsed, filename
+      is used to find other configuration files (relative paths). */
+    void Configure(const std::string & filename,
+                   const Json::Value & jsonConfig);
+
     /*! Method to check if the configuration was successful, ideally called
       after a call to Configure.
     */
@@ -250,6 +297,11 @@ class CISST_EXPORT mtsIntuitiveResearchKitConsole: public mtsTaskFromSignal
     bool AddArm(mtsComponent * genericArm, const Arm::ArmType armType);
     std::string GetArmIOComponentName(const std::string & armName);
 
+    /*! Component name for a name used in the configuration files
+      (e.g. "component" for "base-frame"), arms, tele-operations and
+      IO created by the console use the component prefix. */
+    std::string ConsoleComponentName(const std::string & name) const;
+
     void AddFootpedalInterfaces(void);
 
     bool Connect(void);
@@ -295,6 +347,15 @@ class CISST_EXPORT mtsIntuitiveResearchKitConsole: public mtsTaskFromSignal
     /*! daVinci Endoscope Focus */
     mtsDaVinciEndoscopeFocus * mDaVinciEndoscopeFocus;
 
+    /*! Optional inter-arm collision monitor for PSMs and ECM */
+    mtsCollisionMonitor * mCollisionMonitor;
+
+    /*! Optional fork-join execution of arms in IO thread */
+    mtsParallelArmExecutor * mParallelArmExecutor;
+
+    /*! Optional single threaded execution of all components */
+    mtsConsoleExecutor * mConsoleExecutor;
+
     /*! Find all arm data from JSON configuration. */
     bool ConfigureArmJSON(const Json::Value & jsonArm,
                           const std::string & ioComponentName,
@@ -309,9 +370,15 @@ class CISST_EXPORT mtsIntuitiveResearchKitConsole: public mtsTaskFromSignal
     bool ConfigureECMTeleopJSON(const Json::Value & jsonTeleop);
     bool ConfigurePSMTeleopJSON(const Json::Value & jsonTeleop);
 
+    bool ConfigureCollisionMonitorJSON(const Json::Value & jsonMonitor);
+    bool ConfigureParallelArmsJSON(const Json::Value & jsonParallel);
+    bool ConfigureExecutorJSON(const Json::Value & jsonExecutor,
+                               const double periodIO);
+
     void power_off(void);
     void power_on(void);
     void home(void);
+    void startup_report(std::string & report) const;
     void DisableFaultyArms(void);
     void teleop_enable(const bool & enable);
     void cycle_teleop_psm_by_mtm(const std::string & mtmName);
@@ -330,6 +397,8 @@ class CISST_EXPORT mtsIntuitiveResearchKitConsole: public mtsTaskFromSignal
     void OperatorPresentEventHandler(const prmEventButton & button);
 
     bool m_calibration_mode = false;
+    std::string m_component_prefix;
+    bool m_shared_executor = false;
 
     struct {
         mtsFunctionWrite beep;
@@ -370,6 +439,13 @@ class CISST_EXPORT mtsIntuitiveResearchKitConsole: public mtsTaskFromSignal
     std::map<std::string, prmOperatingState> ArmStates;
     void SetArmCurrentState(const std::string & armName,
                             const prmOperatingState & currentState);
+
+    /*! Staged power on and homing with timing report */
+    mtsConsoleStartup * m_startup;
+    void StartupBegin(const std::string & command);
+    void StartupSendCommand(const std::list<std::string> & arms);
+    void SetArmStateName(const std::string & armName,
+                         const std::string & state);
 };
 
 CMN_DECLARE_SERVICES_INSTANTIATION(mtsIntuitiveResearchKitConsole);
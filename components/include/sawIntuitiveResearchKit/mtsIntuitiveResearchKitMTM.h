@@ -85,6 +85,7 @@ protected:
     } mKinematicType = MTM_ITERATIVE;
 
     virtual void CreateManipulator(void) override;
+    virtual void ResizeKinematicsData(void) override;
     virtual void Init(void) override;
 
     bool IsHomed(void) const override;
@@ -105,6 +106,7 @@ protected:
     /*! Get data specific to the MTM (gripper angle using analog inputs) after
       calling mtsIntuitiveResearchKitArm::GetRobotData. */
     void GetRobotData(void) override;
+    void UpdateGUISnapshot(void) override;
 
     // see base class
     void control_servo_cf_orientation_locked(void) override;
@@ -116,6 +118,9 @@ protected:
     virtual void lock_orientation(const vctMatRot3 & orientation);
     virtual void unlock_orientation(void);
 
+    /*! Set gripper angle in simulation, e.g. to replay a recorded session */
+    void emulate_gripper_measured_js(const prmStateJoint & gripper);
+
     void control_add_gravity_compensation(vctDoubleVec & efforts) override;
 
     // Functions for events
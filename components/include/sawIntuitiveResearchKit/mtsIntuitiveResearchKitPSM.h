@@ -23,6 +23,8 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstParameterTypes/prmActuatorJointCoupling.h>
 #include <sawIntuitiveResearchKit/mtsIntuitiveResearchKitArm.h>
 #include <sawIntuitiveResearchKit/mtsToolList.h>
+#include <sawIntuitiveResearchKit/robPSMWorkspaceMap.h>
+#include <sawIntuitiveResearchKit/robPSMJointCompensation.h>
 
 // Always include last
 #include <sawIntuitiveResearchKit/sawIntuitiveResearchKitExport.h>
@@ -35,7 +37,9 @@ class CISST_EXPORT mtsIntuitiveResearchKitPSM: public mtsIntuitiveResearchKitArm
  public:
     mtsIntuitiveResearchKitPSM(const std::string & componentName, const double periodInSeconds);
     mtsIntuitiveResearchKitPSM(const mtsTaskPeriodicConstructorArg & arg);
-    inline ~mtsIntuitiveResearchKitPSM() override {};
+    inline ~mtsIntuitiveResearchKitPSM() override {
+        delete m_joint_compensation;
+    }
     void set_simulated(void) override;
 
  protected:
@@ -47,10 +51,19 @@ class CISST_EXPORT mtsIntuitiveResearchKitPSM: public mtsIntuitiveResearchKitArm
     void tool_name(const size_t & index, std::string & name) const;
     void tool_full_description(const size_t & index, std::string & description) const;
 
+    /*! Query the workspace map for a batch of goals, one row per goal
+      with translation followed by row major rotation (12 columns),
+      same frame as servo_cp.  Result is a robPSMWorkspaceMap::Status
+      per goal, or -1 for all goals if there is no map for the current
+      tool.  Queued command so the map, base frame and tool offset are
+      read in the arm's thread. */
+    void workspace_query(const vctDoubleMat & goals, vctIntVec & status);
+
     void PostConfigure(const Json::Value & jsonConfig,
                        const cmnPath & configPath,
                        const std::string & filename) override;
     virtual bool ConfigureTool(const std::string & filename);
+    void ConfigureWorkspaceMap(const std::string & toolFilename);
 
     /*! Configuration methods */
     inline size_t NumberOfJoints(void) const override {
@@ -67,11 +80,16 @@ class CISST_EXPORT mtsIntuitiveResearchKitPSM: public mtsIntuitiveResearchKitArm
 
     void UpdateStateJointKinematics(void) override;
     void ToJointsPID(const vctDoubleVec &jointsKinematics, vctDoubleVec &jointsPID) override;
+    void UpdateGUISnapshot(void) override;
 
 
     robManipulator::Errno InverseKinematics(vctDoubleVec & jointSet,
                                             const vctFrm4x4 & cartesianGoal) override;
 
+    /*! Reject trajectory goals outside the workspace map, if any,
+      before solving the inverse kinematics. */
+    void move_cp(const prmPositionCartesianSet & newPosition) override;
+
     bool IsSafeForCartesianControl(void) const override;
 
 
@@ -127,6 +145,18 @@ class CISST_EXPORT mtsIntuitiveResearchKitPSM: public mtsIntuitiveResearchKitArm
     void servo_jp_internal(const vctDoubleVec & newPosition) override;
     void servo_jf_internal(const vctDoubleVec & newEffort) override;
 
+    /*! Velocity feed forward.  servo_cp velocities (e.g. from
+      tele-operation) are converted to joint velocities using the
+      body jacobian and multiplied by the gains provided in the
+      configuration file ("velocity-feed-forward-gains"). */
+    //@{
+    void servo_cp(const prmPositionCartesianSet & newPosition) override;
+    bool use_feed_forward(void) const override;
+    void update_feed_forward(vctDoubleVec & feedForward) override;
+    void RunHomed(void) override;
+    void LeaveHomed(void) override;
+    //@}
+
     void control_move_jp_on_stop(const bool reached) override;
 
     void EnableJointsEventHandler(const vctBoolVec & enable);
@@ -193,10 +223,39 @@ class CISST_EXPORT mtsIntuitiveResearchKitPSM: public mtsIntuitiveResearchKitArm
     robManipulator * ToolOffset = nullptr;
     vctFrm4x4 ToolOffsetTransformation;
 
+    /*! Workspace map for the current tool, loaded from the file next
+      to the tool definition (.dvrk-ws) if any.  Used to reject
+      unreachable move_cp goals, servo goals are not checked. */
+    robPSMWorkspaceMap m_workspace_map;
+    /*! Optional compensation applied in place on measured joint
+      positions before forward kinematics, see "joint-compensation" */
+    robPSMJointCompensation * m_joint_compensation = nullptr;
+    void ApplyJointCompensation(void);
+    vctFrm4x4 m_tool_offset_inverse;
+    bool WorkspaceMapReachable(const vctFrm4x4 & cartesianGoal) const;
+
     prmStateJoint m_jaw_measured_js, m_jaw_setpoint_js;
     double m_jaw_servo_jp;
     double m_jaw_servo_jf;
 
+    struct {
+        size_t too_close_to_RCM;
+        size_t snake_constraint;
+    } m_PSM_message_codes;
+
+    struct {
+        bool configured = false;
+        vctDoubleVec gains;  // for the first 6 actuators, not the jaw
+        vct3 linear, angular; // from last servo_cp, world frame
+        bool new_goal = false; // servo_cp received since last servo_jp
+        bool used = false; // feed forward computed this cycle
+        bool active = false; // non zero feed forward sent to PID
+        vctDoubleVec twist;
+        vctDoubleVec joint_velocity, joint_velocity_pid;
+        vctDoubleMat jacobian;
+        nmrPInverseDynamicData pinverse_data;
+    } m_velocity_feed_forward;
+
     // Home Action
     unsigned int EngagingStage; // 0 requested
     unsigned int LastEngagingStage;
@@ -24,6 +24,7 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstParameterTypes/prmPositionCartesianGet.h>
 #include <cisstParameterTypes/prmOperatingState.h>
 #include <sawIntuitiveResearchKit/mtsStateMachine.h>
+#include <sawIntuitiveResearchKit/mtsMessageRing.h>
 #include <sawIntuitiveResearchKit/mtsIntuitiveResearchKitArmTypes.h>
 
 #include <sawIntuitiveResearchKit/sawIntuitiveResearchKitExport.h>
@@ -41,7 +42,7 @@ public:
 
     mtsIntuitiveResearchKitSUJ(const std::string & componentName, const double periodInSeconds);
     mtsIntuitiveResearchKitSUJ(const mtsTaskPeriodicConstructorArg & arg);
-    inline ~mtsIntuitiveResearchKitSUJ() {}
+    ~mtsIntuitiveResearchKitSUJ();
 
     void Configure(const std::string & filename);
     void Startup(void);
@@ -144,6 +145,11 @@ protected:
     vctBoolVec mMuxState;
     size_t mMuxIndex, mMuxIndexExpected;
 
+    // messages from control loop, see DispatchMessages
+    mtsMessageRing * m_messages;
+    size_t m_message_mux_unexpected;
+    void DispatchMessages(void);
+
     // Functions to control motor on SUJ3
     struct {
         mtsFunctionWrite DisablePWM;
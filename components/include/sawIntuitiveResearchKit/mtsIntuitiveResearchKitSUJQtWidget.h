@@ -48,6 +48,7 @@ protected:
     vctQtWidgetDynamicVectorDoubleWrite * QVPotentiometerRecalibrationFinishWidget;
 
     bool mShowMore;
+    size_t mShowMoreCounter; // voltages are refreshed at a lower rate
     QPushButton * QPBShowMore;
     QWidget * QWMore;
 
@@ -0,0 +1,218 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#ifndef _mtsMessageRing_h
+#define _mtsMessageRing_h
+
+#include <atomic>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include <cisstCommon/cmnGenericObject.h>
+#include <cisstCommon/cmnLogger.h>
+#include <cisstOSAbstraction/osaThread.h>
+#include <cisstOSAbstraction/osaThreadSignal.h>
+
+// always include last
+#include <sawIntuitiveResearchKit/sawIntuitiveResearchKitExport.h>
+
+class mtsInterfaceProvided;
+
+/*!
+  Real-time safe message reporting for control loops.
+
+  Message formats are registered during configuration and the
+  control thread only pushes fixed size records (code, two numeric
+  values and a short text) in a preallocated lock-free ring, no
+  allocation nor lock.  If the ring is full, the record is dropped
+  and counted.
+
+  A low priority thread formats the warning and status records,
+  logs them and rate limits them per code: a message repeated within
+  its minimum interval is suppressed and the number of suppressed
+  messages is added to the next one.  Formatted messages are then
+  queued back for the control thread which forwards them to its
+  interface(s) using Forward or Pop, this only happens at the rate
+  limited frequency.
+
+  Errors don't go through the formatting thread since they can
+  trigger safety actions (e.g. console disabling tele-operation).
+  Push only saves the first record and counts repeats, the message is
+  formatted and delivered by the next Pop or Forward, ahead of all
+  other messages.  Repeats within the minimum interval are coalesced
+  and the number of repeats is added to the message, or sent on its
+  own once the interval has elapsed.
+
+  Formats can use `{0}`, `{1}` and `{text}` for the values and text
+  provided with the record.  All messages are prefixed by the name
+  provided to the constructor.  Logs use the owner's class services.
+*/
+class CISST_EXPORT mtsMessageRing
+{
+public:
+    typedef enum {MESSAGE_STATUS, MESSAGE_WARNING, MESSAGE_ERROR} Level;
+
+    mtsMessageRing(const cmnGenericObject & owner,
+                   const std::string & name,
+                   const size_t size = 64);
+    ~mtsMessageRing();
+
+    /*! Register a message format, returns the code to use with
+      Push.  Must be called before Start. */
+    size_t Register(const Level level,
+                    const std::string & format,
+                    const double minimumInterval = 1.0);
+
+    /*! Real-time safe, can be called from the control thread.
+      Returns false if the record was dropped.  Errors are never
+      dropped, repeats are counted. */
+    bool Push(const size_t code,
+              const double value0 = 0.0,
+              const double value1 = 0.0,
+              const char * text = nullptr);
+
+    /*! Start and stop the formatting thread. */
+    //@{
+    void Start(void);
+    void Stop(void);
+    //@}
+
+    /*! Get next formatted message, to be called from the control
+      thread.  Returns false if there is no message. */
+    bool Pop(Level & level, std::string & message);
+
+    /*! Forward up to maxMessages formatted messages to the provided
+      interface using SendStatus, SendWarning or SendError. */
+    void Forward(mtsInterfaceProvided * interfaceProvided,
+                 const size_t maxMessages = 4);
+
+    /*! Number of records dropped because the ring was full. */
+    inline size_t NumberOfDropped(void) const {
+        return m_dropped;
+    }
+
+protected:
+    enum {TEXT_SIZE = 64};
+
+    struct Record {
+        size_t m_code;
+        double m_values[2];
+        char m_text[TEXT_SIZE];
+    };
+
+    struct Format {
+        Level m_level;
+        std::string m_format;
+        double m_minimum_interval;
+        // managed by formatting thread
+        double m_last_sent;
+        size_t m_suppressed;
+        // errors, managed by control thread
+        bool m_has_values;
+        std::string m_prefixed;
+        Record m_error_first;
+        size_t m_error_pending;
+        size_t m_error_repeats;
+        double m_error_last_sent;
+    };
+
+    struct Message {
+        Level m_level;
+        std::string m_message;
+    };
+
+    /*! Single producer, single consumer ring */
+    template <class _elementType>
+    class Ring {
+    public:
+        void SetSize(const size_t size) {
+            m_buffer.resize(size + 1);
+            m_head = 0;
+            m_tail = 0;
+        }
+        // producer side, returns pointer to write or 0 if full
+        _elementType * Next(void) {
+            const size_t head = m_head.load(std::memory_order_relaxed);
+            const size_t next = (head + 1) % m_buffer.size();
+            if (next == m_tail.load(std::memory_order_acquire)) {
+                return nullptr;
+            }
+            return &(m_buffer[head]);
+        }
+        void Commit(void) {
+            const size_t head = m_head.load(std::memory_order_relaxed);
+            m_head.store((head + 1) % m_buffer.size(), std::memory_order_release);
+        }
+        // consumer side, returns pointer to read or 0 if empty
+        _elementType * Front(void) {
+            const size_t tail = m_tail.load(std::memory_order_relaxed);
+            if (tail == m_head.load(std::memory_order_acquire)) {
+                return nullptr;
+            }
+            return &(m_buffer[tail]);
+        }
+        void Release(void) {
+            const size_t tail = m_tail.load(std::memory_order_relaxed);
+            m_tail.store((tail + 1) % m_buffer.size(), std::memory_order_release);
+        }
+    protected:
+        std::vector<_elementType> m_buffer;
+        std::atomic<size_t> m_head, m_tail;
+    };
+
+    void * ThreadRun(void * argument);
+    std::string FormatRecord(const Format & format,
+                             const double value0,
+                             const double value1,
+                             const char * text) const;
+    void PushError(Format & format,
+                   const double value0,
+                   const double value1,
+                   const char * text);
+    void DrainErrors(const double now);
+    void ProcessRecord(const Record & record, const double now);
+    void FlushSuppressed(const double now);
+    void Send(const Level level, const std::string & message);
+
+    // for logs
+    const cmnClassServicesBase * OwnerServices;
+
+    inline const cmnClassServicesBase * Services(void) const {
+        return this->OwnerServices;
+    }
+
+    inline cmnLogger::StreamBufType * GetLogMultiplexer(void) const {
+        return cmnLogger::GetMultiplexer();
+    }
+
+    std::string m_name;
+    std::vector<Format> m_formats;
+    Ring<Record> m_records;
+    Ring<Message> m_messages;
+    // errors, only used by control thread
+    bool m_errors_pending;
+    std::deque<Message> m_errors;
+    std::atomic<size_t> m_dropped;
+
+    osaThread m_thread;
+    osaThreadSignal m_signal;
+    std::atomic<bool> m_running;
+};
+
+#endif // _mtsMessageRing_h
@@ -0,0 +1,116 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#ifndef _mtsParallelArmExecutor_h
+#define _mtsParallelArmExecutor_h
+
+#include <cisstOSAbstraction/osaThread.h>
+#include <cisstOSAbstraction/osaThreadSignal.h>
+#include <cisstMultiTask/mtsTaskPeriodic.h>
+
+// always include last
+#include <sawIntuitiveResearchKit/sawIntuitiveResearchKitExport.h>
+
+/*!
+  Fork-join execution of arms sharing the same IO component.
+
+  This component is meant to be tied to the IO using the ExecIn/ExecOut
+  interfaces so it runs in the IO thread, after the IO read and the
+  PIDs and before the IO write.  Each arm's ExecIn interface is
+  connected to one of the ExecOut interfaces of this component
+  (see InterfaceName) so arms don't use their own thread anymore.
+  Every cycle, the arms are dispatched on a pool of worker threads
+  and the IO thread waits until all arms are done (barrier) so all
+  arms compute using the same IO read.
+
+  The duration of each arm's cycle and of the whole cycle are
+  available in the state table and a summary is logged when the
+  component is stopped.
+*/
+class CISST_EXPORT mtsParallelArmExecutor: public mtsTaskPeriodic
+{
+    CMN_DECLARE_SERVICES(CMN_DYNAMIC_CREATION_ONEARG, CMN_LOG_ALLOW_DEFAULT);
+
+public:
+    mtsParallelArmExecutor(const std::string & componentName, const double periodInSeconds);
+    mtsParallelArmExecutor(const mtsTaskPeriodicConstructorArg & arg);
+    ~mtsParallelArmExecutor();
+
+    void Configure(const std::string & CMN_UNUSED(filename) = "") {};
+    void Startup(void);
+    void Run(void);
+    void Cleanup(void);
+
+    /*! Add an arm, this creates a provided interface to be
+      connected to the arm's ExecIn interface.  Arms are executed
+      in the order they have been added.  Must be called before the
+      component is started. */
+    bool AddArm(const std::string & name);
+
+    /*! Name of provided interface for a given arm */
+    std::string InterfaceName(const std::string & armName) const;
+
+    /*! Set number of worker threads.  The IO thread is also used to
+      run some arms so the default is number of arms minus one, i.e.
+      one thread per arm.  Zero means all arms are executed
+      sequentially in the IO thread.  Must be called before the
+      component is started. */
+    void SetNumberOfThreads(const size_t numberOfThreads);
+
+protected:
+
+    void Init(void);
+
+    struct ArmData {
+        std::string m_name;
+        mtsFunctionVoid RunEvent;
+        // timing, m_duration is in state table
+        double m_duration;
+        double m_duration_max;
+        double m_duration_sum;
+    };
+
+    struct Worker {
+        osaThread m_thread;
+        osaThreadSignal m_start;
+        osaThreadSignal m_done;
+        std::vector<ArmData *> m_arms;
+    };
+
+    void * WorkerRun(Worker * worker);
+    void RunArms(const std::vector<ArmData *> & arms);
+
+    std::vector<ArmData *> m_arms;
+    std::vector<Worker *> m_workers;
+    std::vector<ArmData *> m_local_arms; // executed in IO thread
+    bool m_number_of_threads_set;
+    size_t m_number_of_threads;
+    bool m_workers_stop;
+
+    // timing for the whole cycle
+    double m_cycle_duration;
+    double m_cycle_duration_max;
+    double m_cycle_duration_sum;
+    size_t m_number_of_cycles;
+
+    mtsInterfaceProvided * m_interface;
+};
+
+CMN_DECLARE_SERVICES_INSTANTIATION(mtsParallelArmExecutor);
+
+#endif // _mtsParallelArmExecutor_h
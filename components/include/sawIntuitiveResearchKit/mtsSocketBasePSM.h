@@ -5,7 +5,7 @@
   Author(s):  Pretham Chalasani, Anton Deguet
   Created on: 2016-11-04
 
-  (C) Copyright 2016-2020 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2016-2021 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -20,16 +20,21 @@ http://www.cisst.org/cisst/license.txt.
 #define _mtsSocketBasePSM_h
 
 #include <cisstCommon/cmnUnits.h>
+#include <cisstVector/vctTransformationTypes.h>
 #include <cisstOSAbstraction/osaSocket.h>
 #include <cisstMultiTask/mtsTaskPeriodic.h>
 #include <sawIntuitiveResearchKit/socketMessages.h>
 
+// always include last
+#include <sawIntuitiveResearchKit/sawIntuitiveResearchKitExport.h>
+
 #define VERSION 10000
 #define BUFFER_SIZE 1024
 #define CLIENT_MSG_SIZE 140
 #define SERVER_MSG_SIZE 140
 
-#define TIMEOUT 4.0 * cmn_ms
+// default duration a late packet can be extrapolated for
+#define EXTRAPOLATION_HORIZON 20.0 * cmn_ms
 
 class mtsSocketBasePSM : public mtsTaskPeriodic
 {
@@ -44,7 +49,50 @@ public:
     void Cleanup(void);
     void UpdateStatistics(void);
 
+    /*! Maximum time since last packet received for which the values
+      are extrapolated.  After this, last values received are used.
+      Set to 0 to disable extrapolation. */
+    void SetExtrapolationHorizon(const double horizon);
+
+    /*! Linear extrapolation of pose and jaw based on the last two
+      packets received.  Velocities are computed using the remote
+      timestamps and extrapolated from the local time the last packet
+      was received, for at most MaxRatio sender periods so a short
+      interval between the last two packets can't produce a large
+      jump. */
+    class CISST_EXPORT Extrapolator {
+    public:
+        /*! Maximum extrapolation, in number of sender periods (time
+          between the last two packets) */
+        static constexpr double MaxRatio = 2.0;
+
+        void Reset(void);
+        void Add(const vctFrm3 & pose, const double jaw,
+                 const double remoteTime, const double localTime);
+        /*! Returns false if there are not enough packets or the last
+          packet is older than the horizon. */
+        bool Predict(const double localTime, const double horizon,
+                     vctFrm3 & pose, double & jaw) const;
+    protected:
+        size_t m_count = 0;
+        vctFrm3 m_pose[2];
+        double m_jaw[2];
+        double m_remote_time[2];
+        double m_local_time = 0.0;
+    };
+
 protected:
+    /*! Receive without blocking.  All pending datagrams are read and
+      only the latest one is kept in buffer.  Returns the number of
+      bytes of the latest datagram, 0 if nothing was received. */
+    int ReceiveLatest(osaSocket * socket, char * buffer);
+
+    /*! To be called when no packet was received this cycle.  Returns
+      true and the extrapolated values if within the horizon, updates
+      flag and counter. */
+    bool Extrapolate(vctFrm3 & pose, double & jaw);
+
+
     // UDP details
     struct {
         socketCommandPSM Data;
@@ -65,9 +113,15 @@ protected:
     const osaTimeServer & mTimeServer;
     socketMessages::StateType CurrentState, DesiredState;
 
+    Extrapolator mExtrapolator;
+    double mExtrapolationHorizon;
+    bool mExtrapolating;
+
 private:
     unsigned int mPacketsLost;
     unsigned int mPacketsDelayed;
+    unsigned int mPacketsExtrapolated;
+    char mReceiveBuffer[BUFFER_SIZE];
     double mLoopTime;
 };
 
@@ -38,6 +38,7 @@ public :
 
 protected:
     void ExecutePSMCommands(void);
+    void ServoPSM(const vctFrm3 & pose, const double jaw);
     void UpdatePSMState(void);
     void ReceivePSMCommandData(void);
     void SendPSMStateData(void);
@@ -28,6 +28,7 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstParameterTypes/prmPositionJointSet.h>
 
 #include <sawIntuitiveResearchKit/mtsStateMachine.h>
+#include <sawIntuitiveResearchKit/mtsDeadlineMonitor.h>
 
 // always include last
 #include <sawIntuitiveResearchKit/sawIntuitiveResearchKitExport.h>
@@ -138,6 +139,10 @@ protected:
 
     bool m_following;
     void set_following(const bool following);
+
+    // cycle duration check, see mtsDeadlineMonitor
+    mtsDeadlineMonitor m_deadline;
+    void DeadlineLevelChanged(void);
 };
 
 CMN_DECLARE_SERVICES_INSTANTIATION(mtsTeleOperationECM);
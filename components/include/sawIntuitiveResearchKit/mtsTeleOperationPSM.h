@@ -23,12 +23,15 @@
 #include <cisstParameterTypes/prmEventButton.h>
 #include <cisstParameterTypes/prmPositionCartesianGet.h>
 #include <cisstParameterTypes/prmPositionCartesianSet.h>
+#include <cisstParameterTypes/prmVelocityCartesianGet.h>
 #include <cisstParameterTypes/prmStateJoint.h>
 #include <cisstParameterTypes/prmConfigurationJoint.h>
 #include <cisstParameterTypes/prmPositionJointSet.h>
 
 #include <sawIntuitiveResearchKit/mtsIntuitiveResearchKit.h>
 #include <sawIntuitiveResearchKit/mtsStateMachine.h>
+#include <sawIntuitiveResearchKit/mtsDeadlineMonitor.h>
+#include <sawIntuitiveResearchKit/mtsDataRecorder.h>
 
 // always include last
 #include <sawIntuitiveResearchKit/sawIntuitiveResearchKitExport.h>
@@ -61,6 +64,8 @@ class CISST_EXPORT mtsTeleOperationPSM: public mtsTaskPeriodic
     // Event Handler
     void MTMErrorEventHandler(const mtsMessage & message);
     void PSMErrorEventHandler(const mtsMessage & message);
+    /*! PSM frozen by its deadline monitor, re-align on recovery */
+    void PSMFrozenEventHandler(const bool & frozen);
 
     void ClutchEventHandler(const prmEventButton & button);
     void Clutch(const bool & clutch);
@@ -100,6 +105,7 @@ class CISST_EXPORT mtsTeleOperationPSM: public mtsTaskPeriodic
 
     struct {
         mtsFunctionRead  measured_cp;
+        mtsFunctionRead  measured_cv;
         mtsFunctionRead  setpoint_cp;
         mtsFunctionWrite move_cp;
         mtsFunctionRead  gripper_measured_js;
@@ -113,6 +119,7 @@ class CISST_EXPORT mtsTeleOperationPSM: public mtsTaskPeriodic
 
         prmStateJoint m_gripper_measured_js;
         prmPositionCartesianGet m_measured_cp;
+        prmVelocityCartesianGet m_measured_cv;
         prmPositionCartesianGet m_setpoint_cp;
         prmPositionCartesianSet m_move_cp;
         vctFrm4x4 CartesianInitial;
@@ -189,6 +196,7 @@ class CISST_EXPORT mtsTeleOperationPSM: public mtsTaskPeriodic
     } m_operator;
 
     bool m_clutched = false;
+    bool m_PSM_frozen = false;
     bool m_back_from_clutch = false;
     bool m_jaw_caught_up_after_clutch = false;
     bool m_rotation_locked = false;
@@ -204,6 +212,23 @@ class CISST_EXPORT mtsTeleOperationPSM: public mtsTaskPeriodic
 
     bool m_following;
     void set_following(const bool following);
+
+    // reduced rate when disabled and not requested to do anything
+    bool IsIdle(void);
+    double m_idle_period = mtsIntuitiveResearchKit::TeleOperationPSM::IdlePeriod;
+    size_t m_idle_skip = 0;
+    size_t m_idle_counter = 0;
+
+    // cycle duration check, see mtsDeadlineMonitor
+    mtsDeadlineMonitor m_deadline;
+    void DeadlineLevelChanged(void);
+
+    // optional high rate recording, see mtsDataRecorder
+    mtsDataRecorder * m_recorder;
+    bool m_recorder_mtm_measured_cp, m_recorder_mtm_measured_cv, m_recorder_mtm_gripper,
+        m_recorder_psm_setpoint_cp, m_recorder_psm_servo_cp, m_recorder_psm_jaw_servo_jp,
+        m_recorder_clutch, m_recorder_enabled, m_recorder_following, m_recorder_cycle_duration;
+    void Record(const double duration);
 };
 
 CMN_DECLARE_SERVICES_INSTANTIATION(mtsTeleOperationPSM);
@@ -0,0 +1,198 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#ifndef _mtsTeleOperationReplay_h
+#define _mtsTeleOperationReplay_h
+
+#include <map>
+
+#include <cisstMultiTask/mtsTaskPeriodic.h>
+#include <cisstParameterTypes/prmOperatingState.h>
+#include <cisstParameterTypes/prmPositionCartesianGet.h>
+#include <cisstParameterTypes/prmPositionCartesianSet.h>
+#include <cisstParameterTypes/prmPositionJointSet.h>
+#include <cisstParameterTypes/prmStateJoint.h>
+
+// always include last
+#include <sawIntuitiveResearchKit/sawIntuitiveResearchKitExport.h>
+
+namespace Json {
+    class Value;
+}
+
+/*!
+  Replay a session recorded with mtsDataRecorder through simulated
+  arms (SIMULATION_KINEMATIC) and a PSM tele-operation component.
+
+  Inputs are read from the MTM recording (measured_js) and the PSM
+  tele-operation recording (MTM/gripper, clutch and enabled).  MTM
+  joint positions are sent with servo_jp, gripper values with
+  emulate_gripper_measured_js and buttons through the console's
+  emulate_clutch and emulate_operator_present commands.  The replay
+  time advances by speed times the period on each cycle so the
+  sequence of inputs doesn't depend on the wall clock.  Only the input
+  timeline is deterministic: the arms and tele-operation still run on
+  the wall clock so pass/fail is only evaluated at speed 1.  Other
+  speeds report statistics but never pass.
+
+  Outputs (PSM setpoint_cp and jaw/setpoint_js, tele-operation
+  following state) are compared to the recorded PSM/servo_cp,
+  PSM/jaw_servo_jp and following using tolerances.  The replay passes
+  if at least one sample was compared, all recorded following
+  transitions were reproduced within the transition tolerance and no
+  sample is over tolerance.  The report also
+  includes the tele-operation cycle duration statistics (see
+  mtsDeadlineMonitor) and delays between recorded and replayed
+  following transitions.
+*/
+class CISST_EXPORT mtsTeleOperationReplay: public mtsTaskPeriodic
+{
+    CMN_DECLARE_SERVICES(CMN_DYNAMIC_CREATION_ONEARG, CMN_LOG_ALLOW_DEFAULT);
+
+ public:
+    mtsTeleOperationReplay(const std::string & componentName, const double periodInSeconds);
+    mtsTeleOperationReplay(const mtsTaskPeriodicConstructorArg & arg);
+    ~mtsTeleOperationReplay() {}
+
+    void Configure(const std::string & filename = "") override;
+    void Configure(const Json::Value & jsonConfig);
+    void Startup(void) override;
+    void Run(void) override;
+    void Cleanup(void) override {};
+
+ protected:
+    typedef enum {IDLE, HOMING, POSITIONING, RUNNING, FINISHED} StateType;
+
+    /*! File created by mtsDataRecorder, loaded in memory */
+    class Recording {
+    public:
+        bool Load(const std::string & filename, std::string & errorMessage);
+        /*! First column of signal, false if the signal is missing */
+        bool Column(const std::string & name, size_t & column, size_t & size) const;
+        inline size_t NumberOfRecords(void) const {
+            return m_number_of_records;
+        }
+        inline const double * Record(const size_t index) const {
+            return &(m_data[index * m_number_of_columns]);
+        }
+        inline double Time(const size_t index) const {
+            return m_data[index * m_number_of_columns];
+        }
+        /*! Advance index to last record with time before or at time */
+        void Advance(size_t & index, const double time) const;
+    protected:
+        std::vector<double> m_data;
+        size_t m_number_of_columns = 0;
+        size_t m_number_of_records = 0;
+        std::map<std::string, std::pair<size_t, size_t> > m_signals;
+    };
+
+    void Init(void);
+    void start(void);
+    void stop(void);
+
+    void RunHoming(void);
+    void RunPositioning(void);
+    void RunReplay(void);
+    void Compare(void);
+    void Report(void);
+
+    void FollowingEventHandler(const bool & following);
+
+    std::string m_mtm_recording_file, m_teleop_recording_file;
+    Recording m_mtm_recording, m_teleop_recording;
+    size_t m_mtm_index, m_teleop_index;
+    double m_speed;
+    bool m_auto_start;
+    std::string m_report_file;
+
+    // columns
+    size_t m_mtm_measured_js, m_mtm_joints;
+    size_t m_gripper, m_clutch, m_enabled, m_servo_cp, m_jaw_servo_jp, m_following;
+
+    struct {
+        double translation;
+        double orientation;
+        double jaw;
+        double transition;
+    } m_tolerance;
+
+    StateType m_state;
+    double m_replay_time, m_start_time, m_end_time;
+    double m_wall_start;
+    double m_state_timer;
+    bool m_clutch_pressed, m_operator_present;
+
+    // replayed following state and transition times
+    bool m_replay_following;
+    std::vector<double> m_recorded_transitions, m_replayed_transitions;
+
+    // statistics
+    struct {
+        size_t samples;
+        size_t translation_failures, orientation_failures, jaw_failures;
+        size_t following_mismatches;
+        double translation_max, translation_sum;
+        double orientation_max, orientation_sum;
+        double jaw_max, jaw_sum;
+        size_t cycles;
+        double cycle_sum, cycle_sum_square, cycle_max;
+    } m_statistics;
+
+    struct {
+        mtsFunctionRead  operating_state;
+        mtsFunctionWrite servo_jp;
+        mtsFunctionWrite move_jp;
+        mtsFunctionWrite emulate_gripper_measured_js;
+        prmOperatingState m_operating_state;
+        prmPositionJointSet m_servo_jp;
+        prmStateJoint m_gripper;
+    } mMTM;
+
+    struct {
+        mtsFunctionRead  operating_state;
+        mtsFunctionRead  setpoint_cp;
+        mtsFunctionRead  jaw_setpoint_js;
+        mtsFunctionWrite move_cp;
+        prmOperatingState m_operating_state;
+        prmPositionCartesianGet m_setpoint_cp;
+        prmStateJoint m_jaw_setpoint_js;
+        prmPositionCartesianSet m_move_cp;
+    } mPSM;
+
+    struct {
+        mtsFunctionRead deadline_duration;
+    } mTeleop;
+
+    struct {
+        mtsFunctionVoid  home;
+        mtsFunctionWrite teleop_enable;
+        mtsFunctionWrite emulate_clutch;
+        mtsFunctionWrite emulate_operator_present;
+    } mConsole;
+
+    struct {
+        mtsFunctionWrite finished;
+    } mEvents;
+
+    mtsInterfaceProvided * mInterface;
+};
+
+CMN_DECLARE_SERVICES_INSTANTIATION(mtsTeleOperationReplay);
+
+#endif // _mtsTeleOperationReplay_h
@@ -0,0 +1,148 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#ifndef _robBatchKinematics_h
+#define _robBatchKinematics_h
+
+#include <string>
+#include <vector>
+
+#include <cisstVector/vctDynamicVectorTypes.h>
+
+// Always include last
+#include <sawIntuitiveResearchKit/sawIntuitiveResearchKitExport.h>
+
+namespace Json {
+    class Value;
+}
+
+class robManipulator;
+class robGravityCompensationMTM;
+
+/*!
+  Forward kinematics, inverse kinematics and MTM gravity compensation
+  for large sets of samples, e.g. to post-process recorded data.
+  Inputs and outputs are contiguous arrays of doubles, one row per
+  sample:
+  - joint positions, velocities and efforts: samples x joints
+  - cartesian positions: samples x 4 x 4, homogeneous transformations,
+    row major (same layout as a NumPy array of shape (samples, 4, 4))
+
+  Samples are split in contiguous blocks, one per thread.  Since the
+  manipulator and gravity compensation classes use internal buffers,
+  each thread has its own instances created from the same
+  configuration.
+
+  Supported manipulator types are "MTM" (robManipulatorMTM), "ECM"
+  (robManipulatorECM, mounted at 45 degrees as in
+  mtsIntuitiveResearchKitECM) and "generic" (robManipulator).  The
+  gravity compensation is only available for the MTMs.
+
+  See dvrk_batch_kinematics.h for the C interface.
+*/
+class CISST_EXPORT robBatchKinematics
+{
+public:
+    robBatchKinematics(void);
+    ~robBatchKinematics();
+
+    /*! Configure from manipulator type, kinematic file content (i.e.
+      "DH" and optional "base-offset") and optional gravity
+      compensation file content (use a null Json::Value if not
+      needed).  Returns false and sets the error message if the
+      configuration is invalid. */
+    bool Configure(const std::string & type,
+                   const Json::Value & jsonKinematic,
+                   const Json::Value & jsonGravity,
+                   std::string & errorMessage);
+
+    inline size_t NumberOfJoints(void) const {
+        return m_number_of_joints;
+    }
+
+    inline bool HasGravityCompensation(void) const {
+        return (m_json_gravity != nullptr);
+    }
+
+    /*! Number of threads used for the next computations, 0 means one
+      per core (default). */
+    void SetNumberOfThreads(const size_t numberOfThreads);
+
+    /*! Forward kinematics, frames is samples x 4 x 4 */
+    void ForwardKinematics(const double * positions,
+                           const size_t samples,
+                           double * frames);
+
+    /*! Inverse kinematics, positions are used as initial guess and
+      replaced by the solutions.  Status per sample is the value of
+      robManipulator::Errno, status can be null.  Returns the number
+      of samples for which the inverse kinematics failed. */
+    size_t InverseKinematics(const double * frames,
+                             const size_t samples,
+                             double * positions,
+                             int * status);
+
+    /*! Gravity compensation and friction efforts for the MTM.
+      Velocities can be null, in which case they are set to zero.
+      Returns false if there is no gravity compensation
+      configured. */
+    bool GravityCompensation(const double * positions,
+                             const double * velocities,
+                             const size_t samples,
+                             double * efforts);
+
+protected:
+    typedef enum {FORWARD_KINEMATICS, INVERSE_KINEMATICS, GRAVITY_COMPENSATION} Kernel;
+
+    struct Job {
+        Kernel Type;
+        const double * Input;
+        const double * Velocities;
+        double * Output;
+        int * Status;
+    };
+
+    struct Worker {
+        robManipulator * Manipulator = nullptr;
+        robGravityCompensationMTM * GravityCompensation = nullptr;
+        vctDoubleVec Positions;
+        vctDoubleVec Velocities;
+        vctDoubleVec Efforts;
+        // block of samples for current job
+        const Job * CurrentJob = nullptr;
+        size_t Begin = 0;
+        size_t End = 0;
+        size_t Failures = 0;
+    };
+
+    robManipulator * CreateManipulator(std::string & errorMessage) const;
+    bool CreateWorkers(const size_t numberOfWorkers, std::string & errorMessage);
+    void DeleteWorkers(void);
+    size_t Run(const Job & job, const size_t samples);
+    void * WorkerRun(Worker * worker);
+
+    typedef enum {GENERIC, MTM, ECM} ManipulatorType;
+    ManipulatorType m_type;
+    Json::Value * m_json_kinematic;
+    Json::Value * m_json_gravity;
+    size_t m_number_of_joints;
+    size_t m_number_of_threads;
+    std::vector<Worker *> m_workers;
+};
+
+#endif // _robBatchKinematics_h
@@ -0,0 +1,101 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+  --- begin cisst license - do not edit ---
+
+  This software is provided "as is" under an open source license, with
+  no warranty.  The complete license can be found in license.txt and
+  http://www.cisst.org/cisst/license.txt.
+
+  --- end cisst license ---
+*/
+
+#ifndef _robForwardKinematicsCache_h
+#define _robForwardKinematicsCache_h
+
+#include <vector>
+
+#include <cisstVector/vctDynamicVectorTypes.h>
+#include <cisstVector/vctDynamicMatrixTypes.h>
+#include <cisstVector/vctTransformationTypes.h>
+#include <cisstRobot/robManipulator.h>
+
+// Always include last
+#include <sawIntuitiveResearchKit/sawIntuitiveResearchKitExport.h>
+
+/*!
+  Cache of the link prefix products \f$ {}^0T_i = T_1 \dots T_i \f$
+  for a given robManipulator, keyed on the joint values.
+
+  Within a control cycle the same joint vector is used for the full
+  forward kinematics, both jacobians, partial chains (e.g. up to
+  link 4 to check the distance to the RCM) and by some closed form
+  inverse kinematics.  Each link transformation is computed once per
+  joint value and when only the last joints change, the prefixes for
+  the first joints are reused.
+
+  The cache doesn't track changes made to the manipulator itself
+  (tool attached or removed, DH parameters reloaded), use Reset() in
+  these cases.  A different manipulator instance or number of links
+  is detected and resets the cache automatically.  Rtw0 is applied
+  on each query so it doesn't need to be tracked.
+*/
+class CISST_EXPORT robForwardKinematicsCache
+{
+public:
+    robForwardKinematicsCache(void);
+    ~robForwardKinematicsCache() {}
+
+    /*! Invalidate all cached transformations, including the tool
+      offset. */
+    void Reset(void);
+
+    /*! Same as robManipulator::ForwardKinematics.  When N is
+      negative or the number of links, returns the full chain
+      including the tool attached to the manipulator, otherwise
+      returns Rtw0 and the first N links. */
+    vctFrm4x4 ForwardKinematics(const robManipulator & manipulator,
+                                const vctDoubleVec & q,
+                                const int N = -1);
+
+    /*! Same as robManipulator::JacobianBody and JacobianSpatial,
+      computed from the cached frames.  The jacobian J must be 6 by
+      number of links. */
+    //@{
+    void JacobianBody(const robManipulator & manipulator,
+                      const vctDoubleVec & q,
+                      vctDoubleMat & J);
+    void JacobianSpatial(const robManipulator & manipulator,
+                         const vctDoubleVec & q,
+                         vctDoubleMat & J);
+    //@}
+
+protected:
+    /*! Make sure the first N prefixes are computed for q.  Returns
+      false if q doesn't have enough elements. */
+    bool Update(const robManipulator & manipulator,
+                const vctDoubleVec & q,
+                const size_t N);
+
+    /*! Update all prefixes and the tool offset. */
+    bool UpdateFull(const robManipulator & manipulator,
+                    const vctDoubleVec & q);
+
+    const robManipulator * m_manipulator;
+    vctDoubleVec m_q;
+    //! Number of links covered by valid prefixes, m_prefixes[0] is always identity
+    size_t m_valid;
+    std::vector<vctFrm4x4> m_prefixes;
+
+    //! Tool offset, i.e. transformation between last link and tool tip
+    bool m_tool_valid;
+    vctFrm4x4 m_tool;
+};
+
+#endif // _robForwardKinematicsCache_h
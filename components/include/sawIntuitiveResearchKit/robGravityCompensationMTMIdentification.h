@@ -0,0 +1,139 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#ifndef _robGravityCompensationMTMIdentification_h
+#define _robGravityCompensationMTMIdentification_h
+
+#include <string>
+
+#include <cisstVector/vctDynamicVectorTypes.h>
+#include <cisstVector/vctDynamicMatrixTypes.h>
+
+// Always include last
+#include <sawIntuitiveResearchKit/sawIntuitiveResearchKitExport.h>
+
+namespace Json {
+    class Value;
+}
+
+/*!
+  Least squares identification of the MTM gravity compensation
+  parameters used by robGravityCompensationMTM (version 2).
+
+  For each joint, the measured effort is modeled as:
+
+  \f$ \tau = \alpha(\dot{q}) Y(q) p_{pos} + (1 - \alpha(\dot{q})) Y(q) p_{neg} \f$
+
+  where Y is robGravityCompensationMTM::AssignRegressor and alpha is
+  based on the joint velocity, the dead band and saturation
+  velocities and the friction compensation ratios.  The first 10
+  parameters (gravity) are shared by Pos and Neg, the remaining 30
+  (polynomial per joint, friction and springs) are identified
+  separately for each direction of motion.  The data should contain
+  slow motions in both directions for each joint.
+
+  Samples are accumulated in the normal equations (70 x 70 per
+  joint) so the memory used doesn't depend on the number of samples.
+  The regressor is sparse so adding a sample is fast.  Solve can be
+  called at any time, more samples can be added after.
+*/
+class CISST_EXPORT robGravityCompensationMTMIdentification
+{
+public:
+    enum {
+        NumberOfJoints = 7,
+        NumberOfModeledJoints = 6, // last joint is not modeled
+        NumberOfDynamicParameters = 40,
+        NumberOfSharedParameters = 10,
+        NumberOfUnknowns = 70
+    };
+
+    robGravityCompensationMTMIdentification(void);
+
+    /*! Use dead band, saturation velocities and friction compensation
+      ratios from an existing gravity compensation file (i.e.
+      "GC_controller": "db_vel_vec", "sat_vec_vec" and
+      "fric_comp_ratio_vec").  Defaults are the values used for the
+      JHU MTMs.  The friction compensation ratios are not used for the
+      identification, they are only saved in the resulting file. */
+    bool ConfigureJSON(const Json::Value & jsonConfig,
+                       std::string & errorMessage);
+
+    /*! Ridge regularization, relative to the scaled normal equations.
+      Default is 1e-6. */
+    inline void SetRegularization(const double regularization) {
+        m_regularization = regularization;
+    }
+
+    /*! Add one sample, vectors must have 7 elements */
+    void Add(const vctDoubleVec & position,
+             const vctDoubleVec & velocity,
+             const vctDoubleVec & effort);
+
+    inline size_t NumberOfSamples(void) const {
+        return m_number_of_samples;
+    }
+
+    /*! Solve using all samples added so far */
+    bool Solve(std::string & errorMessage);
+
+    /*! Identified parameters, valid after Solve */
+    //@{
+    inline const vctDoubleVec & Pos(void) const {
+        return m_pos;
+    }
+    inline const vctDoubleVec & Neg(void) const {
+        return m_neg;
+    }
+    //@}
+
+    /*! Root mean square of the residual efforts per joint, computed
+      from the normal equations, valid after Solve */
+    inline const vctDoubleVec & ResidualRMS(void) const {
+        return m_residual_rms;
+    }
+
+    /*! Parameters in the gravity compensation file format (version
+      2), efforts limits are based on the range of measured efforts.
+      Doesn't overwrite other fields of jsonConfig. */
+    void ToJSON(Json::Value & jsonConfig) const;
+
+protected:
+    vctDoubleVec m_db_vel;
+    vctDoubleVec m_sat_vel;
+    vctDoubleVec m_fric_comp_ratio;
+    double m_regularization;
+
+    // per sample buffers
+    vctDoubleMat m_regressor;
+    double m_row[NumberOfUnknowns];
+    size_t m_row_indices[NumberOfUnknowns];
+
+    // normal equations per joint
+    size_t m_number_of_samples;
+    vctDoubleMat m_normal[NumberOfModeledJoints];
+    vctDoubleVec m_right_hand_side[NumberOfModeledJoints];
+    double m_effort_square[NumberOfModeledJoints];
+    vctDoubleVec m_effort_min, m_effort_max;
+
+    // results
+    vctDoubleVec m_pos, m_neg;
+    vctDoubleVec m_residual_rms;
+};
+
+#endif // _robGravityCompensationMTMIdentification_h
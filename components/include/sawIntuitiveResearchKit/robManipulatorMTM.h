@@ -22,6 +22,8 @@
 #include <cisstRobot/robManipulator.h>
 #include <cisstNumerical/nmrLSEISolver.h>
 
+#include <sawIntuitiveResearchKit/robForwardKinematicsCache.h>
+
 #include <sawIntuitiveResearchKit/sawIntuitiveResearchKitExport.h>
 
 class robManipulatorMTM: public robManipulator
@@ -38,6 +40,12 @@ public:
 
     ~robManipulatorMTM() {}
 
+    /*! Reset the partial chains cached for the inverse kinematics,
+      must be called after LoadRobot */
+    inline void ResetKinematicsCache(void) {
+        m_ik_kinematics.Reset();
+    }
+
     robManipulator::Errno
     InverseKinematics(vctDynamicVector<double> & q,
                       const vctFrame4x4<double> & Rts,
@@ -49,6 +57,11 @@ public:
                                     const vctFrame4x4<double> & Rt07) const;
 
     double ComputeGimbalIK(vctDynamicVector<double> & q, const vctFrame4x4<double> & Rt07) const;
+
+protected:
+    // partial chains used by IK, platform angle and gimbal share
+    // the first joints
+    mutable robForwardKinematicsCache m_ik_kinematics;
 };
 
 #endif // _robManipulatorMTM_h
@@ -0,0 +1,79 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#ifndef _robPSMJointCompensation_h
+#define _robPSMJointCompensation_h
+
+#include <string>
+
+#include <cisstVector/vctDynamicVectorTypes.h>
+
+// Always include last
+#include <sawIntuitiveResearchKit/sawIntuitiveResearchKitExport.h>
+
+namespace Json {
+    class Value;
+}
+
+/*!
+  Correction of the measured positions of the first two PSM joints
+  (outer yaw and pitch) for compliance and backlash.  For each joint,
+  the correction is proportional to the measured effort minus a
+  torque offset, the gain being the backlash plus a compliance which
+  is a cubic polynomial of the insertion:
+
+  \f$ q_i \leftarrow q_i - (b_i + c_i(q_3)) (\tau_i - \tau_{0,i}) \f$
+
+  The torque offset is constant for the first joint and linear in the
+  insertion for the second joint.  The parameters are identified per
+  arm, see share/jhu-daVinci/compensation-PSM3-28613.json for the
+  file format.
+
+  Apply is meant to be called in the arm's control loop, in place on
+  the measured joint positions before forward kinematics, so it
+  doesn't allocate memory.
+*/
+class CISST_EXPORT robPSMJointCompensation
+{
+public:
+    robPSMJointCompensation(void);
+    ~robPSMJointCompensation() {}
+
+    /*! Load from JSON, array "parameters" with "parameter" names
+      compliance_first, torque_offset_first, backlash_first,
+      compliance_second, torque_offset_second and backlash_second.
+      Polynomial coefficients are "value-a" (highest degree) to
+      "value-d".  Missing parameters are set to zero. */
+    bool ConfigureJSON(const Json::Value & jsonConfig,
+                       std::string & errorMessage);
+
+    /*! Correct positions in place, requires at least 3 joints */
+    void Apply(vctDoubleVec & position,
+               const vctDoubleVec & effort) const;
+
+protected:
+    struct Joint {
+        double Compliance[4]; // cubic, highest degree first
+        double TorqueOffset[2]; // linear, highest degree first
+        double Backlash;
+    };
+
+    Joint m_joints[2];
+};
+
+#endif // _robPSMJointCompensation_h
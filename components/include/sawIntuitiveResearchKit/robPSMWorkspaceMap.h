@@ -0,0 +1,138 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#ifndef _robPSMWorkspaceMap_h
+#define _robPSMWorkspaceMap_h
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <cisstVector/vctFixedSizeVectorTypes.h>
+#include <cisstRobot/robManipulator.h>
+
+// Always include last
+#include <sawIntuitiveResearchKit/sawIntuitiveResearchKitExport.h>
+
+/*!
+  Precomputed reachability and RCM safety map for a PSM with a given
+  tool.  The map is a voxel grid in the RCM frame (i.e. manipulator
+  frame, RCM at origin) over the position of the last link's frame,
+  i.e. the tool tip without the tool tip offset.  Each voxel
+  indicates if the position can be reached within the joint limits
+  and if it can be reached with the end of the shaft at least at the
+  safe distance from the RCM.
+
+  The map is built offline by sampling the joint space (see
+  sawIntuitiveResearchKitPSMWorkspaceMap) and both flags are dilated
+  by one voxel so the map can be used as a conservative filter:
+  positions marked as unreachable are unreachable, positions marked
+  as reachable still require the inverse kinematics.  Queries are
+  constant time.
+
+  The map doesn't depend on the tool's orientation.  The last joint
+  doesn't change the position of the last link's frame (modified DH)
+  so it's not sampled.
+*/
+class CISST_EXPORT robPSMWorkspaceMap
+{
+public:
+    enum Status {
+        UNREACHABLE = 0,
+        REACHABLE_UNSAFE = 1, // only reachable with shaft end too close to RCM
+        REACHABLE = 3         // reachable and safe
+    };
+
+    robPSMWorkspaceMap(void);
+    ~robPSMWorkspaceMap() {}
+
+    /*! Build the map by sampling the joint space.  The manipulator
+      must have the RCM at origin (PSM).  The sampling steps are
+      computed so two consecutive samples are less than half a voxel
+      apart.  Progress is reported on the optional stream. */
+    bool Build(const robManipulator & manipulator,
+               const double voxelSize,
+               const double safeDistanceFromRCM,
+               std::string & errorMessage,
+               std::ostream * progress = nullptr);
+
+    /*! Binary file, little endian, see implementation for format */
+    bool Save(const std::string & filename, std::string & errorMessage) const;
+    bool Load(const std::string & filename, std::string & errorMessage);
+
+    /*! Check that the map has been created for the same kinematics,
+      i.e. the signature (positions computed for a few joint
+      configurations) is the same within a tenth of a voxel. */
+    bool Matches(const robManipulator & manipulator) const;
+
+    inline bool IsValid(void) const {
+        return !m_cells.empty();
+    }
+
+    /*! Constant time query, position of last link's frame in RCM
+      frame.  Positions outside the grid are unreachable. */
+    inline Status Query(const vct3 & position) const {
+        int index[3];
+        for (size_t axis = 0; axis < 3; ++axis) {
+            const double cell = (position.Element(axis) - m_origin.Element(axis)) / m_voxel_size;
+            if (!(cell >= 0.0) || (cell >= static_cast<double>(m_size[axis]))) {
+                return UNREACHABLE;
+            }
+            index[axis] = static_cast<int>(cell);
+        }
+        return static_cast<Status>(m_cells[Index(index[0], index[1], index[2])]);
+    }
+
+    static std::string StatusName(const Status status);
+
+    inline double VoxelSize(void) const {
+        return m_voxel_size;
+    }
+
+    inline double SafeDistanceFromRCM(void) const {
+        return m_safe_distance;
+    }
+
+    /*! Number of voxels per status, for statistics */
+    void Count(size_t & reachable, size_t & unsafe, size_t & unreachable) const;
+
+protected:
+    enum {
+        REACHABLE_BIT = 1,
+        SAFE_BIT = 2
+    };
+
+    inline size_t Index(const size_t x, const size_t y, const size_t z) const {
+        return x + m_size[0] * (y + m_size[1] * z);
+    }
+
+    /*! Positions of last link's frame for a few joint configurations */
+    static void Signature(const robManipulator & manipulator,
+                          std::vector<vct3> & signature);
+
+    void Dilate(void);
+
+    double m_voxel_size;
+    double m_safe_distance;
+    vct3 m_origin;
+    size_t m_size[3];
+    std::vector<unsigned char> m_cells;
+    std::vector<vct3> m_signature;
+};
+
+#endif // _robPSMWorkspaceMap_h
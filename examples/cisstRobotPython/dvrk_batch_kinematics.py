@@ -0,0 +1,213 @@
+#!/usr/bin/env python3
+
+# Author: agent
+# Date: 2026-10-18
+
+# (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+# --- begin cisst license - do not edit ---
+
+# This software is provided "as is" under an open source license, with
+# no warranty.  The complete license can be found in license.txt and
+# http://www.cisst.org/cisst/license.txt.
+
+# --- end cisst license ---
+
+# Batch forward kinematics, inverse kinematics and MTM gravity
+# compensation on NumPy arrays using the dVRK C++ code (see
+# robBatchKinematics.h and dvrk_batch_kinematics.h).  Each call
+# processes all samples in C++, spread across all cores, there is no
+# per sample Python call.  Unlike cisstRobotPython, this uses the
+# dVRK .json files and the closed form inverse kinematics for the MTM
+# and ECM.
+#
+# The shared library libsawIntuitiveResearchKitBatch.so must be in
+# LD_LIBRARY_PATH (e.g. source ~/catkin_ws/devel/setup.bash) or
+# defined by the environment variable DVRK_BATCH_LIBRARY.
+#
+# As a module:
+#   import dvrk_batch_kinematics
+#   mtm = dvrk_batch_kinematics.batch('MTM', 'share/kinematic/mtml.json',
+#                                     'share/jhu-dVRK/gc-MTML-22723.json')
+#   frames = mtm.forward(positions)         # (N, 7) -> (N, 4, 4)
+#   solutions, status = mtm.inverse(frames, positions)
+#   efforts = mtm.gravity_compensation(positions, velocities)
+#
+# As a script, runs FK and IK on random joint positions and reports
+# the throughput:
+#   ./dvrk_batch_kinematics.py -t MTM -k ../../share/kinematic/mtml.json
+
+import argparse
+import ctypes
+import ctypes.util
+import os
+import time
+
+import numpy
+
+_double_p = ctypes.POINTER(ctypes.c_double)
+_int_p = ctypes.POINTER(ctypes.c_int)
+
+
+def _load_library():
+    name = os.environ.get('DVRK_BATCH_LIBRARY')
+    if not name:
+        name = ctypes.util.find_library('sawIntuitiveResearchKitBatch')
+    if not name:
+        name = 'libsawIntuitiveResearchKitBatch.so'
+    library = ctypes.CDLL(name)
+
+    library.dvrk_batch_kinematics_create.restype = ctypes.c_void_p
+    library.dvrk_batch_kinematics_create.argtypes = [
+        ctypes.c_char_p, ctypes.c_char_p, ctypes.c_char_p,
+        ctypes.c_char_p, ctypes.c_size_t]
+    library.dvrk_batch_kinematics_destroy.restype = None
+    library.dvrk_batch_kinematics_destroy.argtypes = [ctypes.c_void_p]
+    library.dvrk_batch_kinematics_number_of_joints.restype = ctypes.c_size_t
+    library.dvrk_batch_kinematics_number_of_joints.argtypes = [ctypes.c_void_p]
+    library.dvrk_batch_kinematics_has_gravity_compensation.restype = ctypes.c_int
+    library.dvrk_batch_kinematics_has_gravity_compensation.argtypes = [ctypes.c_void_p]
+    library.dvrk_batch_kinematics_set_number_of_threads.restype = None
+    library.dvrk_batch_kinematics_set_number_of_threads.argtypes = [
+        ctypes.c_void_p, ctypes.c_size_t]
+    library.dvrk_batch_kinematics_forward.restype = None
+    library.dvrk_batch_kinematics_forward.argtypes = [
+        ctypes.c_void_p, _double_p, ctypes.c_size_t, _double_p]
+    library.dvrk_batch_kinematics_inverse.restype = ctypes.c_size_t
+    library.dvrk_batch_kinematics_inverse.argtypes = [
+        ctypes.c_void_p, _double_p, ctypes.c_size_t, _double_p, _int_p]
+    library.dvrk_batch_kinematics_gravity_compensation.restype = ctypes.c_int
+    library.dvrk_batch_kinematics_gravity_compensation.argtypes = [
+        ctypes.c_void_p, _double_p, _double_p, ctypes.c_size_t, _double_p]
+    return library
+
+
+_library = None
+
+
+def _pointer(array):
+    return array.ctypes.data_as(_double_p)
+
+
+class batch:
+    """Batch kinematics for one manipulator type ('MTM', 'ECM' or
+    'generic').  The gravity compensation file is optional and only
+    used for MTMs.  Arrays are converted to contiguous float64 if
+    needed, outputs are new arrays."""
+
+    def __init__(self, manipulator_type, kinematic_file, gravity_file = None,
+                 number_of_threads = 0):
+        global _library
+        if _library is None:
+            _library = _load_library()
+        error = ctypes.create_string_buffer(512)
+        self._handle = _library.dvrk_batch_kinematics_create(
+            manipulator_type.encode(), kinematic_file.encode(),
+            gravity_file.encode() if gravity_file else None,
+            error, len(error))
+        if not self._handle:
+            raise RuntimeError('dvrk_batch_kinematics: ' + error.value.decode())
+        self.number_of_joints = _library.dvrk_batch_kinematics_number_of_joints(self._handle)
+        self.has_gravity_compensation = bool(
+            _library.dvrk_batch_kinematics_has_gravity_compensation(self._handle))
+        self.set_number_of_threads(number_of_threads)
+
+    def __del__(self):
+        if getattr(self, '_handle', None):
+            _library.dvrk_batch_kinematics_destroy(self._handle)
+            self._handle = None
+
+    def set_number_of_threads(self, number_of_threads):
+        """0 means one thread per core"""
+        _library.dvrk_batch_kinematics_set_number_of_threads(self._handle, number_of_threads)
+
+    def _joints(self, array, name):
+        array = numpy.ascontiguousarray(array, dtype = numpy.float64)
+        if array.ndim != 2 or array.shape[1] != self.number_of_joints:
+            raise ValueError('{} must be of shape (N, {})'.format(name, self.number_of_joints))
+        return array
+
+    def forward(self, positions):
+        """Joint positions (N, joints) to frames (N, 4, 4)"""
+        positions = self._joints(positions, 'positions')
+        samples = positions.shape[0]
+        frames = numpy.empty((samples, 4, 4))
+        _library.dvrk_batch_kinematics_forward(self._handle, _pointer(positions),
+                                               samples, _pointer(frames))
+        return frames
+
+    def inverse(self, frames, initial_positions):
+        """Frames (N, 4, 4) and initial guesses (N, joints) to joint
+        positions (N, joints) and status (N), 0 for success.  Failed
+        samples keep the initial guess."""
+        frames = numpy.ascontiguousarray(frames, dtype = numpy.float64)
+        if frames.ndim != 3 or frames.shape[1:] != (4, 4):
+            raise ValueError('frames must be of shape (N, 4, 4)')
+        positions = numpy.array(self._joints(initial_positions, 'initial_positions'))
+        samples = frames.shape[0]
+        if positions.shape[0] != samples:
+            raise ValueError('frames and initial_positions must have the same number of samples')
+        status = numpy.empty(samples, dtype = numpy.intc)
+        _library.dvrk_batch_kinematics_inverse(self._handle, _pointer(frames), samples,
+                                               _pointer(positions),
+                                               status.ctypes.data_as(_int_p))
+        return positions, status
+
+    def gravity_compensation(self, positions, velocities = None):
+        """Joint positions and optional velocities (N, joints) to
+        gravity compensation and friction efforts (N, joints)"""
+        if not self.has_gravity_compensation:
+            raise RuntimeError('dvrk_batch_kinematics: no gravity compensation file provided')
+        positions = self._joints(positions, 'positions')
+        samples = positions.shape[0]
+        velocities_p = None
+        if velocities is not None:
+            velocities = self._joints(velocities, 'velocities')
+            if velocities.shape[0] != samples:
+                raise ValueError('positions and velocities must have the same number of samples')
+            velocities_p = _pointer(velocities)
+        efforts = numpy.empty((samples, self.number_of_joints))
+        _library.dvrk_batch_kinematics_gravity_compensation(self._handle, _pointer(positions),
+                                                            velocities_p, samples,
+                                                            _pointer(efforts))
+        return efforts
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser()
+    parser.add_argument('-t', '--type', type = str, required = True,
+                        choices = ['MTM', 'ECM', 'generic'],
+                        help = 'manipulator type')
+    parser.add_argument('-k', '--kinematic', type = str, required = True,
+                        help = 'kinematic file, e.g. share/kinematic/mtml.json')
+    parser.add_argument('-g', '--gravity', type = str, default = None,
+                        help = 'gravity compensation file for MTM, e.g. gc-MTML-22723.json')
+    parser.add_argument('-n', '--samples', type = int, default = 100000,
+                        help = 'number of random samples')
+    parser.add_argument('-j', '--threads', type = int, default = 0,
+                        help = 'number of threads, 0 for one per core')
+    args = parser.parse_args()
+
+    manipulator = batch(args.type, args.kinematic, args.gravity, args.threads)
+    positions = numpy.random.uniform(-0.5, 0.5, (args.samples, manipulator.number_of_joints))
+    if args.type == 'ECM':
+        # insertion, away from RCM
+        positions[:, 2] += 0.6
+
+    start = time.time()
+    frames = manipulator.forward(positions)
+    elapsed = time.time() - start
+    print('forward kinematics: {} samples in {:.3f}s'.format(args.samples, elapsed))
+
+    start = time.time()
+    solutions, status = manipulator.inverse(frames, positions + 0.01)
+    elapsed = time.time() - start
+    error = numpy.abs(manipulator.forward(solutions)[:, :3, 3] - frames[:, :3, 3]).max(axis = 1)
+    print('inverse kinematics: {} samples in {:.3f}s, {} failed, max position error {:.3e}m'.format(
+        args.samples, elapsed, numpy.count_nonzero(status), error[status == 0].max(initial = 0.0)))
+
+    if manipulator.has_gravity_compensation:
+        start = time.time()
+        efforts = manipulator.gravity_compensation(positions)
+        elapsed = time.time() - start
+        print('gravity compensation: {} samples in {:.3f}s'.format(args.samples, elapsed))
@@ -0,0 +1,124 @@
+#!/usr/bin/env python3
+
+# Author: agent
+# Date: 2026-10-18
+
+# (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+# --- begin cisst license - do not edit ---
+
+# This software is provided "as is" under an open source license, with
+# no warranty.  The complete license can be found in license.txt and
+# http://www.cisst.org/cisst/license.txt.
+
+# --- end cisst license ---
+
+# Convert files created by the dVRK binary data recorder (see
+# mtsDataRecorder.h) to CSV or NumPy.  The output format is based on
+# the output file extension:
+#  .csv: comma separated values with one header line
+#  .npy: NumPy 2D array, use -c to save the column names in a text file
+#  .npz: NumPy archive with one array per signal and "time"
+#
+# Usage: ./dvrk-recorder-convert.py -i PSM1-2021-09-29-10-00-00.dvrk-rec -o PSM1.csv
+
+import argparse
+import json
+import os
+import struct
+import sys
+
+import numpy
+
+MAGIC = b'dVRKREC\0'
+PREAMBLE = struct.Struct('<8sIIIIQ')
+
+
+def load(filename):
+    """Returns the file description (dict) and data as a 2D numpy
+    array, one row per record.  Records written after the last header
+    update (e.g. crash) are recovered based on the file size."""
+    with open(filename, 'rb') as f:
+        preamble = f.read(PREAMBLE.size)
+        if len(preamble) < PREAMBLE.size:
+            sys.exit('{}: file too short'.format(filename))
+        magic, version, header_size, columns, reserved, records = PREAMBLE.unpack(preamble)
+        if magic != MAGIC:
+            sys.exit('{}: not a dVRK recorder file'.format(filename))
+        if version != 1:
+            sys.exit('{}: unsupported version {}'.format(filename, version))
+        text = f.read(header_size - PREAMBLE.size).split(b'\0', 1)[0]
+        description = json.loads(text.decode('utf-8'))
+
+    record_size = columns * 8
+    available = (os.path.getsize(filename) - header_size) // record_size
+    if available > records:
+        # file not closed properly, find last record with a valid time
+        data = numpy.memmap(filename, dtype='<f8', mode='r', offset=header_size,
+                            shape=(available, columns))
+        nonzero = numpy.nonzero(data[records:, 0])[0]
+        records = records + (nonzero[-1] + 1 if len(nonzero) else 0)
+    data = numpy.memmap(filename, dtype='<f8', mode='r', offset=header_size,
+                        shape=(records, columns))
+    return description, numpy.array(data)
+
+
+def column_names(description):
+    names = []
+    for signal in description['signals']:
+        if signal['size'] == 1:
+            names.append(signal['name'])
+        else:
+            names.extend('{}[{}]'.format(signal['name'], index)
+                         for index in range(signal['size']))
+    return names
+
+
+def main():
+    parser = argparse.ArgumentParser(description = 'convert dVRK binary recorder files to CSV or NumPy')
+    parser.add_argument('-i', '--input', type = str, required = True,
+                        help = 'binary file created by the dVRK recorder')
+    parser.add_argument('-o', '--output', type = str, required = True,
+                        help = 'output file, format based on extension: .csv, .npy or .npz')
+    parser.add_argument('-c', '--columns', type = str,
+                        help = 'text file to save column names, one per line (useful with .npy)')
+    parser.add_argument('-s', '--summary', action = 'store_true',
+                        help = 'print file description and statistics on time stamps')
+    args = parser.parse_args()
+
+    description, data = load(args.input)
+    names = column_names(description)
+
+    if args.summary:
+        print('component: {}, created: {}, period: {}'.format(description['component'],
+                                                              description['created'],
+                                                              description['period']))
+        print('records: {}, columns: {}'.format(data.shape[0], data.shape[1]))
+        for signal in description['signals']:
+            print(' - {} ({})'.format(signal['name'], signal['size']))
+        if data.shape[0] > 1:
+            dt = numpy.diff(data[:, 0])
+            print('time step (s): average {:.6f}, min {:.6f}, max {:.6f}'.format(dt.mean(), dt.min(), dt.max()))
+
+    extension = os.path.splitext(args.output)[1].lower()
+    if extension == '.csv':
+        numpy.savetxt(args.output, data, delimiter = ',', header = ','.join(names),
+                      comments = '', fmt = '%.9g')
+    elif extension == '.npy':
+        numpy.save(args.output, data)
+    elif extension == '.npz':
+        arrays = {}
+        for signal in description['signals']:
+            first = signal['first-column']
+            arrays[signal['name']] = data[:, first:first + signal['size']]
+        numpy.savez(args.output, **arrays)
+    else:
+        sys.exit('unsupported output format "{}", use .csv, .npy or .npz'.format(extension))
+
+    if args.columns:
+        with open(args.columns, 'w') as f:
+            f.write('\n'.join(names) + '\n')
+
+
+if __name__ == '__main__':
+    main()
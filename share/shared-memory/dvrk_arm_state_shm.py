@@ -0,0 +1,185 @@
+#!/usr/bin/env python3
+
+# Author: agent
+# Date: 2026-10-18
+
+# (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+# --- begin cisst license - do not edit ---
+
+# This software is provided "as is" under an open source license, with
+# no warranty.  The complete license can be found in license.txt and
+# http://www.cisst.org/cisst/license.txt.
+
+# --- end cisst license ---
+
+# Reader for the arm state published in shared memory by the dVRK
+# arms (see "shared-memory" in the arm configuration file and
+# dvrk_arm_state_shm.h for the segment layout).  The segment is mapped
+# read only and records are NumPy views on the shared memory, there
+# is no copy unless requested.
+#
+# As a module:
+#   import dvrk_arm_state_shm
+#   reader = dvrk_arm_state_shm.reader('PSM1')
+#   record = reader.latest()  # copy of latest record, None if none
+#   records = reader.new()    # all records since previous call to new
+#   print(record['position'][:record['number_of_joints']])
+#
+# As a script, prints the latest state and the rate:
+#   ./dvrk_arm_state_shm.py -a PSM1
+
+import argparse
+import mmap
+import os
+import struct
+import sys
+import time
+
+import numpy
+
+MAGIC = b'dVRKARM\0'
+VERSION = 1
+MAX_JOINTS = 16
+NAME_SIZE = 64
+HEADER_SIZE = 256
+HEADER = struct.Struct('<8sIIIIIId{}sQQ'.format(NAME_SIZE))
+WRITTEN_OFFSET = HEADER.size - 16
+
+OPERATING_STATES = ['UNDEFINED', 'DISABLED', 'ENABLED', 'PAUSED', 'FAULT']
+VALID_JS = 1
+VALID_CP = 2
+VALID_CV = 4
+VALID_CF = 8
+
+RECORD = numpy.dtype([
+    ('sequence', '<u8'),
+    ('time', '<f8'),
+    ('number_of_joints', '<u4'),
+    ('valid', '<u4'),
+    ('operating_state', '<u4'),
+    ('is_homed', '<u4'),
+    ('is_busy', '<u4'),
+    ('reserved', '<u4'),
+    ('position', '<f8', (MAX_JOINTS,)),
+    ('velocity', '<f8', (MAX_JOINTS,)),
+    ('effort', '<f8', (MAX_JOINTS,)),
+    ('measured_cp', '<f8', (12,)),
+    ('measured_cv', '<f8', (6,)),
+    ('body_measured_cf', '<f8', (6,)),
+])
+
+
+def _open(name):
+    """Map the POSIX shared memory segment read only"""
+    path = '/dev/shm/' + name
+    if os.path.exists(path):
+        with open(path, 'rb') as f:
+            return mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+    # macOS, no /dev/shm
+    from multiprocessing import resource_tracker, shared_memory
+    segment = shared_memory.SharedMemory(name = name, create = False)
+    # don't let Python remove the segment when this process exits
+    resource_tracker.unregister(segment._name, 'shared_memory')
+    return segment.buf
+
+
+class reader:
+    def __init__(self, arm = None, name = None):
+        """Attach to the segment published by arm, named "dvrk-<arm>"
+        unless a name is provided"""
+        if name is None:
+            name = 'dvrk-' + arm
+        self.name = name.lstrip('/')
+        self._map = _open(self.name)
+        (magic, version, header_size, record_size, ring_size,
+         max_joints, _, self.period, arm_name,
+         _, self.publisher_pid) = HEADER.unpack_from(self._map, 0)
+        if magic != MAGIC:
+            raise RuntimeError('{}: not a dVRK arm state segment'.format(self.name))
+        if version != VERSION:
+            raise RuntimeError('{}: unsupported version {} (or not initialized yet)'.format(self.name, version))
+        if record_size != RECORD.itemsize or max_joints != MAX_JOINTS or header_size != HEADER_SIZE:
+            raise RuntimeError('{}: unexpected record layout'.format(self.name))
+        self.arm = arm_name.split(b'\0', 1)[0].decode('utf-8')
+        self.ring_size = ring_size
+        # zero copy views on shared memory
+        self.records = numpy.frombuffer(self._map, dtype = RECORD,
+                                        count = ring_size, offset = HEADER_SIZE)
+        self._written = numpy.frombuffer(self._map, dtype = '<u8',
+                                         count = 1, offset = WRITTEN_OFFSET)
+        self._next = self.written()
+        self.lost = 0
+
+    def written(self):
+        """Number of records written by the arm since it started"""
+        return int(self._written[0])
+
+    def record(self, index):
+        """Copy of record index, None if overwritten or not written yet"""
+        view = self.records[index % self.ring_size]
+        expected = 2 * (index + 1)
+        if view['sequence'] != expected:
+            return None
+        result = view.copy()
+        if view['sequence'] != expected:
+            return None
+        return result
+
+    def latest(self):
+        """Copy of latest record, None if no record is available"""
+        for attempt in range(4):
+            written = self.written()
+            if written == 0:
+                return None
+            result = self.record(written - 1)
+            if result is not None:
+                return result
+        return None
+
+    def new(self):
+        """Copies of all records written since the previous call, as a
+        NumPy structured array.  Records overwritten before they could
+        be read are counted in self.lost"""
+        written = self.written()
+        if written - self._next > self.ring_size:
+            self.lost += written - self._next - self.ring_size
+            self._next = written - self.ring_size
+        result = []
+        for index in range(self._next, written):
+            record = self.record(index)
+            if record is None:
+                self.lost += 1
+            else:
+                result.append(record)
+        self._next = written
+        return numpy.array(result, dtype = RECORD)
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser()
+    parser.add_argument('-a', '--arm', type = str, required = True,
+                        help = 'arm name, e.g. PSM1')
+    parser.add_argument('-n', '--name', type = str,
+                        help = 'shared memory name, default is dvrk-<arm>')
+    args = parser.parse_args(sys.argv[1:])
+
+    r = reader(args.arm, args.name)
+    print('{}: arm {}, period {:.3f} ms, ring size {}'.format(r.name, r.arm, r.period * 1000.0, r.ring_size))
+    try:
+        while True:
+            time.sleep(1.0)
+            records = r.new()
+            latest = r.latest()
+            if latest is None:
+                print('no data')
+                continue
+            joints = latest['number_of_joints']
+            print('{:.3f}: {} records/s, lost {}, {}{}, position {}, translation {}'.format(
+                latest['time'], len(records), r.lost,
+                OPERATING_STATES[latest['operating_state']] if latest['operating_state'] < len(OPERATING_STATES) else '?',
+                ' homed' if latest['is_homed'] else '',
+                numpy.array2string(latest['position'][:joints], precision = 3),
+                numpy.array2string(latest['measured_cp'][:3], precision = 4)))
+    except KeyboardInterrupt:
+        pass
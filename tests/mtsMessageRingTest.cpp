@@ -0,0 +1,100 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include "mtsMessageRingTest.h"
+
+#include <cisstCommon/cmnGenericObject.h>
+#include <cisstCommon/cmnClassRegisterMacros.h>
+#include <cisstCommon/cmnUnits.h>
+#include <cisstOSAbstraction/osaSleep.h>
+
+// owner only used for logs
+class mtsMessageRingTestOwner: public cmnGenericObject
+{
+    CMN_DECLARE_SERVICES(CMN_NO_DYNAMIC_CREATION, CMN_LOG_ALLOW_DEFAULT);
+};
+
+CMN_DECLARE_SERVICES_INSTANTIATION(mtsMessageRingTestOwner);
+CMN_IMPLEMENT_SERVICES(mtsMessageRingTestOwner);
+
+
+void mtsMessageRingTest::TestErrorsCoalesced(void)
+{
+    mtsMessageRingTestOwner owner;
+    mtsMessageRing messages(owner, "test");
+    const size_t code = messages.Register(mtsMessageRing::MESSAGE_ERROR,
+                                          "error {0}", 10.0 * cmn_s);
+    const size_t always = messages.Register(mtsMessageRing::MESSAGE_ERROR,
+                                            "always", 0.0);
+
+    // first one delivered with number of repeats
+    CPPUNIT_ASSERT(messages.Push(code, 1.0));
+    CPPUNIT_ASSERT(messages.Push(code, 2.0));
+
+    mtsMessageRing::Level level;
+    std::string message;
+    CPPUNIT_ASSERT(messages.Pop(level, message));
+    CPPUNIT_ASSERT_EQUAL(mtsMessageRing::MESSAGE_ERROR, level);
+    CPPUNIT_ASSERT_EQUAL(std::string("test: error 1 (1 similar message(s) suppressed)"), message);
+    CPPUNIT_ASSERT(!messages.Pop(level, message));
+
+    // within minimum interval, only counted
+    CPPUNIT_ASSERT(messages.Push(code, 3.0));
+    CPPUNIT_ASSERT(!messages.Pop(level, message));
+
+    // no minimum interval, each error delivered
+    CPPUNIT_ASSERT(messages.Push(always));
+    CPPUNIT_ASSERT(messages.Pop(level, message));
+    CPPUNIT_ASSERT_EQUAL(std::string("test: always"), message);
+    CPPUNIT_ASSERT(messages.Push(always));
+    CPPUNIT_ASSERT(messages.Pop(level, message));
+    CPPUNIT_ASSERT_EQUAL(mtsMessageRing::MESSAGE_ERROR, level);
+    CPPUNIT_ASSERT_EQUAL(std::string("test: always"), message);
+    CPPUNIT_ASSERT(!messages.Pop(level, message));
+}
+
+void mtsMessageRingTest::TestWarningsRateLimited(void)
+{
+    mtsMessageRingTestOwner owner;
+    mtsMessageRing messages(owner, "test");
+    const size_t warning = messages.Register(mtsMessageRing::MESSAGE_WARNING,
+                                             "warning {0}", 10.0 * cmn_s);
+    const size_t error = messages.Register(mtsMessageRing::MESSAGE_ERROR,
+                                           "error {0}", 10.0 * cmn_s);
+    messages.Start();
+
+    CPPUNIT_ASSERT(messages.Push(warning, 1.0));
+    CPPUNIT_ASSERT(messages.Push(warning, 2.0));
+    CPPUNIT_ASSERT(messages.Push(error, 3.0));
+    // let the formatting thread process the warnings
+    osaSleep(200.0 * cmn_ms);
+
+    mtsMessageRing::Level level;
+    std::string message;
+    // error is delivered first
+    CPPUNIT_ASSERT(messages.Pop(level, message));
+    CPPUNIT_ASSERT_EQUAL(mtsMessageRing::MESSAGE_ERROR, level);
+    CPPUNIT_ASSERT_EQUAL(std::string("test: error 3"), message);
+    // then only first warning, second one is suppressed
+    CPPUNIT_ASSERT(messages.Pop(level, message));
+    CPPUNIT_ASSERT_EQUAL(mtsMessageRing::MESSAGE_WARNING, level);
+    CPPUNIT_ASSERT_EQUAL(std::string("test: warning 1"), message);
+    CPPUNIT_ASSERT(!messages.Pop(level, message));
+
+    messages.Stop();
+}
@@ -0,0 +1,51 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <sawIntuitiveResearchKit/mtsMessageRing.h>
+
+class mtsMessageRingTest : public CppUnit::TestFixture
+{
+protected:
+
+    CPPUNIT_TEST_SUITE(mtsMessageRingTest);
+    {
+        CPPUNIT_TEST(TestErrorsCoalesced);
+        CPPUNIT_TEST(TestWarningsRateLimited);
+    }
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    void setUp(void) {
+    }
+
+    void tearDown(void) {
+    }
+
+    // errors are delivered by the next Pop, even without formatting
+    // thread, repeats within the minimum interval are counted
+    void TestErrorsCoalesced(void);
+
+    // warnings with same code within the minimum interval are coalesced
+    void TestWarningsRateLimited(void);
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(mtsMessageRingTest);
@@ -0,0 +1,127 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include "mtsSocketBasePSMTest.h"
+
+#include <cisstCommon/cmnConstants.h>
+#include <cisstCommon/cmnUnits.h>
+#include <cisstVector/vctAxisAngleRotation3.h>
+
+namespace {
+    // sender period, receiver clock is offset from sender clock
+    const double Period = 1.0 * cmn_ms;
+    const double Offset = 100.0;
+
+    vctFrm3 Pose(const double x, const double angle) {
+        vctFrm3 pose;
+        pose.Translation().Assign(x, 0.0, 0.0);
+        pose.Rotation().From(vctAxAnRot3(vct3(0.0, 0.0, 1.0), angle));
+        return pose;
+    }
+
+    double AngleBetween(const vctFrm3 & first, const vctFrm3 & second) {
+        vctMatRot3 difference;
+        first.Rotation().ApplyInverseTo(second.Rotation(), difference);
+        return vctAxAnRot3(difference).Angle();
+    }
+}
+
+
+void mtsSocketBasePSMTest::TestExtrapolatorLinear(void)
+{
+    mtsSocketBasePSM::Extrapolator extrapolator;
+    extrapolator.Add(Pose(0.0 * cmn_mm, 0.0), 0.1, 0.0, Offset);
+    extrapolator.Add(Pose(1.0 * cmn_mm, 0.0), 0.2, Period, Offset + Period);
+
+    vctFrm3 pose;
+    double jaw;
+    CPPUNIT_ASSERT(extrapolator.Predict(Offset + 1.5 * Period, 20.0 * cmn_ms, pose, jaw));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.5 * cmn_mm, pose.Translation().X(), 1.0e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, pose.Translation().Y(), 1.0e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, pose.Translation().Z(), 1.0e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.25, jaw, 1.0e-9);
+    CPPUNIT_ASSERT(AngleBetween(pose, Pose(0.0, 0.0)) < 1.0e-9);
+
+    // no time elapsed, last values received
+    CPPUNIT_ASSERT(extrapolator.Predict(Offset + Period, 20.0 * cmn_ms, pose, jaw));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0 * cmn_mm, pose.Translation().X(), 1.0e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.2, jaw, 1.0e-9);
+}
+
+
+void mtsSocketBasePSMTest::TestExtrapolatorRotation(void)
+{
+    mtsSocketBasePSM::Extrapolator extrapolator;
+    extrapolator.Add(Pose(0.0, 10.0 * cmnPI_180), 0.0, 0.0, Offset);
+    extrapolator.Add(Pose(0.0, 12.0 * cmnPI_180), 0.0, Period, Offset + Period);
+
+    vctFrm3 pose;
+    double jaw;
+    CPPUNIT_ASSERT(extrapolator.Predict(Offset + 1.5 * Period, 20.0 * cmn_ms, pose, jaw));
+    CPPUNIT_ASSERT(AngleBetween(pose, Pose(0.0, 13.0 * cmnPI_180)) < 1.0e-6);
+    CPPUNIT_ASSERT(pose.Translation().Norm() < 1.0e-9);
+    CPPUNIT_ASSERT(pose.Rotation().IsNormalized());
+}
+
+
+void mtsSocketBasePSMTest::TestExtrapolatorHorizon(void)
+{
+    mtsSocketBasePSM::Extrapolator extrapolator;
+    extrapolator.Add(Pose(0.0 * cmn_mm, 0.0), 0.0, 0.0, Offset);
+    extrapolator.Add(Pose(1.0 * cmn_mm, 1.0 * cmnPI_180), 0.1, Period, Offset + Period);
+
+    vctFrm3 pose;
+    double jaw;
+    // within horizon but more than MaxRatio sender periods, clamped
+    const double maxRatio = mtsSocketBasePSM::Extrapolator::MaxRatio;
+    CPPUNIT_ASSERT(extrapolator.Predict(Offset + 11.0 * Period, 20.0 * cmn_ms, pose, jaw));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL((1.0 + maxRatio) * cmn_mm, pose.Translation().X(), 1.0e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.1 * (1.0 + maxRatio), jaw, 1.0e-9);
+    CPPUNIT_ASSERT(AngleBetween(pose, Pose(0.0, (1.0 + maxRatio) * cmnPI_180)) < 1.0e-6);
+
+    // past horizon
+    CPPUNIT_ASSERT(!extrapolator.Predict(Offset + Period + 21.0 * cmn_ms, 20.0 * cmn_ms, pose, jaw));
+    CPPUNIT_ASSERT(!extrapolator.Predict(Offset + 3.0 * Period, 1.0 * cmn_ms, pose, jaw));
+}
+
+
+void mtsSocketBasePSMTest::TestExtrapolatorReset(void)
+{
+    mtsSocketBasePSM::Extrapolator extrapolator;
+    vctFrm3 pose;
+    double jaw;
+
+    // not enough packets
+    CPPUNIT_ASSERT(!extrapolator.Predict(Offset, 20.0 * cmn_ms, pose, jaw));
+    extrapolator.Add(Pose(0.0, 0.0), 0.0, 0.0, Offset);
+    CPPUNIT_ASSERT(!extrapolator.Predict(Offset + Period, 20.0 * cmn_ms, pose, jaw));
+    extrapolator.Add(Pose(1.0 * cmn_mm, 0.0), 0.0, Period, Offset + Period);
+    CPPUNIT_ASSERT(extrapolator.Predict(Offset + 1.5 * Period, 20.0 * cmn_ms, pose, jaw));
+
+    // sender restarted (id 1), its clock restarts too
+    extrapolator.Reset();
+    extrapolator.Add(Pose(5.0 * cmn_mm, 0.0), 0.0, 0.0, Offset + 2.0 * Period);
+    CPPUNIT_ASSERT(!extrapolator.Predict(Offset + 2.5 * Period, 20.0 * cmn_ms, pose, jaw));
+    extrapolator.Add(Pose(6.0 * cmn_mm, 0.0), 0.0, Period, Offset + 3.0 * Period);
+    CPPUNIT_ASSERT(extrapolator.Predict(Offset + 3.5 * Period, 20.0 * cmn_ms, pose, jaw));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(6.5 * cmn_mm, pose.Translation().X(), 1.0e-9);
+
+    // without reset, timestamps going backward are not used
+    extrapolator.Add(Pose(7.0 * cmn_mm, 0.0), 0.0, 0.0, Offset + 4.0 * Period);
+    CPPUNIT_ASSERT(!extrapolator.Predict(Offset + 4.5 * Period, 20.0 * cmn_ms, pose, jaw));
+}
@@ -0,0 +1,58 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <sawIntuitiveResearchKit/mtsSocketBasePSM.h>
+
+class mtsSocketBasePSMTest : public CppUnit::TestFixture
+{
+protected:
+
+    CPPUNIT_TEST_SUITE(mtsSocketBasePSMTest);
+    {
+        CPPUNIT_TEST(TestExtrapolatorLinear);
+        CPPUNIT_TEST(TestExtrapolatorRotation);
+        CPPUNIT_TEST(TestExtrapolatorHorizon);
+        CPPUNIT_TEST(TestExtrapolatorReset);
+    }
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    void setUp(void) {
+    }
+
+    void tearDown(void) {
+    }
+
+    // translation and jaw at constant velocity
+    void TestExtrapolatorLinear(void);
+
+    // rotation at constant angular velocity around a fixed axis
+    void TestExtrapolatorRotation(void);
+
+    // no prediction past the horizon, at most MaxRatio sender periods
+    void TestExtrapolatorHorizon(void);
+
+    // reset on restart (id 1), two packets needed after reset
+    void TestExtrapolatorReset(void);
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(mtsSocketBasePSMTest);
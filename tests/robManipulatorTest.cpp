@@ -20,6 +20,7 @@ http://www.cisst.org/cisst/license.txt.
 
 #include <cisstCommon/cmnPath.h>
 #include <cisstCommon/cmnUnits.h>
+#include <cisstCommon/cmnRandomSequence.h>
 
 #include <sawIntuitiveResearchKit/sawIntuitiveResearchKitConfig.h>
 
@@ -231,3 +232,62 @@ void robManipulatorTest::TestMTMIKSampleJointSpace(void)
 
     TestSampleJointSpace(data);
 }
+
+
+void robManipulatorTest::CompareForwardKinematicsCache(ManipulatorTestData & data)
+{
+    robForwardKinematicsCache cache;
+    cmnRandomSequence & random = cmnRandomSequence::GetInstance();
+    const size_t nbLinks = data.NumberOfLinks;
+    vctDoubleMat jacobian(6, nbLinks), jacobianCache(6, nbLinks);
+    vctFrm4x4 frame, frameCache;
+
+    for (size_t sample = 0; sample < 500; ++sample) {
+        // every other sample, only change the last joints to exercise prefix reuse
+        const size_t firstJoint = (sample % 2) ? (sample % nbLinks) : 0;
+        for (size_t joint = firstJoint; joint < nbLinks; ++joint) {
+            data.ActualJoints[joint] = random.ExtractRandomDouble(data.LowerLimits[joint],
+                                                                  data.UpperLimits[joint]);
+        }
+
+        // partial chains, in reverse order so shorter chains are served from cache
+        for (int link = static_cast<int>(nbLinks) - 1; link >= 0; --link) {
+            frame = data.Manipulator->ForwardKinematics(data.ActualJoints, link);
+            frameCache = cache.ForwardKinematics(*(data.Manipulator), data.ActualJoints, link);
+            CPPUNIT_ASSERT_MESSAGE(data.Name + ": cached partial forward kinematics differ",
+                                   frame.AlmostEqual(frameCache, 1e-9));
+        }
+
+        // full chain with tool
+        frame = data.Manipulator->ForwardKinematics(data.ActualJoints);
+        frameCache = cache.ForwardKinematics(*(data.Manipulator), data.ActualJoints);
+        CPPUNIT_ASSERT_MESSAGE(data.Name + ": cached forward kinematics differ",
+                               frame.AlmostEqual(frameCache, 1e-9));
+
+        // jacobians
+        data.Manipulator->JacobianSpatial(data.ActualJoints, jacobian);
+        cache.JacobianSpatial(*(data.Manipulator), data.ActualJoints, jacobianCache);
+        CPPUNIT_ASSERT_MESSAGE(data.Name + ": cached spatial jacobian differs",
+                               jacobian.AlmostEqual(jacobianCache, 1e-9));
+        data.Manipulator->JacobianBody(data.ActualJoints, jacobian);
+        cache.JacobianBody(*(data.Manipulator), data.ActualJoints, jacobianCache);
+        CPPUNIT_ASSERT_MESSAGE(data.Name + ": cached body jacobian differs",
+                               jacobian.AlmostEqual(jacobianCache, 1e-9));
+    }
+}
+
+void robManipulatorTest::TestForwardKinematicsCache(void)
+{
+    ManipulatorTestDataMTM dataMTM;
+    SetupTestData(dataMTM, "mtmr.json");
+    CompareForwardKinematicsCache(dataMTM);
+
+    // ECM with a tool tip offset similar to 30 degrees up endoscope
+    ManipulatorTestDataECM dataECM;
+    SetupTestData(dataECM, "ecm.json");
+    vctFrm4x4 toolOffset;
+    toolOffset.Rotation().From(vctAxAnRot3(vct3(1.0, 0.0, 0.0), -30.0 * cmnPI_180));
+    toolOffset.Translation().Assign(0.0, 0.0, 1.0 * cmn_cm);
+    dataECM.Manipulator->Attach(new robManipulator(toolOffset));
+    CompareForwardKinematicsCache(dataECM);
+}
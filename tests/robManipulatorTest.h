@@ -22,6 +22,7 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstVector/vctDynamicVectorTypes.h>
 #include <sawIntuitiveResearchKit/robManipulatorECM.h>
 #include <sawIntuitiveResearchKit/robManipulatorMTM.h>
+#include <sawIntuitiveResearchKit/robForwardKinematicsCache.h>
 
 class ManipulatorTestData {
 public:
@@ -47,6 +48,7 @@ protected:
     {
         CPPUNIT_TEST(TestECMIKSampleJointSpace);
         CPPUNIT_TEST(TestMTMIKSampleJointSpace);
+        CPPUNIT_TEST(TestForwardKinematicsCache);
     }
     CPPUNIT_TEST_SUITE_END();
 
@@ -60,6 +62,9 @@ protected:
     // returns joint values as well as forward kinematic
     void TestSampleJointSpace(ManipulatorTestData & data);
 
+    // compare cached kinematics to robManipulator for random joint values
+    void CompareForwardKinematicsCache(ManipulatorTestData & data);
+
 public:
 
     void setUp(void) {
@@ -71,6 +76,8 @@ public:
     void TestECMIKSampleJointSpace(void);
 
     void TestMTMIKSampleJointSpace(void);
+
+    void TestForwardKinematicsCache(void);
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(robManipulatorTest);
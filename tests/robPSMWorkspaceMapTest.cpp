@@ -0,0 +1,180 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include "robPSMWorkspaceMapTest.h"
+
+#include <cstdio>
+#include <limits>
+
+#include <cisstCommon/cmnUnits.h>
+
+// small grid set by hand, no need to sample a manipulator
+class robPSMWorkspaceMapTestGrid: public robPSMWorkspaceMap
+{
+public:
+    robPSMWorkspaceMapTestGrid(const size_t size, const double voxelSize) {
+        m_voxel_size = voxelSize;
+        m_safe_distance = 5.0 * cmn_mm;
+        m_origin.SetAll(-0.5 * static_cast<double>(size) * voxelSize);
+        m_size[0] = m_size[1] = m_size[2] = size;
+        m_cells.assign(size * size * size, 0);
+    }
+
+    void Set(const size_t x, const size_t y, const size_t z, const bool safe) {
+        m_cells[Index(x, y, z)] = safe ? (REACHABLE_BIT | SAFE_BIT) : REACHABLE_BIT;
+    }
+
+    // center of voxel
+    vct3 Center(const size_t x, const size_t y, const size_t z) const {
+        return vct3(m_origin.X() + (x + 0.5) * m_voxel_size,
+                    m_origin.Y() + (y + 0.5) * m_voxel_size,
+                    m_origin.Z() + (z + 0.5) * m_voxel_size);
+    }
+
+    const vct3 & Origin(void) const {
+        return m_origin;
+    }
+
+    using robPSMWorkspaceMap::Dilate;
+};
+
+
+void robPSMWorkspaceMapTest::TestStatusClassification(void)
+{
+    robPSMWorkspaceMapTestGrid map(3, 1.0 * cmn_mm);
+    CPPUNIT_ASSERT(map.IsValid());
+    map.Set(0, 0, 0, true);
+    map.Set(2, 1, 0, false);
+
+    CPPUNIT_ASSERT_EQUAL(robPSMWorkspaceMap::REACHABLE, map.Query(map.Center(0, 0, 0)));
+    CPPUNIT_ASSERT_EQUAL(robPSMWorkspaceMap::REACHABLE_UNSAFE, map.Query(map.Center(2, 1, 0)));
+    CPPUNIT_ASSERT_EQUAL(robPSMWorkspaceMap::UNREACHABLE, map.Query(map.Center(1, 1, 1)));
+    // x varies first
+    CPPUNIT_ASSERT_EQUAL(robPSMWorkspaceMap::UNREACHABLE, map.Query(map.Center(0, 1, 2)));
+
+    size_t reachable, unsafe, unreachable;
+    map.Count(reachable, unsafe, unreachable);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), reachable);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), unsafe);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(25), unreachable);
+
+    CPPUNIT_ASSERT_EQUAL(std::string("REACHABLE_UNSAFE"),
+                         robPSMWorkspaceMap::StatusName(robPSMWorkspaceMap::REACHABLE_UNSAFE));
+}
+
+
+void robPSMWorkspaceMapTest::TestDilate(void)
+{
+    robPSMWorkspaceMapTestGrid map(5, 1.0 * cmn_mm);
+    map.Set(1, 1, 1, true);
+    map.Set(3, 3, 3, false);
+    map.Dilate();
+
+    // 3x3x3 neighborhood, including diagonals
+    CPPUNIT_ASSERT_EQUAL(robPSMWorkspaceMap::REACHABLE, map.Query(map.Center(0, 0, 0)));
+    CPPUNIT_ASSERT_EQUAL(robPSMWorkspaceMap::REACHABLE, map.Query(map.Center(2, 2, 0)));
+    CPPUNIT_ASSERT_EQUAL(robPSMWorkspaceMap::REACHABLE_UNSAFE, map.Query(map.Center(4, 4, 4)));
+    // both neighbors, safe wins
+    CPPUNIT_ASSERT_EQUAL(robPSMWorkspaceMap::REACHABLE, map.Query(map.Center(2, 2, 2)));
+    // two voxels away
+    CPPUNIT_ASSERT_EQUAL(robPSMWorkspaceMap::UNREACHABLE, map.Query(map.Center(4, 0, 0)));
+    CPPUNIT_ASSERT_EQUAL(robPSMWorkspaceMap::UNREACHABLE, map.Query(map.Center(0, 4, 4)));
+
+    size_t reachable, unsafe, unreachable;
+    map.Count(reachable, unsafe, unreachable);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(27), reachable);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(26), unsafe);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(125 - 27 - 26), unreachable);
+}
+
+
+void robPSMWorkspaceMapTest::TestQueryBoundary(void)
+{
+    const double voxelSize = 1.0 * cmn_mm;
+    const double epsilon = 1.0e-6 * voxelSize;
+    robPSMWorkspaceMapTestGrid map(2, voxelSize);
+    map.Set(0, 0, 0, true);
+    map.Set(1, 1, 1, false);
+
+    // lower face belongs to the first voxel
+    const vct3 lower(map.Origin());
+    CPPUNIT_ASSERT_EQUAL(robPSMWorkspaceMap::REACHABLE, map.Query(lower));
+    for (size_t axis = 0; axis < 3; ++axis) {
+        vct3 outside(lower);
+        outside.Element(axis) -= epsilon;
+        CPPUNIT_ASSERT_EQUAL(robPSMWorkspaceMap::UNREACHABLE, map.Query(outside));
+    }
+
+    // upper face is outside the grid
+    const vct3 upper(lower + vct3(2.0 * voxelSize));
+    CPPUNIT_ASSERT_EQUAL(robPSMWorkspaceMap::UNREACHABLE, map.Query(upper));
+    CPPUNIT_ASSERT_EQUAL(robPSMWorkspaceMap::REACHABLE_UNSAFE, map.Query(upper - vct3(epsilon)));
+    for (size_t axis = 0; axis < 3; ++axis) {
+        vct3 outside(upper - vct3(epsilon));
+        outside.Element(axis) += 2.0 * epsilon;
+        CPPUNIT_ASSERT_EQUAL(robPSMWorkspaceMap::UNREACHABLE, map.Query(outside));
+    }
+
+    // between voxels, position on the face belongs to the upper voxel
+    CPPUNIT_ASSERT_EQUAL(robPSMWorkspaceMap::REACHABLE_UNSAFE, map.Query(vct3(0.0)));
+    CPPUNIT_ASSERT_EQUAL(robPSMWorkspaceMap::REACHABLE, map.Query(vct3(-epsilon)));
+
+    // invalid positions
+    CPPUNIT_ASSERT_EQUAL(robPSMWorkspaceMap::UNREACHABLE,
+                         map.Query(vct3(std::numeric_limits<double>::quiet_NaN())));
+    CPPUNIT_ASSERT_EQUAL(robPSMWorkspaceMap::UNREACHABLE,
+                         map.Query(vct3(-std::numeric_limits<double>::infinity())));
+    CPPUNIT_ASSERT_EQUAL(robPSMWorkspaceMap::UNREACHABLE,
+                         map.Query(vct3(std::numeric_limits<double>::infinity())));
+
+    // empty map
+    robPSMWorkspaceMap empty;
+    CPPUNIT_ASSERT(!empty.IsValid());
+    CPPUNIT_ASSERT_EQUAL(robPSMWorkspaceMap::UNREACHABLE, empty.Query(vct3(0.0)));
+}
+
+
+void robPSMWorkspaceMapTest::TestSaveLoad(void)
+{
+    robPSMWorkspaceMapTestGrid map(4, 2.0 * cmn_mm);
+    map.Set(0, 1, 2, true);
+    map.Set(3, 3, 0, false);
+
+    std::string errorMessage;
+    const std::string filename = "robPSMWorkspaceMapTest.dvrk-ws";
+    bool ok = map.Save(filename, errorMessage);
+    CPPUNIT_ASSERT_MESSAGE(errorMessage, ok);
+
+    robPSMWorkspaceMap loaded;
+    ok = loaded.Load(filename, errorMessage);
+    std::remove(filename.c_str());
+    CPPUNIT_ASSERT_MESSAGE(errorMessage, ok);
+
+    CPPUNIT_ASSERT_EQUAL(map.VoxelSize(), loaded.VoxelSize());
+    CPPUNIT_ASSERT_EQUAL(map.SafeDistanceFromRCM(), loaded.SafeDistanceFromRCM());
+    for (size_t z = 0; z < 4; ++z) {
+        for (size_t y = 0; y < 4; ++y) {
+            for (size_t x = 0; x < 4; ++x) {
+                const vct3 center = map.Center(x, y, z);
+                CPPUNIT_ASSERT_EQUAL(map.Query(center), loaded.Query(center));
+            }
+        }
+    }
+    CPPUNIT_ASSERT_EQUAL(robPSMWorkspaceMap::REACHABLE, loaded.Query(map.Center(0, 1, 2)));
+    CPPUNIT_ASSERT_EQUAL(robPSMWorkspaceMap::REACHABLE_UNSAFE, loaded.Query(map.Center(3, 3, 0)));
+}
@@ -0,0 +1,58 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  agent
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <sawIntuitiveResearchKit/robPSMWorkspaceMap.h>
+
+class robPSMWorkspaceMapTest : public CppUnit::TestFixture
+{
+protected:
+
+    CPPUNIT_TEST_SUITE(robPSMWorkspaceMapTest);
+    {
+        CPPUNIT_TEST(TestStatusClassification);
+        CPPUNIT_TEST(TestDilate);
+        CPPUNIT_TEST(TestQueryBoundary);
+        CPPUNIT_TEST(TestSaveLoad);
+    }
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    void setUp(void) {
+    }
+
+    void tearDown(void) {
+    }
+
+    // status and count for voxels with reachable and safe flags
+    void TestStatusClassification(void);
+
+    // reachable and safe flags are dilated by one voxel
+    void TestDilate(void);
+
+    // positions on and around the grid faces
+    void TestQueryBoundary(void);
+
+    // same queries after save and load
+    void TestSaveLoad(void);
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(robPSMWorkspaceMapTest);